@@ -0,0 +1,242 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _ASYNCCOMMANDS_H_HEADER
+#define _ASYNCCOMMANDS_H_HEADER
+
+/**
+ * @file AsyncCommands.h
+ * @brief Provides a pool of worker threads for running slow commands without stalling the main loop.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Jupiter/GenericCommand.h"
+#include "Jupiter_Bot.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Runs command work on a pool of worker threads, and delivers the responses on the main thread.
+* Work must only touch state which it owns (i.e: a snapshot taken when the command was triggered), and should
+* periodically check its cancellation flag. Deliveries are made from deliver(), which is called by the main loop,
+* so that responses are only ever sent on the main thread. Each user may only have a limited number of jobs pending.
+* Note: work and deliveries run code from the module which submitted them, so a module must pass an owner when submitting,
+* and call cancelAll() with that owner before it is unloaded.
+*/
+class JUPITER_BOT_API AsyncCommands
+{
+public:
+	using ResponseLine = Jupiter::GenericCommand::ResponseLine;
+
+	/** Runs on a worker thread; returns the response lines to deliver */
+	using Work = std::function<ResponseLine*(const std::atomic<bool>& in_cancelled)>;
+
+	/** Runs on the main thread; takes ownership of the response lines */
+	using Delivery = std::function<void(ResponseLine* in_response)>;
+
+	/** Identifies a job; 0 is never a valid ID */
+	using JobId = uint64_t;
+
+	/**
+	* @brief Queues work to run on a worker thread.
+	*
+	* @param in_user Key identifying the user which the job belongs to, for per-user limits and cancellation
+	* @param in_origin Object which the delivery depends upon (i.e: the IRC server to respond on), for cancellation
+	* @param in_work Work to run on a worker thread
+	* @param in_delivery Function to call on the main thread with the result of the work
+	* @param in_owner Object identifying the module which the work and delivery belong to (i.e: a plugin), for cancelAll()
+	* @return ID of the queued job, or 0 if the user already has the maximum number of jobs pending.
+	*/
+	JobId submit(std::string_view in_user, const void* in_origin, Work in_work, Delivery in_delivery, const void* in_owner = nullptr);
+
+	/**
+	* @brief Cancels a job. Queued jobs are dropped, and running jobs have their cancellation flag set; either way, the job is never delivered.
+	*
+	* @param in_job ID of the job to cancel
+	* @return True if the job was pending, false otherwise.
+	*/
+	bool cancel(JobId in_job);
+
+	/**
+	* @brief Cancels every job belonging to a user.
+	*
+	* @param in_user Key of the user whose jobs to cancel
+	* @return Number of jobs cancelled
+	*/
+	size_t cancelUser(std::string_view in_user);
+
+	/**
+	* @brief Cancels every job which depends upon an object. Called when the object is about to be destroyed.
+	*
+	* @param in_origin Object which is going away
+	* @return Number of jobs cancelled
+	*/
+	size_t cancelOrigin(const void* in_origin);
+
+	/**
+	* @brief Cancels every job submitted by an owner, waits for any of them which are running to return, and destroys
+	* their work and deliveries. Once this returns, no code from the owner's module is referenced by the pool, so this
+	* must be called from the main thread before that module is unloaded (i.e: from a plugin's destructor).
+	*
+	* @param in_owner Owner passed to submit()
+	* @return Number of jobs cancelled
+	*/
+	size_t cancelAll(const void* in_owner);
+
+	/**
+	* @brief Fetches the number of jobs which a user has pending, including jobs awaiting delivery.
+	*
+	* @param in_user Key of the user
+	* @return Number of pending jobs
+	*/
+	size_t getPendingCount(std::string_view in_user) const;
+
+	/**
+	* @brief Delivers the results of finished jobs. Called from the main loop.
+	*/
+	void deliver();
+
+	/**
+	* @brief Sets the limits of the pool. Existing workers are kept if the thread limit shrinks.
+	*
+	* @param in_thread_limit Maximum number of worker threads; 0 to use the number of hardware threads
+	* @param in_user_limit Maximum number of jobs each user may have pending; 0 for no limit
+	*/
+	void setLimits(size_t in_thread_limit, size_t in_user_limit);
+
+	/**
+	* @brief Cancels every job, and waits for the workers to exit.
+	*/
+	void shutdown();
+
+	/**
+	* @brief Deletes a chain of response lines.
+	*
+	* @param in_response First line of the chain
+	*/
+	static void freeResponse(ResponseLine* in_response);
+
+	AsyncCommands() = default;
+	~AsyncCommands();
+	AsyncCommands(const AsyncCommands&) = delete;
+	AsyncCommands& operator=(const AsyncCommands&) = delete;
+
+private:
+	struct Job
+	{
+		JobId id;
+		std::string user;
+		const void* origin;
+		const void* owner;
+		Work work;
+		Delivery delivery;
+		std::atomic<bool> cancelled{ false };
+		bool running = false; /** Requires m_mutex */
+		ResponseLine* result = nullptr;
+	};
+	using JobPtr = std::shared_ptr<Job>;
+
+	void work();
+	void release(const Job& in_job); /** Requires m_mutex */
+	void cancelJob(const JobPtr& in_job); /** Requires m_mutex */
+
+	bool m_stopping = false;
+	size_t m_thread_limit = 2;
+	size_t m_user_limit = 2;
+	JobId m_next_id = 1;
+	std::unordered_map<JobId, JobPtr> m_jobs; /** Jobs which have not been delivered or cancelled */
+	std::unordered_map<std::string, size_t> m_user_counts;
+	std::deque<JobPtr> m_queued;
+	std::vector<JobPtr> m_running; /** Jobs whose work is running on a worker; may include cancelled jobs */
+	std::vector<JobPtr> m_finished; /** Jobs awaiting delivery; may include cancelled jobs */
+	std::vector<std::thread> m_workers;
+	size_t m_idle_workers = 0;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_queued_condition;
+	std::condition_variable m_finished_condition;
+};
+
+/**
+* @brief Generic command whose work is run on the AsyncCommands pool when triggered from IRC or the console.
+* prepare() runs on the main thread, where it parses the parameters and snapshots whatever state the work needs.
+* The returned work runs on a worker thread; if preparation fails, the work may simply return an error response.
+*/
+class JUPITER_BOT_API AsyncGenericCommand : public Jupiter::GenericCommand
+{
+public:
+	/**
+	* @brief Prepares the work for a command on the main thread.
+	*
+	* @param in_parameters Parameters passed to the command
+	* @return Work to run on a worker thread
+	*/
+	virtual AsyncCommands::Work prepare(std::string_view in_parameters) = 0;
+
+	/**
+	* @brief Prepares and runs the work immediately, for callers which are unaware of asynchronous commands.
+	*
+	* @param in_parameters Parameters passed to the command
+	* @return Response lines from the work
+	*/
+	ResponseLine* trigger(std::string_view in_parameters) override;
+
+	/** Cancels this command's jobs, which were submitted with it as their owner */
+	~AsyncGenericCommand() override;
+};
+
+/** Async command pool driven by main_loop(). Note: DO NOT DELETE OR FREE THIS POINTER. */
+JUPITER_BOT_API extern AsyncCommands *asyncCommands;
+
+/** Async Generic Command Macros */
+
+/** Defines the core of an asynchronous generic command's declaration. This should be included in every asynchronous generic command. */
+#define BASE_ASYNC_GENERIC_COMMAND(CLASS) \
+	public: \
+	AsyncCommands::Work prepare(std::string_view parameters) override; \
+	std::string_view getHelp(std::string_view parameters) override; \
+	static CLASS instance; \
+	CLASS();
+
+/** Expands to an asynchronous generic command's declaration. */
+#define GENERIC_ASYNC_GENERIC_COMMAND(CLASS) \
+	class CLASS : public AsyncGenericCommand { \
+		BASE_ASYNC_GENERIC_COMMAND(CLASS) \
+	};
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _ASYNCCOMMANDS_H_HEADER
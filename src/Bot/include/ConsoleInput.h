@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _CONSOLEINPUT_H_HEADER
+#define _CONSOLEINPUT_H_HEADER
+
+/**
+ * @file ConsoleInput.h
+ * @brief Provides the queue of console commands, fed by standard input and the admin socket.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "Jupiter_Bot.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Bounded lock-free queue of console command lines, with many producers and the main loop as the only consumer.
+* Each slot has a sequence number which tells producers whether it is free and the consumer whether it is filled,
+* so that neither side ever takes a lock. Lines may optionally carry a reply function, which is passed everything
+* the command wrote to std::cout; this is how output is returned to admin socket clients.
+* Note: Output is captured at the stream level; anything written directly to the stdout descriptor (printf(), puts(),
+* fwrite(stdout), or a plugin's own handle) bypasses the capture and is written to the console instead.
+*/
+class JUPITER_BOT_API ConsoleInput
+{
+public:
+	/** Called on the main thread with the output of a command */
+	using Reply = std::function<void(std::string_view in_output)>;
+
+	/** Maximum number of lines which may be queued; must be a power of two */
+	static constexpr size_t capacity = 1024;
+
+	/**
+	* @brief Queues a command line. Safe to call from any thread.
+	*
+	* @param in_line Command line to queue
+	* @param in_reply Function to pass the command's output (std::cout, std::cerr, and std::clog) to, or nullptr to write it to the console
+	* @return True if the line was queued, false if the queue is full.
+	*/
+	bool push(std::string in_line, Reply in_reply = nullptr);
+
+	/**
+	* @brief Queues a command line, blocking until the main loop makes room if the queue is full.
+	* Safe to call from any thread except the main loop's.
+	*
+	* @param in_line Command line to queue
+	* @param in_reply Function to pass the command's output to, or nullptr to write it to the console
+	*/
+	void pushWait(std::string in_line, Reply in_reply = nullptr);
+
+	/**
+	* @brief Runs every queued command line. Called from the main loop.
+	* At most capacity lines are run per call, so that producers can't stall the main loop.
+	*
+	* @return Number of command lines run
+	*/
+	size_t process();
+
+	/**
+	* @brief Takes over replying for the command line currently being run, for commands which finish later
+	* (i.e: on an RCON response). Output the command writes before returning is still captured, and is sent first.
+	* Called from within a console command's trigger().
+	*
+	* @return Function to call exactly once with the rest of the output, or nullptr if the command line has no reply
+	* function (i.e: it was read from standard input) or the reply was already taken, in which case the command
+	* should write its output to std::cout as usual. If every copy of the function is destroyed without being called,
+	* the captured output is sent on its own.
+	*/
+	Reply deferReply();
+
+	/**
+	* @brief Starts accepting command lines from a local UNIX-domain socket.
+	* Clients send one command per line; the output of each command is sent back, followed by a null byte.
+	* Note: Only output written to std::cout, std::cerr, or std::clog on the main thread while the command runs, or passed
+	* to a reply taken through deferReply(), is returned.
+	*
+	* @param in_path Path of the socket to create; a stale socket at the path is replaced, but any other file is left alone
+	* @return True if the socket is listening, false otherwise.
+	*/
+	bool startAdminSocket(std::string_view in_path);
+
+	/**
+	* @brief Stops the admin socket, if started, and disconnects every client.
+	*/
+	void stopAdminSocket();
+
+	ConsoleInput();
+	~ConsoleInput();
+	ConsoleInput(const ConsoleInput&) = delete;
+	ConsoleInput& operator=(const ConsoleInput&) = delete;
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		std::string line;
+		Reply reply;
+	};
+
+	struct DeferredReply;
+
+	bool tryPush(std::string& in_line, Reply& in_reply);
+	bool pop(std::string& out_line, Reply& out_reply);
+	void run(std::string_view in_line);
+	void adminLoop();
+
+	std::unique_ptr<Slot[]> m_slots;
+	alignas(64) std::atomic<size_t> m_push_position{ 0 };
+	alignas(64) size_t m_pop_position = 0; /** Only touched by the consumer */
+	const Reply* m_running_reply = nullptr; /** Reply of the line being run; only touched by the consumer */
+	std::shared_ptr<DeferredReply> m_deferred_reply; /** Set by deferReply(); only touched by the consumer */
+
+	std::mutex m_room_mutex;
+	std::condition_variable m_room; /** Notified by process() when it frees slots while a producer is waiting */
+	std::atomic<size_t> m_room_waiters{ 0 };
+
+	std::string m_admin_path;
+	std::thread m_admin_thread;
+	std::atomic<bool> m_admin_stopping{ false };
+	std::atomic<bool> m_admin_backlogged{ false }; /** Set while the admin thread has lines waiting for room in the queue */
+	int m_admin_socket = -1;
+	int m_admin_wake[2]{ -1, -1 }; /** Pipe written to when a reply is ready to send */
+};
+
+/** Console command queue drained by main_loop(). Note: DO NOT DELETE OR FREE THIS POINTER. */
+JUPITER_BOT_API extern ConsoleInput *consoleInput;
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _CONSOLEINPUT_H_HEADER
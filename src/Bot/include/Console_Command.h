@@ -25,8 +25,11 @@
 */
 
 #include <iostream>
+#include <memory>
+#include <type_traits>
 #include "Jupiter/GenericCommand.h"
 #include "Jupiter_Bot.h"
+#include "AsyncCommands.h"
 
 class ConsoleCommand;
 
@@ -111,8 +114,16 @@ template <typename T> Generic_Command_As_Console_Command<T>::Generic_Command_As_
 	}
 }
 
-template<typename T> void Generic_Command_As_Console_Command<T>::trigger(std::string_view parameters) {
-	std::unique_ptr<Jupiter::GenericCommand::ResponseLine> response_line{ T::instance.trigger(parameters) };
+/** Key which identifies the console's asynchronous commands */
+constexpr std::string_view console_async_user{ "console" };
+
+/**
+* @brief Prints a chain of response lines to the console, and deletes them.
+*
+* @param in_response First line of the chain
+*/
+inline void print_generic_response(Jupiter::GenericCommand::ResponseLine *in_response) {
+	std::unique_ptr<Jupiter::GenericCommand::ResponseLine> response_line{ in_response };
 	while (response_line != nullptr) {
 		auto& out_stream = response_line->type == Jupiter::GenericCommand::DisplayType::PublicError
 			|| response_line->type == Jupiter::GenericCommand::DisplayType::PrivateError ? std::cerr : std::cout;
@@ -122,6 +133,18 @@ template<typename T> void Generic_Command_As_Console_Command<T>::trigger(std::st
 	}
 }
 
+template<typename T> void Generic_Command_As_Console_Command<T>::trigger(std::string_view parameters) {
+	if constexpr (std::is_base_of_v<AsyncGenericCommand, T>) {
+		AsyncCommands::Work work = T::instance.prepare(parameters);
+		if (work && asyncCommands->submit(console_async_user, nullptr, std::move(work), print_generic_response, &T::instance) == 0) {
+			std::cerr << "Error: Too many commands in progress. Use \"cancel\" to cancel them." << std::endl;
+		}
+	}
+	else {
+		print_generic_response(T::instance.trigger(parameters));
+	}
+}
+
 template<typename T> std::string_view Generic_Command_As_Console_Command<T>::getHelp(std::string_view parameters)
 {
 	return T::instance.getHelp(parameters);
@@ -24,8 +24,11 @@
  * @brief Provides extendable bot-like interfacing with the IRC client.
  */
 
+#include <unordered_map>
 #include <vector>
+#include "jessilib/unicode.hpp"
 #include "Jupiter_Bot.h"
+#include "Metrics.h"
 #include "Jupiter/IRC_Client.h"
 #include "Jupiter/Rehash.h"
 
@@ -116,8 +119,12 @@ protected:
 
 	/** Private members for internal usage */
 private:
-	std::vector<std::unique_ptr<IRCCommand>> m_commands;
+	void indexCommand(IRCCommand *in_command);
+
+	std::vector<std::unique_ptr<IRCCommand>> m_commands; /** Per-bot copies; unlike game commands, most commands carry per-channel access levels from the bot's own config */
+	std::unordered_map<std::string, IRCCommand*, jessilib::text_hashi, jessilib::text_equali> m_commandIndex; /** Case-insensitive trigger lookup into m_commands */
 	std::string m_commandPrefix;
+	MetricsRegistry::Counter* m_chatMetric; /** Channel messages received */
 };
 
 /** Re-enable warnings */
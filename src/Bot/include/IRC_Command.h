@@ -201,6 +201,15 @@ public:
 	*/
 	const Jupiter::GenericCommand &getGenericCommand() const;
 
+	/**
+	* @brief Fetches the key which identifies a user's asynchronous commands
+	*
+	* @param in_server IRC server the user is on
+	* @param in_nick Nickname of the user
+	* @return Key to pass to AsyncCommands
+	*/
+	static std::string getAsyncUser(IRC_Bot *in_server, std::string_view in_nick);
+
 	/**
 	* @brief Copy constructor for the GenericCommandWrapperIRCCommand class
 	*/
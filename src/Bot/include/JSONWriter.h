@@ -0,0 +1,159 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _JSONWRITER_H_HEADER
+#define _JSONWRITER_H_HEADER
+
+/**
+ * @file JSONWriter.h
+ * @brief Provides a streaming JSON writer which appends directly to a caller-owned buffer.
+ */
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "Jupiter_Bot.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Streaming JSON writer.
+* Values are appended to the buffer as they are written; no intermediate strings or documents are built, so
+* writing does not allocate beyond growing the buffer. Separators are tracked by the writer, and strings are
+* escaped in bulk, 16 bytes at a time where SSE2 is available.
+* The writer does not validate its input; keys must only be written within objects, and each container must be closed.
+*/
+class JUPITER_BOT_API JSONWriter
+{
+public:
+	/**
+	* @brief Begins an object or array.
+	*
+	* @return This writer
+	*/
+	JSONWriter& beginObject();
+	JSONWriter& beginArray();
+
+	/**
+	* @brief Ends the innermost object or array.
+	*
+	* @return This writer
+	*/
+	JSONWriter& endObject();
+	JSONWriter& endArray();
+
+	/**
+	* @brief Writes the key of the next member of an object.
+	*
+	* @param in_key Key to write
+	* @return This writer
+	*/
+	JSONWriter& key(std::string_view in_key);
+
+	/**
+	* @brief Writes a value.
+	* Non-finite floating point values are written as null.
+	*
+	* @param in_value Value to write
+	* @return This writer
+	*/
+	JSONWriter& value(std::string_view in_value);
+	JSONWriter& value(const char* in_value) { return value(std::string_view{ in_value }); }
+	JSONWriter& value(bool in_value);
+	JSONWriter& value(double in_value);
+	JSONWriter& null();
+
+	template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+	JSONWriter& value(T in_value) {
+		char buffer[24];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), in_value);
+		return raw(std::string_view{ buffer, static_cast<size_t>(result.ptr - buffer) });
+	}
+
+	/**
+	* @brief Writes a member of an object; equivalent to key(in_key).value(in_value).
+	*
+	* @param in_key Key of the member
+	* @param in_value Value of the member
+	* @return This writer
+	*/
+	template<typename T>
+	JSONWriter& member(std::string_view in_key, T&& in_value) {
+		key(in_key);
+		return value(std::forward<T>(in_value));
+	}
+
+	/**
+	* @brief Writes an already serialized JSON value, as-is.
+	*
+	* @param in_json Serialized value to write
+	* @return This writer
+	*/
+	JSONWriter& raw(std::string_view in_json);
+
+	/**
+	* @brief Appends the escaped contents of a JSON string (without quotation marks) to a buffer.
+	* Bytes outside of ASCII are copied as-is, so UTF-8 passes through unchanged.
+	*
+	* @param out_buffer Buffer to append to
+	* @param in_string String to escape
+	*/
+	static void escape(std::string& out_buffer, std::string_view in_string);
+
+	/**
+	* @brief Fetches the buffer being written to.
+	*
+	* @return Buffer being written to
+	*/
+	std::string& buffer() const { return m_buffer; }
+
+	/**
+	* @brief Constructor for the JSONWriter class.
+	* Output is appended to the buffer; any existing contents are kept.
+	*
+	* @param in_buffer Buffer to append to
+	* @param in_pretty True to write each value on its own line, indented by tabs, false to write compactly
+	*/
+	explicit JSONWriter(std::string& in_buffer, bool in_pretty = false)
+		: m_buffer{ in_buffer },
+		m_pretty{ in_pretty } {
+	}
+
+private:
+	void separate();
+	void end(char in_token);
+
+	std::string& m_buffer;
+	size_t m_depth = 0;
+	bool m_pretty;
+	bool m_first = true; /** True until the innermost container has an element */
+	bool m_after_key = false;
+};
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _JSONWRITER_H_HEADER
@@ -0,0 +1,284 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _METRICS_H_HEADER
+#define _METRICS_H_HEADER
+
+/**
+ * @file Metrics.h
+ * @brief Provides a registry of counters, gauges, and histograms, which may be exported in the Prometheus text format.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Jupiter_Bot.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Registry of named metrics.
+* Updating a metric is a relaxed atomic operation on a shard picked by the calling thread, so metrics may be updated from
+* any thread without contention; shards are only summed when the registry is written out (i.e: when it is scraped).
+* Metrics are owned by the registry and are reference counted: each call which fetches or registers a metric adds a reference,
+* and the metric lives until each reference is released, so pointers to them may be kept for fast access.
+*/
+class JUPITER_BOT_API MetricsRegistry
+{
+public:
+	static constexpr size_t shard_count = 8;
+	static constexpr size_t cache_line_size = 64;
+
+	/**
+	* @brief Fetches the shard which the calling thread updates.
+	*
+	* @return Shard index, less than shard_count
+	*/
+	static size_t shard();
+
+	/** Base of all metric types */
+	class JUPITER_BOT_API Metric
+	{
+	public:
+		virtual ~Metric() = default;
+
+		/**
+		* @brief Appends this metric's samples in the Prometheus text format.
+		*
+		* @param out_text String to append to
+		* @param in_name Name of the metric's family
+		* @param in_labels Formatted labels of this metric (see label())
+		*/
+		virtual void write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const = 0;
+	};
+
+	/** Monotonically increasing integer */
+	class JUPITER_BOT_API Counter : public Metric
+	{
+	public:
+		void add(uint64_t in_value = 1) { m_shards[shard()].value.fetch_add(in_value, std::memory_order_relaxed); }
+		uint64_t value() const;
+		void write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const override;
+
+	private:
+		struct alignas(cache_line_size) Shard
+		{
+			std::atomic<uint64_t> value{ 0 };
+		};
+
+		std::array<Shard, shard_count> m_shards;
+	};
+
+	/** Value which may go up and down */
+	class JUPITER_BOT_API Gauge : public Metric
+	{
+	public:
+		void set(double in_value) { m_value.store(in_value, std::memory_order_relaxed); }
+		void add(double in_value) { m_value.fetch_add(in_value, std::memory_order_relaxed); }
+		double value() const { return m_value.load(std::memory_order_relaxed); }
+		void write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const override;
+
+	private:
+		std::atomic<double> m_value{ 0.0 };
+	};
+
+	/** Gauge whose value is computed by a function when written out; the function is called on the thread writing the registry */
+	class JUPITER_BOT_API CallbackGauge : public Metric
+	{
+	public:
+		CallbackGauge(std::function<double()> in_function) : m_function{ std::move(in_function) } {}
+		void write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const override;
+
+	private:
+		std::function<double()> m_function;
+	};
+
+	/** Distribution of observed values across a fixed set of buckets */
+	class JUPITER_BOT_API Histogram : public Metric
+	{
+	public:
+		/**
+		* @brief Records an observation.
+		*
+		* @param in_value Value to record
+		*/
+		void observe(double in_value);
+
+		/**
+		* @brief Records a duration, in seconds.
+		*
+		* @param in_duration Duration to record
+		*/
+		void observe(std::chrono::steady_clock::duration in_duration) {
+			observe(std::chrono::duration<double>(in_duration).count());
+		}
+
+		Histogram(std::vector<double> in_bounds);
+		void write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const override;
+
+	private:
+		struct alignas(cache_line_size) Shard
+		{
+			std::atomic<uint64_t> count{ 0 };
+			std::atomic<double> sum{ 0.0 };
+		};
+
+		std::vector<double> m_bounds; /** Sorted upper bounds of each bucket, excluding +Inf */
+		size_t m_stride; /** Distance between each shard's bucket counts */
+		std::unique_ptr<std::atomic<uint64_t>[]> m_buckets; /** Non-cumulative bucket counts, by shard */
+		std::array<Shard, shard_count> m_shards;
+	};
+
+	/**
+	* @brief Fetches or registers a counter. Note: a name may only be used by one type of metric.
+	*
+	* @param in_name Name of the metric (i.e: "renx_rcon_lines_total")
+	* @param in_help Description of the metric
+	* @param in_labels Formatted labels which distinguish this metric within its family (see label())
+	* @return Counter with the specified name and labels
+	*/
+	Counter& counter(std::string_view in_name, std::string_view in_help, std::string_view in_labels = {});
+
+	/**
+	* @brief Fetches or registers a gauge.
+	*
+	* @param in_name Name of the metric
+	* @param in_help Description of the metric
+	* @param in_labels Formatted labels which distinguish this metric within its family (see label())
+	* @return Gauge with the specified name and labels
+	*/
+	Gauge& gauge(std::string_view in_name, std::string_view in_help, std::string_view in_labels = {});
+
+	/** Identifies the registration of a callback gauge; 0 is never a valid ID */
+	using CallbackGaugeId = uint64_t;
+
+	/**
+	* @brief Registers a gauge whose value is computed when written out; if it exists, its function is replaced.
+	* Callback gauges are not reference counted: each registration has its own ID, and replacing a gauge invalidates the
+	* previous registration's ID, so that releasing it afterwards has no effect on the replacement.
+	* Note: The gauge must be released before the module which the function lives in is unloaded.
+	*
+	* @param in_name Name of the metric
+	* @param in_help Description of the metric
+	* @param in_labels Formatted labels which distinguish this metric within its family (see label())
+	* @param in_function Function which computes the gauge's value
+	* @return ID of the registration, or 0 if the name is already used by another type of metric.
+	*/
+	CallbackGaugeId gauge(std::string_view in_name, std::string_view in_help, std::string_view in_labels, std::function<double()> in_function);
+
+	/**
+	* @brief Fetches or registers a histogram.
+	*
+	* @param in_name Name of the metric
+	* @param in_help Description of the metric
+	* @param in_bounds Upper bounds of each bucket; ignored if the histogram already exists
+	* @param in_labels Formatted labels which distinguish this metric within its family (see label())
+	* @return Histogram with the specified name and labels
+	*/
+	Histogram& histogram(std::string_view in_name, std::string_view in_help, std::vector<double> in_bounds, std::string_view in_labels = {});
+
+	/**
+	* @brief Releases a reference to a metric, removing it from the registry and destroying it once no references remain.
+	*
+	* @param in_metric Metric to release
+	* @return True if the metric was destroyed, false otherwise.
+	*/
+	bool release(const Metric& in_metric);
+
+	/**
+	* @brief Removes a callback gauge and destroys its function, unless it has since been replaced.
+	*
+	* @param in_gauge ID returned when the gauge was registered
+	* @return True if the gauge was removed, false if the ID is no longer valid.
+	*/
+	bool release(CallbackGaugeId in_gauge);
+
+	/**
+	* @brief Appends every metric in the Prometheus text exposition format.
+	*
+	* @param out_text String to append to
+	*/
+	void write(std::string& out_text) const;
+
+	/**
+	* @brief Formats a label, escaping its value.
+	*
+	* @param in_name Name of the label
+	* @param in_value Value of the label
+	* @return Label formatted as name="value"
+	*/
+	static std::string label(std::string_view in_name, std::string_view in_value);
+
+	/** Default histogram bounds for durations, in seconds (10us to 10s) */
+	static std::vector<double> durationBounds();
+
+private:
+	enum class Type
+	{
+		Counter,
+		Gauge,
+		Histogram
+	};
+
+	struct Series
+	{
+		std::string labels;
+		std::unique_ptr<Metric> metric;
+		size_t references = 1;
+		CallbackGaugeId callback_id = 0; /** ID of the current registration, for callback gauges */
+	};
+
+	struct Family
+	{
+		std::string name;
+		std::string help;
+		Type type;
+		std::vector<Series> series;
+	};
+
+	Series* find(std::string_view in_name, std::string_view in_labels);
+	bool erase(const Series& in_series); /** Requires m_mutex */
+	Metric& add(std::string_view in_name, std::string_view in_help, Type in_type, std::string_view in_labels, std::unique_ptr<Metric> in_metric);
+
+	mutable std::mutex m_mutex;
+	std::vector<Family> m_families;
+	std::vector<std::unique_ptr<Metric>> m_conflicts; /** Metrics requested with a name already used by another type; never written out */
+	CallbackGaugeId m_next_callback_id = 1;
+};
+
+/** Application-wide metrics. Note: DO NOT DELETE OR FREE THIS POINTER. */
+JUPITER_BOT_API extern MetricsRegistry *metricsRegistry;
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _METRICS_H_HEADER
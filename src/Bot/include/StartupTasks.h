@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _STARTUPTASKS_H_HEADER
+#define _STARTUPTASKS_H_HEADER
+
+/**
+ * @file StartupTasks.h
+ * @brief Provides a parallel phase for plugins' I/O-bound loading work during startup.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Jupiter_Bot.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Runs plugins' independent loading work (i.e: reading databases) on a pool of threads while plugins initialize.
+* Each task has a load function, which runs on a worker thread once the tasks it depends on have loaded, and an optional
+* commit function, which runs on the main thread after every task has loaded, and before any plugin's OnPostInitialize().
+* Load functions must only touch state owned by the task until it is committed.
+* If a load function throws, the task fails: its commit function is never called, tasks which depend on it fail without
+* loading, and the failures are reported by finish().
+* Outside of the startup phase (i.e: when a plugin is loaded at runtime), tasks are loaded and committed immediately.
+*/
+class JUPITER_BOT_API StartupTasks
+{
+public:
+	using clock = std::chrono::steady_clock;
+	using Function = std::function<void()>;
+
+	/** Identifies a task; 0 is never a valid ID */
+	using TaskId = size_t;
+
+	/**
+	* @brief Adds a task. Note: only add tasks once initialize() is certain to succeed, since the plugin must not be
+	* unloaded while its load function is running.
+	*
+	* @param in_name Name of the task, for reporting
+	* @param in_load Function to call on a worker thread
+	* @param in_commit Function to call on the main thread once all tasks have loaded (optional)
+	* @param in_dependencies Tasks which must finish loading before this task starts loading
+	* @return ID of the added task, or 0 if the task was run immediately.
+	*/
+	TaskId add(std::string_view in_name, Function in_load, Function in_commit = {}, std::initializer_list<TaskId> in_dependencies = {});
+
+	/**
+	* @brief Checks if the startup phase is in progress.
+	*
+	* @return True if added tasks are deferred, false if they are run immediately.
+	*/
+	bool isActive() const { return m_active; }
+
+	/**
+	* @brief Starts the startup phase.
+	*
+	* @param in_thread_limit Maximum number of worker threads; 0 to use the number of hardware threads
+	*/
+	void begin(size_t in_thread_limit = 0);
+
+	/**
+	* @brief Sets the name of the plugin which subsequently added tasks belong to, for reporting.
+	*
+	* @param in_owner Name of the plugin being initialized
+	*/
+	void setOwner(std::string_view in_owner);
+
+	/**
+	* @brief Waits for all tasks to load, commits them in the order they were added, reports their timings, and ends the startup phase.
+	*/
+	void finish();
+
+	StartupTasks() = default;
+	~StartupTasks();
+	StartupTasks(const StartupTasks&) = delete;
+	StartupTasks& operator=(const StartupTasks&) = delete;
+
+private:
+	struct Task
+	{
+		std::string name;
+		std::string owner;
+		Function load;
+		Function commit;
+		std::vector<TaskId> dependents;
+		size_t pending_dependencies = 0;
+		bool loaded = false;
+		bool failed = false;
+		std::string error; /** Why the task failed */
+		clock::duration load_time{};
+		clock::time_point loaded_at{};
+	};
+
+	void work();
+	void fail(Task& in_task, std::string in_error); /** Requires m_mutex */
+
+	bool m_active = false;
+	bool m_stopping = false;
+	size_t m_thread_limit = 0;
+	size_t m_remaining = 0; /** Tasks which have not finished loading */
+	clock::time_point m_begin_time{};
+	std::string m_owner;
+	std::deque<Task> m_tasks; /** Indexed by ID - 1; deque so that tasks never move */
+	std::deque<TaskId> m_ready; /** Tasks whose dependencies have loaded */
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_ready_condition;
+	std::condition_variable m_loaded_condition;
+};
+
+/** Startup phase driven by initialize_plugins(). Note: DO NOT DELETE OR FREE THIS POINTER. */
+JUPITER_BOT_API extern StartupTasks *startupTasks;
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _STARTUPTASKS_H_HEADER
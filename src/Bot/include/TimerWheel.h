@@ -0,0 +1,232 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _TIMERWHEEL_H_HEADER
+#define _TIMERWHEEL_H_HEADER
+
+/**
+ * @file TimerWheel.h
+ * @brief Provides a hierarchical timing wheel for scheduling delayed and repeating work on the main thread.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Jupiter_Bot.h"
+#include "Metrics.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief Hierarchical timing wheel with millisecond resolution.
+* Timers are stored in intrusive lists in one of several levels of slots; scheduling and cancelling are O(1),
+* and timers are moved to lower levels as their deadline approaches. Timer nodes are pooled, so scheduling
+* does not allocate once the pool has grown to the peak number of pending timers.
+*/
+class JUPITER_BOT_API TimerWheel
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	/** Identifies a scheduled timer; 0 is never a valid ID */
+	using TimerId = uint64_t;
+
+	/**
+	* @brief Type-erased callback stored inline in each timer, without allocating.
+	* Plain function pointers are called directly by the wheel; other callables (i.e: lambdas) must fit
+	* within the inline buffer, and their call code lives in the module which scheduled them.
+	*/
+	class JUPITER_BOT_API Callback
+	{
+	public:
+		static constexpr size_t capacity = 48;
+
+		Callback() = default;
+		Callback(void (*in_function)()) : m_function{ in_function } {}
+
+		template<typename CallableT,
+			std::enable_if_t<!std::is_same_v<std::decay_t<CallableT>, Callback>
+				&& !std::is_convertible_v<CallableT, void(*)()>, int> = 0>
+		Callback(CallableT&& in_callable) {
+			using stored_type = std::decay_t<CallableT>;
+			static_assert(sizeof(stored_type) <= capacity, "Callable is too large to store inline in a timer");
+			static_assert(alignof(stored_type) <= alignof(std::max_align_t), "Callable is over-aligned");
+			static_assert(std::is_nothrow_move_constructible_v<stored_type>, "Callable must be nothrow move constructible");
+
+			new (m_storage) stored_type(std::forward<CallableT>(in_callable));
+			m_invoke = [](void* in_storage) { (*static_cast<stored_type*>(in_storage))(); };
+			m_relocate = [](void* in_destination, void* in_source) noexcept {
+				if (in_destination != nullptr) {
+					new (in_destination) stored_type(std::move(*static_cast<stored_type*>(in_source)));
+				}
+				static_cast<stored_type*>(in_source)->~stored_type();
+			};
+		}
+
+		Callback(Callback&& in_callback) noexcept { *this = std::move(in_callback); }
+		Callback& operator=(Callback&& in_callback) noexcept;
+		Callback(const Callback&) = delete;
+		Callback& operator=(const Callback&) = delete;
+		~Callback() { reset(); }
+
+		void operator()();
+		void reset();
+		explicit operator bool() const { return m_function != nullptr || m_invoke != nullptr; }
+
+	private:
+		alignas(std::max_align_t) unsigned char m_storage[capacity];
+		void (*m_function)() = nullptr;
+		void (*m_invoke)(void*) = nullptr;
+		void (*m_relocate)(void*, void*) noexcept = nullptr; /** Move-constructs into the destination (if not null), then destroys the source */
+	};
+
+	/**
+	* @brief Schedules a callback to be called once, after a delay.
+	*
+	* @param in_delay Time to wait before calling the callback; rounded up to the next millisecond
+	* @param in_callback Callback to call
+	* @return ID of the scheduled timer
+	*/
+	TimerId schedule(clock::duration in_delay, Callback in_callback);
+
+	/**
+	* @brief Schedules a callback to be called repeatedly, at an interval, until cancelled.
+	*
+	* @param in_interval Time between calls; rounded up to the next millisecond, and at least 1 millisecond
+	* @param in_callback Callback to call
+	* @return ID of the scheduled timer
+	*/
+	TimerId scheduleRepeating(clock::duration in_interval, Callback in_callback);
+
+	/**
+	* @brief Cancels a timer. A timer may cancel itself (or any other timer) from within its callback.
+	*
+	* @param in_id ID of the timer to cancel
+	* @return True if the timer was pending and is now cancelled, false otherwise.
+	*/
+	bool cancel(TimerId in_id);
+
+	/**
+	* @brief Checks if a timer has yet to be called (or, for a repeating timer, has not been cancelled).
+	*
+	* @param in_id ID of the timer to check
+	* @return True if the timer is pending, false otherwise.
+	*/
+	bool isPending(TimerId in_id) const;
+
+	/**
+	* @brief Calls the callbacks of all timers which are due.
+	*
+	* @param in_now Current time
+	* @return Number of callbacks called.
+	*/
+	size_t advance(clock::time_point in_now = clock::now());
+
+	/**
+	* @brief Fetches a time no later than when the next timer is due.
+	* This is exact when the next timer is due within 256 milliseconds, and a lower bound otherwise.
+	*
+	* @return Time to wake up at, or clock::time_point::max() if no timers are pending.
+	*/
+	clock::time_point nextDeadline() const;
+
+	/**
+	* @brief Fetches the number of pending timers.
+	*
+	* @return Number of pending timers.
+	*/
+	size_t size() const { return m_size; }
+
+	TimerWheel();
+	~TimerWheel();
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+private:
+	static constexpr size_t slot_bits = 8;
+	static constexpr size_t slot_count = size_t{ 1 } << slot_bits;
+	static constexpr size_t slot_mask = slot_count - 1;
+	static constexpr size_t level_count = 4;
+
+	enum class NodeState : uint8_t
+	{
+		Free,
+		Scheduled,
+		Firing
+	};
+
+	/** Intrusive circular list link; a link which points to itself is unlinked (or an empty list) */
+	struct Link
+	{
+		Link* prev = this;
+		Link* next = this;
+	};
+
+	struct Node : Link
+	{
+		uint64_t expiry = 0; /** Tick which this timer is due on */
+		uint64_t interval = 0; /** Ticks between calls; 0 if this timer does not repeat */
+		uint32_t index = 0;
+		uint32_t generation = 0;
+		uint8_t level = 0;
+		uint8_t slot = 0;
+		NodeState state = NodeState::Free;
+		Callback callback;
+	};
+
+	struct Level
+	{
+		std::array<Link, slot_count> slots; /** Sentinels of each slot's list */
+		std::array<uint64_t, slot_count / 64> occupied{}; /** Bitmap of non-empty slots */
+	};
+
+	TimerId add(uint64_t in_delay_ticks, uint64_t in_interval_ticks, Callback&& in_callback);
+	void insert(Node& in_node);
+	void unlink(Node& in_node);
+	void release(Node& in_node);
+	void cascade(size_t in_level);
+	uint64_t toTick(clock::time_point in_time) const;
+
+	clock::time_point m_origin = clock::now();
+	uint64_t m_now = 0; /** Last tick processed */
+	size_t m_size = 0;
+	std::array<Level, level_count> m_levels;
+	std::deque<Node> m_nodes; /** Pool of timer nodes; deque so that nodes never move */
+	std::vector<uint32_t> m_free_nodes;
+	MetricsRegistry::Histogram* m_lagMetric = nullptr; /** Time between when timers were due and when they were called */
+};
+
+/** Scheduler driven by the main loop. Note: DO NOT DELETE OR FREE THIS POINTER. */
+JUPITER_BOT_API extern TimerWheel *timerWheel;
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _TIMERWHEEL_H_HEADER
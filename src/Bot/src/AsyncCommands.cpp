@@ -0,0 +1,282 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include "AsyncCommands.h"
+
+AsyncCommands g_asyncCommands;
+AsyncCommands *asyncCommands = &g_asyncCommands;
+
+AsyncCommands::JobId AsyncCommands::submit(std::string_view in_user, const void* in_origin, Work in_work, Delivery in_delivery, const void* in_owner) {
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	std::string user{ in_user };
+	size_t& user_count = m_user_counts[user];
+	if (m_user_limit != 0 && user_count >= m_user_limit) {
+		return 0;
+	}
+	++user_count;
+
+	JobPtr job = std::make_shared<Job>();
+	job->id = m_next_id++;
+	job->user = std::move(user);
+	job->origin = in_origin;
+	job->owner = in_owner;
+	job->work = std::move(in_work);
+	job->delivery = std::move(in_delivery);
+	m_jobs.emplace(job->id, job);
+	m_queued.push_back(job);
+
+	JobId result = job->id;
+	bool spawn_worker = m_idle_workers == 0 && m_workers.size() < m_thread_limit;
+	guard.unlock();
+
+	m_queued_condition.notify_one();
+	if (spawn_worker) {
+		m_workers.emplace_back(&AsyncCommands::work, this);
+	}
+
+	return result;
+}
+
+bool AsyncCommands::cancel(JobId in_job) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	auto itr = m_jobs.find(in_job);
+	if (itr == m_jobs.end()) {
+		return false;
+	}
+
+	JobPtr job = itr->second;
+	cancelJob(job);
+	return true;
+}
+
+size_t AsyncCommands::cancelUser(std::string_view in_user) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	std::vector<JobPtr> jobs;
+	for (auto& pair : m_jobs) {
+		if (pair.second->user == in_user) {
+			jobs.push_back(pair.second);
+		}
+	}
+
+	for (auto& job : jobs) {
+		cancelJob(job);
+	}
+
+	return jobs.size();
+}
+
+size_t AsyncCommands::cancelOrigin(const void* in_origin) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	std::vector<JobPtr> jobs;
+	for (auto& pair : m_jobs) {
+		if (pair.second->origin == in_origin) {
+			jobs.push_back(pair.second);
+		}
+	}
+
+	for (auto& job : jobs) {
+		cancelJob(job);
+	}
+
+	return jobs.size();
+}
+
+size_t AsyncCommands::cancelAll(const void* in_owner) {
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	std::vector<JobPtr> jobs;
+	for (auto& pair : m_jobs) {
+		if (pair.second->owner == in_owner) {
+			jobs.push_back(pair.second);
+		}
+	}
+
+	size_t result = jobs.size();
+	for (auto& job : jobs) {
+		cancelJob(job);
+	}
+
+	// Jobs which were already cancelled may still be running or awaiting delivery, with their closures intact
+	auto add_owned = [in_owner, &jobs](const JobPtr& in_job) {
+		if (in_job->owner == in_owner && std::find(jobs.begin(), jobs.end(), in_job) == jobs.end()) {
+			jobs.push_back(in_job);
+		}
+	};
+	std::for_each(m_running.begin(), m_running.end(), add_owned);
+	std::for_each(m_finished.begin(), m_finished.end(), add_owned);
+
+	// Running work can't be interrupted; wait for it to observe its cancellation flag
+	m_finished_condition.wait(guard, [&jobs] {
+		return std::none_of(jobs.begin(), jobs.end(), [](const JobPtr& in_job) { return in_job->running; });
+	});
+	std::erase_if(m_finished, [in_owner](const JobPtr& in_job) { return in_job->owner == in_owner; });
+	guard.unlock();
+
+	// Destroy the closures and results here, while the owner's module is still loaded
+	for (auto& job : jobs) {
+		job->work = nullptr;
+		job->delivery = nullptr;
+		freeResponse(job->result);
+		job->result = nullptr;
+	}
+
+	return result;
+}
+
+size_t AsyncCommands::getPendingCount(std::string_view in_user) const {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	auto itr = m_user_counts.find(std::string{ in_user });
+	if (itr == m_user_counts.end()) {
+		return 0;
+	}
+
+	return itr->second;
+}
+
+void AsyncCommands::deliver() {
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	if (m_finished.empty()) {
+		return;
+	}
+
+	std::vector<JobPtr> finished;
+	finished.swap(m_finished);
+
+	// Deliveries may submit or cancel other jobs, so the lock is released while each is called
+	for (auto& job : finished) {
+		if (job->cancelled) {
+			freeResponse(job->result);
+			continue;
+		}
+
+		release(*job);
+		guard.unlock();
+		job->delivery(job->result);
+		guard.lock();
+	}
+}
+
+void AsyncCommands::setLimits(size_t in_thread_limit, size_t in_user_limit) {
+	if (in_thread_limit == 0) {
+		in_thread_limit = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	m_thread_limit = in_thread_limit;
+	m_user_limit = in_user_limit;
+}
+
+void AsyncCommands::shutdown() {
+	{
+		std::lock_guard<std::mutex> guard{ m_mutex };
+		m_stopping = true;
+		for (auto& pair : m_jobs) {
+			pair.second->cancelled = true;
+		}
+		m_jobs.clear();
+		m_user_counts.clear();
+		m_queued.clear();
+	}
+
+	m_queued_condition.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+
+	for (auto& job : m_finished) {
+		freeResponse(job->result);
+	}
+	m_finished.clear();
+	m_stopping = false;
+}
+
+void AsyncCommands::freeResponse(ResponseLine* in_response) {
+	while (in_response != nullptr) {
+		ResponseLine* next = in_response->next;
+		delete in_response;
+		in_response = next;
+	}
+}
+
+AsyncCommands::~AsyncCommands() {
+	shutdown();
+}
+
+void AsyncCommands::work() {
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	while (true) {
+		++m_idle_workers;
+		m_queued_condition.wait(guard, [this] { return m_stopping || !m_queued.empty(); });
+		--m_idle_workers;
+		if (m_stopping) {
+			return;
+		}
+
+		JobPtr job = std::move(m_queued.front());
+		m_queued.pop_front();
+		job->running = true;
+		m_running.push_back(job);
+		guard.unlock();
+
+		ResponseLine* result = job->work(job->cancelled);
+		job->work = nullptr; // Free the job's snapshot here, rather than on the main thread
+
+		guard.lock();
+		job->running = false;
+		job->result = result;
+		std::erase(m_running, job);
+		m_finished.push_back(std::move(job));
+		m_finished_condition.notify_all();
+	}
+}
+
+void AsyncCommands::release(const Job& in_job) {
+	m_jobs.erase(in_job.id);
+	auto itr = m_user_counts.find(in_job.user);
+	if (itr != m_user_counts.end() && --itr->second == 0) {
+		m_user_counts.erase(itr);
+	}
+}
+
+void AsyncCommands::cancelJob(const JobPtr& in_job) {
+	in_job->cancelled = true;
+	auto itr = std::find(m_queued.begin(), m_queued.end(), in_job);
+	if (itr != m_queued.end()) {
+		m_queued.erase(itr);
+	}
+
+	// Running and finished jobs are discarded once they reach deliver()
+	release(*in_job);
+}
+
+// AsyncGenericCommand
+
+Jupiter::GenericCommand::ResponseLine* AsyncGenericCommand::trigger(std::string_view in_parameters) {
+	AsyncCommands::Work work = prepare(in_parameters);
+	if (!work) {
+		return nullptr;
+	}
+
+	std::atomic<bool> cancelled{ false };
+	return work(cancelled);
+}
+
+AsyncGenericCommand::~AsyncGenericCommand() {
+	asyncCommands->cancelAll(this);
+}
@@ -0,0 +1,509 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "jessilib/word_split.hpp"
+#include "Jupiter/Functions.h"
+#include "Console_Command.h"
+#include "ConsoleInput.h"
+
+#if !defined _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // _WIN32
+
+ConsoleInput g_consoleInput;
+ConsoleInput *consoleInput = &g_consoleInput;
+
+static_assert((ConsoleInput::capacity & (ConsoleInput::capacity - 1)) == 0, "ConsoleInput::capacity must be a power of two");
+
+ConsoleInput::ConsoleInput()
+	: m_slots{ std::make_unique<Slot[]>(capacity) } {
+	for (size_t index = 0; index != capacity; ++index) {
+		m_slots[index].sequence.store(index, std::memory_order_relaxed);
+	}
+}
+
+ConsoleInput::~ConsoleInput() {
+	stopAdminSocket();
+}
+
+bool ConsoleInput::push(std::string in_line, Reply in_reply) {
+	return tryPush(in_line, in_reply);
+}
+
+void ConsoleInput::pushWait(std::string in_line, Reply in_reply) {
+	if (tryPush(in_line, in_reply)) {
+		return;
+	}
+
+	// Queue is full; wait for process() to free a slot. The waiter count is raised before trying again, so that
+	// process() either sees it or frees the slot before that attempt
+	++m_room_waiters;
+	{
+		std::unique_lock<std::mutex> lock(m_room_mutex);
+		m_room.wait(lock, [&]() { return tryPush(in_line, in_reply); });
+	}
+	--m_room_waiters;
+}
+
+bool ConsoleInput::tryPush(std::string& in_line, Reply& in_reply) {
+	size_t position = m_push_position.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+		slot = &m_slots[position & (capacity - 1)];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+		if (difference == 0) {
+			// Slot is free; claim it
+			if (m_push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			// Slot hasn't been consumed since the last lap; queue is full
+			return false;
+		}
+		else {
+			// Another producer claimed the slot first
+			position = m_push_position.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->line = std::move(in_line);
+	slot->reply = std::move(in_reply);
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool ConsoleInput::pop(std::string& out_line, Reply& out_reply) {
+	Slot& slot = m_slots[m_pop_position & (capacity - 1)];
+	if (slot.sequence.load(std::memory_order_acquire) != m_pop_position + 1) {
+		// Empty, or the producer hasn't finished filling the slot yet
+		return false;
+	}
+
+	out_line = std::move(slot.line);
+	out_reply = std::move(slot.reply);
+	slot.reply = nullptr;
+	slot.sequence.store(m_pop_position + capacity, std::memory_order_release);
+	++m_pop_position;
+	return true;
+}
+
+void ConsoleInput::run(std::string_view in_line) {
+	auto input_split = jessilib::word_split_once_view(in_line, WHITESPACE_SV);
+	std::string_view command_name = input_split.first;
+
+	ConsoleCommand* command = getConsoleCommand(command_name);
+	if (command != nullptr) {
+		command->trigger(input_split.second);
+	}
+	else {
+		std::cout << "Error: Command \"" << command_name << "\" not found." << std::endl;
+	}
+}
+
+/** Redirects std::cout, std::cerr, and std::clog into a buffer, restoring them on destruction */
+class OutputCapture
+{
+public:
+	OutputCapture(std::streambuf* in_buffer)
+		: m_cout{ std::cout.rdbuf(in_buffer) },
+		m_cerr{ std::cerr.rdbuf(in_buffer) },
+		m_clog{ std::clog.rdbuf(in_buffer) } {
+	}
+
+	~OutputCapture() {
+		std::cout.rdbuf(m_cout);
+		std::cerr.rdbuf(m_cerr);
+		std::clog.rdbuf(m_clog);
+	}
+
+	OutputCapture(const OutputCapture&) = delete;
+	OutputCapture& operator=(const OutputCapture&) = delete;
+
+private:
+	std::streambuf* m_cout;
+	std::streambuf* m_cerr;
+	std::streambuf* m_clog;
+};
+
+/** Reply taken over by a command through deferReply(); sent once the command has returned and the reply is called or dropped */
+struct ConsoleInput::DeferredReply
+{
+	Reply reply;
+	std::string output;
+	bool captured = false; /** The command has returned, and its captured output is at the front of output */
+	bool finished = false; /** The deferred function was called */
+
+	void send() {
+		if (reply) {
+			reply(output);
+			reply = nullptr;
+		}
+	}
+
+	~DeferredReply() {
+		if (!finished) {
+			send();
+		}
+	}
+};
+
+ConsoleInput::Reply ConsoleInput::deferReply() {
+	if (m_running_reply == nullptr || !*m_running_reply || m_deferred_reply != nullptr) {
+		return nullptr;
+	}
+
+	m_deferred_reply = std::make_shared<DeferredReply>();
+	m_deferred_reply->reply = *m_running_reply;
+	return [deferred = m_deferred_reply](std::string_view in_output) {
+		if (deferred->finished) {
+			return;
+		}
+
+		deferred->output += in_output;
+		deferred->finished = true;
+		if (deferred->captured) {
+			deferred->send();
+		}
+	};
+}
+
+size_t ConsoleInput::process() {
+	std::string line;
+	Reply reply;
+	size_t result = 0;
+	while (result != capacity && pop(line, reply)) {
+		++result;
+		if (!reply) {
+			run(line);
+			continue;
+		}
+
+		// Capture the command's output for the reply, including errors
+		std::ostringstream output;
+		m_running_reply = &reply;
+		{
+			OutputCapture capture{ output.rdbuf() };
+			run(line);
+		}
+		m_running_reply = nullptr;
+
+		if (m_deferred_reply == nullptr) {
+			reply(output.view());
+			continue;
+		}
+
+		// The command replies later; put what it wrote so far in front of the rest of its output
+		auto deferred = std::move(m_deferred_reply);
+		deferred->output.insert(0, output.view());
+		deferred->captured = true;
+		if (deferred->finished) {
+			deferred->send();
+		}
+	}
+
+	if (result != 0) {
+		// Wake producers waiting for room; pairs with the waiters' registration before their last attempt to push
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_room_waiters != 0) {
+			{
+				std::lock_guard<std::mutex> guard(m_room_mutex);
+			}
+			m_room.notify_all();
+		}
+
+#if !defined _WIN32
+		if (m_admin_backlogged.exchange(false)) {
+			char wake = 0;
+			write(m_admin_wake[1], &wake, sizeof(wake));
+		}
+#endif // _WIN32
+	}
+
+	return result;
+}
+
+#if !defined _WIN32
+
+static constexpr size_t admin_max_inbound = 64 * 1024; /** Longest line a client may send */
+static constexpr size_t admin_max_outbound = 16 * 1024 * 1024; /** Most output which may be waiting for a client to read */
+
+struct AdminClient
+{
+	int socket;
+	std::string inbound;
+	bool read_closed = false;
+	bool failed = false;
+	std::atomic<size_t> pending{ 0 }; /** Queued commands which haven't replied yet */
+	std::mutex outbound_mutex;
+	std::string outbound;
+
+	~AdminClient() {
+		close(socket);
+	}
+};
+
+static bool set_nonblocking(int in_fd) {
+	int flags = fcntl(in_fd, F_GETFL, 0);
+	return flags != -1 && fcntl(in_fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+/** Removes a socket file; anything else at the path is left alone */
+static void unlink_socket(const std::string& in_path) {
+	struct stat info;
+	if (lstat(in_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+		unlink(in_path.c_str());
+	}
+}
+
+bool ConsoleInput::startAdminSocket(std::string_view in_path) {
+	stopAdminSocket();
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (in_path.empty() || in_path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "ERROR: Admin socket path \"" << in_path << "\" is too long." << std::endl;
+		return false;
+	}
+	in_path.copy(address.sun_path, in_path.size());
+	m_admin_path = in_path;
+
+	m_admin_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_admin_socket == -1) {
+		return false;
+	}
+
+	// Replace any socket left behind by a previous run; only the owner may connect
+	unlink_socket(m_admin_path);
+	if (bind(m_admin_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+		|| chmod(m_admin_path.c_str(), S_IRUSR | S_IWUSR) != 0
+		|| listen(m_admin_socket, SOMAXCONN) != 0
+		|| !set_nonblocking(m_admin_socket)
+		|| pipe(m_admin_wake) != 0) {
+		std::cerr << "ERROR: Unable to listen on admin socket \"" << m_admin_path << "\": " << strerror(errno) << std::endl;
+		stopAdminSocket();
+		return false;
+	}
+
+	set_nonblocking(m_admin_wake[0]);
+	set_nonblocking(m_admin_wake[1]);
+
+	m_admin_stopping = false;
+	m_admin_thread = std::thread(&ConsoleInput::adminLoop, this);
+	return true;
+}
+
+void ConsoleInput::stopAdminSocket() {
+	if (m_admin_thread.joinable()) {
+		m_admin_stopping = true;
+		char wake = 0;
+		write(m_admin_wake[1], &wake, sizeof(wake));
+		m_admin_thread.join();
+	}
+	m_admin_backlogged = false;
+
+	for (int& fd : m_admin_wake) {
+		if (fd != -1) {
+			close(fd);
+			fd = -1;
+		}
+	}
+
+	if (m_admin_socket != -1) {
+		close(m_admin_socket);
+		m_admin_socket = -1;
+		unlink_socket(m_admin_path);
+	}
+}
+
+void ConsoleInput::adminLoop() {
+	std::vector<std::shared_ptr<AdminClient>> clients;
+	std::vector<pollfd> poll_fds;
+	char buffer[4096];
+
+	while (!m_admin_stopping) {
+		// Queue each client's complete lines, until the queue fills up
+		bool backlogged = false;
+		for (auto& client : clients) {
+			size_t offset = 0;
+			size_t newline;
+			while (!backlogged && (newline = client->inbound.find('\n', offset)) != std::string::npos) {
+				std::string_view line{ client->inbound.data() + offset, newline - offset };
+				if (!line.empty() && line.back() == '\r') {
+					line.remove_suffix(1);
+				}
+
+				if (!line.empty()) {
+					++client->pending;
+					std::weak_ptr<AdminClient> weak_client = client;
+					int wake = m_admin_wake[1];
+					std::string command{ line };
+					Reply reply = [weak_client, wake](std::string_view in_output) {
+						auto client = weak_client.lock();
+						if (client == nullptr) {
+							return;
+						}
+
+						{
+							std::lock_guard<std::mutex> guard(client->outbound_mutex);
+							client->outbound += in_output;
+							client->outbound += '\0';
+						}
+						--client->pending;
+
+						char wake_byte = 0;
+						write(wake, &wake_byte, sizeof(wake_byte));
+					};
+
+					if (!tryPush(command, reply)) {
+						// Ask process() to wake this thread once it frees room; retry in case it already did
+						m_admin_backlogged = true;
+						std::atomic_thread_fence(std::memory_order_seq_cst);
+						if (!tryPush(command, reply)) {
+							--client->pending;
+							backlogged = true;
+							break;
+						}
+					}
+				}
+
+				offset = newline + 1;
+			}
+			client->inbound.erase(0, offset);
+		}
+
+		poll_fds.clear();
+		poll_fds.push_back({ m_admin_socket, POLLIN, 0 });
+		poll_fds.push_back({ m_admin_wake[0], POLLIN, 0 });
+		for (auto& client : clients) {
+			short events = 0;
+			// Stop reading from clients with lines waiting for room in the queue
+			if (!client->read_closed && client->inbound.find('\n') == std::string::npos) {
+				events |= POLLIN;
+			}
+
+			std::lock_guard<std::mutex> guard(client->outbound_mutex);
+			if (!client->outbound.empty()) {
+				events |= POLLOUT;
+			}
+
+			// Negative descriptors are skipped, so that hung up clients awaiting replies don't wake poll() repeatedly
+			poll_fds.push_back({ events != 0 ? client->socket : -1, events, 0 });
+		}
+
+		// Backlogged lines are retried once process() frees room in the queue and writes to the wake pipe
+		if (poll(poll_fds.data(), poll_fds.size(), 1000) < 0 && errno != EINTR) {
+			break;
+		}
+
+		if ((poll_fds[1].revents & POLLIN) != 0) {
+			while (read(m_admin_wake[0], buffer, sizeof(buffer)) > 0);
+		}
+
+		for (size_t index = 0; index != clients.size(); ++index) {
+			AdminClient& client = *clients[index];
+			short revents = poll_fds[index + 2].revents;
+
+			if ((revents & (POLLIN | POLLHUP | POLLERR)) != 0 && !client.read_closed) {
+				ssize_t length = recv(client.socket, buffer, sizeof(buffer), 0);
+				if (length > 0) {
+					client.inbound.append(buffer, static_cast<size_t>(length));
+					if (client.inbound.size() > admin_max_inbound && client.inbound.find('\n') == std::string::npos) {
+						client.failed = true;
+					}
+				}
+				else if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+					// Client is done sending; treat any unterminated command as a complete line
+					client.read_closed = true;
+					if (!client.inbound.empty() && client.inbound.back() != '\n') {
+						client.inbound += '\n';
+					}
+				}
+			}
+
+			std::lock_guard<std::mutex> guard(client.outbound_mutex);
+			if (!client.outbound.empty()) {
+				ssize_t sent = send(client.socket, client.outbound.data(), client.outbound.size(), 0);
+				if (sent > 0) {
+					client.outbound.erase(0, static_cast<size_t>(sent));
+				}
+				else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+					client.failed = true;
+				}
+				else if (client.outbound.size() > admin_max_outbound) {
+					// Client isn't reading its output
+					client.failed = true;
+				}
+			}
+		}
+
+		// Disconnect clients which failed, or which are done and have received all of their output
+		std::erase_if(clients, [](const std::shared_ptr<AdminClient>& in_client) {
+			if (in_client->failed) {
+				return true;
+			}
+
+			std::lock_guard<std::mutex> guard(in_client->outbound_mutex);
+			return in_client->read_closed
+				&& in_client->inbound.empty()
+				&& in_client->pending == 0
+				&& in_client->outbound.empty();
+		});
+
+		if ((poll_fds[0].revents & POLLIN) != 0) {
+			int fd;
+			while ((fd = accept(m_admin_socket, nullptr, nullptr)) != -1) {
+				if (!set_nonblocking(fd)) {
+					close(fd);
+					continue;
+				}
+
+				auto client = std::make_shared<AdminClient>();
+				client->socket = fd;
+				clients.push_back(std::move(client));
+			}
+		}
+	}
+}
+
+#else // _WIN32
+
+bool ConsoleInput::startAdminSocket(std::string_view) {
+	std::cerr << "ERROR: The admin socket is not supported on this platform." << std::endl;
+	return false;
+}
+
+void ConsoleInput::stopAdminSocket() {
+}
+
+void ConsoleInput::adminLoop() {
+}
+
+#endif // _WIN32
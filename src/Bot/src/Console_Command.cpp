@@ -16,13 +16,20 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include <unordered_map>
+#include "jessilib/unicode.hpp"
 #include "Console_Command.h"
 
 std::vector<ConsoleCommand*> g_consoleCommands;
 std::vector<ConsoleCommand*>& consoleCommands = g_consoleCommands;
 
+// Triggers are added by derived constructors after registration, so the index is rebuilt lazily on lookup
+std::unordered_map<std::string, ConsoleCommand*, jessilib::text_hashi, jessilib::text_equali> g_consoleCommandIndex;
+bool g_consoleCommandIndexStale = true;
+
 ConsoleCommand::ConsoleCommand() {
 	consoleCommands.push_back(this);
+	g_consoleCommandIndexStale = true;
 }
 
 ConsoleCommand::~ConsoleCommand() {
@@ -32,13 +39,25 @@ ConsoleCommand::~ConsoleCommand() {
 			break;
 		}
 	}
+
+	g_consoleCommandIndexStale = true;
 }
 
 ConsoleCommand* getConsoleCommand(std::string_view trigger) {
-	for (const auto& command : consoleCommands) {
-		if (command->matches(trigger)) {
-			return command;
+	if (g_consoleCommandIndexStale) {
+		g_consoleCommandIndex.clear();
+		for (const auto& command : consoleCommands) {
+			for (size_t index = 0; index != command->getTriggerCount(); ++index) {
+				g_consoleCommandIndex.try_emplace(static_cast<std::string>(command->getTrigger(index)), command);
+			}
 		}
+
+		g_consoleCommandIndexStale = false;
+	}
+
+	auto itr = g_consoleCommandIndex.find(trigger);
+	if (itr != g_consoleCommandIndex.end()) {
+		return itr->second;
 	}
 
 	return nullptr;
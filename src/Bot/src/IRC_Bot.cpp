@@ -27,6 +27,7 @@
 #include "Jupiter/Readable_String.h"
 #include "IRC_Bot.h"
 #include "IRC_Command.h"
+#include "AsyncCommands.h"
 
 using namespace std::literals;
 
@@ -36,12 +37,19 @@ IRC_Bot::IRC_Bot(Jupiter::Config *in_primary_section, Jupiter::Config *in_second
 	
 	for (const auto& command : IRCMasterCommandList) {
 		m_commands.emplace_back(command->copy());
+		indexCommand(m_commands.back().get());
 	}
 
 	setCommandAccessLevels();
+
+	m_chatMetric = &metricsRegistry->counter("jupiter_irc_messages_received_total"sv, "IRC channel messages received"sv,
+		MetricsRegistry::label("server"sv, getConfigSection()));
 }
 
 IRC_Bot::~IRC_Bot() {
+	metricsRegistry->release(*m_chatMetric);
+	asyncCommands->cancelOrigin(this);
+
 	if (IRCCommand::selected_server == this) {
 		IRCCommand::selected_server = nullptr;
 	}
@@ -53,30 +61,47 @@ IRC_Bot::~IRC_Bot() {
 
 void IRC_Bot::addCommand(IRCCommand *in_command) {
 	m_commands.emplace_back(in_command);
+	indexCommand(in_command);
 	setCommandAccessLevels(in_command);
 }
 
 bool IRC_Bot::freeCommand(std::string_view trigger) {
+	IRCCommand *command = getCommand(trigger);
+	if (command == nullptr) {
+		return false;
+	}
+
 	for (auto itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
-		if ((*itr)->matches(trigger)) {
+		if (itr->get() == command) {
 			m_commands.erase(itr);
-			return true;
+			break;
 		}
 	}
 
-	return false;
+	// Rebuild, so that any command shadowed by the removed one becomes reachable again
+	m_commandIndex.clear();
+	for (const auto& remaining_command : m_commands) {
+		indexCommand(remaining_command.get());
+	}
+
+	return true;
 }
 
 IRCCommand* IRC_Bot::getCommand(std::string_view trigger) const {
-	for (const auto& command : m_commands) {
-		if (command->matches(trigger)) {
-			return command.get();
-		}
+	auto itr = m_commandIndex.find(trigger);
+	if (itr != m_commandIndex.end()) {
+		return itr->second;
 	}
 
 	return nullptr;
 }
 
+void IRC_Bot::indexCommand(IRCCommand *in_command) {
+	for (size_t index = 0; index != in_command->getTriggerCount(); ++index) {
+		m_commandIndex.try_emplace(static_cast<std::string>(in_command->getTrigger(index)), in_command);
+	}
+}
+
 std::vector<IRCCommand*> IRC_Bot::getAccessCommands(Jupiter::IRC::Client::Channel *chan, int access) {
 	std::vector<IRCCommand*> result;
 	for (const auto& command : m_commands) {
@@ -155,6 +180,7 @@ void IRC_Bot::setCommandAccessLevels(IRCCommand *in_command) {
 }
 
 void IRC_Bot::OnChat(std::string_view in_channel, std::string_view nick, std::string_view message) {
+	m_chatMetric->add();
 	Channel *channel = this->getChannel(in_channel);
 	if (channel != nullptr && channel->getType() >= 0) {
 		std::string_view msg = message;
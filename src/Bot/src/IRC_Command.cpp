@@ -18,6 +18,9 @@
 
 #include "jessilib/unicode.hpp"
 #include "IRC_Command.h"
+#include "AsyncCommands.h"
+
+using namespace std::literals;
 
 std::vector<IRCCommand*> g_IRCMasterCommandList;
 std::vector<IRCCommand*>& IRCMasterCommandList = g_IRCMasterCommandList;
@@ -140,10 +143,8 @@ GenericCommandWrapperIRCCommand::GenericCommandWrapperIRCCommand(Jupiter::Generi
 
 // GenericCommandWrapperIRCCommand functions
 
-void GenericCommandWrapperIRCCommand::trigger(IRC_Bot *source, std::string_view in_channel, std::string_view in_nick, std::string_view in_parameters) {
+void send_generic_response(IRC_Bot *source, std::string_view in_channel, std::string_view in_nick, Jupiter::GenericCommand::ResponseLine *result) {
 	Jupiter::GenericCommand::ResponseLine *del;
-	Jupiter::GenericCommand::ResponseLine *result = m_command->trigger(in_parameters);
-
 	while (result != nullptr)
 	{
 		switch (result->type)
@@ -167,6 +168,35 @@ void GenericCommandWrapperIRCCommand::trigger(IRC_Bot *source, std::string_view
 	}
 }
 
+void GenericCommandWrapperIRCCommand::trigger(IRC_Bot *source, std::string_view in_channel, std::string_view in_nick, std::string_view in_parameters) {
+	AsyncGenericCommand *async_command = dynamic_cast<AsyncGenericCommand *>(m_command);
+	if (async_command == nullptr) {
+		send_generic_response(source, in_channel, in_nick, m_command->trigger(in_parameters));
+		return;
+	}
+
+	AsyncCommands::Work work = async_command->prepare(in_parameters);
+	if (!work) {
+		return;
+	}
+
+	AsyncCommands::JobId job = asyncCommands->submit(getAsyncUser(source, in_nick), source, std::move(work),
+		[source, channel = std::string{ in_channel }, nick = std::string{ in_nick }](Jupiter::GenericCommand::ResponseLine *result) {
+			send_generic_response(source, channel, nick, result);
+		}, async_command);
+
+	if (job == 0) {
+		source->sendNotice(in_nick, "Error: Too many commands in progress. Use \"cancel\" to cancel them."sv);
+	}
+}
+
+std::string GenericCommandWrapperIRCCommand::getAsyncUser(IRC_Bot *in_server, std::string_view in_nick) {
+	std::string result{ in_server->getConfigSection() };
+	result += '/';
+	result += in_nick;
+	return result;
+}
+
 std::string_view GenericCommandWrapperIRCCommand::getHelp(std::string_view parameters) {
 	return GenericCommandWrapperIRCCommand::m_command->getHelp(parameters);
 }
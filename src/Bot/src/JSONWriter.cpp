@@ -0,0 +1,208 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <bit>
+#include <cmath>
+#include "JSONWriter.h"
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSONWRITER_SSE2
+#endif
+
+using namespace std::literals;
+
+/** Escaping */
+
+constexpr bool json_needs_escape(unsigned char in_chr) {
+	return in_chr < 0x20 || in_chr == '\"' || in_chr == '\\';
+}
+
+void append_json_escape(std::string& out_buffer, unsigned char in_chr) {
+	switch (in_chr) {
+	case '\"':
+		out_buffer += "\\\""sv;
+		break;
+	case '\\':
+		out_buffer += "\\\\"sv;
+		break;
+	case '\b':
+		out_buffer += "\\b"sv;
+		break;
+	case '\f':
+		out_buffer += "\\f"sv;
+		break;
+	case '\n':
+		out_buffer += "\\n"sv;
+		break;
+	case '\r':
+		out_buffer += "\\r"sv;
+		break;
+	case '\t':
+		out_buffer += "\\t"sv;
+		break;
+	default: {
+		static constexpr std::string_view hex_digits = "0123456789abcdef"sv;
+		char escape[]{ '\\', 'u', '0', '0', hex_digits[in_chr >> 4], hex_digits[in_chr & 0xF] };
+		out_buffer.append(escape, sizeof(escape));
+		break;
+	}
+	}
+}
+
+void JSONWriter::escape(std::string& out_buffer, std::string_view in_string) {
+	const char* itr = in_string.data();
+	const char* end = itr + in_string.size();
+	const char* run = itr; // Start of the pending bytes which need no escaping
+
+#if defined JSONWRITER_SSE2
+	const __m128i quote = _mm_set1_epi8('\"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control_max = _mm_set1_epi8(0x1F);
+	while (end - itr >= 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(itr));
+
+		// Unsigned chunk <= 0x1F is the same as min(chunk, 0x1F) == chunk
+		__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+			_mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk));
+		unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(special));
+		if (mask == 0) {
+			itr += 16;
+			continue;
+		}
+
+		itr += std::countr_zero(mask);
+		out_buffer.append(run, itr);
+		append_json_escape(out_buffer, static_cast<unsigned char>(*itr));
+		run = ++itr;
+	}
+#endif // JSONWRITER_SSE2
+
+	while (itr != end) {
+		if (json_needs_escape(static_cast<unsigned char>(*itr))) {
+			out_buffer.append(run, itr);
+			append_json_escape(out_buffer, static_cast<unsigned char>(*itr));
+			run = itr + 1;
+		}
+		++itr;
+	}
+
+	out_buffer.append(run, end);
+}
+
+/** JSONWriter */
+
+void JSONWriter::separate() {
+	if (m_after_key) {
+		m_after_key = false;
+		return;
+	}
+
+	if (m_depth != 0) {
+		if (!m_first) {
+			m_buffer += ',';
+		}
+
+		if (m_pretty) {
+			m_buffer += '\n';
+			m_buffer.append(m_depth, '\t');
+		}
+	}
+
+	m_first = false;
+}
+
+void JSONWriter::end(char in_token) {
+	--m_depth;
+
+	// Empty containers are kept on one line
+	if (m_pretty && !m_first) {
+		m_buffer += '\n';
+		m_buffer.append(m_depth, '\t');
+	}
+
+	m_buffer += in_token;
+	m_first = false;
+}
+
+JSONWriter& JSONWriter::beginObject() {
+	separate();
+	m_buffer += '{';
+	++m_depth;
+	m_first = true;
+	return *this;
+}
+
+JSONWriter& JSONWriter::beginArray() {
+	separate();
+	m_buffer += '[';
+	++m_depth;
+	m_first = true;
+	return *this;
+}
+
+JSONWriter& JSONWriter::endObject() {
+	end('}');
+	return *this;
+}
+
+JSONWriter& JSONWriter::endArray() {
+	end(']');
+	return *this;
+}
+
+JSONWriter& JSONWriter::key(std::string_view in_key) {
+	separate();
+	m_buffer += '\"';
+	escape(m_buffer, in_key);
+	m_buffer += m_pretty ? "\": "sv : "\":"sv;
+	m_after_key = true;
+	return *this;
+}
+
+JSONWriter& JSONWriter::value(std::string_view in_value) {
+	separate();
+	m_buffer += '\"';
+	escape(m_buffer, in_value);
+	m_buffer += '\"';
+	return *this;
+}
+
+JSONWriter& JSONWriter::value(bool in_value) {
+	return raw(in_value ? "true"sv : "false"sv);
+}
+
+JSONWriter& JSONWriter::value(double in_value) {
+	if (!std::isfinite(in_value)) {
+		return null();
+	}
+
+	char buffer[32];
+	auto result = std::to_chars(buffer, buffer + sizeof(buffer), in_value);
+	return raw(std::string_view{ buffer, static_cast<size_t>(result.ptr - buffer) });
+}
+
+JSONWriter& JSONWriter::null() {
+	return raw("null"sv);
+}
+
+JSONWriter& JSONWriter::raw(std::string_view in_json) {
+	separate();
+	m_buffer += in_json;
+	return *this;
+}
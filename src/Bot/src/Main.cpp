@@ -22,7 +22,6 @@
 #include <csignal>
 #include <exception>
 #include <thread>
-#include <mutex>
 #include "jessilib/unicode.hpp"
 #include "jessilib/app_parameters.hpp"
 #include "Jupiter/Functions.h"
@@ -34,6 +33,10 @@
 #include "jessilib/serialize.hpp"
 #include "IRC_Bot.h"
 #include "Console_Command.h"
+#include "StartupTasks.h"
+#include "AsyncCommands.h"
+#include "ConsoleInput.h"
+#include "TimerWheel.h"
 #include "IRC_Command.h"
 
 #if defined _WIN32
@@ -46,18 +49,6 @@ Jupiter::INIConfig o_config;
 Jupiter::Config *Jupiter::g_config = &o_config;
 std::chrono::steady_clock::time_point Jupiter::g_start_time = std::chrono::steady_clock::now();
 
-constexpr size_t INPUT_BUFFER_SIZE = 2048;
-
-struct ConsoleInput {
-	std::string input;
-	std::mutex input_mutex;
-	bool awaiting_processing = false;
-
-	ConsoleInput() {
-		input.reserve(INPUT_BUFFER_SIZE);
-	}
-} console_input;
-
 void onTerminate() {
 	std::cout << "Terminate signal received..." << std::endl;
 }
@@ -71,25 +62,18 @@ void onExit() {
 void inputLoop() {
 	std::string input;
 	while (ftell(stdin) != -1 || errno != EBADF) {
-		std::getline(std::cin, input);
-
-	check_input_processing:
-
-		std::lock_guard<std::mutex> guard(console_input.input_mutex);
-		if (console_input.awaiting_processing == false)
-		{
-			console_input.input = input;
-			console_input.awaiting_processing = true;
-		}
-		else // User input received before previous input was processed.
-		{
-			std::this_thread::sleep_for((std::chrono::seconds(1)));
-			goto check_input_processing;
+		if (!std::getline(std::cin, input)) {
+			break;
 		}
+
+		// Blocks while the queue is full, until the main loop drains it
+		consoleInput->pushWait(std::move(input));
 	}
 }
 
 void initialize_plugins() {
+	asyncCommands->setLimits(Jupiter::g_config->get<size_t>("CommandThreads"sv, 2), Jupiter::g_config->get<size_t>("CommandUserLimit"sv, 2));
+
 	std::cout << "Loading plugins..." << std::endl;
 	std::string_view plugin_list_str = Jupiter::g_config->get("Plugins"sv);
 	if (plugin_list_str.empty()) {
@@ -100,7 +84,10 @@ void initialize_plugins() {
 		auto plugin_names = jessilib::word_split_view(plugin_list_str, WHITESPACE_SV);
 		std::cout << "Attempting to load " << plugin_names.size() << " plugins..." << std::endl;
 
+		// Plugins may defer loading work to the startup phase, which runs while the remaining plugins initialize
+		startupTasks->begin(Jupiter::g_config->get<size_t>("StartupThreads"sv, 0));
 		for (const auto& plugin_name : plugin_names) {
+			startupTasks->setOwner(plugin_name);
 			std::chrono::steady_clock::time_point load_start = std::chrono::steady_clock::now();
 			bool load_success = Jupiter::Plugin::load(plugin_name) != nullptr;
 			double time_taken = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - load_start).count()) / 1000.0;
@@ -113,6 +100,9 @@ void initialize_plugins() {
 			}
 		}
 
+		// Commit deferred loading work before any plugin may depend on it
+		startupTasks->finish();
+
 		// OnPostInitialize
 		for (const auto& plugin : Jupiter::plugins) {
 			plugin->OnPostInitialize();
@@ -122,6 +112,9 @@ void initialize_plugins() {
 
 namespace Jupiter {
 void reinitialize_plugins() {
+	// Asynchronous commands may be running plugin code
+	asyncCommands->shutdown();
+
 	// Uninitialize back -> front
 	while (!Jupiter::plugins.empty()) {
 		Jupiter::Plugin::free(Jupiter::plugins.size() - 1);
@@ -144,23 +137,9 @@ void reinitialize_plugins() {
 			}
 		}
 		Jupiter::Timer::check();
-
-		if (console_input.input_mutex.try_lock()) {
-			if (console_input.awaiting_processing) {
-				console_input.awaiting_processing = false;
-				auto input_split = jessilib::word_split_once_view(console_input.input, WHITESPACE_SV);
-				std::string_view command_name = input_split.first;
-
-				ConsoleCommand* command = getConsoleCommand(command_name);
-				if (command != nullptr) {
-					command->trigger(input_split.second);
-				}
-				else {
-					std::cout << "Error: Command \"" << command_name << "\" not found." << std::endl;
-				}
-			}
-			console_input.input_mutex.unlock();
-		}
+		timerWheel->advance();
+		asyncCommands->deliver();
+		consoleInput->process();
 		std::this_thread::sleep_for((std::chrono::milliseconds(1)));
 	}
 }
@@ -244,6 +223,11 @@ int main(int argc, char* argv[]) {
 		std::cout << IRCMasterCommandList.size() << " IRC Commands have been loaded into the master list." << std::endl;
 	}
 
+	std::string_view admin_socket = o_config.get("AdminSocket"sv);
+	if (!admin_socket.empty() && consoleInput->startAdminSocket(admin_socket)) {
+		std::cout << "Accepting console commands on admin socket \"" << admin_socket << "\"." << std::endl;
+	}
+
 	if (parameters.has_switch(u8"exit")) {
 		std::cout << "exit switch specified; closing down post-initialization before entering main_loop" << std::endl;
 		return 0;
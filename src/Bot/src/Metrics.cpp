@@ -0,0 +1,386 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include "Metrics.h"
+
+using namespace std::literals;
+
+// Intentionally never destroyed, since metrics are released by the destructors of other globals during exit
+MetricsRegistry *metricsRegistry = new MetricsRegistry();
+
+static std::atomic<size_t> g_next_metrics_shard{ 0 };
+
+size_t MetricsRegistry::shard() {
+	static thread_local size_t s_shard = g_next_metrics_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+	return s_shard;
+}
+
+static void append_number(std::string& out_text, uint64_t in_value) {
+	char buffer[24];
+	auto result = std::to_chars(buffer, buffer + sizeof(buffer), in_value);
+	out_text.append(buffer, result.ptr);
+}
+
+static void append_number(std::string& out_text, double in_value) {
+	if (std::isinf(in_value)) {
+		out_text += in_value > 0 ? "+Inf"sv : "-Inf"sv;
+		return;
+	}
+
+	if (std::isnan(in_value)) {
+		out_text += "NaN"sv;
+		return;
+	}
+
+	char buffer[32];
+	auto result = std::to_chars(buffer, buffer + sizeof(buffer), in_value);
+	out_text.append(buffer, result.ptr);
+}
+
+/** Appends: name{labels,extra_label} */
+static void append_sample_name(std::string& out_text, std::string_view in_name, std::string_view in_suffix, std::string_view in_labels, std::string_view in_extra_label = {}) {
+	out_text += in_name;
+	out_text += in_suffix;
+	if (!in_labels.empty() || !in_extra_label.empty()) {
+		out_text += '{';
+		out_text += in_labels;
+		if (!in_labels.empty() && !in_extra_label.empty()) {
+			out_text += ',';
+		}
+		out_text += in_extra_label;
+		out_text += '}';
+	}
+	out_text += ' ';
+}
+
+/** Counter */
+
+uint64_t MetricsRegistry::Counter::value() const {
+	uint64_t result = 0;
+	for (const auto& shard : m_shards) {
+		result += shard.value.load(std::memory_order_relaxed);
+	}
+
+	return result;
+}
+
+void MetricsRegistry::Counter::write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const {
+	append_sample_name(out_text, in_name, {}, in_labels);
+	append_number(out_text, value());
+	out_text += '\n';
+}
+
+/** Gauge */
+
+void MetricsRegistry::Gauge::write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const {
+	append_sample_name(out_text, in_name, {}, in_labels);
+	append_number(out_text, value());
+	out_text += '\n';
+}
+
+/** CallbackGauge */
+
+void MetricsRegistry::CallbackGauge::write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const {
+	append_sample_name(out_text, in_name, {}, in_labels);
+	append_number(out_text, m_function());
+	out_text += '\n';
+}
+
+/** Histogram */
+
+MetricsRegistry::Histogram::Histogram(std::vector<double> in_bounds)
+	: m_bounds{ std::move(in_bounds) } {
+	std::sort(m_bounds.begin(), m_bounds.end());
+	m_bounds.erase(std::unique(m_bounds.begin(), m_bounds.end()), m_bounds.end());
+
+	// One count per bound, plus +Inf; rounded up so that each shard's counts start on their own cache line
+	constexpr size_t counts_per_line = cache_line_size / sizeof(std::atomic<uint64_t>);
+	m_stride = (m_bounds.size() + 1 + counts_per_line - 1) / counts_per_line * counts_per_line;
+	m_buckets = std::make_unique<std::atomic<uint64_t>[]>(m_stride * shard_count);
+}
+
+void MetricsRegistry::Histogram::observe(double in_value) {
+	size_t bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), in_value) - m_bounds.begin();
+	size_t shard_index = shard();
+	m_buckets[shard_index * m_stride + bucket].fetch_add(1, std::memory_order_relaxed);
+
+	Shard& shard = m_shards[shard_index];
+	shard.count.fetch_add(1, std::memory_order_relaxed);
+	shard.sum.fetch_add(in_value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Histogram::write(std::string& out_text, std::string_view in_name, std::string_view in_labels) const {
+	std::string le_label;
+	uint64_t cumulative = 0;
+	for (size_t bucket = 0; bucket <= m_bounds.size(); ++bucket) {
+		for (size_t shard_index = 0; shard_index != shard_count; ++shard_index) {
+			cumulative += m_buckets[shard_index * m_stride + bucket].load(std::memory_order_relaxed);
+		}
+
+		le_label = "le=\""sv;
+		append_number(le_label, bucket == m_bounds.size() ? std::numeric_limits<double>::infinity() : m_bounds[bucket]);
+		le_label += '\"';
+		append_sample_name(out_text, in_name, "_bucket"sv, in_labels, le_label);
+		append_number(out_text, cumulative);
+		out_text += '\n';
+	}
+
+	// Counts are summed from the shards' totals rather than the buckets; the two may briefly disagree during a write
+	double sum = 0.0;
+	uint64_t count = 0;
+	for (const auto& shard : m_shards) {
+		sum += shard.sum.load(std::memory_order_relaxed);
+		count += shard.count.load(std::memory_order_relaxed);
+	}
+
+	append_sample_name(out_text, in_name, "_sum"sv, in_labels);
+	append_number(out_text, sum);
+	out_text += '\n';
+	append_sample_name(out_text, in_name, "_count"sv, in_labels);
+	append_number(out_text, count);
+	out_text += '\n';
+}
+
+/** MetricsRegistry */
+
+MetricsRegistry::Series* MetricsRegistry::find(std::string_view in_name, std::string_view in_labels) {
+	for (auto& family : m_families) {
+		if (family.name == in_name) {
+			for (auto& series : family.series) {
+				if (series.labels == in_labels) {
+					return &series;
+				}
+			}
+
+			return nullptr;
+		}
+	}
+
+	return nullptr;
+}
+
+MetricsRegistry::Metric& MetricsRegistry::add(std::string_view in_name, std::string_view in_help, Type in_type, std::string_view in_labels, std::unique_ptr<Metric> in_metric) {
+	auto family = std::find_if(m_families.begin(), m_families.end(), [in_name](const Family& in_family) {
+		return in_family.name == in_name;
+	});
+
+	if (family == m_families.end()) {
+		family = m_families.insert(m_families.end(), Family{ std::string{ in_name }, std::string{ in_help }, in_type, {} });
+	}
+	else if (family->type != in_type) {
+		return *m_conflicts.emplace_back(std::move(in_metric));
+	}
+
+	return *family->series.emplace_back(Series{ std::string{ in_labels }, std::move(in_metric) }).metric;
+}
+
+MetricsRegistry::Counter& MetricsRegistry::counter(std::string_view in_name, std::string_view in_help, std::string_view in_labels) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	Series* series = find(in_name, in_labels);
+	if (series != nullptr) {
+		if (auto result = dynamic_cast<Counter*>(series->metric.get())) {
+			++series->references;
+			return *result;
+		}
+
+		return static_cast<Counter&>(*m_conflicts.emplace_back(std::make_unique<Counter>()));
+	}
+
+	return static_cast<Counter&>(add(in_name, in_help, Type::Counter, in_labels, std::make_unique<Counter>()));
+}
+
+MetricsRegistry::Gauge& MetricsRegistry::gauge(std::string_view in_name, std::string_view in_help, std::string_view in_labels) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	Series* series = find(in_name, in_labels);
+	if (series != nullptr) {
+		if (auto result = dynamic_cast<Gauge*>(series->metric.get())) {
+			++series->references;
+			return *result;
+		}
+
+		return static_cast<Gauge&>(*m_conflicts.emplace_back(std::make_unique<Gauge>()));
+	}
+
+	return static_cast<Gauge&>(add(in_name, in_help, Type::Gauge, in_labels, std::make_unique<Gauge>()));
+}
+
+MetricsRegistry::CallbackGaugeId MetricsRegistry::gauge(std::string_view in_name, std::string_view in_help, std::string_view in_labels, std::function<double()> in_function) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	auto gauge = std::make_unique<CallbackGauge>(std::move(in_function));
+
+	Series* series = find(in_name, in_labels);
+	if (series != nullptr) {
+		if (dynamic_cast<CallbackGauge*>(series->metric.get()) == nullptr) {
+			// Never written out, so there's nothing to keep
+			return 0;
+		}
+
+		// Replace the previous callback, which may belong to a module that has since been unloaded; its ID is invalidated
+		series->metric = std::move(gauge);
+		series->callback_id = m_next_callback_id++;
+		return series->callback_id;
+	}
+
+	auto family = std::find_if(m_families.begin(), m_families.end(), [in_name](const Family& in_family) {
+		return in_family.name == in_name;
+	});
+	if (family != m_families.end() && family->type != Type::Gauge) {
+		return 0;
+	}
+
+	add(in_name, in_help, Type::Gauge, in_labels, std::move(gauge));
+	series = find(in_name, in_labels);
+	series->callback_id = m_next_callback_id++;
+	return series->callback_id;
+}
+
+MetricsRegistry::Histogram& MetricsRegistry::histogram(std::string_view in_name, std::string_view in_help, std::vector<double> in_bounds, std::string_view in_labels) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	Series* series = find(in_name, in_labels);
+	if (series != nullptr) {
+		if (auto result = dynamic_cast<Histogram*>(series->metric.get())) {
+			++series->references;
+			return *result;
+		}
+
+		return static_cast<Histogram&>(*m_conflicts.emplace_back(std::make_unique<Histogram>(std::move(in_bounds))));
+	}
+
+	return static_cast<Histogram&>(add(in_name, in_help, Type::Histogram, in_labels, std::make_unique<Histogram>(std::move(in_bounds))));
+}
+
+bool MetricsRegistry::erase(const Series& in_series) {
+	for (auto family = m_families.begin(); family != m_families.end(); ++family) {
+		for (auto series = family->series.begin(); series != family->series.end(); ++series) {
+			if (&*series == &in_series) {
+				family->series.erase(series);
+				if (family->series.empty()) {
+					m_families.erase(family);
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool MetricsRegistry::release(const Metric& in_metric) {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	for (auto& family : m_families) {
+		for (auto& series : family.series) {
+			if (series.metric.get() == &in_metric) {
+				if (--series.references != 0) {
+					return false;
+				}
+
+				return erase(series);
+			}
+		}
+	}
+
+	return std::erase_if(m_conflicts, [&in_metric](const std::unique_ptr<Metric>& in_conflict) {
+		return in_conflict.get() == &in_metric;
+	}) != 0;
+}
+
+bool MetricsRegistry::release(CallbackGaugeId in_gauge) {
+	if (in_gauge == 0) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	for (auto& family : m_families) {
+		for (auto& series : family.series) {
+			if (series.callback_id == in_gauge) {
+				return erase(series);
+			}
+		}
+	}
+
+	return false;
+}
+
+void MetricsRegistry::write(std::string& out_text) const {
+	std::lock_guard<std::mutex> guard{ m_mutex };
+	for (const auto& family : m_families) {
+		out_text += "# HELP "sv;
+		out_text += family.name;
+		out_text += ' ';
+		for (char chr : family.help) {
+			if (chr == '\\') {
+				out_text += "\\\\"sv;
+			}
+			else if (chr == '\n') {
+				out_text += "\\n"sv;
+			}
+			else {
+				out_text += chr;
+			}
+		}
+
+		out_text += "\n# TYPE "sv;
+		out_text += family.name;
+		switch (family.type) {
+		case Type::Counter:
+			out_text += " counter\n"sv;
+			break;
+		case Type::Gauge:
+			out_text += " gauge\n"sv;
+			break;
+		case Type::Histogram:
+			out_text += " histogram\n"sv;
+			break;
+		}
+
+		for (const auto& series : family.series) {
+			series.metric->write(out_text, family.name, series.labels);
+		}
+	}
+}
+
+std::string MetricsRegistry::label(std::string_view in_name, std::string_view in_value) {
+	std::string result;
+	result.reserve(in_name.size() + in_value.size() + 3);
+	result = in_name;
+	result += "=\""sv;
+	for (char chr : in_value) {
+		if (chr == '\\' || chr == '\"') {
+			result += '\\';
+			result += chr;
+		}
+		else if (chr == '\n') {
+			result += "\\n"sv;
+		}
+		else {
+			result += chr;
+		}
+	}
+	result += '\"';
+
+	return result;
+}
+
+std::vector<double> MetricsRegistry::durationBounds() {
+	return { 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0 };
+}
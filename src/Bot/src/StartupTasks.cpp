@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include "StartupTasks.h"
+
+StartupTasks g_startupTasks;
+StartupTasks *startupTasks = &g_startupTasks;
+
+static double to_milliseconds(StartupTasks::clock::duration in_duration) {
+	return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(in_duration).count()) / 1000.0;
+}
+
+StartupTasks::TaskId StartupTasks::add(std::string_view in_name, Function in_load, Function in_commit, std::initializer_list<TaskId> in_dependencies) {
+	if (!m_active) {
+		in_load();
+		if (in_commit) {
+			in_commit();
+		}
+		return 0;
+	}
+
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	TaskId id = m_tasks.size() + 1;
+	Task& task = m_tasks.emplace_back();
+	task.name = in_name;
+	task.owner = m_owner;
+	task.load = std::move(in_load);
+	task.commit = std::move(in_commit);
+
+	for (TaskId dependency : in_dependencies) {
+		if (dependency != 0 && dependency < id) {
+			Task& dependency_task = m_tasks[dependency - 1];
+			if (dependency_task.failed) {
+				task.failed = true;
+				task.error = "Dependency \"" + dependency_task.name + "\" failed";
+			}
+			else if (!dependency_task.loaded) {
+				dependency_task.dependents.push_back(id);
+				++task.pending_dependencies;
+			}
+		}
+	}
+
+	if (task.failed) {
+		return id;
+	}
+
+	++m_remaining;
+	if (task.pending_dependencies == 0) {
+		m_ready.push_back(id);
+	}
+	guard.unlock();
+
+	m_ready_condition.notify_one();
+	if (m_workers.size() < m_thread_limit) {
+		m_workers.emplace_back(&StartupTasks::work, this);
+	}
+
+	return id;
+}
+
+void StartupTasks::begin(size_t in_thread_limit) {
+	if (m_active) {
+		return;
+	}
+
+	if (in_thread_limit == 0) {
+		in_thread_limit = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	m_thread_limit = in_thread_limit;
+	m_stopping = false;
+	m_begin_time = clock::now();
+	m_active = true;
+}
+
+void StartupTasks::setOwner(std::string_view in_owner) {
+	m_owner = in_owner;
+}
+
+void StartupTasks::finish() {
+	if (!m_active) {
+		return;
+	}
+
+	// Wait for loading to finish
+	clock::time_point wait_start = clock::now();
+	{
+		std::unique_lock<std::mutex> guard{ m_mutex };
+		m_loaded_condition.wait(guard, [this] { return m_remaining == 0; });
+		m_stopping = true;
+	}
+	clock::duration wait_time = clock::now() - wait_start;
+
+	m_ready_condition.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+
+	// Tasks added by commit functions are run immediately
+	m_active = false;
+
+	// Commit in the order tasks were added, so that plugins see each other's data as if they had loaded sequentially
+	clock::duration total_load_time{};
+	size_t failures = 0;
+	for (auto& task : m_tasks) {
+		if (task.failed) {
+			++failures;
+			std::cerr << "\"" << task.owner << "\" " << task.name << " failed to load: " << task.error << std::endl;
+			continue;
+		}
+
+		clock::time_point commit_start = clock::now();
+		if (task.commit) {
+			task.commit();
+		}
+		clock::duration commit_time = clock::now() - commit_start;
+		total_load_time += task.load_time;
+
+		std::cout << "\"" << task.owner << "\" " << task.name << " loaded in " << to_milliseconds(task.load_time)
+			<< "ms (finished at +" << to_milliseconds(task.loaded_at - m_begin_time) << "ms; committed in "
+			<< to_milliseconds(commit_time) << "ms)." << std::endl;
+	}
+
+	if (!m_tasks.empty()) {
+		std::cout << "Startup tasks completed in " << to_milliseconds(clock::now() - m_begin_time) << "ms ("
+			<< to_milliseconds(total_load_time) << "ms of loading across " << m_tasks.size() << " tasks; waited "
+			<< to_milliseconds(wait_time) << "ms after plugins initialized)." << std::endl;
+	}
+
+	if (failures != 0) {
+		std::cerr << failures << " startup task(s) failed to load; their data was not committed." << std::endl;
+	}
+
+	m_tasks.clear();
+	m_ready.clear();
+	m_owner.clear();
+}
+
+StartupTasks::~StartupTasks() {
+	{
+		std::lock_guard<std::mutex> guard{ m_mutex };
+		m_stopping = true;
+	}
+
+	m_ready_condition.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+void StartupTasks::work() {
+	std::unique_lock<std::mutex> guard{ m_mutex };
+	while (true) {
+		m_ready_condition.wait(guard, [this] { return m_stopping || !m_ready.empty(); });
+		if (m_ready.empty()) {
+			// Stopping, and nothing left to load
+			return;
+		}
+
+		TaskId id = m_ready.front();
+		m_ready.pop_front();
+		Task& task = m_tasks[id - 1];
+		guard.unlock();
+
+		// An exception escaping a worker would terminate the process, so it fails the task instead
+		bool failed = false;
+		std::string error;
+		clock::time_point load_start = clock::now();
+		try {
+			task.load();
+		}
+		catch (const std::exception& exception) {
+			failed = true;
+			error = exception.what();
+		}
+		catch (...) {
+			failed = true;
+			error = "Unknown exception";
+		}
+		clock::time_point load_end = clock::now();
+
+		guard.lock();
+		task.load_time = load_end - load_start;
+		task.loaded_at = load_end;
+		if (failed) {
+			fail(task, std::move(error));
+		}
+		else {
+			task.loaded = true;
+			for (TaskId dependent : task.dependents) {
+				Task& dependent_task = m_tasks[dependent - 1];
+				if (--dependent_task.pending_dependencies == 0 && !dependent_task.failed) {
+					m_ready.push_back(dependent);
+					m_ready_condition.notify_one();
+				}
+			}
+		}
+
+		if (--m_remaining == 0) {
+			m_loaded_condition.notify_all();
+		}
+	}
+}
+
+void StartupTasks::fail(Task& in_task, std::string in_error) {
+	in_task.failed = true;
+	in_task.error = std::move(in_error);
+
+	// Dependents have not started loading, since this task never finished; they will never load, so they're done
+	for (TaskId dependent : in_task.dependents) {
+		Task& dependent_task = m_tasks[dependent - 1];
+		if (!dependent_task.failed) {
+			fail(dependent_task, "Dependency \"" + in_task.name + "\" failed");
+			--m_remaining;
+		}
+	}
+}
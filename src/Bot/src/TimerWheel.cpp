@@ -0,0 +1,339 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include <bit>
+#include "TimerWheel.h"
+
+using namespace std::literals;
+
+TimerWheel g_timerWheel;
+TimerWheel *timerWheel = &g_timerWheel;
+
+/** Callback */
+
+TimerWheel::Callback& TimerWheel::Callback::operator=(Callback&& in_callback) noexcept {
+	if (this != &in_callback) {
+		reset();
+
+		m_function = in_callback.m_function;
+		m_invoke = in_callback.m_invoke;
+		m_relocate = in_callback.m_relocate;
+		if (m_relocate != nullptr) {
+			m_relocate(m_storage, in_callback.m_storage);
+		}
+
+		in_callback.m_function = nullptr;
+		in_callback.m_invoke = nullptr;
+		in_callback.m_relocate = nullptr;
+	}
+
+	return *this;
+}
+
+void TimerWheel::Callback::operator()() {
+	if (m_function != nullptr) {
+		m_function();
+	}
+	else if (m_invoke != nullptr) {
+		m_invoke(m_storage);
+	}
+}
+
+void TimerWheel::Callback::reset() {
+	if (m_relocate != nullptr) {
+		m_relocate(nullptr, m_storage);
+	}
+
+	m_function = nullptr;
+	m_invoke = nullptr;
+	m_relocate = nullptr;
+}
+
+/** TimerWheel */
+
+TimerWheel::TimerWheel() = default;
+
+TimerWheel::~TimerWheel() = default;
+
+TimerWheel::TimerId TimerWheel::schedule(clock::duration in_delay, Callback in_callback) {
+	auto delay = std::chrono::ceil<std::chrono::milliseconds>(in_delay);
+	return add(static_cast<uint64_t>(std::max<long long>(delay.count(), 0)), 0, std::move(in_callback));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleRepeating(clock::duration in_interval, Callback in_callback) {
+	auto interval = std::chrono::ceil<std::chrono::milliseconds>(in_interval);
+	uint64_t ticks = static_cast<uint64_t>(std::max<long long>(interval.count(), 1));
+	return add(ticks, ticks, std::move(in_callback));
+}
+
+bool TimerWheel::cancel(TimerId in_id) {
+	uint32_t index = static_cast<uint32_t>(in_id);
+	uint32_t generation = static_cast<uint32_t>(in_id >> 32);
+	if (index >= m_nodes.size()) {
+		return false;
+	}
+
+	Node& node = m_nodes[index];
+	if (node.generation != generation) {
+		return false;
+	}
+
+	switch (node.state) {
+	case NodeState::Scheduled:
+		unlink(node);
+		release(node);
+		return true;
+
+	case NodeState::Firing:
+		// Callback is running; advance() releases the node once it returns
+		if (node.interval == 0) {
+			return false;
+		}
+		node.interval = 0;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+bool TimerWheel::isPending(TimerId in_id) const {
+	uint32_t index = static_cast<uint32_t>(in_id);
+	if (index >= m_nodes.size()) {
+		return false;
+	}
+
+	const Node& node = m_nodes[index];
+	return node.generation == static_cast<uint32_t>(in_id >> 32)
+		&& (node.state == NodeState::Scheduled || (node.state == NodeState::Firing && node.interval != 0));
+}
+
+size_t TimerWheel::advance(clock::time_point in_now) {
+	uint64_t target = toTick(in_now);
+	size_t result = 0;
+
+	while (m_now < target) {
+		if (m_size == 0) {
+			// Nothing to fire; skip straight to the target
+			m_now = target;
+			break;
+		}
+
+		++m_now;
+
+		// Move timers down from higher levels as their ranges come due
+		for (size_t level = 1; level != level_count; ++level) {
+			if ((m_now & ((uint64_t{ 1 } << (slot_bits * level)) - 1)) != 0) {
+				break;
+			}
+
+			cascade(level);
+		}
+
+		// Detach this tick's timers, so that callbacks may freely schedule and cancel timers
+		size_t slot = m_now & slot_mask;
+		Link& head = m_levels[0].slots[slot];
+		if (head.next == &head) {
+			continue;
+		}
+
+		Link due;
+		due.next = head.next;
+		due.prev = head.prev;
+		due.next->prev = &due;
+		due.prev->next = &due;
+		head.next = &head;
+		head.prev = &head;
+		m_levels[0].occupied[slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+
+		// Acquired here rather than on construction, since the registry may not be constructed yet
+		if (m_lagMetric == nullptr) {
+			m_lagMetric = &metricsRegistry->histogram("jupiter_timer_lag_seconds"sv, "Time between when a timer was due and when it was called"sv,
+				MetricsRegistry::durationBounds());
+		}
+		clock::duration lag = in_now - (m_origin + std::chrono::milliseconds(m_now));
+
+		while (due.next != &due) {
+			Node& node = static_cast<Node&>(*due.next);
+			unlink(node);
+			node.state = NodeState::Firing;
+			m_lagMetric->observe(lag);
+			node.callback();
+			++result;
+
+			if (node.interval != 0) {
+				node.expiry = m_now + node.interval;
+				node.state = NodeState::Scheduled;
+				insert(node);
+			}
+			else {
+				release(node);
+			}
+		}
+	}
+
+	return result;
+}
+
+TimerWheel::clock::time_point TimerWheel::nextDeadline() const {
+	if (m_size == 0) {
+		return clock::time_point::max();
+	}
+
+	// Timers in higher levels may come due before those in lower levels, so take the earliest across all levels
+	uint64_t result = UINT64_MAX;
+	for (size_t level = 0; level != level_count; ++level) {
+		size_t shift = slot_bits * level;
+		uint64_t current = m_now >> shift;
+		const auto& occupied = m_levels[level].occupied;
+
+		// Find the nearest non-empty slot after the current one, wrapping around to the current slot last
+		for (uint64_t offset = 1; offset <= slot_count; ++offset) {
+			size_t slot = (current + offset) & slot_mask;
+			uint64_t word = occupied[slot / 64] >> (slot % 64);
+			if (word == 0) {
+				// Skip the rest of this word
+				offset += 63 - (slot % 64);
+				continue;
+			}
+
+			offset += std::countr_zero(word);
+			if (offset <= slot_count) {
+				// Exact for level 0; the start of the slot's range otherwise
+				result = std::min(result, (current + offset) << shift);
+			}
+			break;
+		}
+	}
+
+	return m_origin + std::chrono::milliseconds(result);
+}
+
+TimerWheel::TimerId TimerWheel::add(uint64_t in_delay_ticks, uint64_t in_interval_ticks, Callback&& in_callback) {
+	Node* node;
+	if (!m_free_nodes.empty()) {
+		node = &m_nodes[m_free_nodes.back()];
+		m_free_nodes.pop_back();
+	}
+	else {
+		node = &m_nodes.emplace_back();
+		node->index = static_cast<uint32_t>(m_nodes.size() - 1);
+	}
+
+	++node->generation;
+	if (node->generation == 0) { // Keep IDs non-zero
+		node->generation = 1;
+	}
+
+	// Timers are due no sooner than the next tick, since the current tick's slot has already been processed
+	node->expiry = std::max(toTick(clock::now()), m_now) + std::max<uint64_t>(in_delay_ticks, 1);
+	node->interval = in_interval_ticks;
+	node->state = NodeState::Scheduled;
+	node->callback = std::move(in_callback);
+	insert(*node);
+	++m_size;
+
+	return (static_cast<TimerId>(node->generation) << 32) | node->index;
+}
+
+void TimerWheel::insert(Node& in_node) {
+	// Pick the lowest level whose range covers the deadline
+	uint64_t delta = in_node.expiry > m_now ? in_node.expiry - m_now : 0;
+	size_t level = 0;
+	while (level != level_count - 1 && delta >= (uint64_t{ 1 } << (slot_bits * (level + 1)))) {
+		++level;
+	}
+
+	uint64_t position;
+	if (level == level_count - 1 && delta >= (uint64_t{ 1 } << (slot_bits * level_count))) {
+		// Beyond the wheel's range; park it in the furthest slot and let cascading re-place it
+		position = ((m_now >> (slot_bits * level)) + slot_mask) & slot_mask;
+	}
+	else {
+		position = (in_node.expiry >> (slot_bits * level)) & slot_mask;
+	}
+
+	in_node.level = static_cast<uint8_t>(level);
+	in_node.slot = static_cast<uint8_t>(position);
+
+	Link& head = m_levels[level].slots[position];
+	in_node.prev = head.prev;
+	in_node.next = &head;
+	head.prev->next = &in_node;
+	head.prev = &in_node;
+	m_levels[level].occupied[position / 64] |= uint64_t{ 1 } << (position % 64);
+}
+
+void TimerWheel::unlink(Node& in_node) {
+	Link* prev = in_node.prev;
+	Link* next = in_node.next;
+	prev->next = next;
+	next->prev = prev;
+	in_node.prev = &in_node;
+	in_node.next = &in_node;
+
+	// Update the occupancy bitmap if this emptied a wheel slot (nodes being fired are in a detached list instead)
+	if (in_node.state == NodeState::Scheduled) {
+		Link& head = m_levels[in_node.level].slots[in_node.slot];
+		if (head.next == &head) {
+			m_levels[in_node.level].occupied[in_node.slot / 64] &= ~(uint64_t{ 1 } << (in_node.slot % 64));
+		}
+	}
+}
+
+void TimerWheel::release(Node& in_node) {
+	in_node.state = NodeState::Free;
+	in_node.interval = 0;
+	in_node.callback.reset();
+	m_free_nodes.push_back(in_node.index);
+	--m_size;
+}
+
+void TimerWheel::cascade(size_t in_level) {
+	size_t slot = (m_now >> (slot_bits * in_level)) & slot_mask;
+	Link& head = m_levels[in_level].slots[slot];
+	if (head.next == &head) {
+		return;
+	}
+
+	// Detach the slot, then re-insert each timer relative to the current tick
+	Link pending;
+	pending.next = head.next;
+	pending.prev = head.prev;
+	pending.next->prev = &pending;
+	pending.prev->next = &pending;
+	head.next = &head;
+	head.prev = &head;
+	m_levels[in_level].occupied[slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+
+	while (pending.next != &pending) {
+		Node& node = static_cast<Node&>(*pending.next);
+		pending.next = node.next;
+		node.next->prev = &pending;
+		insert(node);
+	}
+}
+
+uint64_t TimerWheel::toTick(clock::time_point in_time) const {
+	if (in_time <= m_origin) {
+		return 0;
+	}
+
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(in_time - m_origin).count());
+}
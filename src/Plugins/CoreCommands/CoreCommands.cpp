@@ -21,6 +21,7 @@
 #include "Jupiter/Functions.h"
 #include "CoreCommands.h"
 #include "IRC_Bot.h"
+#include "AsyncCommands.h"
 
 using namespace std::literals;
 
@@ -156,6 +157,42 @@ std::string_view RehashGenericCommand::getHelp(std::string_view ) {
 GENERIC_COMMAND_INIT(RehashGenericCommand)
 GENERIC_COMMAND_AS_CONSOLE_COMMAND(RehashGenericCommand)
 
+// Cancel Console Command
+
+CancelConsoleCommand::CancelConsoleCommand() {
+	this->addTrigger("cancel"sv);
+}
+
+void CancelConsoleCommand::trigger(std::string_view parameters) {
+	size_t cancelled = asyncCommands->cancelUser(console_async_user);
+	std::cout << "Cancelled " << cancelled << " command(s)." << std::endl;
+}
+
+std::string_view CancelConsoleCommand::getHelp(std::string_view ) {
+	static constexpr std::string_view defaultHelp = "Cancels any commands still in progress. Syntax: cancel"sv;
+	return defaultHelp;
+}
+
+CONSOLE_COMMAND_INIT(CancelConsoleCommand)
+
+// Cancel IRC Command
+
+void CancelIRCCommand::create() {
+	this->addTrigger("cancel"sv);
+}
+
+void CancelIRCCommand::trigger(IRC_Bot *source, std::string_view in_channel, std::string_view nick, std::string_view parameters) {
+	size_t cancelled = asyncCommands->cancelUser(GenericCommandWrapperIRCCommand::getAsyncUser(source, nick));
+	source->sendNotice(nick, string_printf("Cancelled %zu command(s).", cancelled));
+}
+
+std::string_view CancelIRCCommand::getHelp(std::string_view ) {
+	static constexpr std::string_view defaultHelp = "Cancels any of your commands still in progress. Syntax: cancel"sv;
+	return defaultHelp;
+}
+
+IRC_COMMAND_INIT(CancelIRCCommand)
+
 // Plugin instantiation and entry point.
 CoreCommandsPlugin pluginInstance;
 
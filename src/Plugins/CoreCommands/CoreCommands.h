@@ -31,5 +31,7 @@ GENERIC_CONSOLE_COMMAND(HelpConsoleCommand)
 GENERIC_IRC_COMMAND(HelpIRCCommand)
 GENERIC_GENERIC_COMMAND(VersionGenericCommand)
 GENERIC_GENERIC_COMMAND(RehashGenericCommand)
+GENERIC_CONSOLE_COMMAND(CancelConsoleCommand)
+GENERIC_IRC_COMMAND(CancelIRCCommand)
 
 #endif // _CORECOMMANDS_H_HEADER
\ No newline at end of file
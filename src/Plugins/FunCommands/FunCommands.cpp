@@ -160,29 +160,38 @@ ResolveGenericCommand::ResolveGenericCommand()
 	this->addTrigger("resolve"sv);
 }
 
-Jupiter::GenericCommand::ResponseLine *ResolveGenericCommand::trigger(std::string_view parameters) {
+AsyncCommands::Work ResolveGenericCommand::prepare(std::string_view parameters) {
 	auto command_split = jessilib::word_split_once_view(std::string_view{parameters}, WHITESPACE_SV);
 	if (command_split.second.empty()) {
-		return new Jupiter::GenericCommand::ResponseLine("Error: Too few parameters. Syntax: resolve <hostname|ip> <address>"sv, GenericCommand::DisplayType::PrivateError);
+		return [](const std::atomic<bool>&) {
+			return new Jupiter::GenericCommand::ResponseLine("Error: Too few parameters. Syntax: resolve <hostname|ip> <address>"sv, GenericCommand::DisplayType::PrivateError);
+		};
 	}
 
+	// Resolution blocks on DNS, so it's done on a worker thread
 	std::string_view subcommand = command_split.first;
 	if (jessilib::equalsi(subcommand, "hostname"sv)
 		|| jessilib::equalsi(subcommand, "host"sv))
 	{
-		std::string_view resolved = Jupiter::Socket::resolveHostname(static_cast<std::string>(command_split.second).c_str(), 0);
-		if (resolved.empty())
-			return new Jupiter::GenericCommand::ResponseLine("Error: Unable to resolve."sv, GenericCommand::DisplayType::PublicError);
-		return new Jupiter::GenericCommand::ResponseLine(resolved, GenericCommand::DisplayType::PublicSuccess);
+		return [address = static_cast<std::string>(command_split.second)](const std::atomic<bool>&) {
+			std::string_view resolved = Jupiter::Socket::resolveHostname(address.c_str(), 0);
+			if (resolved.empty())
+				return new Jupiter::GenericCommand::ResponseLine("Error: Unable to resolve."sv, GenericCommand::DisplayType::PublicError);
+			return new Jupiter::GenericCommand::ResponseLine(resolved, GenericCommand::DisplayType::PublicSuccess);
+		};
 	}
 	else if (jessilib::equalsi(subcommand, "ip"sv))
 	{
-		std::string_view resolved = Jupiter::Socket::resolveAddress(static_cast<std::string>(command_split.second).c_str(), 0);
-		if (resolved.empty())
-			return new Jupiter::GenericCommand::ResponseLine("Error: Unable to resolve."sv, GenericCommand::DisplayType::PublicError);
-		return new Jupiter::GenericCommand::ResponseLine(resolved, GenericCommand::DisplayType::PublicSuccess);
+		return [address = static_cast<std::string>(command_split.second)](const std::atomic<bool>&) {
+			std::string_view resolved = Jupiter::Socket::resolveAddress(address.c_str(), 0);
+			if (resolved.empty())
+				return new Jupiter::GenericCommand::ResponseLine("Error: Unable to resolve."sv, GenericCommand::DisplayType::PublicError);
+			return new Jupiter::GenericCommand::ResponseLine(resolved, GenericCommand::DisplayType::PublicSuccess);
+		};
 	}
-	return new Jupiter::GenericCommand::ResponseLine("Error: Invalid type. You can only resolve hostnames and IP addresses."sv, GenericCommand::DisplayType::PrivateError);
+	return [](const std::atomic<bool>&) {
+		return new Jupiter::GenericCommand::ResponseLine("Error: Invalid type. You can only resolve hostnames and IP addresses."sv, GenericCommand::DisplayType::PrivateError);
+	};
 }
 
 std::string_view ResolveGenericCommand::getHelp(std::string_view parameters)
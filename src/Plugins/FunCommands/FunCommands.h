@@ -21,12 +21,13 @@
 
 #include "Jupiter/Plugin.h"
 #include "IRC_Command.h"
+#include "AsyncCommands.h"
 
 class ExtraCommandsPlugin : public Jupiter::Plugin
 {
 };
 
 GENERIC_IRC_COMMAND(EightBallIRCCommand)
-GENERIC_GENERIC_COMMAND(ResolveGenericCommand)
+GENERIC_ASYNC_GENERIC_COMMAND(ResolveGenericCommand)
 
 #endif // _FUNCOMMANDS_H_HEADER
\ No newline at end of file
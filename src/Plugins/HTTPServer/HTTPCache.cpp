@@ -0,0 +1,228 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include "HTTPCache.h"
+
+#if defined HTTPSERVER_ZLIB
+#include <zlib.h>
+#endif // HTTPSERVER_ZLIB
+
+using namespace std::literals;
+
+/** Bodies smaller than this aren't worth compressing; the headers alone outweigh the savings */
+static constexpr size_t MIN_COMPRESS_SIZE = 256;
+
+static std::string_view trim(std::string_view in_text) {
+	while (!in_text.empty() && (in_text.front() == ' ' || in_text.front() == '\t')) {
+		in_text.remove_prefix(1);
+	}
+	while (!in_text.empty() && (in_text.back() == ' ' || in_text.back() == '\t')) {
+		in_text.remove_suffix(1);
+	}
+	return in_text;
+}
+
+/** Calls a function with each trimmed, non-empty element of a comma-separated header value; stops early if it returns true */
+template<typename FunctionT>
+static bool for_each_element(std::string_view in_list, FunctionT&& in_function) {
+	while (!in_list.empty()) {
+		size_t comma = in_list.find(',');
+		std::string_view element = trim(in_list.substr(0, comma));
+		if (!element.empty() && in_function(element)) {
+			return true;
+		}
+
+		if (comma == std::string_view::npos) {
+			break;
+		}
+		in_list.remove_prefix(comma + 1);
+	}
+
+	return false;
+}
+
+#if defined HTTPSERVER_ZLIB
+/** Compresses a body; window bits of 15 produce a zlib stream ("deflate"), and 15 + 16 a gzip stream */
+static std::string compress_body(std::string_view in_body, int in_window_bits) {
+	z_stream stream{};
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, in_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return {};
+	}
+
+	std::string result;
+	result.resize(deflateBound(&stream, static_cast<uLong>(in_body.size())));
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in_body.data()));
+	stream.avail_in = static_cast<uInt>(in_body.size());
+	stream.next_out = reinterpret_cast<Bytef*>(result.data());
+	stream.avail_out = static_cast<uInt>(result.size());
+
+	int status = deflate(&stream, Z_FINISH);
+	result.resize(stream.total_out);
+	deflateEnd(&stream);
+	if (status != Z_STREAM_END || result.size() >= in_body.size()) {
+		return {};
+	}
+
+	return result;
+}
+#endif // HTTPSERVER_ZLIB
+
+/** CachedResponse */
+
+CachedResponse::CachedResponse(std::string in_body)
+	: body{ std::move(in_body) } {
+	// FNV-1a; stable across restarts, so clients' cached copies stay valid
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned char chr : body) {
+		hash = (hash ^ chr) * 1099511628211ULL;
+	}
+
+	char buffer[24];
+	int length = std::snprintf(buffer, sizeof(buffer), "\"%016" PRIx64 "\"", hash);
+	etag.assign(buffer, static_cast<size_t>(length));
+
+#if defined HTTPSERVER_ZLIB
+	if (body.size() >= MIN_COMPRESS_SIZE) {
+		gzip = compress_body(body, 15 + 16);
+		deflate = compress_body(body, 15);
+	}
+#endif // HTTPSERVER_ZLIB
+}
+
+const std::string& CachedResponse::select(std::string_view in_accept_encoding, std::string_view& out_content_encoding) const {
+	bool accepts_gzip = false;
+	bool accepts_deflate = false;
+	for_each_element(in_accept_encoding, [&](std::string_view in_element) {
+		size_t semicolon = in_element.find(';');
+		std::string_view coding = trim(in_element.substr(0, semicolon));
+		if (semicolon != std::string_view::npos) {
+			// "q=0" (or "q=0.0", etc) explicitly refuses the coding
+			std::string_view params = trim(in_element.substr(semicolon + 1));
+			if (params.starts_with("q=0"sv) && params.find_first_not_of("0."sv, 2) == std::string_view::npos) {
+				return false;
+			}
+		}
+
+		if (coding == "gzip"sv || coding == "x-gzip"sv || coding == "*"sv) {
+			accepts_gzip = true;
+		}
+		else if (coding == "deflate"sv) {
+			accepts_deflate = true;
+		}
+		return false;
+	});
+
+	if (accepts_gzip && !gzip.empty()) {
+		out_content_encoding = "gzip"sv;
+		return gzip;
+	}
+
+	if (accepts_deflate && !deflate.empty()) {
+		out_content_encoding = "deflate"sv;
+		return deflate;
+	}
+
+	out_content_encoding = {};
+	return body;
+}
+
+bool CachedResponse::matches(std::string_view in_if_none_match) const {
+	// If-None-Match uses weak comparison, so a "W/" prefix is ignored
+	return for_each_element(in_if_none_match, [this](std::string_view in_element) {
+		if (in_element.starts_with("W/"sv)) {
+			in_element.remove_prefix(2);
+		}
+		return in_element == "*"sv || in_element == etag;
+	});
+}
+
+/** CachedContent */
+
+static std::unordered_map<std::string, uint64_t> s_cache_generations; /** Nodes never move, so content may hold pointers to them */
+
+static uint64_t &cache_generation(std::string_view in_tag) {
+	auto itr = s_cache_generations.find(std::string{ in_tag });
+	if (itr == s_cache_generations.end()) {
+		itr = s_cache_generations.emplace(in_tag, 0).first;
+	}
+
+	return itr->second;
+}
+
+CachedContent::CachedContent(std::string in_name, HTTPFunction in_function, std::string_view in_tag, std::chrono::milliseconds in_ttl, size_t in_max_entries)
+	: Jupiter::HTTP::Server::Content{ std::move(in_name), in_function },
+	m_tag_generation{ &cache_generation(in_tag) },
+	m_generation{ *m_tag_generation },
+	m_ttl{ in_ttl },
+	m_max_entries{ in_max_entries } {
+}
+
+std::shared_ptr<const CachedResponse> CachedContent::fetch(std::string_view query_string) {
+	clock::time_point now = clock::now();
+	if (m_generation != *m_tag_generation) {
+		m_entries.clear();
+		m_generation = *m_tag_generation;
+	}
+
+	auto itr = m_entries.find(std::string{ query_string });
+	if (itr != m_entries.end()) {
+		if (itr->second.expires > now) {
+			return itr->second.response;
+		}
+	}
+	else {
+		if (m_entries.size() >= m_max_entries) {
+			// Make room; drop expired responses first, then anything
+			std::erase_if(m_entries, [now](const auto& entry) { return entry.second.expires <= now; });
+			if (m_entries.size() >= m_max_entries) {
+				m_entries.erase(m_entries.begin());
+			}
+		}
+
+		itr = m_entries.emplace(query_string, Entry{}).first;
+	}
+
+	std::unique_ptr<std::string> body{ function(query_string) };
+	if (body == nullptr) {
+		m_entries.erase(itr);
+		return nullptr;
+	}
+
+	itr->second.response = std::make_shared<const CachedResponse>(std::move(*body));
+	itr->second.expires = now + m_ttl;
+	return itr->second.response;
+}
+
+std::string* CachedContent::execute(std::string_view query_string) {
+	std::shared_ptr<const CachedResponse> response = fetch(query_string);
+	if (response == nullptr) {
+		return nullptr;
+	}
+
+	return new std::string(response->body);
+}
+
+void CachedContent::invalidate() {
+	m_entries.clear();
+}
+
+void invalidateHTTPCache(std::string_view in_tag) {
+	++cache_generation(in_tag);
+}
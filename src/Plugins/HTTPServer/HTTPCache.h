@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _HTTPCACHE_H_HEADER
+#define _HTTPCACHE_H_HEADER
+
+/**
+ * @file HTTPCache.h
+ * @brief Provides cached HTTP content, with precompressed variants and entity tags.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Jupiter/HTTP_Server.h"
+#include "Jupiter_Bot.h"
+
+#if defined HTTPSERVER_EXPORTS
+#define HTTPSERVER_API JUPITER_EXPORT
+#else // HTTPSERVER_EXPORTS
+#define HTTPSERVER_API JUPITER_IMPORT
+#endif // HTTPSERVER_EXPORTS
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/**
+* @brief A generated response, along with its precompressed variants and entity tag.
+* Variants are built once, when the response is cached, so that serving them costs no compression.
+*/
+struct HTTPSERVER_API CachedResponse
+{
+	std::string body;
+	std::string gzip; /** gzip-encoded body; empty if zlib is unavailable, or if encoding wouldn't shrink the body */
+	std::string deflate; /** zlib-wrapped ("deflate") body; empty as above */
+	std::string etag; /** Strong entity tag of the body, including its quotation marks */
+
+	/**
+	* @brief Selects the variant to send for a request's Accept-Encoding header.
+	*
+	* @param in_accept_encoding Value of the request's Accept-Encoding header
+	* @param out_content_encoding Set to the Content-Encoding of the selected variant; empty for the identity body
+	* @return Selected variant
+	*/
+	const std::string& select(std::string_view in_accept_encoding, std::string_view& out_content_encoding) const;
+
+	/**
+	* @brief Checks whether a request's If-None-Match header matches this response, in which case 304 may be sent instead.
+	*
+	* @param in_if_none_match Value of the request's If-None-Match header
+	* @return True if the header lists this response's entity tag (or is "*"), false otherwise
+	*/
+	bool matches(std::string_view in_if_none_match) const;
+
+	/**
+	* @brief Builds a response, along with its variants and entity tag.
+	*
+	* @param in_body Body of the response
+	*/
+	explicit CachedResponse(std::string in_body);
+};
+
+/**
+* @brief Content whose generated responses are cached by query string.
+* A cached response is served until it is older than the content's TTL, or until the content's cache tag is
+* invalidated through invalidateHTTPCache(). The wrapped function must return responses allocated with new.
+* Jupiter's Content interface only exposes the query string and the body, so execute() always serves the identity
+* body; fetch() exposes the compressed variants and entity tag for a server which can read and write headers.
+*/
+class HTTPSERVER_API CachedContent : public Jupiter::HTTP::Server::Content
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	/**
+	* @brief Fetches the cached response for a query string, generating it if it's missing or stale.
+	* The response is shared, so it remains valid however the cache changes afterwards.
+	*
+	* @param query_string Query string of the request
+	* @return Cached response; nullptr if the function failed
+	*/
+	std::shared_ptr<const CachedResponse> fetch(std::string_view query_string);
+
+	/**
+	* @brief Fetches a copy of the cached body for a query string; see fetch().
+	*
+	* @param query_string Query string of the request
+	* @return Copy of the cached body, to be freed by the caller; nullptr if the function failed
+	*/
+	std::string* execute(std::string_view query_string) override;
+
+	/**
+	* @brief Discards every cached response of this content.
+	*/
+	void invalidate();
+
+	/**
+	* @brief Constructor for the CachedContent class.
+	*
+	* @param in_name Name of the content
+	* @param in_function Function which generates responses
+	* @param in_tag Tag which invalidates this content's responses when passed to invalidateHTTPCache()
+	* @param in_ttl Maximum age of a cached response
+	* @param in_max_entries Maximum number of distinct query strings to cache
+	*/
+	CachedContent(std::string in_name, HTTPFunction in_function, std::string_view in_tag, std::chrono::milliseconds in_ttl, size_t in_max_entries = 256);
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<const CachedResponse> response;
+		clock::time_point expires;
+	};
+
+	const uint64_t *m_tag_generation; /** Incremented when the tag is invalidated */
+	uint64_t m_generation;
+	std::chrono::milliseconds m_ttl;
+	size_t m_max_entries;
+	std::unordered_map<std::string, Entry> m_entries; /** Keyed by query string */
+};
+
+/**
+* @brief Invalidates the cached responses of all CachedContent with a tag.
+* Called by plugins when the data behind their pages changes.
+*
+* @param in_tag Tag to invalidate
+*/
+HTTPSERVER_API void invalidateHTTPCache(std::string_view in_tag);
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _HTTPCACHE_H_HEADER
@@ -16,12 +16,37 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include "Jupiter/HTTP.h"
+#include "Metrics.h"
 #include "HTTPServer.h"
 
 using namespace std::literals;
 
+static constexpr std::string_view CONTENT_TYPE_TEXT_PLAIN = "text/plain"sv;
+
+std::string* handle_metrics_page(std::string_view) {
+	// Metrics are only gathered from their shards here, so the registry costs nothing beyond its counters until scraped
+	std::string* result = new std::string();
+	metricsRegistry->write(*result);
+	return result;
+}
+
 bool HTTPServerPlugin::initialize() {
-	return HTTPServerPlugin::server.bind(this->config.get("BindAddress"sv, "0.0.0.0"sv), this->config.get<uint16_t>("BindPort"sv, 80));
+	if (!HTTPServerPlugin::server.bind(this->config.get("BindAddress"sv, "0.0.0.0"sv), this->config.get<uint16_t>("BindPort"sv, 80))) {
+		return false;
+	}
+
+	// Metrics page, in the Prometheus text format
+	if (this->config.get<bool>("Metrics"sv, true)) {
+		std::unique_ptr<Jupiter::HTTP::Server::Content> content = std::make_unique<Jupiter::HTTP::Server::Content>(std::string{ this->config.get("MetricsPageName"sv, "metrics"sv) }, handle_metrics_page);
+		content->language = Jupiter::HTTP::Content::Language::ENGLISH;
+		content->type = CONTENT_TYPE_TEXT_PLAIN;
+		content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
+		content->free_result = true;
+		HTTPServerPlugin::server.hook(this->config.get("MetricsHostname"sv, ""sv), this->config.get("MetricsPath"sv, "/"sv), std::move(content));
+	}
+
+	return true;
 }
 
 int HTTPServerPlugin::think() {
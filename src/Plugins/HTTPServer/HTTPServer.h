@@ -26,13 +26,7 @@
 
 #include "Jupiter/Plugin.h"
 #include "Jupiter/HTTP_Server.h"
-#include "Jupiter_Bot.h"
-
-#if defined HTTPSERVER_EXPORTS
-#define HTTPSERVER_API JUPITER_EXPORT
-#else // HTTPSERVER_EXPORTS
-#define HTTPSERVER_API JUPITER_IMPORT
-#endif // HTTPSERVER_EXPORTS
+#include "HTTPCache.h"
 
 /** DLL Linkage Nagging */
 #if defined _MSC_VER
@@ -18,7 +18,7 @@
 
 #include <cstring>
 #include "Jupiter/Functions.h"
-#include "Jupiter/Timer.h" // This timer implementation isn't great, but it'll work for delaying reloads
+#include "TimerWheel.h"
 #include "jessilib/word_split.hpp"
 #include "jessilib/unicode.hpp"
 #include "PluginManager.h"
@@ -82,10 +82,8 @@ Jupiter::GenericCommand::ResponseLine *PluginGenericCommand::trigger(std::string
 	if (jessilib::starts_withi(parameters_view, "reload"sv)) {
 		if (split_params.second.empty()
 			|| split_params.second == "*") {
-			// Reinitialize all plugins on next tick
-			new Jupiter::Timer(1, std::chrono::milliseconds{0}, [](unsigned int, void*) {
-				Jupiter::reinitialize_plugins();
-			}, true);
+			// Reinitialize all plugins on next tick; call into the bot directly, since this plugin is unloaded by the reload
+			timerWheel->schedule(std::chrono::milliseconds{0}, &Jupiter::reinitialize_plugins);
 
 			return result->set("Triggering full plugin reload..."sv, GenericCommand::DisplayType::PublicSuccess);
 		}
@@ -18,6 +18,7 @@
 
 #include "Jupiter/IRC_Client.h"
 #include "RenX_Announcements.h"
+#include "RenX_Broadcast.h"
 #include "RenX_Core.h"
 #include "RenX_Server.h"
 #include "RenX_Tags.h"
@@ -26,12 +27,7 @@ using namespace std::literals;
 
 RenX_AnnouncementsPlugin pluginInstance;
 
-void announce_(unsigned int x, void*)
-{
-	pluginInstance.announce(x, nullptr);
-}
-
-void RenX_AnnouncementsPlugin::announce(unsigned int, void *)
+void RenX_AnnouncementsPlugin::announce()
 {
 	if (RenX_AnnouncementsPlugin::random == false)
 	{
@@ -47,27 +43,17 @@ void RenX_AnnouncementsPlugin::announce(unsigned int, void *)
 	}
 	std::string announcement = RenX_AnnouncementsPlugin::announcementsFile.getLine(RenX_AnnouncementsPlugin::lastLine);
 	RenX::sanitizeTags(announcement);
-	
-	std::string msg;
-	RenX::Core *core = RenX::getCore();
-	RenX::Server *server;
-	for (unsigned int i = 0; i != RenX::getCore()->getServerCount(); i++)
-	{
-		server = core->getServer(i);
-		if (server->players.size() != server->getBotCount())
-		{
-			msg = announcement;
-			RenX::processTags(msg, server);
-			server->sendMessage(msg);
-		}
-	}
+
+	RenX::broadcastTags(announcement, [](const RenX::Server &server) {
+		return server.getHumanCount() != 0;
+	}, RenX_AnnouncementsPlugin::stagger);
 }
 
 int RenX_AnnouncementsPlugin::OnRehash()
 {
 	RenX::Plugin::OnRehash();
 
-	RenX_AnnouncementsPlugin::timer->kill();
+	timerWheel->cancel(RenX_AnnouncementsPlugin::timer);
 	RenX_AnnouncementsPlugin::announcementsFile.unload();
 	return this->initialize() ? 0 : -1;
 }
@@ -75,6 +61,7 @@ int RenX_AnnouncementsPlugin::OnRehash()
 bool RenX_AnnouncementsPlugin::initialize()
 {
 	RenX_AnnouncementsPlugin::random = this->config.get<bool>("Random"sv);
+	RenX_AnnouncementsPlugin::stagger = std::chrono::milliseconds(this->config.get<long long>("Stagger"sv, 0));
 
 	RenX_AnnouncementsPlugin::announcementsFile.load(this->config.get("File"sv, "Announcements.txt"s));
 	if (RenX_AnnouncementsPlugin::announcementsFile.getLineCount() == 0)
@@ -83,7 +70,9 @@ bool RenX_AnnouncementsPlugin::initialize()
 		return false;
 	}
 	std::chrono::milliseconds delay = std::chrono::seconds(this->config.get<long long>("Delay"sv, 60));
-	RenX_AnnouncementsPlugin::timer = new Jupiter::Timer(0, delay, announce_);
+	RenX_AnnouncementsPlugin::timer = timerWheel->scheduleRepeating(delay, [this]() {
+		announce();
+	});
 	if (RenX_AnnouncementsPlugin::random == false)
 		RenX_AnnouncementsPlugin::lastLine = RenX_AnnouncementsPlugin::announcementsFile.getLineCount() - 1;
 	return true;
@@ -91,7 +80,7 @@ bool RenX_AnnouncementsPlugin::initialize()
 
 RenX_AnnouncementsPlugin::~RenX_AnnouncementsPlugin()
 {
-	RenX_AnnouncementsPlugin::timer->kill();
+	timerWheel->cancel(RenX_AnnouncementsPlugin::timer);
 	RenX_AnnouncementsPlugin::announcementsFile.unload();
 }
 
@@ -20,14 +20,14 @@
 #define _RENX_ANNOUNCEMENTS_H_HEADER
 
 #include "Jupiter/Plugin.h"
-#include "Jupiter/Timer.h"
 #include "Jupiter/File.h"
+#include "TimerWheel.h"
 #include "RenX_Plugin.h"
 
 class RenX_AnnouncementsPlugin : public RenX::Plugin
 {
 public:
-	void announce(unsigned int, void *);
+	void announce();
 
 public: // Jupiter::Plugin
 	virtual bool initialize() override;
@@ -37,7 +37,8 @@ public: // Jupiter::Plugin
 private:
 	bool random;
 	size_t lastLine;
-	Jupiter::Timer *timer;
+	std::chrono::milliseconds stagger;
+	TimerWheel::TimerId timer = 0;
 	Jupiter::File announcementsFile;
 };
 
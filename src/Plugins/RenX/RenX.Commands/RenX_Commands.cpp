@@ -16,6 +16,7 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include <algorithm>
 #include <forward_list>
 #include <functional>
 #include <sstream>
@@ -24,36 +25,49 @@
 #include "jessilib/unicode.hpp"
 #include "jessilib/word_split.hpp"
 #include "IRC_Bot.h"
+#include "AsyncCommands.h"
+#include "ConsoleInput.h"
 #include "RenX_Commands.h"
 #include "RenX_Core.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
+#include "RenX_PlayerIndex.h"
 #include "RenX_BuildingInfo.h"
 #include "RenX_Functions.h"
 #include "RenX_BanDatabase.h"
 #include "RenX_ExemptionDatabase.h"
 #include "RenX_Tags.h"
+#include "RenX_Broadcast.h"
 
 using namespace jessilib::literals;
 using namespace std::literals;
 
-constexpr std::string_view RxCommandsSection = "RenX.Commands"sv;
+RenX::ServerSlot<bool> g_phasing_slot{ false };
 
 bool togglePhasing(RenX::Server *server, bool newState) {
-	server->varData[RxCommandsSection].set("phasing"sv, newState ? "true"s : "false"s);
+	g_phasing_slot.set(*server, newState);
 	return newState;
 }
 
 bool togglePhasing(RenX::Server *server) {
-	return togglePhasing(server, !server->varData[RxCommandsSection].get<bool>("phasing"sv, false));
+	return togglePhasing(server, !g_phasing_slot.get(*server));
 }
 
 void onDie(RenX::Server &server, const RenX::PlayerInfo &player) {
-	if (player.isBot && server.varData[RxCommandsSection].get<bool>("phasing"sv, false)) {
+	if (player.isBot && g_phasing_slot.get(server)) {
 		server.kickPlayer(player, ""sv);
 	}
 }
 
+// Thread-safe localtime(), for formatting on worker threads
+tm* localtime_safe(const time_t* in_time, tm* out_time) {
+#if defined _WIN32
+	return localtime_s(out_time, in_time) == 0 ? out_time : nullptr;
+#else // _WIN32
+	return localtime_r(in_time, out_time);
+#endif // _WIN32
+}
+
 std::string player_not_found_message(std::string_view name) {
 	std::string result = "Error: Player \""s;
 	result += name;
@@ -94,6 +108,11 @@ int RenX_CommandsPlugin::OnRehash() {
 	return this->initialize() ? 0 : -1;
 }
 
+RenX_CommandsPlugin::~RenX_CommandsPlugin() {
+	// Pending ban searches run code from this plugin
+	asyncCommands->cancelAll(this);
+}
+
 std::chrono::seconds RenX_CommandsPlugin::getDefaultTBanTime() const {
 	return m_defaultTempBanTime;
 }
@@ -163,9 +182,21 @@ RCONConsoleCommand::RCONConsoleCommand() {
 	this->addTrigger("renx"sv);
 }
 
+/** Collects the responses of an admin socket "rcon" command; replies with them once every server has responded or failed */
+struct RCONConsoleReply
+{
+	ConsoleInput::Reply reply;
+	std::string output;
+
+	~RCONConsoleReply() {
+		reply(output);
+	}
+};
+
 void RCONConsoleCommand::trigger(std::string_view parameters) {
 	if (parameters.empty()) {
 		std::cout << "Error: Too Few Parameters. Syntax: rcon <input>" << std::endl;
+		return;
 	}
 
 	const auto& servers = RenX::getCore()->getServers();
@@ -174,8 +205,48 @@ void RCONConsoleCommand::trigger(std::string_view parameters) {
 		return;
 	}
 
+	// Commands from standard input are fire-and-forget; responses show up in the console log
+	ConsoleInput::Reply reply = consoleInput->deferReply();
+	if (!reply) {
+		for (const auto& server : servers) {
+			server->send(parameters);
+		}
+		return;
+	}
+
+	// Commands from the admin socket reply with each server's response
+	auto collector = std::make_shared<RCONConsoleReply>();
+	collector->reply = std::move(reply);
 	for (const auto& server : servers) {
-		server->send(parameters);
+		bool requested = server->request(parameters, [collector](RenX::Server &in_server, const RenX::RCONResponse &in_response) {
+			std::string &output = collector->output;
+			output += '[';
+			output += in_server.getName();
+			output += "]\n"sv;
+			for (const auto& row : in_response.rows) {
+				for (const auto& token : row) {
+					output += token;
+					output += ' ';
+				}
+				if (!row.empty()) {
+					output.back() = '\n';
+				}
+			}
+			for (const auto& error : in_response.errors) {
+				output += "Error: "sv;
+				output += error;
+				output += '\n';
+			}
+			if (!in_response.completed) {
+				output += "Error: No response; the request timed out or the connection was lost.\n"sv;
+			}
+		}, &pluginInstance);
+
+		if (!requested) {
+			collector->output += '[';
+			collector->output += server->getName();
+			collector->output += "]\nError: Unable to send command.\n"sv;
+		}
 	}
 }
 
@@ -209,17 +280,10 @@ void MsgIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::stri
 		msg += "@IRC: ";
 		msg += parameters;
 
-		prefix = '\0'; // Reusing prefix to check if a match is ever found.
-		for (unsigned int i = 0; i != RenX::getCore()->getServerCount(); i++)
-		{
-			RenX::Server *server = RenX::getCore()->getServer(i);
-			if (server->isLogChanType(type))
-			{
-				server->sendMessage(msg);
-				prefix = 1;
-			}
-		}
-		if (prefix == '\0')
+		size_t sent = RenX::broadcast(msg, [type](const RenX::Server &server) {
+			return server.isLogChanType(type);
+		});
+		if (sent == 0)
 			source->sendMessage(channel, "Error: Channel not attached to any connected Renegade X servers."sv);
 	}
 	else source->sendNotice(nick, "Error: Too Few Parameters. Syntax: Msg <Message>"sv);
@@ -443,7 +507,7 @@ void PlayersIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::
 		if (server->isLogChanType(type))
 		{
 			noServers = false;
-			if (server->players.size() != server->getBotCount())
+			if (server->getHumanCount() != 0)
 			{
 				if (server->players.size() == 0)
 				{
@@ -606,7 +670,7 @@ void PlayerTableIRCCommand::trigger(IRC_Bot *source, std::string_view channel, s
 		if (server->isLogChanType(type))
 		{
 			noServers = false;
-			if (server->players.size() != server->getBotCount())
+			if (server->getHumanCount() != 0)
 			{
 				std::forward_list<RenX::PlayerInfo *> gPlayers;
 				std::forward_list<RenX::PlayerInfo *> nPlayers;
@@ -629,11 +693,11 @@ void PlayerTableIRCCommand::trigger(IRC_Bot *source, std::string_view channel, s
 						if (player->id > highID)
 							highID = player->id;
 
-						if (player->score > highScore)
-							highScore = player->score;
+						if (player->score() > highScore)
+							highScore = player->score();
 
-						if (player->credits > highCredits)
-							highCredits = player->credits;
+						if (player->credits() > highCredits)
+							highCredits = player->credits();
 
 						switch (player->team)
 						{
@@ -670,10 +734,10 @@ void PlayerTableIRCCommand::trigger(IRC_Bot *source, std::string_view channel, s
 				{
 					if (server->isAdminLogChanType(type))
 						source->sendMessage(channel, string_printf(IRCCOLOR "%.*s%*.*s" IRCCOLOR " " IRCCOLOR "03|" IRCCOLOR " %*d " IRCCOLOR "03|" IRCCOLOR " %*.0f " IRCCOLOR "03|" IRCCOLOR " %*.0f " IRCCOLOR "03|" IRCNORMAL " %.*s", color.size(),
-							color.data(), maxNickLen, player->name.size(), player->name.data(), idColLen, player->id, scoreColLen, player->score, creditColLen, player->credits, player->ip.size(), player->ip.data()));
+							color.data(), maxNickLen, player->name.size(), player->name.data(), idColLen, player->id, scoreColLen, player->score(), creditColLen, player->credits(), player->ip.size(), player->ip.data()));
 					else
 						source->sendMessage(channel, string_printf(IRCCOLOR "%.*s%*.*s" IRCCOLOR " " IRCCOLOR "03|" IRCCOLOR " %*d " IRCCOLOR "03|" IRCCOLOR " %*.0f " IRCCOLOR "03|" IRCCOLOR " %*.0f", color.size(),
-							color.data(), maxNickLen, player->name.size(), player->name.data(), idColLen, player->id, scoreColLen, player->score, creditColLen, player->credits));
+							color.data(), maxNickLen, player->name.size(), player->name.data(), idColLen, player->id, scoreColLen, player->score(), creditColLen, player->credits()));
 				};
 
 				for (auto node = gPlayers.begin(); node != gPlayers.end(); ++node)
@@ -1083,6 +1147,118 @@ std::string_view SteamIRCCommand::getHelp(std::string_view )
 
 IRC_COMMAND_INIT(SteamIRCCommand)
 
+// Clients IRC Command
+
+void ClientsIRCCommand::create()
+{
+	this->addTrigger("clients"sv);
+	this->addTrigger("sameclient"sv);
+	this->setAccessLevel(2);
+}
+
+void ClientsIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::string_view nick, std::string_view parameters) {
+	if (parameters.empty()) {
+		source->sendNotice(nick, "Error: Too few parameters. Syntax: Clients <Player>"sv);
+		return;
+	}
+
+	Jupiter::IRC::Client::Channel *chan = source->getChannel(channel);
+	if (chan == nullptr) {
+		return;
+	}
+
+	int type = chan->getType();
+	bool found = false;
+	for (unsigned int i = 0; i != RenX::getCore()->getServerCount(); i++) {
+		RenX::Server *server = RenX::getCore()->getServer(i);
+		if (!server->isLogChanType(type)) {
+			continue;
+		}
+
+		for (auto& player : server->players) {
+			if (jessilib::findi(player.name, parameters) == std::string::npos) {
+				continue;
+			}
+			found = true;
+
+			// Gather every other player sharing any identifier with this player, noting which identifiers they share
+			struct Match {
+				RenX::PlayerLocation location;
+				bool hwid, ip, steam;
+			};
+			std::vector<Match> matches;
+			auto add_matches = [&matches, &player, type](auto in_range, bool Match::* in_flag) {
+				for (const auto& entry : in_range) {
+					const RenX::PlayerLocation& location = entry.second;
+					if (location.player == &player) {
+						continue;
+					}
+
+					// Don't expose players on servers which aren't attached to this channel
+					if (!location.server->isLogChanType(type)) {
+						continue;
+					}
+
+					auto itr = std::find_if(matches.begin(), matches.end(), [&location](const Match& in_match) {
+						return in_match.location.player == location.player;
+					});
+					if (itr == matches.end()) {
+						itr = matches.insert(matches.end(), Match{ location, false, false, false });
+					}
+					(*itr).*in_flag = true;
+				}
+			};
+
+			if (!player.hwid.empty()) {
+				add_matches(RenX::playerIndex->findByHWID(player.hwid), &Match::hwid);
+			}
+			if (player.ip32 != 0) {
+				add_matches(RenX::playerIndex->findByIP(player.ip32), &Match::ip);
+			}
+			if (player.steamid != 0) {
+				add_matches(RenX::playerIndex->findBySteamID(player.steamid), &Match::steam);
+			}
+
+			std::string playerName = RenX::getFormattedPlayerName(player);
+			if (matches.empty()) {
+				source->sendMessage(channel, string_printf(IRCCOLOR "03[Clients] " IRCCOLOR "%.*s (ID: %d) shares no identifiers with any other player.",
+					playerName.size(), playerName.data(), player.id));
+				continue;
+			}
+
+			source->sendMessage(channel, string_printf(IRCCOLOR "03[Clients] " IRCCOLOR "%.*s (ID: %d) shares identifiers with %u player(s):",
+				playerName.size(), playerName.data(), player.id, static_cast<unsigned int>(matches.size())));
+			for (const auto& match : matches) {
+				std::string matchName = RenX::getFormattedPlayerName(*match.location.player);
+				std::string msg = string_printf(IRCCOLOR "03[Clients] " IRCCOLOR "%.*s (ID: %d) on %.*s; shared:", matchName.size(),
+					matchName.data(), match.location.player->id, match.location.server->getName().size(), match.location.server->getName().data());
+				if (match.hwid) {
+					msg += " HWID"sv;
+				}
+				if (match.ip) {
+					msg += " IP"sv;
+				}
+				if (match.steam) {
+					msg += " Steam"sv;
+				}
+				source->sendMessage(channel, msg);
+			}
+		}
+	}
+
+	if (!found) {
+		source->sendNotice(nick, "Error: Player not found."sv);
+	}
+}
+
+std::string_view ClientsIRCCommand::getHelp(std::string_view )
+{
+	static constexpr std::string_view defaultHelp = "Lists players on any server who share a HWID, IP address, or Steam ID with a player. Syntax: Clients <Player>"sv;
+	return defaultHelp;
+}
+
+IRC_COMMAND_INIT(ClientsIRCCommand)
+
 // Kill-Death Ratio IRC Command
 
 void KillDeathRatioIRCCommand::create()
@@ -1106,7 +1282,7 @@ void KillDeathRatioIRCCommand::trigger(IRC_Bot *source, std::string_view channel
 						if (jessilib::findi(node->name, parameters) != std::string::npos) {
 							std::string playerName = RenX::getFormattedPlayerName(*node);
 							msg = string_printf(IRCBOLD "%.*s" IRCBOLD IRCCOLOR ": Kills: %u - Deaths: %u - KDR: %.2f", playerName.size(),
-								playerName.data(), node->kills, node->deaths, static_cast<double>(node->kills) / (node->deaths == 0 ? 1.0f : static_cast<double>(node->deaths)));
+								playerName.data(), node->kills(), node->deaths(), static_cast<double>(node->kills()) / (node->deaths() == 0 ? 1.0f : static_cast<double>(node->deaths())));
 							source->sendMessage(channel, msg);
 						}
 					}
@@ -1374,7 +1550,7 @@ void GameOverIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std:
 					server->gameoverWhenEmpty();
 				else if (jessilib::equalsi(parameters, "if empty"sv))
 				{
-					if (server->players.size() == server->getBotCount())
+					if (server->getHumanCount() == 0)
 						server->gameover();
 				}
 				else if (jessilib::equalsi(parameters, "now"sv))
@@ -1883,33 +2059,7 @@ void BanSearchIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std
 		else {
 			auto command_split = jessilib::word_split_once_view(std::string_view{parameters}, WHITESPACE_SV);
 
-			RenX::BanDatabase::Entry *entry;
 			std::string_view params = command_split.second;
-			std::function<bool(unsigned int)> isMatch = [&](unsigned int type_l) -> bool {
-				switch (type_l)
-				{
-				default:
-				case 0:	// ANY
-					return isMatch(1) || isMatch(2) || isMatch(3) || isMatch(4);
-				case 1: // ALL
-					return true;
-				case 2:	// IP
-					return entry->ip == Jupiter::asUnsignedInt(params); // TODO: Actually parse as an IP address...
-				case 3: // HWID
-					return entry->hwid == params;
-				case 4: // RDNS
-					return entry->rdns == params;
-				case 5:	// STEAM
-					return entry->steamid == Jupiter::asUnsignedLongLong(params);
-				case 6:	// NAME
-					return jessilib::equalsi(entry->name, params);
-				case 7:	// BANNER
-					return jessilib::equalsi(entry->banner, params);
-				case 8:	// ACTIVE
-					return Jupiter::asBool(params) == entry->is_active();
-				}
-			};
-
 			unsigned int type;
 			std::string_view type_str = command_split.first;
 			if (jessilib::equalsi(type_str, "all"sv) || type_str == "*"sv)
@@ -1934,51 +2084,88 @@ void BanSearchIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std
 				params = parameters;
 			}
 
-			std::string out;
-			std::string types;
-			char dateStr[256];
-			char expireStr[256];
-			for (size_t i = 0; i != entries.size(); i++) {
-				entry = entries[i].get();
-				if (isMatch(type)) {
+			// Matching and formatting both run on a worker thread, against a shared copy of the database
+			AsyncCommands::Work work = [entries = RenX::banDatabase->getSnapshot(), type, params = std::string{ params }](const std::atomic<bool>& cancelled) {
+				const RenX::BanDatabase::Entry *entry;
+				std::function<bool(unsigned int)> isMatch = [&](unsigned int type_l) -> bool {
+					switch (type_l)
+					{
+					default:
+					case 0:	// ANY
+						return isMatch(1) || isMatch(2) || isMatch(3) || isMatch(4);
+					case 1: // ALL
+						return true;
+					case 2:	// IP
+						return entry->ip == Jupiter::asUnsignedInt(params); // TODO: Actually parse as an IP address...
+					case 3: // HWID
+						return entry->hwid == params;
+					case 4: // RDNS
+						return entry->rdns == params;
+					case 5:	// STEAM
+						return entry->steamid == Jupiter::asUnsignedLongLong(params);
+					case 6:	// NAME
+						return jessilib::equalsi(entry->name, params);
+					case 7:	// BANNER
+						return jessilib::equalsi(entry->banner, params);
+					case 8:	// ACTIVE
+						return Jupiter::asBool(params) == ((entry->flags & RenX::BanDatabase::Entry::FLAG_ACTIVE) != 0);
+					}
+				};
+
+				Jupiter::GenericCommand::ResponseLine *head = nullptr;
+				Jupiter::GenericCommand::ResponseLine **tail = &head;
+				std::string types;
+				char dateStr[256];
+				char expireStr[256];
+				tm time_info;
+				for (size_t index = 0; index != entries->size(); ++index) {
+					if (cancelled) {
+						break;
+					}
+
+					entry = &(*entries)[index];
+					if (!isMatch(type)) {
+						continue;
+					}
+
 					std::string ip_str = Jupiter::Socket::ntop4(entry->ip);
 
 					time_t added_time = std::chrono::system_clock::to_time_t(entry->timestamp);
 					if (entry->length.count() != 0) {
 						time_t expire_time = std::chrono::system_clock::to_time_t(entry->timestamp + entry->length);
-						strftime(expireStr, sizeof(expireStr), "%b %d %Y, %H:%M:%S", localtime(&expire_time));
+						strftime(expireStr, sizeof(expireStr), "%b %d %Y, %H:%M:%S", localtime_safe(&expire_time, &time_info));
 					}
 					else {
 						std::strcpy(expireStr, "never");
 					}
-					strftime(dateStr, sizeof(dateStr), "%b %d %Y, %H:%M:%S", localtime(&added_time));
+					strftime(dateStr, sizeof(dateStr), "%b %d %Y, %H:%M:%S", localtime_safe(&added_time, &time_info));
 
 					if ((entry->flags & 0x7FFF) == 0)
 						types = " NULL;"sv;
 					else
 					{
 						types.clear();
-						if (entry->is_rdns_ban())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_USE_RDNS) != 0)
 							types += " rdns"sv;
-						if (entry->is_type_game())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_GAME) != 0)
 							types += " game"sv;
-						if (entry->is_type_chat())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_CHAT) != 0)
 							types += " chat"sv;
-						if (entry->is_type_bot())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_BOT) != 0)
 							types += " bot"sv;
-						if (entry->is_type_vote())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_VOTE) != 0)
 							types += " vote"sv;
-						if (entry->is_type_mine())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_MINE) != 0)
 							types += " mine"sv;
-						if (entry->is_type_ladder())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_LADDER) != 0)
 							types += " ladder"sv;
-						if (entry->is_type_alert())
+						if ((entry->flags & RenX::BanDatabase::Entry::FLAG_TYPE_ALERT) != 0)
 							types += " alert"sv;
 						types += ";"sv;
 					}
 
-					out = string_printf("ID: %lu (" IRCCOLOR "%sactive" IRCCOLOR "); Added: %s; Expires: %s; IP: %.*s/%u; HWID: %.*s; Steam: %llu; Types:%.*s Name: %.*s; Banner: %.*s",
-						i, entry->is_active() ? "12" : "04in", dateStr, expireStr, ip_str.size(), ip_str.data(), entry->prefix_length, entry->hwid.size(), entry->hwid.data(), entry->steamid,
+					std::string out = string_printf("ID: %lu (" IRCCOLOR "%sactive" IRCCOLOR "); Added: %s; Expires: %s; IP: %.*s/%u; HWID: %.*s; Steam: %llu; Types:%.*s Name: %.*s; Banner: %.*s",
+						index, (entry->flags & RenX::BanDatabase::Entry::FLAG_ACTIVE) != 0 ? "12" : "04in", dateStr, expireStr, ip_str.size(), ip_str.data(), entry->prefix_length, entry->hwid.size(), entry->hwid.data(), entry->steamid,
 						types.size(), types.data(), entry->name.size(), entry->name.data(), entry->banner.size(), entry->banner.data());
 
 					if (!entry->rdns.empty())
@@ -1991,11 +2178,31 @@ void BanSearchIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std
 						out += "; Reason: "sv;
 						out += entry->reason;
 					}
-					source->sendNotice(nick, out);
+
+					*tail = new Jupiter::GenericCommand::ResponseLine(out, Jupiter::GenericCommand::DisplayType::PrivateSuccess);
+					tail = &(*tail)->next;
+				}
+
+				if (head == nullptr && !cancelled) {
+					head = new Jupiter::GenericCommand::ResponseLine("No matches found."sv, Jupiter::GenericCommand::DisplayType::PrivateSuccess);
 				}
+
+				return head;
+			};
+
+			AsyncCommands::JobId job = asyncCommands->submit(GenericCommandWrapperIRCCommand::getAsyncUser(source, nick), source, std::move(work),
+				[source, nick = std::string{ nick }](Jupiter::GenericCommand::ResponseLine *response) {
+					while (response != nullptr) {
+						source->sendNotice(nick, response->response);
+						Jupiter::GenericCommand::ResponseLine *next = response->next;
+						delete response;
+						response = next;
+					}
+				}, &pluginInstance);
+
+			if (job == 0) {
+				source->sendNotice(nick, "Error: Too many commands in progress. Use \"cancel\" to cancel them."sv);
 			}
-			if (out.empty())
-				source->sendNotice(nick, "No matches found."sv);
 		}
 	}
 	else
@@ -35,6 +35,7 @@ public: // RenX::Plugin
 public: // Jupiter::Plugin
 	virtual bool initialize() override;
 	int OnRehash() override;
+	~RenX_CommandsPlugin();
 
 public:
 	std::chrono::seconds getDefaultTBanTime() const;
@@ -71,6 +72,7 @@ GENERIC_IRC_COMMAND(RotationIRCCommand)
 GENERIC_IRC_COMMAND(MapIRCCommand)
 GENERIC_IRC_COMMAND(GameInfoIRCCommand)
 GENERIC_IRC_COMMAND(SteamIRCCommand)
+GENERIC_IRC_COMMAND(ClientsIRCCommand)
 GENERIC_IRC_COMMAND(KillDeathRatioIRCCommand)
 GENERIC_IRC_COMMAND(ShowModsIRCCommand)
 GENERIC_IRC_COMMAND(ModsIRCCommand)
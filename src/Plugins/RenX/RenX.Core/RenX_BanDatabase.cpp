@@ -67,6 +67,7 @@ void RenX::BanDatabase::process_data(Jupiter::DataBuffer &buffer, FILE *file, fp
 	}
 
 	m_entries.push_back(std::move(entry));
+	m_snapshot = nullptr;
 }
 
 void RenX::BanDatabase::process_header(FILE *file)
@@ -188,6 +189,7 @@ void RenX::BanDatabase::add(RenX::Server *server, const RenX::PlayerInfo &player
 	}
 
 	m_entries.push_back(std::move(entry));
+	m_snapshot = nullptr;
 	write(m_entries.back().get());
 }
 
@@ -207,6 +209,7 @@ void RenX::BanDatabase::add(std::string name, uint32_t ip, uint8_t prefix_length
 	entry->reason = std::move(reason);
 
 	m_entries.push_back(std::move(entry));
+	m_snapshot = nullptr;
 	write(m_entries.back().get());
 }
 
@@ -218,6 +221,7 @@ bool RenX::BanDatabase::deactivate(size_t index) {
 bool RenX::BanDatabase::deactivate(Entry* entry) {
 	if (entry->is_active()) {
 		entry->unset_active();
+		m_snapshot = nullptr;
 		FILE *file = fopen(m_filename.c_str(), "r+b");
 		if (file != nullptr) {
 			fsetpos(file, &entry->pos);
@@ -242,6 +246,19 @@ const std::vector<std::unique_ptr<RenX::BanDatabase::Entry>>& RenX::BanDatabase:
 	return m_entries;
 }
 
+RenX::BanDatabase::Snapshot RenX::BanDatabase::getSnapshot() {
+	if (m_snapshot == nullptr) {
+		auto snapshot = std::make_shared<std::vector<Entry>>();
+		snapshot->reserve(m_entries.size());
+		for (const auto& entry : m_entries) {
+			snapshot->push_back(*entry);
+		}
+		m_snapshot = std::move(snapshot);
+	}
+
+	return m_snapshot;
+}
+
 bool RenX::BanDatabase::initialize() {
 	m_filename = RenX::getCore()->getConfig().get("BanDB"sv, "Bans.db"s);
 	return this->process_file(m_filename);
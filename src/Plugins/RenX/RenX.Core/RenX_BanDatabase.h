@@ -20,7 +20,9 @@
 #define _RENX_BANDATABASE_H_HEADER
 
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "jessilib/unicode.hpp"
 #include "Jupiter/Database.h"
 #include "RenX.h"
@@ -210,6 +212,18 @@ namespace RenX
 		*/
 		const std::vector<std::unique_ptr<Entry>>& getEntries() const;
 
+		/** Read-only copy of the ban entries, in database order */
+		using Snapshot = std::shared_ptr<const std::vector<Entry>>;
+
+		/**
+		* @brief Fetches a copy of every entry, for reading off the main thread (i.e: searches run on the AsyncCommands pool).
+		* The copy is made on the first call after the database changes through add(), deactivate(), or loading, and is
+		* shared by every call until the next change.
+		*
+		* @return Copy of the entries
+		*/
+		Snapshot getSnapshot();
+
 		virtual bool initialize();
 		~BanDatabase();
 
@@ -221,6 +235,7 @@ namespace RenX
 
 		std::string m_filename;
 		std::vector<std::unique_ptr<Entry>> m_entries;
+		Snapshot m_snapshot; /** Cleared whenever m_entries changes */
 	};
 
 	RENX_API extern RenX::BanDatabase *banDatabase;
@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TimerWheel.h"
+#include "RenX_Broadcast.h"
+#include "RenX_Core.h"
+#include "RenX_Server.h"
+#include "RenX_PlayerInfo.h"
+#include "RenX_RCONCodec.h"
+#include "RenX_Tags.h"
+
+using broadcast_payload = std::shared_ptr<const std::string>;
+
+/** Pending staggered sends; cancelled by cancelBroadcasts() when RenX.Core unloads */
+static std::vector<TimerWheel::TimerId> s_broadcast_timers;
+
+static broadcast_payload make_broadcast_payload(std::string_view in_message) {
+	auto result = std::make_shared<std::string>();
+	RenX::escapifyRCON(in_message, *result);
+	return result;
+}
+
+static void deliver_broadcast(RenX::Server *in_server, broadcast_payload in_payload, std::chrono::milliseconds in_delay) {
+	if (in_delay.count() <= 0) {
+		in_server->sendEscapedMessage(*in_payload);
+		return;
+	}
+
+	// Look the server up by ID when the timer fires; it may have been removed, and another server may have taken its address
+	s_broadcast_timers.push_back(timerWheel->schedule(in_delay, [server_id = in_server->getID(), payload = std::move(in_payload)]() {
+		RenX::Server *server = RenX::getCore()->getServerByID(server_id);
+		if (server != nullptr) {
+			server->sendEscapedMessage(*payload);
+		}
+	}));
+}
+
+void RenX::cancelBroadcasts() {
+	for (TimerWheel::TimerId id : s_broadcast_timers) {
+		timerWheel->cancel(id);
+	}
+	s_broadcast_timers.clear();
+}
+
+size_t RenX::broadcast(std::string_view message, const BroadcastFilter &filter, std::chrono::milliseconds stagger) {
+	RenX::Core *core = RenX::getCore();
+	broadcast_payload payload;
+	size_t result = 0;
+
+	std::erase_if(s_broadcast_timers, [](TimerWheel::TimerId id) { return !timerWheel->isPending(id); });
+
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		RenX::Server *server = core->getServer(index);
+		if (filter && !filter(*server)) {
+			continue;
+		}
+
+		if (payload == nullptr) {
+			payload = make_broadcast_payload(message);
+		}
+
+		deliver_broadcast(server, payload, stagger * result);
+		++result;
+	}
+
+	return result;
+}
+
+size_t RenX::broadcastTags(std::string_view format, const BroadcastFilter &filter, std::chrono::milliseconds stagger) {
+	// Render server-independent tags (i.e: date and time) once for every server
+	std::string shared_message{ format };
+	RenX::processTags(shared_message);
+
+	// Internal tags begin with a null byte; if none remain, every server renders the same message
+	if (shared_message.find('\0') == std::string::npos) {
+		return broadcast(shared_message, filter, stagger);
+	}
+
+	RenX::Core *core = RenX::getCore();
+	std::unordered_map<std::string, broadcast_payload> payloads;
+	std::string message;
+	size_t result = 0;
+
+	std::erase_if(s_broadcast_timers, [](TimerWheel::TimerId id) { return !timerWheel->isPending(id); });
+
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		RenX::Server *server = core->getServer(index);
+		if (filter && !filter(*server)) {
+			continue;
+		}
+
+		message = shared_message;
+		RenX::processTags(message, server);
+
+		auto itr = payloads.find(message);
+		if (itr == payloads.end()) {
+			broadcast_payload payload = make_broadcast_payload(message);
+			itr = payloads.emplace(std::move(message), std::move(payload)).first;
+		}
+
+		deliver_broadcast(server, itr->second, stagger * result);
+		++result;
+	}
+
+	return result;
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_BROADCAST_H_HEADER
+#define _RENX_BROADCAST_H_HEADER
+
+/**
+ * @file RenX_Broadcast.h
+ * @brief Sends in-game messages to many servers at once.
+ */
+
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/** Forward declarations */
+	class Server;
+
+	/** Returns true for servers which should receive a broadcast */
+	using BroadcastFilter = std::function<bool(const RenX::Server &)>;
+
+	/**
+	* @brief Sends an in-game message to every server which passes a filter.
+	* The message is escaped once, and the escaped payload is shared by every server.
+	*
+	* @param message Message to send; tags are not processed
+	* @param filter Filter to select servers with, or nullptr to send to every server
+	* @param stagger Delay between sends to consecutive servers, or 0 to send to every server immediately; delayed sends to servers removed in the meantime are dropped
+	* @return Number of servers the message was sent or scheduled to
+	*/
+	RENX_API size_t broadcast(std::string_view message, const BroadcastFilter &filter = nullptr, std::chrono::milliseconds stagger = std::chrono::milliseconds::zero());
+
+	/**
+	* @brief Processes tags in a message for each server which passes a filter, and sends the result in-game.
+	* Messages which only use server-independent tags are rendered once; otherwise, each server's message is rendered
+	* separately, and servers which render identical messages share a single escaped payload.
+	*
+	* @param format Message to send, with tags already sanitized by RenX::sanitizeTags()
+	* @param filter Filter to select servers with, or nullptr to send to every server
+	* @param stagger Delay between sends to consecutive servers, or 0 to send to every server immediately
+	* @return Number of servers the message was sent or scheduled to
+	*/
+	RENX_API size_t broadcastTags(std::string_view format, const BroadcastFilter &filter = nullptr, std::chrono::milliseconds stagger = std::chrono::milliseconds::zero());
+
+	/**
+	* @brief Cancels every staggered send which has yet to go out. Called by RenX::Core when it is destroyed.
+	*/
+	RENX_API void cancelBroadcasts();
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_BROADCAST_H_HEADER
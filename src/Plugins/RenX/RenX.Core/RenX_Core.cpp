@@ -20,6 +20,7 @@
 #include "jessilib/word_split.hpp"
 #include "Jupiter/Functions.h"
 #include "IRC_Bot.h"
+#include "StartupTasks.h"
 #include "RenX_Core.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
@@ -29,6 +30,7 @@
 #include "RenX_BanDatabase.h"
 #include "RenX_ExemptionDatabase.h"
 #include "RenX_Tags.h"
+#include "RenX_Broadcast.h"
 
 using namespace std::literals;
 
@@ -40,8 +42,9 @@ RenX::Core *RenX::getCore() {
 }
 
 bool RenX::Core::initialize() {
-	RenX::banDatabase->initialize();
-	RenX::exemptionDatabase->initialize();
+	// Databases are only read from once servers are processed in think()
+	startupTasks->add("ban database"sv, [] { RenX::banDatabase->initialize(); });
+	startupTasks->add("exemption database"sv, [] { RenX::exemptionDatabase->initialize(); });
 	RenX::tags->initialize();
 	RenX::initTranslations(this->config);
 
@@ -63,7 +66,17 @@ bool RenX::Core::initialize() {
 	return true;
 }
 
+int RenX::Core::OnRehash() {
+	Jupiter::Plugin::OnRehash();
+
+	// Translations view the config, which has just been reloaded
+	RenX::initTranslations(this->config);
+	return 0;
+}
+
 RenX::Core::~Core() {
+	// Staggered broadcasts capture code from this module
+	RenX::cancelBroadcasts();
 }
 
 size_t RenX::Core::send(int type, std::string_view msg) {
@@ -100,6 +113,16 @@ RenX::Server* RenX::Core::getServer(size_t index) {
 	return m_servers[index].get();
 }
 
+RenX::Server* RenX::Core::getServerByID(uint64_t id) {
+	for (const auto& server : m_servers) {
+		if (server->getID() == id) {
+			return server.get();
+		}
+	}
+
+	return nullptr;
+}
+
 std::vector<RenX::Server*> RenX::Core::getServers() {
 	std::vector<RenX::Server*> result;
 
@@ -163,13 +186,45 @@ Jupiter::Config &RenX::Core::getCommandsFile() {
 }
 
 size_t RenX::Core::addCommand(RenX::GameCommand *command) {
+	// First command added for a trigger wins, matching the order servers add commands in
+	for (size_t index = 0; index != command->getTriggerCount(); ++index) {
+		m_commandIndex.try_emplace(static_cast<std::string>(command->getTrigger(index)), command);
+	}
+
 	for (const auto& server : m_servers) {
-		server->addCommand(command->copy());
+		server->addSharedCommand(command);
 	}
 
 	return m_servers.size();
 }
 
+void RenX::Core::removeCommand(RenX::GameCommand *command) {
+	for (const auto& server : m_servers) {
+		server->releaseSharedCommand(command);
+	}
+
+	// Rebuild, so that any command shadowed by the removed one becomes reachable again
+	m_commandIndex.clear();
+	for (const auto& master_command : RenX::GameMasterCommandList) {
+		if (master_command == command) {
+			continue;
+		}
+
+		for (size_t index = 0; index != master_command->getTriggerCount(); ++index) {
+			m_commandIndex.try_emplace(static_cast<std::string>(master_command->getTrigger(index)), master_command);
+		}
+	}
+}
+
+RenX::GameCommand *RenX::Core::getCommand(std::string_view trigger) const {
+	auto itr = m_commandIndex.find(trigger);
+	if (itr != m_commandIndex.end()) {
+		return itr->second;
+	}
+
+	return nullptr;
+}
+
 void RenX::Core::banCheck() {
 	for (const auto& server : m_servers) {
 		server->banCheck();
@@ -67,6 +67,13 @@ namespace RenX
 		*/
 		bool initialize() override;
 
+		/**
+		* @brief Reloads RenX.Core's configuration, and the translations which depend on it.
+		*
+		* @return 0.
+		*/
+		int OnRehash() override;
+
 		/**
 		* @brief Sends a command to all servers of a specific type.
 		*
@@ -98,6 +105,14 @@ namespace RenX
 		*/
 		RenX::Server *getServer(size_t index);
 
+		/**
+		* @brief Fetches a server based on its ID.
+		*
+		* @param id ID of the server, from Server::getID()
+		* @return Server with the specified ID if it still exists, nullptr otherwise.
+		*/
+		RenX::Server *getServerByID(uint64_t id);
+
 		/**
 		* @brief Fetches the list of servers
 		* Note: This copies the array of pointers, not the objects themselves.
@@ -159,13 +174,30 @@ namespace RenX
 		Jupiter::Config &getCommandsFile();
 
 		/**
-		* @brief Copys a command, and passes it to each server.
+		* @brief Adds a master command to the shared trigger index, and passes it to each server.
 		*
-		* @param command Command to copy.
-		* @return Number of commands added.
+		* @param command Command to add.
+		* @return Number of servers the command was added to.
 		*/
 		size_t addCommand(GameCommand *command);
 
+		/**
+		* @brief Removes a master command from each server and from the shared trigger index.
+		* Note: This is called automatically when a master command is destroyed.
+		*
+		* @param command Command to remove
+		*/
+		void removeCommand(GameCommand *command);
+
+		/**
+		* @brief Fetches a master command from the shared trigger index.
+		* Note: Servers may disable or override master commands; use Server::getCommand() to find a server's command.
+		*
+		* @param trigger Trigger or alias of the command to find
+		* @return First master command added with the specified trigger if one exists, nullptr otherwise
+		*/
+		GameCommand *getCommand(std::string_view trigger) const;
+
 		/**
 		* @brief Performs a ban check on every player on each server, and kicks as appropriate.
 		*/
@@ -185,6 +217,7 @@ namespace RenX
 		std::vector<std::unique_ptr<RenX::Server>> m_servers;
 		std::vector<RenX::Plugin*> m_plugins;
 		Jupiter::INIConfig m_commandsFile;
+		std::unordered_map<std::string, GameCommand*, jessilib::text_hashi, jessilib::text_equali> m_commandIndex; /** Case-insensitive trigger lookup into GameMasterCommandList, shared by all servers */
 	};
 
 	RENX_API Core *getCore();
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <mutex>
+#include <vector>
+#include "RenX_DataSlot.h"
+#include "RenX_Core.h"
+#include "RenX_Server.h"
+#include "RenX_PlayerInfo.h"
+
+std::mutex g_data_slot_mutex;
+size_t g_data_slot_count = 0;
+std::vector<size_t> g_free_data_slots;
+
+// Defined in RenX_Server.cpp; unsets a slot index on the temporary and null players, which no server holds
+void reset_detached_player_slots(size_t in_index);
+
+void RenX::SlotStorage::reset(size_t in_index) {
+	if (in_index < m_values.size()) {
+		m_values[in_index].reset();
+	}
+}
+
+size_t RenX::acquireDataSlot() {
+	std::lock_guard<std::mutex> guard{ g_data_slot_mutex };
+	if (!g_free_data_slots.empty()) {
+		size_t result = g_free_data_slots.back();
+		g_free_data_slots.pop_back();
+		return result;
+	}
+
+	return g_data_slot_count++;
+}
+
+void RenX::releaseDataSlot(size_t in_index) {
+	RenX::Core *core = RenX::getCore();
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		RenX::Server *server = core->getServer(index);
+		server->slots.reset(in_index);
+		for (auto& player : server->players) {
+			player.slots.reset(in_index);
+		}
+	}
+	reset_detached_player_slots(in_index);
+
+	std::lock_guard<std::mutex> guard{ g_data_slot_mutex };
+	g_free_data_slots.push_back(in_index);
+}
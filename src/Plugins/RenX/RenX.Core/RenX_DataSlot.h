@@ -0,0 +1,189 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_DATASLOT_H_HEADER
+#define _RENX_DATASLOT_H_HEADER
+
+/**
+ * @file RenX_DataSlot.h
+ * @brief Provides typed, indexed plugin data attached to players and servers.
+ */
+
+#include <any>
+#include <deque>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/**
+	* @brief Storage for values of registered data slots, held by each PlayerInfo and Server.
+	* Values are allocated on first access, and are indexed by the slot's registration index.
+	* Values are never moved, so references to them remain valid when other slots are first accessed.
+	*/
+	class RENX_API SlotStorage
+	{
+	public:
+		/**
+		* @brief Fetches the value at a slot index, constructing it from a default value if it is not yet set.
+		* A value of another type (i.e: left behind by a previous user of a reused index) is replaced.
+		*
+		* @param in_index Index of the slot
+		* @param in_default Value to initialize the slot with if it is unset
+		* @return Reference to the slot's value
+		*/
+		template<typename T> T& get(size_t in_index, const T& in_default) {
+			if (in_index >= m_values.size()) {
+				m_values.resize(in_index + 1);
+			}
+
+			std::any& value = m_values[in_index];
+			if (T* result = std::any_cast<T>(&value)) {
+				return *result;
+			}
+
+			return value.emplace<T>(in_default);
+		}
+
+		/**
+		* @brief Fetches the value at a slot index, if it is set.
+		*
+		* @param in_index Index of the slot
+		* @return Pointer to the slot's value if set, nullptr otherwise
+		*/
+		template<typename T> const T* find(size_t in_index) const {
+			if (in_index >= m_values.size()) {
+				return nullptr;
+			}
+
+			return std::any_cast<T>(&m_values[in_index]);
+		}
+
+		/**
+		* @brief Unsets the value at a slot index.
+		*
+		* @param in_index Index of the slot
+		*/
+		void reset(size_t in_index);
+
+	private:
+		std::deque<std::any> m_values;
+	};
+
+	/**
+	* @brief Reserves a slot index. Indexes are shared between players and servers.
+	* This is safe to call from any thread, since plugins may be loaded while startup tasks are running.
+	*
+	* @return Reserved slot index
+	*/
+	RENX_API size_t acquireDataSlot();
+
+	/**
+	* @brief Unsets a slot index on every player and server, including temporary players, and returns it for reuse.
+	* This must happen before the plugin which registered the slot is unloaded, since the values' destructors live in that plugin.
+	* Values are unset from the main thread only, since players and servers are not otherwise locked.
+	*
+	* @param in_index Slot index to release
+	*/
+	RENX_API void releaseDataSlot(size_t in_index);
+
+	/**
+	* @brief A typed data slot on objects holding a SlotStorage named "slots" (PlayerInfo, Server).
+	* Declare one as a member of a plugin, or at namespace scope in a plugin, so that it is registered when the plugin loads and released when it unloads.
+	*/
+	template<typename OwnerT, typename T> class DataSlot
+	{
+	public:
+		/**
+		* @brief Fetches this slot's value on an object, initializing it to the slot's default if it is unset.
+		*
+		* @param in_owner Object to fetch the value from
+		* @return Reference to the value
+		*/
+		T& get(const OwnerT& in_owner) const {
+			return in_owner.slots.get(m_index, m_default);
+		}
+
+		/**
+		* @brief Fetches this slot's value on an object, if it has been set.
+		*
+		* @param in_owner Object to fetch the value from
+		* @return Pointer to the value if set, nullptr otherwise
+		*/
+		const T* find(const OwnerT& in_owner) const {
+			return in_owner.slots.template find<T>(m_index);
+		}
+
+		/**
+		* @brief Sets this slot's value on an object.
+		*
+		* @param in_owner Object to set the value on
+		* @param in_value Value to set
+		*/
+		void set(const OwnerT& in_owner, T in_value) const {
+			get(in_owner) = std::move(in_value);
+		}
+
+		/**
+		* @brief Unsets this slot's value on an object, so that the next access sees the default value.
+		*
+		* @param in_owner Object to reset the value on
+		*/
+		void reset(const OwnerT& in_owner) const {
+			in_owner.slots.reset(m_index);
+		}
+
+		DataSlot(T in_default = T{})
+			: m_index{ acquireDataSlot() },
+			m_default{ std::move(in_default) } {
+		}
+
+		~DataSlot() {
+			releaseDataSlot(m_index);
+		}
+
+		DataSlot(const DataSlot&) = delete;
+		DataSlot& operator=(const DataSlot&) = delete;
+
+	private:
+		size_t m_index;
+		T m_default;
+	};
+
+	/** Forward declarations */
+	struct PlayerInfo;
+	class Server;
+
+	/** Typed data slot stored on each player */
+	template<typename T> using PlayerSlot = DataSlot<PlayerInfo, T>;
+
+	/** Typed data slot stored on each server */
+	template<typename T> using ServerSlot = DataSlot<Server, T>;
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_DATASLOT_H_HEADER
@@ -0,0 +1,187 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+#include <algorithm>
+#include "RenX_EventRates.h"
+#include "RenX_PlayerInfo.h"
+
+RenX::EventRateTracker g_eventRates;
+RenX::EventRateTracker *RenX::eventRates = &g_eventRates;
+
+/** Window */
+
+unsigned int RenX::EventRateTracker::Window::expired(int64_t in_bucket) const {
+	int64_t delta = in_bucket - head;
+	if (delta <= 0) {
+		return 0;
+	}
+
+	if (delta >= static_cast<int64_t>(s_buckets)) {
+		return total;
+	}
+
+	// Buckets after the head are the oldest; the first 'delta' of them have left the window
+	unsigned int result = 0;
+	for (int64_t offset = 1; offset <= delta; ++offset) {
+		result += buckets[static_cast<size_t>(head + offset) % s_buckets];
+	}
+
+	return result;
+}
+
+void RenX::EventRateTracker::Window::advance(int64_t in_bucket) {
+	int64_t delta = in_bucket - head;
+	if (delta <= 0) {
+		return;
+	}
+
+	if (delta >= static_cast<int64_t>(s_buckets)) {
+		buckets.fill(0);
+		total = 0;
+	}
+	else {
+		for (int64_t offset = 1; offset <= delta; ++offset) {
+			unsigned int& bucket = buckets[static_cast<size_t>(head + offset) % s_buckets];
+			total -= bucket;
+			bucket = 0;
+		}
+	}
+
+	head = in_bucket;
+}
+
+/** EventRateTracker */
+
+size_t RenX::EventRateTracker::subscribe(RateEvent in_event, std::chrono::milliseconds in_window, unsigned int in_threshold, Callback in_callback) {
+	clock::duration bucket_width = std::max<clock::duration>(std::chrono::duration_cast<clock::duration>(in_window) / s_buckets, clock::duration{ 1 });
+
+	// Find or create a track for this event and window
+	auto track_itr = std::find_if(m_tracks.begin(), m_tracks.end(), [in_event, bucket_width](const Track& in_track) {
+		return in_track.event == in_event && in_track.bucketWidth == bucket_width;
+	});
+	size_t track_index = static_cast<size_t>(track_itr - m_tracks.begin());
+	if (track_itr == m_tracks.end()) {
+		m_tracks.push_back({ in_event, bucket_width, {} });
+	}
+
+	Track& track = m_tracks[track_index];
+	if (track.subscriptions.empty()) {
+		// Stale counts from a previous use of this track must not carry over
+		for (auto& player : m_players) {
+			if (track_index < player.second.size()) {
+				player.second[track_index] = Window{};
+			}
+		}
+		m_activeTracks[static_cast<size_t>(in_event)].push_back(track_index);
+	}
+
+	// Reserve a subscription ID
+	size_t result;
+	if (!m_freeSubscriptions.empty()) {
+		result = m_freeSubscriptions.back();
+		m_freeSubscriptions.pop_back();
+		m_subscriptions[result] = { track_index, in_threshold, std::move(in_callback) };
+	}
+	else {
+		result = m_subscriptions.size();
+		m_subscriptions.push_back({ track_index, in_threshold, std::move(in_callback) });
+	}
+
+	track.subscriptions.push_back(result);
+	return result;
+}
+
+void RenX::EventRateTracker::unsubscribe(size_t in_subscription) {
+	if (in_subscription >= m_subscriptions.size() || m_subscriptions[in_subscription].callback == nullptr) {
+		return;
+	}
+
+	Subscription& subscription = m_subscriptions[in_subscription];
+	Track& track = m_tracks[subscription.track];
+	track.subscriptions.erase(std::find(track.subscriptions.begin(), track.subscriptions.end(), in_subscription));
+	if (track.subscriptions.empty()) {
+		auto& active_tracks = m_activeTracks[static_cast<size_t>(track.event)];
+		active_tracks.erase(std::find(active_tracks.begin(), active_tracks.end(), subscription.track));
+	}
+
+	subscription.callback = nullptr;
+	m_freeSubscriptions.push_back(in_subscription);
+}
+
+unsigned int RenX::EventRateTracker::count(const RenX::PlayerInfo &in_player, size_t in_subscription, clock::time_point in_now) const {
+	if (in_subscription >= m_subscriptions.size()) {
+		return 0;
+	}
+
+	size_t track_index = m_subscriptions[in_subscription].track;
+	auto player_itr = m_players.find(&in_player);
+	if (player_itr == m_players.end() || track_index >= player_itr->second.size()) {
+		return 0;
+	}
+
+	const Window& window = player_itr->second[track_index];
+	return window.total - window.expired(bucketOf(m_tracks[track_index], in_now));
+}
+
+void RenX::EventRateTracker::record(RenX::Server &in_server, const RenX::PlayerInfo &in_player, RateEvent in_event, clock::time_point in_now) {
+	const auto& active_tracks = m_activeTracks[static_cast<size_t>(in_event)];
+	if (active_tracks.empty() || in_player.id == 0) {
+		return;
+	}
+
+	std::vector<Window>& windows = m_players[&in_player];
+	if (windows.size() < m_tracks.size()) {
+		windows.resize(m_tracks.size());
+	}
+
+	// Update windows first; callbacks may subscribe or unsubscribe, which would invalidate iteration
+	std::vector<std::pair<size_t, unsigned int>> reached;
+	for (size_t track_index : active_tracks) {
+		const Track& track = m_tracks[track_index];
+		Window& window = windows[track_index];
+		window.advance(bucketOf(track, in_now));
+
+		unsigned int previous = window.total;
+		++window.buckets[static_cast<size_t>(window.head) % s_buckets];
+		++window.total;
+
+		for (size_t subscription_index : track.subscriptions) {
+			unsigned int threshold = m_subscriptions[subscription_index].threshold;
+			if (previous < threshold && window.total >= threshold) {
+				reached.emplace_back(subscription_index, window.total);
+			}
+		}
+	}
+
+	for (const auto& entry : reached) {
+		// Copy, in case the callback unsubscribes itself
+		Callback callback = m_subscriptions[entry.first].callback;
+		if (callback != nullptr) {
+			callback(in_server, in_player, entry.second);
+		}
+	}
+}
+
+void RenX::EventRateTracker::forget(const RenX::PlayerInfo &in_player) {
+	m_players.erase(&in_player);
+}
+
+int64_t RenX::EventRateTracker::bucketOf(const Track &in_track, clock::time_point in_time) const {
+	return static_cast<int64_t>(in_time.time_since_epoch() / in_track.bucketWidth);
+}
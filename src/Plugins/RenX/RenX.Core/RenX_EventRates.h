@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+#if !defined _RENX_EVENTRATES_H_HEADER
+#define _RENX_EVENTRATES_H_HEADER
+
+/**
+ * @file RenX_EventRates.h
+ * @brief Tracks how often players cause events over sliding windows of time.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/** Forward declarations */
+	struct PlayerInfo;
+	class Server;
+
+	/** Player events whose rates may be tracked */
+	enum class RateEvent : size_t
+	{
+		Kills,
+		Headshots,
+		VehicleKills,
+		Deaths,
+		Purchases,
+		Count
+	};
+
+	/**
+	* @brief Counts player events over sliding windows, and notifies subscribers when a player's count reaches a threshold.
+	* Each window is a ring of a fixed number of buckets, so memory per player is constant in the number of events;
+	* counts are exact to within one bucket (1/16th of the window).
+	* Only windows with at least one subscriber are tracked, and subscriptions with the same event and window share a ring.
+	*/
+	class RENX_API EventRateTracker
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/**
+		* @brief Called when a player's event count within a window reaches a threshold.
+		* Called again only after the count falls back below the threshold and reaches it once more.
+		*
+		* @param server Server the player is on
+		* @param player Player who reached the threshold
+		* @param count Number of events within the window
+		*/
+		using Callback = std::function<void(RenX::Server &server, const RenX::PlayerInfo &player, unsigned int count)>;
+
+		/**
+		* @brief Subscribes to a threshold on an event's rate.
+		* Note: Callbacks must be unsubscribed before the plugin which holds them is unloaded.
+		*
+		* @param in_event Event to count
+		* @param in_window Duration of the sliding window
+		* @param in_threshold Count within the window at which to call the callback
+		* @param in_callback Function to call
+		* @return Subscription ID, for unsubscribe() and count()
+		*/
+		size_t subscribe(RateEvent in_event, std::chrono::milliseconds in_window, unsigned int in_threshold, Callback in_callback);
+
+		/**
+		* @brief Removes a subscription.
+		*
+		* @param in_subscription Subscription ID returned by subscribe()
+		*/
+		void unsubscribe(size_t in_subscription);
+
+		/**
+		* @brief Fetches a player's current event count within a subscription's window.
+		*
+		* @param in_player Player to fetch the count of
+		* @param in_subscription Subscription ID returned by subscribe()
+		* @param in_now Current time
+		* @return Number of events within the window
+		*/
+		unsigned int count(const RenX::PlayerInfo &in_player, size_t in_subscription, clock::time_point in_now = clock::now()) const;
+
+		/**
+		* @brief Records an event for a player, and calls any subscriptions whose threshold it reaches.
+		* Temporary players (ID 0) are ignored.
+		*
+		* @param in_server Server the player is on
+		* @param in_player Player who caused the event
+		* @param in_event Event which occurred
+		* @param in_now Time at which the event occurred
+		*/
+		void record(RenX::Server &in_server, const RenX::PlayerInfo &in_player, RateEvent in_event, clock::time_point in_now = clock::now());
+
+		/**
+		* @brief Discards a player's windows; called when a player leaves a server.
+		*
+		* @param in_player Player to discard
+		*/
+		void forget(const RenX::PlayerInfo &in_player);
+
+	private:
+		static constexpr size_t s_buckets = 16;
+
+		/** A player's ring of event counts for one window */
+		struct Window
+		{
+			int64_t head = 0; /** Bucket number of the newest bucket */
+			unsigned int total = 0;
+			std::array<unsigned int, s_buckets> buckets{};
+
+			unsigned int expired(int64_t in_bucket) const;
+			void advance(int64_t in_bucket);
+		};
+
+		/** A window duration being tracked for an event, shared by subscriptions */
+		struct Track
+		{
+			RateEvent event;
+			clock::duration bucketWidth;
+			std::vector<size_t> subscriptions;
+		};
+
+		struct Subscription
+		{
+			size_t track;
+			unsigned int threshold;
+			Callback callback;
+		};
+
+		int64_t bucketOf(const Track &in_track, clock::time_point in_time) const;
+
+		std::vector<Track> m_tracks;
+		std::array<std::vector<size_t>, static_cast<size_t>(RateEvent::Count)> m_activeTracks; /** Tracks with subscribers, by event */
+		std::vector<Subscription> m_subscriptions;
+		std::vector<size_t> m_freeSubscriptions;
+		std::unordered_map<const RenX::PlayerInfo*, std::vector<Window>> m_players; /** Windows of each player, indexed by track */
+	};
+
+	RENX_API extern RenX::EventRateTracker *eventRates;
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_EVENTRATES_H_HEADER
@@ -16,6 +16,8 @@
 * Written by Jessica James <jessica.aj@outlook.com>
 */
 
+#include <algorithm>
+#include <array>
 #include <cstdio>
 #include "Jupiter/IRC_Client.h"
 #include "Jupiter/DataBuffer.h"
@@ -58,13 +60,24 @@ void RenX::ExemptionDatabase::create_header(FILE *file) {
 
 void RenX::ExemptionDatabase::process_file_finish(FILE *file) {
 	fgetpos(file, std::addressof(m_eof));
+
+	for (const auto& entry : m_entries) {
+		if (entry->is_active()) {
+			index(entry.get());
+		}
+	}
 }
 
 void RenX::ExemptionDatabase::upgrade_database() {
+	if (m_file != nullptr) {
+		fclose(m_file);
+		m_file = nullptr;
+	}
+
 	FILE *file = fopen(m_filename.c_str(), "wb");
 	if (file != nullptr) {
 		this->create_header(file);
-		for (size_t index = 0; m_entries.size(); ++index) {
+		for (size_t index = 0; index != m_entries.size(); ++index) {
 			write(m_entries[index].get(), file);
 		}
 
@@ -73,11 +86,11 @@ void RenX::ExemptionDatabase::upgrade_database() {
 }
 
 void RenX::ExemptionDatabase::write(RenX::ExemptionDatabase::Entry *entry) {
-	FILE *file = fopen(m_filename.c_str(), "r+b");
-	fsetpos(file, std::addressof(m_eof));
+	FILE *file = get_file();
 	if (file != nullptr) {
+		fsetpos(file, std::addressof(m_eof));
 		write(entry, file);
-		fclose(file);
+		fflush(file);
 	}
 }
 
@@ -116,42 +129,165 @@ void RenX::ExemptionDatabase::add(uint32_t ip, uint8_t prefix_length, uint64_t s
 
 	m_entries.push_back(std::move(entry));
 	write(m_entries.back().get());
+	index(m_entries.back().get());
 }
 
 bool RenX::ExemptionDatabase::deactivate(size_t index) {
 	Entry* entry = m_entries[index].get();
 	if (entry->is_active()) {
 		entry->unset_active();
-		FILE *file = fopen(m_filename.c_str(), "r+b");
-		if (file != nullptr) {
-			fsetpos(file, &entry->pos);
-			fseek(file, sizeof(size_t), SEEK_CUR);
-			fwrite(std::addressof(entry->flags), sizeof(entry->flags), 1, file);
-			fclose(file);
+		unindex(entry);
+		if (write_flags(entry)) {
+			fflush(m_file);
 		}
 		return true;
 	}
 	return false;
 }
 
-void RenX::ExemptionDatabase::exemption_check(RenX::PlayerInfo &player) {
-	Entry* entry;
-	uint32_t netmask;
-	size_t index = m_entries.size();
-	while (index != 0) {
-		entry = m_entries[--index].get();
+size_t RenX::ExemptionDatabase::expire(std::chrono::system_clock::time_point now) {
+	size_t result = 0;
+	while (!m_expiries.empty() && m_expiries.top().first <= now) {
+		Entry *entry = m_expiries.top().second;
+		m_expiries.pop();
+
+		// Entries deactivated by other means are left in the queue until they'd have expired
 		if (entry->is_active()) {
-			if (entry->length == std::chrono::seconds::zero() || entry->timestamp + entry->length < std::chrono::system_clock::now()) {
-				netmask = Jupiter_prefix_length_to_netmask(entry->prefix_length);
-				if ((player.steamid != 0 && entry->steamid == player.steamid) // SteamID exemption
-					|| (player.ip32 != 0U && (player.ip32 & netmask) == (entry->ip & netmask))) { // IP address exemption
-					player.exemption_flags |= entry->flags;
-				}
+			entry->unset_active();
+			unindex(entry);
+			write_flags(entry);
+			++result;
+		}
+	}
+
+	// Flush the whole sweep at once
+	if (result != 0 && m_file != nullptr) {
+		fflush(m_file);
+	}
+
+	return result;
+}
+
+void RenX::ExemptionDatabase::exemption_check(RenX::PlayerInfo &player) {
+	expire();
+
+	if (player.steamid != 0) { // SteamID exemption
+		auto itr = m_steamid_index.find(player.steamid);
+		if (itr != m_steamid_index.end()) {
+			for (Entry *entry : itr->second) {
+				player.exemption_flags |= entry->flags;
+			}
+		}
+	}
+
+	if (player.ip32 != 0U) { // IP address exemption
+		m_ip_index.match(player.ip32, [&player](Entry *entry) {
+			player.exemption_flags |= entry->flags;
+		});
+	}
+}
+
+void RenX::ExemptionDatabase::index(Entry *entry) {
+	if (entry->steamid != 0) {
+		m_steamid_index[entry->steamid].push_back(entry);
+	}
+
+	m_ip_index.insert(entry);
+	if (entry->length != std::chrono::seconds::zero()) {
+		m_expiries.emplace(entry->timestamp + entry->length, entry);
+	}
+}
+
+void RenX::ExemptionDatabase::unindex(Entry *entry) {
+	if (entry->steamid != 0) {
+		auto itr = m_steamid_index.find(entry->steamid);
+		if (itr != m_steamid_index.end()) {
+			std::erase(itr->second, entry);
+			if (itr->second.empty()) {
+				m_steamid_index.erase(itr);
 			}
-			else {
-				deactivate(index);
+		}
+	}
+
+	m_ip_index.erase(entry);
+}
+
+bool RenX::ExemptionDatabase::write_flags(Entry *entry) {
+	// Flags are the first field after the entry's length prefix, so they can be overwritten in place
+	FILE *file = get_file();
+	if (file == nullptr) {
+		return false;
+	}
+
+	fsetpos(file, &entry->pos);
+	fseek(file, sizeof(size_t), SEEK_CUR);
+	return fwrite(std::addressof(entry->flags), sizeof(entry->flags), 1, file) == 1;
+}
+
+FILE *RenX::ExemptionDatabase::get_file() {
+	if (m_file == nullptr) {
+		m_file = fopen(m_filename.c_str(), "r+b");
+	}
+
+	return m_file;
+}
+
+/** IPTrie */
+
+uint32_t RenX::ExemptionDatabase::IPTrie::prefix_bit(uint8_t depth) {
+	// Bit which is added to the netmask when the prefix length grows from depth to depth + 1
+	static const auto s_bits = [] {
+		std::array<uint32_t, 32> result{};
+		uint32_t previous = 0;
+		for (uint8_t length = 1; length <= 32; ++length) {
+			uint32_t netmask = length == 32 ? 0xFFFFFFFF : Jupiter_prefix_length_to_netmask(length);
+			result[length - 1] = netmask & ~previous;
+			previous = netmask;
+		}
+		return result;
+	}();
+
+	return s_bits[depth];
+}
+
+uint32_t RenX::ExemptionDatabase::IPTrie::find(const Entry *entry, bool create) {
+	if (m_nodes.empty()) {
+		if (!create) {
+			return UINT32_MAX;
+		}
+		m_nodes.emplace_back();
+	}
+
+	uint32_t node = 0;
+	uint8_t prefix_length = std::min<uint8_t>(entry->prefix_length, 32);
+	for (uint8_t depth = 0; depth != prefix_length; ++depth) {
+		size_t side = (entry->ip & prefix_bit(depth)) != 0 ? 1 : 0;
+		uint32_t child = m_nodes[node].children[side];
+		if (child == 0) {
+			if (!create) {
+				return UINT32_MAX;
 			}
+
+			child = static_cast<uint32_t>(m_nodes.size());
+			m_nodes[node].children[side] = child;
+			m_nodes.emplace_back();
 		}
+
+		node = child;
+	}
+
+	return node;
+}
+
+void RenX::ExemptionDatabase::IPTrie::insert(Entry *entry) {
+	m_nodes[find(entry, true)].entries.push_back(entry);
+}
+
+void RenX::ExemptionDatabase::IPTrie::erase(Entry *entry) {
+	// Nodes are left in place; they're reused if the block is exempted again
+	uint32_t node = find(entry, false);
+	if (node != UINT32_MAX) {
+		std::erase(m_nodes[node].entries, entry);
 	}
 }
 
@@ -173,4 +309,7 @@ bool RenX::ExemptionDatabase::initialize() {
 }
 
 RenX::ExemptionDatabase::~ExemptionDatabase() {
+	if (m_file != nullptr) {
+		fclose(m_file);
+	}
 }
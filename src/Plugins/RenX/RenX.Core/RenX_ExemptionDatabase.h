@@ -21,6 +21,9 @@
 
 #include <cstdint>
 #include <chrono>
+#include <queue>
+#include <unordered_map>
+#include <vector>
 #include "Jupiter/Database.h"
 #include "RenX.h"
 
@@ -152,7 +155,16 @@ namespace RenX
 		bool deactivate(size_t index);
 
 		/**
-		* @brief Checks a player for any relevant ban exemptions, and assigns their exemption_flags
+		* @brief Deactivates every temporary exemption which has expired.
+		*
+		* @param now Current time
+		* @return Number of entries deactivated
+		*/
+		size_t expire(std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+		/**
+		* @brief Checks a player for any relevant ban exemptions, and assigns their exemption_flags.
+		* Active entries are indexed by SteamID and by IP address block, so only matching entries are visited.
 		*
 		* @param player Player to check exemption flags for
 		*/
@@ -183,13 +195,71 @@ namespace RenX
 		~ExemptionDatabase();
 
 	private:
+		/**
+		* @brief Binary trie of IPv4 address blocks; each entry is stored at the node for its prefix.
+		* Bits are walked in the order given by Jupiter_prefix_length_to_netmask(), so that matches are
+		* identical to comparing masked addresses.
+		*/
+		class IPTrie
+		{
+		public:
+			void insert(Entry *entry);
+			void erase(Entry *entry);
+
+			template<typename CallbackT>
+			void match(uint32_t ip, CallbackT&& callback) const {
+				uint32_t node = 0;
+				for (uint8_t depth = 0; node < m_nodes.size(); ++depth) {
+					for (Entry *entry : m_nodes[node].entries) {
+						callback(entry);
+					}
+
+					if (depth == 32) {
+						break;
+					}
+
+					node = m_nodes[node].children[(ip & prefix_bit(depth)) != 0 ? 1 : 0];
+					if (node == 0) {
+						break;
+					}
+				}
+			}
+
+		private:
+			struct Node
+			{
+				uint32_t children[2]{}; /** Index of each child node; 0 (the root) if there is no child */
+				std::vector<Entry*> entries;
+			};
+
+			static uint32_t prefix_bit(uint8_t depth);
+			uint32_t find(const Entry *entry, bool create);
+
+			std::vector<Node> m_nodes;
+		};
+
+		void index(Entry *entry);
+		void unindex(Entry *entry);
+		bool write_flags(Entry *entry);
+		FILE *get_file();
+
+		using Expiry = std::pair<std::chrono::system_clock::time_point, Entry*>;
+		struct ExpiryOrder
+		{
+			bool operator()(const Expiry &lhs, const Expiry &rhs) const { return lhs.first > rhs.first; }
+		};
+
 		/** Database version */
 		const uint8_t m_write_version = 0U;
 		uint8_t m_read_version = m_write_version;
 		fpos_t m_eof;
 
 		std::string m_filename;
+		FILE *m_file = nullptr; /** Kept open for appending entries and updating flags in place */
 		std::vector<std::unique_ptr<RenX::ExemptionDatabase::Entry>> m_entries;
+		std::unordered_map<uint64_t, std::vector<Entry*>> m_steamid_index; /** Active entries with a SteamID */
+		IPTrie m_ip_index; /** Active entries */
+		std::priority_queue<Expiry, std::vector<Expiry>, ExpiryOrder> m_expiries; /** Active temporary entries, soonest first */
 	};
 
 	RENX_API extern RenX::ExemptionDatabase *exemptionDatabase;
@@ -25,6 +25,8 @@
 #include "RenX_Core.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
+#include "RenX_RCONCodec.h"
+#include "RenX_Symbols.h"
 
 using namespace std::literals;
 
@@ -489,6 +491,15 @@ std::string_view translateCharacter(std::string_view object)
 
 // TODO: Use a map...
 std::string_view RenX::translateName(std::string_view obj) {
+	// Names reported by servers are interned as they're parsed, so their translations are usually cached
+	RenX::Symbol symbol;
+	if (RenX::symbols->find(obj, symbol))
+		return RenX::symbols->translated(symbol);
+
+	return RenX::translateNameUncached(obj);
+}
+
+std::string_view RenX::translateNameUncached(std::string_view obj) {
 	if (obj.empty())
 		return ""sv;
 
@@ -831,6 +842,8 @@ std::string_view RenX::translateWinTypePlain(RenX::WinType winType)
 
 void RenX::initTranslations(Jupiter::Config &translationsFile)
 {
+	RenX::symbols->clearTranslations();
+
 	NodColor = translationsFile["TeamColor"sv].get("Nod"sv, "04"sv);
 	GDIColor = translationsFile["TeamColor"sv].get("GDI"sv, "08"sv);
 	OtherColor = translationsFile["TeamColor"sv].get("Other"sv, "14"sv);
@@ -888,96 +901,28 @@ std::string RenX::default_uuid_func(RenX::PlayerInfo &player)
 
 double RenX::getKillDeathRatio(const RenX::PlayerInfo &player, bool includeSuicides)
 {
-	double deaths = player.deaths;
+	double deaths = player.deaths();
 
 	if (includeSuicides == false)
-		deaths -= player.suicides;
+		deaths -= player.suicides();
 
 	if (deaths == 0)
 		deaths = 1;
 
-	return static_cast<double>(player.kills) / deaths;
+	return static_cast<double>(player.kills()) / deaths;
 }
 
 double RenX::getHeadshotKillRatio(const RenX::PlayerInfo &player)
 {
-	if (player.kills == 0)
+	if (player.kills() == 0)
 		return 0;
 
-	return static_cast<double>(player.headshots) / static_cast<double>(player.kills);
+	return static_cast<double>(player.headshots()) / static_cast<double>(player.kills());
 }
 
 std::string RenX::escapifyRCON(std::string_view str) {
-	const char *ptr = str.data();
-	size_t length = str.size();
 	std::string result;
 	result.reserve(str.size() + 32);
-	uint16_t value;
-
-	while (length != 0)
-	{
-		if ((*ptr & 0x80) != 0) // UTF-8 sequence
-		{
-			if (length < 2)
-				break;
-
-			if ((*ptr & 0x40) != 0) // validity check
-			{
-				// get codepoint value
-				if ((*ptr & 0x20) != 0)
-				{
-					if (length < 3)
-						break;
-
-					if ((*ptr & 0x10) != 0) // This is a 4 byte sequence, which we can not fit into a 16-bit codepoint. ignore it.
-					{
-						if (length < 4)
-							break;
-
-						ptr += 4;
-						length -= 4;
-						continue;
-					}
-					else
-					{
-						// this is a 3 byte sequence
-						value = (*ptr & 0x0F) << 12;
-						value += (*++ptr & 0x3F) << 6;
-						value += *++ptr & 0x3F;
-
-						length -= 3;
-					}
-				}
-				else
-				{
-					// This is a 2 byte sequence
-					value = (*ptr & 0x1F) << 6;
-					value += *++ptr & 0x3F;
-
-					length -= 2;
-				}
-
-				// write escape sequence
-				result += '\\';
-				result += 'u';
-				result += Jupiter_asHex_upper(value >> 8);
-				result += Jupiter_asHex_upper(value & 0x00FF);
-			}
-			// else // This is an invalid 1 byte sequence
-		}
-		else if (*ptr == '\\') // backslash, which is used for escape sequencing
-		{
-			result += '\\';
-			result += '\\';
-			--length;
-		}
-		else // an ordinary character
-		{
-			result += *ptr;
-			--length;
-		}
-
-		++ptr;
-	}
+	RenX::escapifyRCON(str, result);
 	return result;
 }
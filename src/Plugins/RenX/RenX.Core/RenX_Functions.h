@@ -102,6 +102,15 @@ namespace RenX
 	*/
 	RENX_API std::string_view translateName(std::string_view object);
 
+	/**
+	* @brief Translates a preset's name into a real name, without consulting or filling the symbol table's cache.
+	* Note: The result may view part of object.
+	*
+	* @param object Preset to translate.
+	* @return Translated name of the preset.
+	*/
+	RENX_API std::string_view translateNameUncached(std::string_view object);
+
 	/**
 	* @brief Translates a WinType into a human-readable string.
 	* Example:
@@ -182,6 +191,7 @@ namespace RenX
 
 	/**
 	* @brief Escapifies a string so that it can be safely transmitted over RCON.
+	* See RenX_RCONCodec.h to escapify into an existing buffer instead.
 	*
 	* @param str String to escapify
 	* @return Escapified version of str.
@@ -18,6 +18,7 @@
 
 #include "RenX_GameCommand.h"
 #include "RenX_Server.h"
+#include "RenX_PlayerInfo.h"
 
 using namespace std::literals;
 
@@ -42,14 +43,7 @@ RenX::GameCommand::~GameCommand() {
 	RenX::Core *core = RenX::getCore();
 	for (auto itr = RenX::GameMasterCommandList.begin(); itr != RenX::GameMasterCommandList.end(); ++itr) {
 		if (*itr == this) {
-			RenX::Server *server;
-			for (size_t server_index = 0; server_index != core->getServerCount(); ++server_index) {
-				server = core->getServer(server_index);
-				if (server != nullptr) {
-					server->removeCommand(this->getTrigger());
-				}
-			}
-
+			core->removeCommand(this);
 			RenX::GameMasterCommandList.erase(itr);
 			break;
 		}
@@ -64,6 +58,44 @@ void RenX::GameCommand::setAccessLevel(int accessLevel) {
 	RenX::GameCommand::access = accessLevel;
 }
 
+AsyncCommands::JobId RenX::GameCommand::submitAsync(RenX::Server &source, const RenX::PlayerInfo &player, AsyncCommands::Work work, const void *owner) {
+	std::string user = string_printf("RenX/%llu/%d", static_cast<unsigned long long>(source.getID()), player.id);
+	auto deliver = [server_id = source.getID(), player_id = player.id, player_name = player.name](Jupiter::GenericCommand::ResponseLine *response) {
+		RenX::Server *server = RenX::getCore()->getServerByID(server_id);
+		RenX::PlayerInfo *target = server != nullptr ? server->getPlayer(player_id) : nullptr;
+
+		// Player IDs may be reused after a map change; make sure it's still the same player
+		if (target != nullptr && target->name != player_name) {
+			target = nullptr;
+		}
+
+		while (response != nullptr) {
+			if (target != nullptr) {
+				switch (response->type) {
+				case Jupiter::GenericCommand::DisplayType::PublicSuccess:
+				case Jupiter::GenericCommand::DisplayType::PublicError:
+					server->sendMessage(response->response);
+					break;
+				default:
+					server->sendMessage(*target, response->response);
+					break;
+				}
+			}
+
+			Jupiter::GenericCommand::ResponseLine *next = response->next;
+			delete response;
+			response = next;
+		}
+	};
+
+	AsyncCommands::JobId result = asyncCommands->submit(user, nullptr, std::move(work), std::move(deliver), owner);
+	if (result == 0) {
+		source.sendMessage(player, "Error: Too many commands in progress."sv);
+	}
+
+	return result;
+}
+
 // Basic Game Command
 
 RenX::BasicGameCommand::BasicGameCommand() : RenX::GameCommand(nullptr) {
@@ -25,6 +25,7 @@
  */
 
 #include "Jupiter/Command.h"
+#include "AsyncCommands.h"
 #include "RenX.h"
 #include "RenX_Core.h" // getCore().
 
@@ -85,6 +86,19 @@ namespace RenX
 		*/
 		virtual GameCommand *copy() = 0;
 
+		/**
+		* @brief Runs work on the AsyncCommands pool on behalf of a player, and sends the response lines to that player.
+		* The response is addressed by server ID and player ID, and is dropped if either the server or the player is gone
+		* by the time it is delivered. Public response lines are sent to the whole server; all others are sent privately.
+		*
+		* @param source Server where the player is located
+		* @param player Player who executed the command
+		* @param work Work to run on a worker thread
+		* @param owner Object identifying the module which the work belongs to, for AsyncCommands::cancelAll()
+		* @return ID of the queued job, or 0 if the player already has too many jobs pending (in which case the player is told so).
+		*/
+		static AsyncCommands::JobId submitAsync(RenX::Server &source, const RenX::PlayerInfo &player, AsyncCommands::Work work, const void *owner);
+
 		/**
 		* @brief Same as the Default constructor, except that the command is not added to the master command list.
 		*/
@@ -16,6 +16,7 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include <algorithm>
 #include <iostream>
 #include "jessilib/unicode.hpp"
 #include "Jupiter/DataBuffer.h"
@@ -24,6 +25,8 @@
 #include "RenX_PlayerInfo.h"
 #include "RenX_BanDatabase.h"
 
+using namespace std::literals;
+
 RenX::LadderDatabase *RenX::default_ladder_database = nullptr;
 std::vector<RenX::LadderDatabase*> g_ladder_databases;
 std::vector<RenX::LadderDatabase*>& RenX::ladder_databases = g_ladder_databases;
@@ -41,6 +44,10 @@ RenX::LadderDatabase::LadderDatabase(std::string_view in_name) : LadderDatabase(
 }
 
 RenX::LadderDatabase::~LadderDatabase() {
+	if (m_updateMetric != nullptr) {
+		metricsRegistry->release(*m_updateMetric);
+	}
+
 	while (m_head != nullptr) {
 		m_end = m_head;
 		m_head = m_head->next;
@@ -160,6 +167,8 @@ void RenX::LadderDatabase::process_data(Jupiter::DataBuffer &buffer, FILE *file,
 	}
 
 	entry->rank = ++m_entries;
+	index_name(entry);
+	++m_revision;
 }
 
 void RenX::LadderDatabase::process_header(FILE *file) {
@@ -234,70 +243,207 @@ std::pair<RenX::LadderDatabase::Entry *, size_t> RenX::LadderDatabase::getPlayer
 }
 
 RenX::LadderDatabase::Entry *RenX::LadderDatabase::getPlayerEntryByPartName(std::string_view name) const {
-	for (Entry *itr = m_head; itr != nullptr; itr = itr->next) {
-		if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-			return itr;
-		}
-	}
-
-	return nullptr;
+	return getPlayerEntryAndIndexByPartName(name).first;
 }
 
 std::pair<RenX::LadderDatabase::Entry *, size_t> RenX::LadderDatabase::getPlayerEntryAndIndexByPartName(std::string_view name) const {
-	size_t index = 0;
-	for (Entry *itr = m_head; itr != nullptr; itr = itr->next, ++index) {
-		if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-			return std::pair<RenX::LadderDatabase::Entry*, size_t>(itr, index);
+	Entry *result = nullptr;
+	for (const auto& match : match_names(name)) {
+		if (result == nullptr || match.entry->rank < result->rank) {
+			result = match.entry;
 		}
 	}
 
-	return std::pair<Entry *, size_t>(nullptr, SIZE_MAX);
+	if (result == nullptr) {
+		return std::pair<Entry *, size_t>(nullptr, SIZE_MAX);
+	}
+
+	return std::pair<Entry *, size_t>(result, result->rank - 1);
 }
 
 std::forward_list<RenX::LadderDatabase::Entry> RenX::LadderDatabase::getPlayerEntriesByPartName(std::string_view name, size_t max) const {
 	std::forward_list<Entry> list;
-	if (max == 0) {
-		for (Entry *itr = m_head; itr != nullptr; itr = itr->next) {
-			if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-				list.emplace_front(*itr);
-			}
-		}
-	}
-	else {
-		for (Entry* itr = m_head; itr != nullptr; itr = itr->next) {
-			if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-				list.emplace_front(*itr);
-				if (--max == 0) {
-					return list;
-				}
-			}
-		}
+	SearchResults results = searchPlayerEntriesByPartName(name, 0, max);
+	for (auto itr = results.entries.rbegin(); itr != results.entries.rend(); ++itr) {
+		list.emplace_front(*itr->first);
 	}
+
 	return list;
 }
 
 std::forward_list<std::pair<RenX::LadderDatabase::Entry, size_t>> RenX::LadderDatabase::getPlayerEntriesAndIndexByPartName(std::string_view name, size_t max) const {
 	std::forward_list<std::pair<Entry, size_t>> list;
-	size_t index = 0;
-	if (max == 0)
-	{
-		for (Entry *itr = m_head; itr != nullptr; itr = itr->next, ++index) {
-			if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-				list.emplace_front(*itr, index);
+	SearchResults results = searchPlayerEntriesByPartName(name, 0, max);
+	for (auto itr = results.entries.rbegin(); itr != results.entries.rend(); ++itr) {
+		list.emplace_front(*itr->first, itr->second);
+	}
+
+	return list;
+}
+
+RenX::LadderDatabase::SearchResults RenX::LadderDatabase::searchPlayerEntriesByPartName(std::string_view name, size_t start, size_t count) const {
+	SearchResults result;
+	std::vector<NameMatch> matches = match_names(name);
+	result.total = matches.size();
+	if (start >= matches.size()) {
+		return result;
+	}
+
+	size_t end = matches.size();
+	if (count != 0 && count < end - start) {
+		end = start + count;
+	}
+
+	// Only the requested page and the matches before it need to be ordered
+	std::partial_sort(matches.begin(), matches.begin() + end, matches.end(), [](const NameMatch& lhs, const NameMatch& rhs) {
+		if (lhs.quality != rhs.quality) {
+			return lhs.quality < rhs.quality;
+		}
+
+		return lhs.entry->rank < rhs.entry->rank;
+	});
+
+	result.entries.reserve(end - start);
+	for (size_t index = start; index != end; ++index) {
+		result.entries.emplace_back(matches[index].entry, matches[index].entry->rank - 1);
+	}
+
+	return result;
+}
+
+void RenX::LadderDatabase::setEntryName(Entry *entry, std::string_view name) {
+	if (entry->most_recent_name == name) {
+		return;
+	}
+
+	unindex_name(entry);
+	entry->most_recent_name = name;
+	index_name(entry);
+	++m_revision;
+}
+
+/** Name index */
+
+constexpr size_t ladder_name_gram_length = 3;
+
+static bool is_ladder_name_foldable(std::string_view in_name) {
+	return std::all_of(in_name.begin(), in_name.end(), [](char chr) {
+		return static_cast<unsigned char>(chr) < 0x80;
+	});
+}
+
+static uint32_t fold_ladder_name_char(char chr) {
+	if (chr >= 'A' && chr <= 'Z') {
+		chr += 'a' - 'A';
+	}
+
+	return static_cast<unsigned char>(chr);
+}
+
+/** Fetches the distinct case-folded trigrams of an ASCII name */
+static std::vector<uint32_t> ladder_name_grams(std::string_view in_name) {
+	std::vector<uint32_t> result;
+	if (in_name.size() < ladder_name_gram_length) {
+		return result;
+	}
+
+	result.reserve(in_name.size() - ladder_name_gram_length + 1);
+	for (size_t index = 0; index + ladder_name_gram_length <= in_name.size(); ++index) {
+		result.push_back(fold_ladder_name_char(in_name[index]) << 16
+			| fold_ladder_name_char(in_name[index + 1]) << 8
+			| fold_ladder_name_char(in_name[index + 2]));
+	}
+
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+void RenX::LadderDatabase::index_name(Entry *entry) {
+	if (!is_ladder_name_foldable(entry->most_recent_name)) {
+		m_unindexed_names.push_back(entry);
+		return;
+	}
+
+	for (uint32_t gram : ladder_name_grams(entry->most_recent_name)) {
+		m_name_index[gram].push_back(entry);
+	}
+}
+
+void RenX::LadderDatabase::unindex_name(Entry *entry) {
+	auto remove_entry = [entry](std::vector<Entry *>& entries) {
+		auto itr = std::find(entries.begin(), entries.end(), entry);
+		if (itr != entries.end()) {
+			*itr = entries.back();
+			entries.pop_back();
+		}
+	};
+
+	if (!is_ladder_name_foldable(entry->most_recent_name)) {
+		remove_entry(m_unindexed_names);
+		return;
+	}
+
+	for (uint32_t gram : ladder_name_grams(entry->most_recent_name)) {
+		auto itr = m_name_index.find(gram);
+		if (itr != m_name_index.end()) {
+			remove_entry(itr->second);
+			if (itr->second.empty()) {
+				m_name_index.erase(itr);
 			}
 		}
 	}
-	else {
-		for (Entry* itr = m_head; itr != nullptr; itr = itr->next, ++index) {
-			if (jessilib::findi(itr->most_recent_name, name) != std::string::npos) {
-				list.emplace_front(*itr, index);
-				if (--max) {
-					return list;
-				}
+}
+
+std::vector<RenX::LadderDatabase::NameMatch> RenX::LadderDatabase::match_names(std::string_view name) const {
+	std::vector<NameMatch> result;
+	auto match = [&result, name](Entry *entry) {
+		size_t position = jessilib::findi(entry->most_recent_name, name);
+		if (position != std::string::npos) {
+			uint8_t quality = 2;
+			if (position == 0) {
+				quality = entry->most_recent_name.size() == name.size() ? 0 : 1;
 			}
+
+			result.push_back({ entry, quality });
 		}
+	};
+
+	std::vector<uint32_t> grams = ladder_name_grams(name);
+	if (grams.empty() || !is_ladder_name_foldable(name)) {
+		// The index can't narrow this search down; check every entry
+		for (Entry *itr = m_head; itr != nullptr; itr = itr->next) {
+			match(itr);
+		}
+
+		return result;
 	}
-	return list;
+
+	// Every indexed match has every trigram of the name, so only the entries with the rarest trigram need checking
+	const std::vector<Entry *> *candidates = nullptr;
+	for (uint32_t gram : grams) {
+		auto itr = m_name_index.find(gram);
+		if (itr == m_name_index.end()) {
+			candidates = nullptr;
+			break;
+		}
+
+		if (candidates == nullptr || itr->second.size() < candidates->size()) {
+			candidates = &itr->second;
+		}
+	}
+
+	if (candidates != nullptr) {
+		for (Entry *entry : *candidates) {
+			match(entry);
+		}
+	}
+
+	for (Entry *entry : m_unindexed_names) {
+		match(entry);
+	}
+
+	return result;
 }
 
 RenX::LadderDatabase::Entry *RenX::LadderDatabase::getPlayerEntryByIndex(size_t index) const {
@@ -317,8 +463,15 @@ std::chrono::steady_clock::time_point RenX::LadderDatabase::getLastSortTime() co
 	return m_last_sort;
 }
 
+uint64_t RenX::LadderDatabase::getRevision() const {
+	return m_revision;
+}
+
 void RenX::LadderDatabase::append(Entry *entry) {
 	++m_entries;
+	++m_revision;
+	entry->rank = m_entries;
+	index_name(entry);
 	if (m_head == nullptr) {
 		m_head = entry;
 		m_end = m_head;
@@ -478,7 +631,9 @@ void RenX::LadderDatabase::sort_entries() {
 }
 
 void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamType &team) {
-	if (server.players.size() != server.getBotCount()) {
+	if (server.getHumanCount() != 0) {
+		std::chrono::steady_clock::time_point update_start = std::chrono::steady_clock::now();
+
 		// call the PreUpdateLadder event
 		if (this->OnPreUpdateLadder != nullptr) {
 			this->OnPreUpdateLadder(*this, server, team);
@@ -495,20 +650,20 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 					entry->steam_id = player->steamid;
 				}
 
-				entry->total_score += static_cast<uint64_t>(player->score);
+				entry->total_score += static_cast<uint64_t>(player->score());
 
-				entry->total_kills += player->kills;
-				entry->total_deaths += player->deaths;
-				entry->total_headshot_kills += player->headshots;
-				entry->total_vehicle_kills += player->vehicleKills;
-				entry->total_building_kills += player->buildingKills;
-				entry->total_defence_kills += player->defenceKills;
-				entry->total_captures += player->captures;
+				entry->total_kills += player->kills();
+				entry->total_deaths += player->deaths();
+				entry->total_headshot_kills += player->headshots();
+				entry->total_vehicle_kills += player->vehicleKills();
+				entry->total_building_kills += player->buildingKills();
+				entry->total_defence_kills += player->defenceKills();
+				entry->total_captures += player->captures();
 				entry->total_game_time += static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(server.getGameTime(*player)).count());
-				entry->total_beacon_placements += player->beaconPlacements;
-				entry->total_beacon_disarms += player->beaconDisarms;
-				entry->total_proxy_placements += player->proxy_placements;
-				entry->total_proxy_disarms += player->proxy_disarms;
+				entry->total_beacon_placements += player->beaconPlacements();
+				entry->total_beacon_disarms += player->beaconDisarms();
+				entry->total_proxy_placements += player->proxy_placements();
+				entry->total_proxy_disarms += player->proxy_disarms();
 
 				++entry->total_games;
 				switch (player->team) {
@@ -520,17 +675,17 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 						++entry->total_gdi_ties;
 
 					entry->total_gdi_game_time += static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(server.getGameTime(*player)).count());
-					entry->total_gdi_score += static_cast<uint64_t>(player->score);
-					entry->total_gdi_beacon_placements += player->beaconPlacements;
-					entry->total_gdi_beacon_disarms += player->beaconDisarms;
-					entry->total_gdi_proxy_placements += player->proxy_placements;
-					entry->total_gdi_proxy_disarms += player->proxy_disarms;
-					entry->total_gdi_kills += player->kills;
-					entry->total_gdi_deaths += player->deaths;
-					entry->total_gdi_vehicle_kills += player->vehicleKills;
-					entry->total_gdi_defence_kills += player->defenceKills;
-					entry->total_gdi_building_kills += player->buildingKills;
-					entry->total_gdi_headshots += player->headshots;
+					entry->total_gdi_score += static_cast<uint64_t>(player->score());
+					entry->total_gdi_beacon_placements += player->beaconPlacements();
+					entry->total_gdi_beacon_disarms += player->beaconDisarms();
+					entry->total_gdi_proxy_placements += player->proxy_placements();
+					entry->total_gdi_proxy_disarms += player->proxy_disarms();
+					entry->total_gdi_kills += player->kills();
+					entry->total_gdi_deaths += player->deaths();
+					entry->total_gdi_vehicle_kills += player->vehicleKills();
+					entry->total_gdi_defence_kills += player->defenceKills();
+					entry->total_gdi_building_kills += player->buildingKills();
+					entry->total_gdi_headshots += player->headshots();
 					break;
 				case RenX::TeamType::Nod:
 					++entry->total_nod_games;
@@ -540,17 +695,17 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 						++entry->total_nod_ties;
 
 					entry->total_nod_game_time += static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(server.getGameTime(*player)).count());
-					entry->total_nod_score += static_cast<uint64_t>(player->score);
-					entry->total_nod_beacon_placements += player->beaconPlacements;
-					entry->total_nod_beacon_disarms += player->beaconDisarms;
-					entry->total_nod_proxy_placements += player->proxy_placements;
-					entry->total_nod_proxy_disarms += player->proxy_disarms;
-					entry->total_nod_kills += player->kills;
-					entry->total_nod_deaths += player->deaths;
-					entry->total_nod_vehicle_kills += player->vehicleKills;
-					entry->total_nod_defence_kills += player->defenceKills;
-					entry->total_nod_building_kills += player->buildingKills;
-					entry->total_nod_headshots += player->headshots;
+					entry->total_nod_score += static_cast<uint64_t>(player->score());
+					entry->total_nod_beacon_placements += player->beaconPlacements();
+					entry->total_nod_beacon_disarms += player->beaconDisarms();
+					entry->total_nod_proxy_placements += player->proxy_placements();
+					entry->total_nod_proxy_disarms += player->proxy_disarms();
+					entry->total_nod_kills += player->kills();
+					entry->total_nod_deaths += player->deaths();
+					entry->total_nod_vehicle_kills += player->vehicleKills();
+					entry->total_nod_defence_kills += player->defenceKills();
+					entry->total_nod_building_kills += player->buildingKills();
+					entry->total_nod_headshots += player->headshots();
 					break;
 				default:
 					if (player->team == team)
@@ -564,29 +719,36 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 					}
 				};
 
-				set_if_greater(entry->top_score, static_cast<uint32_t>(player->score));
-				set_if_greater(entry->top_kills, player->kills);
-				set_if_greater(entry->most_deaths, player->deaths);
-				set_if_greater(entry->top_headshot_kills, player->headshots);
-				set_if_greater(entry->top_vehicle_kills, player->vehicleKills);
-				set_if_greater(entry->top_building_kills, player->buildingKills);
-				set_if_greater(entry->top_defence_kills, player->defenceKills);
-				set_if_greater(entry->top_captures, player->captures);
+				set_if_greater(entry->top_score, static_cast<uint32_t>(player->score()));
+				set_if_greater(entry->top_kills, player->kills());
+				set_if_greater(entry->most_deaths, player->deaths());
+				set_if_greater(entry->top_headshot_kills, player->headshots());
+				set_if_greater(entry->top_vehicle_kills, player->vehicleKills());
+				set_if_greater(entry->top_building_kills, player->buildingKills());
+				set_if_greater(entry->top_defence_kills, player->defenceKills());
+				set_if_greater(entry->top_captures, player->captures());
 				set_if_greater(entry->top_game_time, static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(server.getGameTime(*player)).count()));
-				set_if_greater(entry->top_beacon_placements, player->beaconPlacements);
-				set_if_greater(entry->top_beacon_disarms, player->beaconDisarms);
-				set_if_greater(entry->top_proxy_placements, player->proxy_placements);
-				set_if_greater(entry->top_proxy_disarms, player->proxy_disarms);
+				set_if_greater(entry->top_beacon_placements, player->beaconPlacements());
+				set_if_greater(entry->top_beacon_disarms, player->beaconDisarms());
+				set_if_greater(entry->top_proxy_placements, player->proxy_placements());
+				set_if_greater(entry->top_proxy_disarms, player->proxy_disarms());
 
 				entry->most_recent_ip = player->ip32;
 				entry->last_game = time(nullptr);
-				entry->most_recent_name = player->name;
+				setEntryName(entry, player->name);
 			}
 		}
 
 		// sort new stats
 		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
 		sort_entries();
+		++m_revision;
+
+		// keep indexes current for searches, even if the write below fails
+		size_t rank = 0;
+		for (Entry *itr = m_head; itr != nullptr; itr = itr->next) {
+			itr->rank = ++rank;
+		}
 		std::chrono::steady_clock::duration sort_duration = std::chrono::steady_clock::now() - start_time;
 
 		// write new stats
@@ -594,6 +756,12 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 		write(this->getFilename());
 		std::chrono::steady_clock::duration write_duration = std::chrono::steady_clock::now() - start_time;
 
+		if (m_updateMetric == nullptr) {
+			m_updateMetric = &metricsRegistry->histogram("renx_ladder_update_seconds"sv, "Time taken to update, sort, and write a ladder database"sv,
+				{ 0.001, 0.005, 0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0 }, MetricsRegistry::label("database"sv, m_name));
+		}
+		m_updateMetric->observe(std::chrono::steady_clock::now() - update_start);
+
 		if (m_output_times)
 		{
 			std::string str = string_printf("Ladder: %zu entries sorted in %f seconds; Database written in %f seconds." ENDL,
@@ -608,6 +776,7 @@ void RenX::LadderDatabase::updateLadder(RenX::Server &server, const RenX::TeamTy
 
 void RenX::LadderDatabase::erase() {
 	if (m_head != nullptr) {
+		++m_revision;
 		m_entries = 0;
 		while (m_head->next != nullptr) {
 			m_head = m_head->next;
@@ -617,6 +786,8 @@ void RenX::LadderDatabase::erase() {
 		delete m_head;
 		m_head = nullptr;
 		m_end = nullptr;
+		m_name_index.clear();
+		m_unindexed_names.clear();
 	}
 }
 
@@ -626,6 +797,12 @@ std::string_view RenX::LadderDatabase::getName() const {
 
 void RenX::LadderDatabase::setName(std::string_view in_name) {
 	m_name = in_name;
+
+	// Relabel on next update
+	if (m_updateMetric != nullptr) {
+		metricsRegistry->release(*m_updateMetric);
+		m_updateMetric = nullptr;
+	}
 }
 
 bool RenX::LadderDatabase::getOutputTimes() const {
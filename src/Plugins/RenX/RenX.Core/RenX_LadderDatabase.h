@@ -21,7 +21,10 @@
 
 #include <chrono>
 #include <forward_list>
+#include <unordered_map>
+#include <vector>
 #include "Jupiter/Database.h"
+#include "Metrics.h"
 #include "RenX.h"
 
 /** DLL Linkage Nagging */
@@ -127,6 +130,36 @@ namespace RenX {
 		std::forward_list<Entry> getPlayerEntriesByPartName(std::string_view name, size_t max) const;
 		std::forward_list<std::pair<Entry, size_t>> getPlayerEntriesAndIndexByPartName(std::string_view name, size_t max) const;
 
+		/**
+		* @brief A page of name search results.
+		*/
+		struct SearchResults
+		{
+			std::vector<std::pair<Entry *, size_t>> entries; /** Matching entries and their indexes, best match first */
+			size_t total = 0; /** Number of matches across all pages */
+		};
+
+		/**
+		* @brief Fetches a page of entries matching a part name, ranked by relevance.
+		* Exact names rank first, followed by names starting with the part name, followed by all other matches;
+		* ties are ranked by ladder index.
+		*
+		* @param name Part of name to search for
+		* @param start Number of ranked matches to skip
+		* @param count Maximum number of matches to return, or 0 for no limit
+		* @return Page of matching entries
+		*/
+		SearchResults searchPlayerEntriesByPartName(std::string_view name, size_t start, size_t count) const;
+
+		/**
+		* @brief Sets the most recent name of an entry, keeping the name index up to date.
+		* Entries which are in the database must always be renamed through this.
+		*
+		* @param entry Entry to rename
+		* @param name New name of the entry
+		*/
+		void setEntryName(Entry *entry, std::string_view name);
+
 		/**
 		* @brief Fetches a ladder entry at a specified index
 		*
@@ -147,6 +180,14 @@ namespace RenX {
 		*/
 		std::chrono::steady_clock::time_point getLastSortTime() const;
 
+		/**
+		* @brief Fetches a counter which changes whenever the contents of this database change.
+		* Useful for invalidating anything generated from the database.
+		*
+		* @return Revision of the database
+		*/
+		uint64_t getRevision() const;
+
 		/**
 		* @brief Places a ladder entry at the end of the list, regardless of order
 		* Note: This does not copy data from the pointer -- the pointer is added to the list.
@@ -231,8 +272,24 @@ namespace RenX {
 		std::string m_name;
 		std::chrono::steady_clock::time_point m_last_sort = std::chrono::steady_clock::now();
 		size_t m_entries = 0;
+		uint64_t m_revision = 0;
 		Entry* m_head = nullptr;
 		Entry* m_end = nullptr;
+		MetricsRegistry::Histogram* m_updateMetric = nullptr; /** Acquired on first update, labelled by m_name */
+
+		struct NameMatch
+		{
+			Entry *entry;
+			uint8_t quality; /** 0 for exact, 1 for prefix, 2 for any other match */
+		};
+
+		void index_name(Entry *entry);
+		void unindex_name(Entry *entry);
+		std::vector<NameMatch> match_names(std::string_view name) const;
+
+		/** Name index; maps each case-folded trigram to the entries with it in their names */
+		std::unordered_map<uint32_t, std::vector<Entry *>> m_name_index;
+		std::vector<Entry *> m_unindexed_names; /** Entries with non-ASCII names, which can't be folded into trigrams; always scanned */
 	};
 
 	RENX_API extern RenX::LadderDatabase *default_ladder_database;
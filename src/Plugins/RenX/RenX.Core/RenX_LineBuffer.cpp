@@ -0,0 +1,37 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include "RenX_LineBuffer.h"
+
+void RenX::LineBuffer::append(std::string_view in_data) {
+	m_buffer.append(in_data);
+}
+
+void RenX::LineBuffer::clear() {
+	// Lines may still be referenced by a consumeLines() callback; leave the memory in place until compact()
+	m_begin = m_buffer.size();
+}
+
+void RenX::LineBuffer::compact() {
+	if (m_begin == 0) {
+		return;
+	}
+
+	m_buffer.erase(0, m_begin);
+	m_begin = 0;
+}
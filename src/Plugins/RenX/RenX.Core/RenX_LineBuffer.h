@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_LINEBUFFER_H_HEADER
+#define _RENX_LINEBUFFER_H_HEADER
+
+/**
+ * @file RenX_LineBuffer.h
+ * @brief Provides newline framing for data received on RCON sockets.
+ */
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/**
+	* @brief Reusable buffer which splits received data into newline-terminated lines.
+	* Complete lines are handed out as views into the buffer; only a trailing partial line is kept between reads.
+	*/
+	class RENX_API LineBuffer
+	{
+	public:
+		/**
+		* @brief Appends received data to the end of the buffer.
+		*
+		* @param in_data Data to append
+		*/
+		void append(std::string_view in_data);
+
+		/**
+		* @brief Passes each complete line in the buffer to a callback, and discards the consumed lines.
+		* Lines are passed without their terminating newline, and are only valid for the duration of the callback.
+		* The callback may safely call clear().
+		*
+		* @param in_callback Function to call with each std::string_view line
+		*/
+		template<typename CallbackT> void consumeLines(CallbackT&& in_callback) {
+			while (m_begin < m_buffer.size()) {
+				const char* begin = m_buffer.data() + m_begin;
+				const char* end = static_cast<const char*>(std::memchr(begin, '\n', m_buffer.size() - m_begin));
+				if (end == nullptr) {
+					break;
+				}
+
+				// Advance past the line before processing it, in case the callback clears the buffer
+				m_begin += end - begin + 1;
+				in_callback(std::string_view{ begin, static_cast<size_t>(end - begin) });
+			}
+
+			compact();
+		}
+
+		/**
+		* @brief Discards all buffered data, including any partial line.
+		*/
+		void clear();
+
+		/**
+		* @brief Fetches the number of buffered bytes which are not yet part of a complete line.
+		*
+		* @return Number of pending bytes
+		*/
+		size_t pending() const { return m_buffer.size() - m_begin; }
+
+	private:
+		/** Moves the partial line to the front of the buffer, retaining the allocation */
+		void compact();
+
+		std::string m_buffer;
+		size_t m_begin = 0; /** Offset of the first unconsumed byte */
+	};
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_LINEBUFFER_H_HEADER
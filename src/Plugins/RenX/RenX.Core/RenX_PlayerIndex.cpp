@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include "RenX_PlayerIndex.h"
+#include "RenX_PlayerInfo.h"
+#include "RenX_Server.h"
+
+RenX::PlayerIndex g_playerIndex;
+RenX::PlayerIndex *RenX::playerIndex = &g_playerIndex;
+
+template<typename MapT, typename KeyT>
+void erase_location(MapT& in_map, const KeyT& in_key, const RenX::PlayerInfo* in_player) {
+	auto range = in_map.equal_range(in_key);
+	for (auto itr = range.first; itr != range.second; ++itr) {
+		if (itr->second.player == in_player) {
+			in_map.erase(itr);
+			return;
+		}
+	}
+}
+
+template<typename MapT, typename KeyT>
+RenX::PlayerInfo* find_on_server(const MapT& in_map, const KeyT& in_key, const RenX::Server& in_server) {
+	auto range = in_map.equal_range(in_key);
+	for (auto itr = range.first; itr != range.second; ++itr) {
+		if (itr->second.server == &in_server) {
+			return itr->second.player;
+		}
+	}
+
+	return nullptr;
+}
+
+void RenX::PlayerIndex::update(RenX::Server& in_server, RenX::PlayerInfo& in_player) {
+	auto itr = m_records.find(&in_player);
+	if (itr != m_records.end()) {
+		Record& record = itr->second;
+		if (record.server == &in_server
+			&& record.hwid == in_player.hwid
+			&& record.ip32 == in_player.ip32
+			&& record.steamid == in_player.steamid) {
+			// Nothing changed
+			return;
+		}
+
+		unindex(in_player, record);
+		record.server = &in_server;
+		record.hwid = in_player.hwid;
+		record.ip32 = in_player.ip32;
+		record.steamid = in_player.steamid;
+		index(in_player, record);
+		return;
+	}
+
+	if (in_player.hwid.empty() && in_player.ip32 == 0 && in_player.steamid == 0) {
+		// Nothing to index by (i.e: bots)
+		return;
+	}
+
+	const Record& record = m_records.emplace(&in_player, Record{ &in_server, in_player.hwid, in_player.ip32, in_player.steamid }).first->second;
+	index(in_player, record);
+}
+
+void RenX::PlayerIndex::remove(const RenX::PlayerInfo& in_player) {
+	auto itr = m_records.find(&in_player);
+	if (itr != m_records.end()) {
+		unindex(in_player, itr->second);
+		m_records.erase(itr);
+	}
+}
+
+RenX::PlayerIndex::Range<RenX::PlayerIndex::HWIDMap> RenX::PlayerIndex::findByHWID(std::string_view in_hwid) const {
+	auto range = m_byHWID.equal_range(in_hwid);
+	return { range.first, range.second };
+}
+
+RenX::PlayerIndex::Range<RenX::PlayerIndex::IPMap> RenX::PlayerIndex::findByIP(uint32_t in_ip32) const {
+	auto range = m_byIP.equal_range(in_ip32);
+	return { range.first, range.second };
+}
+
+RenX::PlayerIndex::Range<RenX::PlayerIndex::SteamIDMap> RenX::PlayerIndex::findBySteamID(uint64_t in_steamid) const {
+	auto range = m_bySteamID.equal_range(in_steamid);
+	return { range.first, range.second };
+}
+
+RenX::PlayerInfo* RenX::PlayerIndex::findByHWID(const RenX::Server& in_server, std::string_view in_hwid) const {
+	return find_on_server(m_byHWID, in_hwid, in_server);
+}
+
+RenX::PlayerInfo* RenX::PlayerIndex::findByIP(const RenX::Server& in_server, uint32_t in_ip32) const {
+	return find_on_server(m_byIP, in_ip32, in_server);
+}
+
+RenX::PlayerInfo* RenX::PlayerIndex::findBySteamID(const RenX::Server& in_server, uint64_t in_steamid) const {
+	return find_on_server(m_bySteamID, in_steamid, in_server);
+}
+
+void RenX::PlayerIndex::index(RenX::PlayerInfo& in_player, const Record& in_record) {
+	PlayerLocation location{ in_record.server, &in_player };
+	if (!in_record.hwid.empty()) {
+		m_byHWID.emplace(in_record.hwid, location);
+	}
+
+	if (in_record.ip32 != 0) {
+		m_byIP.emplace(in_record.ip32, location);
+	}
+
+	if (in_record.steamid != 0) {
+		m_bySteamID.emplace(in_record.steamid, location);
+	}
+}
+
+void RenX::PlayerIndex::unindex(const RenX::PlayerInfo& in_player, const Record& in_record) {
+	if (!in_record.hwid.empty()) {
+		erase_location(m_byHWID, std::string_view{ in_record.hwid }, &in_player);
+	}
+
+	if (in_record.ip32 != 0) {
+		erase_location(m_byIP, in_record.ip32, &in_player);
+	}
+
+	if (in_record.steamid != 0) {
+		erase_location(m_bySteamID, in_record.steamid, &in_player);
+	}
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_PLAYERINDEX_H_HEADER
+#define _RENX_PLAYERINDEX_H_HEADER
+
+/**
+ * @file RenX_PlayerIndex.h
+ * @brief Indexes players on every server by HWID, IP address, and Steam ID.
+ */
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/** Forward declarations */
+	struct PlayerInfo;
+	class Server;
+
+	/** A player, and the server they are on */
+	struct PlayerLocation
+	{
+		RenX::Server* server;
+		RenX::PlayerInfo* player;
+	};
+
+	/**
+	* @brief Index of every identified player across every server, by HWID, IP address, and Steam ID.
+	* Servers keep the index up to date as players join, identify, and part; lookups are O(1) in the number of players.
+	* Empty HWIDs, IP addresses of 0, and Steam IDs of 0 are not indexed.
+	*/
+	class RENX_API PlayerIndex
+	{
+	public:
+		template<typename MapT>
+		struct Range
+		{
+			typename MapT::const_iterator first;
+			typename MapT::const_iterator last;
+
+			typename MapT::const_iterator begin() const { return first; }
+			typename MapT::const_iterator end() const { return last; }
+			bool empty() const { return first == last; }
+			size_t size() const { return static_cast<size_t>(std::distance(first, last)); }
+		};
+
+		using HWIDMap = std::unordered_multimap<std::string_view, PlayerLocation>;
+		using IPMap = std::unordered_multimap<uint32_t, PlayerLocation>;
+		using SteamIDMap = std::unordered_multimap<uint64_t, PlayerLocation>;
+
+		/**
+		* @brief Indexes a player, or re-indexes them if their HWID, IP address, or Steam ID has changed since they were last indexed.
+		*
+		* @param in_server Server the player is on
+		* @param in_player Player to index
+		*/
+		void update(RenX::Server& in_server, RenX::PlayerInfo& in_player);
+
+		/**
+		* @brief Removes a player from the index.
+		*
+		* @param in_player Player to remove
+		*/
+		void remove(const RenX::PlayerInfo& in_player);
+
+		/**
+		* @brief Fetches every indexed player with a HWID, IP address, or Steam ID, on any server.
+		* Note: Ranges are invalidated when the index is updated.
+		*
+		* @param in_hwid / in_ip32 / in_steamid Key to search for
+		* @return Range of entries whose second member is a PlayerLocation
+		*/
+		Range<HWIDMap> findByHWID(std::string_view in_hwid) const;
+		Range<IPMap> findByIP(uint32_t in_ip32) const;
+		Range<SteamIDMap> findBySteamID(uint64_t in_steamid) const;
+
+		/**
+		* @brief Fetches a player on a specific server with a HWID, IP address, or Steam ID.
+		*
+		* @param in_server Server to search
+		* @param in_hwid / in_ip32 / in_steamid Key to search for
+		* @return First matching player on the server if one exists, nullptr otherwise.
+		*/
+		RenX::PlayerInfo* findByHWID(const RenX::Server& in_server, std::string_view in_hwid) const;
+		RenX::PlayerInfo* findByIP(const RenX::Server& in_server, uint32_t in_ip32) const;
+		RenX::PlayerInfo* findBySteamID(const RenX::Server& in_server, uint64_t in_steamid) const;
+
+		/**
+		* @brief Fetches the number of indexed players.
+		*
+		* @return Number of indexed players
+		*/
+		size_t size() const { return m_records.size(); }
+
+	private:
+		/** Keys a player was last indexed under; kept so that a player's entries can be found after their fields change */
+		struct Record
+		{
+			RenX::Server* server;
+			std::string hwid;
+			uint32_t ip32;
+			uint64_t steamid;
+		};
+
+		void index(RenX::PlayerInfo& in_player, const Record& in_record);
+		void unindex(const RenX::PlayerInfo& in_player, const Record& in_record);
+
+		std::unordered_map<const RenX::PlayerInfo*, Record> m_records;
+		HWIDMap m_byHWID; /** Keys view Record::hwid */
+		IPMap m_byIP;
+		SteamIDMap m_bySteamID;
+	};
+
+	RENX_API extern RenX::PlayerIndex *playerIndex;
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_PLAYERINDEX_H_HEADER
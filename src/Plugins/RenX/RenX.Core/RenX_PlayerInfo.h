@@ -29,6 +29,9 @@
 #include <thread>
 #include "Jupiter/Config.h"
 #include "RenX.h"
+#include "RenX_DataSlot.h"
+#include "RenX_PlayerStats.h"
+#include "RenX_Symbols.h"
 
 /** DLL Linkage Nagging */
 #if defined _MSC_VER
@@ -51,9 +54,9 @@ namespace RenX
 		std::string ip;
 		std::string adminType;
 		std::string uuid;
-		std::string character;
-		std::string vehicle;
 		std::string hwid;
+		RenX::Symbol character_id = 0; /** Interned class name of the player's character (see RenX::symbols) */
+		RenX::Symbol vehicle_id = 0; /** Interned class name of the player's vehicle (see RenX::symbols) */
 		uint64_t steamid = 0;
 		uint32_t ip32 = 0;
 		uint16_t ban_flags = 0;
@@ -63,26 +66,52 @@ namespace RenX
 		bool isBot = false;
 		bool is_dev = false;
 		unsigned short ping = 0;
-		double score = 0.0f;
-		double credits = 0.0f;
 		size_t global_rank = 0;
 		size_t local_rank = 0;
-		unsigned int kills = 0;
-		unsigned int deaths = 0;
-		unsigned int suicides = 0;
-		unsigned int headshots = 0;
-		unsigned int vehicleKills = 0;
-		unsigned int buildingKills = 0;
-		unsigned int defenceKills = 0;
-		unsigned int wins = 0;
-		unsigned int loses = 0;
-		unsigned int beaconPlacements = 0;
-		unsigned int beaconDisarms = 0;
-		unsigned int proxy_placements = 0;
-		unsigned int proxy_disarms = 0;
-		unsigned int captures = 0;
-		unsigned int steals = 0;
-		unsigned int stolen = 0;
+
+		// Counters are stored in the owning server's StatsTable (RenX::Server::stats)
+		RenX::StatsRow statsRow;
+		double& score() { return statsRow.score(); }
+		double score() const { return statsRow.score(); }
+		double& credits() { return statsRow.credits(); }
+		double credits() const { return statsRow.credits(); }
+		unsigned int& kills() { return statsRow.get(Stat::Kills); }
+		unsigned int kills() const { return statsRow.get(Stat::Kills); }
+		unsigned int& deaths() { return statsRow.get(Stat::Deaths); }
+		unsigned int deaths() const { return statsRow.get(Stat::Deaths); }
+		unsigned int& suicides() { return statsRow.get(Stat::Suicides); }
+		unsigned int suicides() const { return statsRow.get(Stat::Suicides); }
+		unsigned int& headshots() { return statsRow.get(Stat::Headshots); }
+		unsigned int headshots() const { return statsRow.get(Stat::Headshots); }
+		unsigned int& vehicleKills() { return statsRow.get(Stat::VehicleKills); }
+		unsigned int vehicleKills() const { return statsRow.get(Stat::VehicleKills); }
+		unsigned int& buildingKills() { return statsRow.get(Stat::BuildingKills); }
+		unsigned int buildingKills() const { return statsRow.get(Stat::BuildingKills); }
+		unsigned int& defenceKills() { return statsRow.get(Stat::DefenceKills); }
+		unsigned int defenceKills() const { return statsRow.get(Stat::DefenceKills); }
+		unsigned int& wins() { return statsRow.get(Stat::Wins); }
+		unsigned int wins() const { return statsRow.get(Stat::Wins); }
+		unsigned int& loses() { return statsRow.get(Stat::Loses); }
+		unsigned int loses() const { return statsRow.get(Stat::Loses); }
+		unsigned int& beaconPlacements() { return statsRow.get(Stat::BeaconPlacements); }
+		unsigned int beaconPlacements() const { return statsRow.get(Stat::BeaconPlacements); }
+		unsigned int& beaconDisarms() { return statsRow.get(Stat::BeaconDisarms); }
+		unsigned int beaconDisarms() const { return statsRow.get(Stat::BeaconDisarms); }
+		unsigned int& proxy_placements() { return statsRow.get(Stat::ProxyPlacements); }
+		unsigned int proxy_placements() const { return statsRow.get(Stat::ProxyPlacements); }
+		unsigned int& proxy_disarms() { return statsRow.get(Stat::ProxyDisarms); }
+		unsigned int proxy_disarms() const { return statsRow.get(Stat::ProxyDisarms); }
+		unsigned int& captures() { return statsRow.get(Stat::Captures); }
+		unsigned int captures() const { return statsRow.get(Stat::Captures); }
+		unsigned int& steals() { return statsRow.get(Stat::Steals); }
+		unsigned int steals() const { return statsRow.get(Stat::Steals); }
+		unsigned int& stolen() { return statsRow.get(Stat::Stolen); }
+		unsigned int stolen() const { return statsRow.get(Stat::Stolen); }
+
+		std::string_view character() const { return RenX::symbols->name(character_id); }
+		std::string_view vehicle() const { return RenX::symbols->name(vehicle_id); }
+		std::string_view characterName() const { return RenX::symbols->translated(character_id); }
+		std::string_view vehicleName() const { return RenX::symbols->translated(vehicle_id); }
 
 		// Lock-free getter -- never access m_rdns until it's been set by RDNS thread
 		std::string_view get_rdns() const {
@@ -105,12 +134,46 @@ namespace RenX
 		mutable std::string formatNamePrefix;
 		mutable int access = 0;
 		mutable Jupiter::Config varData; // TODO: use jessilib::object instead
+		mutable RenX::SlotStorage slots; /** Values of registered PlayerSlots */
+
+		PlayerInfo() = default;
+		explicit PlayerInfo(RenX::StatsTable& in_stats) : statsRow{ in_stats } {}
 
 	private:
 		std::shared_ptr<std::string> m_rdns_ptr; // Needs synchronization across threads
 	};
 
 	static constexpr std::string_view rdns_pending{ "RDNS_PENDING" };
+
+	/** Bitmask values for the PlayerInfo fields which are refreshed by client list polling */
+	namespace PlayerField
+	{
+		enum : unsigned int
+		{
+			Kills = 1 << 0,
+			Deaths = 1 << 1,
+			Score = 1 << 2,
+			Credits = 1 << 3,
+			Character = 1 << 4,
+			Vehicle = 1 << 5,
+			Ping = 1 << 6,
+			Admin = 1 << 7
+		};
+	}
+
+	/**
+	* @brief Describes the fields of a player which changed during a client list refresh.
+	* Numeric fields hold the values from before the refresh; the current values are on the PlayerInfo.
+	*/
+	struct PlayerDelta
+	{
+		unsigned int fields = 0; /** Bitmask of PlayerField values which changed */
+		unsigned int kills = 0;
+		unsigned int deaths = 0;
+		double score = 0.0;
+		double credits = 0.0;
+		unsigned short ping = 0;
+	};
 }
 
 /** Re-enable warnings */
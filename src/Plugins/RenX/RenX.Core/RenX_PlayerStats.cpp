@@ -0,0 +1,146 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include "RenX_PlayerStats.h"
+
+/** StatsTable */
+
+size_t RenX::StatsTable::acquire() {
+	if (!m_free_rows.empty()) {
+		size_t result = m_free_rows.back();
+		m_free_rows.pop_back();
+		return result;
+	}
+
+	if (m_rows == m_chunks.size() * chunk_rows) {
+		m_chunks.push_back(std::make_unique<Chunk>());
+	}
+
+	return m_rows++;
+}
+
+void RenX::StatsTable::release(size_t in_row) {
+	Chunk& row_chunk = chunk(in_row);
+	size_t offset = in_row % chunk_rows;
+	for (auto& column : row_chunk.counters) {
+		column[offset] = 0;
+	}
+	row_chunk.score[offset] = 0.0;
+	row_chunk.credits[offset] = 0.0;
+
+	m_free_rows.push_back(in_row);
+}
+
+unsigned long long RenX::StatsTable::sum(Stat in_stat) const {
+	unsigned long long result = 0;
+	for (const auto& table_chunk : m_chunks) {
+		const auto& column = table_chunk->counters[static_cast<size_t>(in_stat)];
+		result = std::accumulate(column.begin(), column.end(), result);
+	}
+
+	return result;
+}
+
+double RenX::StatsTable::sumScore() const {
+	double result = 0.0;
+	for (const auto& table_chunk : m_chunks) {
+		result = std::accumulate(table_chunk->score.begin(), table_chunk->score.end(), result);
+	}
+
+	return result;
+}
+
+double RenX::StatsTable::sumCredits() const {
+	double result = 0.0;
+	for (const auto& table_chunk : m_chunks) {
+		result = std::accumulate(table_chunk->credits.begin(), table_chunk->credits.end(), result);
+	}
+
+	return result;
+}
+
+void RenX::StatsTable::resetMatch() {
+	for (const auto& table_chunk : m_chunks) {
+		for (size_t index = 0; index != static_cast<size_t>(Stat::Count); ++index) {
+			if (index != static_cast<size_t>(Stat::Wins) && index != static_cast<size_t>(Stat::Loses)) {
+				table_chunk->counters[index].fill(0U);
+			}
+		}
+
+		table_chunk->score.fill(0.0);
+		table_chunk->credits.fill(0.0);
+	}
+}
+
+void RenX::StatsTable::reset(Stat in_stat) {
+	for (const auto& table_chunk : m_chunks) {
+		table_chunk->counters[static_cast<size_t>(in_stat)].fill(0U);
+	}
+}
+
+/** StatsRow */
+
+RenX::StatsTable& detached_stats_table() {
+	static RenX::StatsTable s_table;
+	return s_table;
+}
+
+// The detached table is not owned by a server, so it may be reached from any thread and is locked
+std::unique_lock<std::mutex> lock_stats_table(const RenX::StatsTable& in_table) {
+	static std::mutex s_detached_mutex;
+	if (&in_table == &detached_stats_table()) {
+		return std::unique_lock<std::mutex>{ s_detached_mutex };
+	}
+
+	return {};
+}
+
+RenX::StatsRow::StatsRow()
+	: StatsRow{ detached_stats_table() } {
+}
+
+RenX::StatsRow::StatsRow(StatsTable& in_table)
+	: m_table{ &in_table } {
+	auto guard = lock_stats_table(in_table);
+	m_row = in_table.acquire();
+	m_chunk = &in_table.chunk(m_row);
+	m_offset = m_row % StatsTable::chunk_rows;
+}
+
+RenX::StatsRow::StatsRow(const StatsRow& in_row)
+	: StatsRow{ *in_row.m_table } {
+	*this = in_row;
+}
+
+RenX::StatsRow& RenX::StatsRow::operator=(const StatsRow& in_row) {
+	for (size_t index = 0; index != static_cast<size_t>(Stat::Count); ++index) {
+		get(static_cast<Stat>(index)) = in_row.get(static_cast<Stat>(index));
+	}
+	score() = in_row.score();
+	credits() = in_row.credits();
+
+	return *this;
+}
+
+RenX::StatsRow::~StatsRow() {
+	auto guard = lock_stats_table(*m_table);
+	m_table->release(m_row);
+}
@@ -0,0 +1,185 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_PLAYERSTATS_H_HEADER
+#define _RENX_PLAYERSTATS_H_HEADER
+
+/**
+ * @file RenX_PlayerStats.h
+ * @brief Defines the contiguous per-server table of player counters.
+ */
+
+#include <array>
+#include <memory>
+#include <vector>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/** Integer counters tracked for each player */
+	enum class Stat : size_t
+	{
+		Kills,
+		Deaths,
+		Suicides,
+		Headshots,
+		VehicleKills,
+		BuildingKills,
+		DefenceKills,
+		BeaconPlacements,
+		BeaconDisarms,
+		ProxyPlacements,
+		ProxyDisarms,
+		Captures,
+		Steals,
+		Stolen,
+		Wins, // Persists across matches
+		Loses, // Persists across matches
+		Count
+	};
+
+	/**
+	* @brief Structure-of-arrays table of player counters, with one row per player.
+	* Rows are stored in fixed-size chunks which are never moved, so references to a row's values remain valid until the row is released.
+	* Within a chunk, each counter is stored in its own contiguous column, so that operations across all players only touch the columns they need.
+	* Released rows are zeroed, so aggregates may be taken over every row without checking which rows are in use.
+	* Note: A server's table is only accessed from the main thread; the table shared by detached players is guarded by StatsRow.
+	*/
+	class RENX_API StatsTable
+	{
+	public:
+		static constexpr size_t chunk_rows = 64;
+
+		/** A fixed-size block of rows */
+		struct Chunk
+		{
+			std::array<std::array<unsigned int, chunk_rows>, static_cast<size_t>(Stat::Count)> counters{};
+			std::array<double, chunk_rows> score{};
+			std::array<double, chunk_rows> credits{};
+		};
+
+		/**
+		* @brief Reserves a zeroed row.
+		*
+		* @return Index of the reserved row
+		*/
+		size_t acquire();
+
+		/**
+		* @brief Zeroes a row and returns it for reuse.
+		*
+		* @param in_row Row to release
+		*/
+		void release(size_t in_row);
+
+		/**
+		* @brief Fetches the chunk which holds a row; the row is at (in_row % chunk_rows) within it.
+		*
+		* @param in_row Row to fetch the chunk of
+		* @return Chunk holding the row
+		*/
+		Chunk& chunk(size_t in_row) { return *m_chunks[in_row / chunk_rows]; }
+		const Chunk& chunk(size_t in_row) const { return *m_chunks[in_row / chunk_rows]; }
+
+		/** Fetches a counter of a row */
+		unsigned int& get(Stat in_stat, size_t in_row) { return chunk(in_row).counters[static_cast<size_t>(in_stat)][in_row % chunk_rows]; }
+		unsigned int get(Stat in_stat, size_t in_row) const { return chunk(in_row).counters[static_cast<size_t>(in_stat)][in_row % chunk_rows]; }
+		double& score(size_t in_row) { return chunk(in_row).score[in_row % chunk_rows]; }
+		double score(size_t in_row) const { return chunk(in_row).score[in_row % chunk_rows]; }
+		double& credits(size_t in_row) { return chunk(in_row).credits[in_row % chunk_rows]; }
+		double credits(size_t in_row) const { return chunk(in_row).credits[in_row % chunk_rows]; }
+
+		/**
+		* @brief Fetches the number of rows in the table, including released rows.
+		*
+		* @return Number of rows
+		*/
+		size_t rows() const { return m_rows; }
+
+		/**
+		* @brief Sums a counter across all players.
+		*
+		* @param in_stat Counter to sum
+		* @return Sum of the counter
+		*/
+		unsigned long long sum(Stat in_stat) const;
+		double sumScore() const;
+		double sumCredits() const;
+
+		/**
+		* @brief Zeroes every per-match counter, score, and credits of every player; Wins and Loses are preserved.
+		*/
+		void resetMatch();
+
+		/**
+		* @brief Zeroes a counter for every player.
+		*
+		* @param in_stat Counter to zero
+		*/
+		void reset(Stat in_stat);
+
+	private:
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		size_t m_rows = 0;
+		std::vector<size_t> m_free_rows;
+	};
+
+	/**
+	* @brief Owns a row in a StatsTable for the lifetime of a player.
+	* Copies reserve a new row in the same table, holding a copy of the values.
+	* The row's chunk is resolved once, so that accessing values never touches the table itself.
+	*/
+	class RENX_API StatsRow
+	{
+	public:
+		unsigned int& get(Stat in_stat) { return m_chunk->counters[static_cast<size_t>(in_stat)][m_offset]; }
+		unsigned int get(Stat in_stat) const { return m_chunk->counters[static_cast<size_t>(in_stat)][m_offset]; }
+		double& score() { return m_chunk->score[m_offset]; }
+		double score() const { return m_chunk->score[m_offset]; }
+		double& credits() { return m_chunk->credits[m_offset]; }
+		double credits() const { return m_chunk->credits[m_offset]; }
+		StatsTable& table() const { return *m_table; }
+		size_t row() const { return m_row; }
+
+		/** Reserves a row in a table shared by players not attached to a server (i.e: temporary players); safe from any thread */
+		StatsRow();
+		explicit StatsRow(StatsTable& in_table);
+		StatsRow(const StatsRow& in_row);
+		StatsRow& operator=(const StatsRow& in_row);
+		~StatsRow();
+
+	private:
+		StatsTable* m_table;
+		size_t m_row;
+		StatsTable::Chunk* m_chunk;
+		size_t m_offset;
+	};
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_PLAYERSTATS_H_HEADER
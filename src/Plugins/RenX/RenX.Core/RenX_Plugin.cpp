@@ -18,12 +18,21 @@
 
 #include "RenX_Plugin.h"
 #include "RenX_Core.h"
+#include "RenX_Server.h"
+#include "RenX_PlayerInfo.h"
+#include "RenX_Symbols.h"
 
 RenX::Plugin::Plugin() {
 	RenX::getCore()->getPlugins().push_back(this);
 }
 
 RenX::Plugin::~Plugin() {
+	// Pending request callbacks may be code from this plugin
+	RenX::Core *core = RenX::getCore();
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		core->getServer(index)->cancelRequests(this);
+	}
+
 	auto& renx_plugins = RenX::getCore()->getPlugins();
 	for (auto itr = renx_plugins.begin(); itr != renx_plugins.end(); ++itr) {
 		if (*itr == this) {
@@ -61,6 +70,10 @@ void RenX::Plugin::RenX_OnPlayerIdentify(Server &, const PlayerInfo &) {
 	return;
 }
 
+void RenX::Plugin::RenX_OnPlayerDelta(Server &, const PlayerInfo &, const PlayerDelta &) {
+	return;
+}
+
 void RenX::Plugin::RenX_OnServerCreate(Server &) {
 	return;
 }
@@ -241,6 +254,30 @@ void RenX::Plugin::RenX_OnDestroy(Server &, std::string_view , const TeamType &,
 	return;
 }
 
+void RenX::Plugin::RenX_OnSuicide(Server &server, const PlayerInfo &player, Symbol damageType) {
+	this->RenX_OnSuicide(server, player, RenX::symbols->name(damageType));
+}
+
+void RenX::Plugin::RenX_OnKill(Server &server, const PlayerInfo &player, const PlayerInfo &victim, Symbol damageType) {
+	this->RenX_OnKill(server, player, victim, RenX::symbols->name(damageType));
+}
+
+void RenX::Plugin::RenX_OnKill(Server &server, std::string_view killer, const TeamType &killerTeam, const PlayerInfo &victim, Symbol damageType) {
+	this->RenX_OnKill(server, killer, killerTeam, victim, RenX::symbols->name(damageType));
+}
+
+void RenX::Plugin::RenX_OnDie(Server &server, const PlayerInfo &player, Symbol damageType) {
+	this->RenX_OnDie(server, player, RenX::symbols->name(damageType));
+}
+
+void RenX::Plugin::RenX_OnDestroy(Server &server, const PlayerInfo &player, Symbol objectName, const TeamType &victimTeam, Symbol damageType, ObjectType type) {
+	this->RenX_OnDestroy(server, player, RenX::symbols->name(objectName), victimTeam, RenX::symbols->name(damageType), type);
+}
+
+void RenX::Plugin::RenX_OnDestroy(Server &server, std::string_view killer, const TeamType &killerTeam, Symbol objectName, const TeamType &objectTeam, Symbol damageType, ObjectType type) {
+	this->RenX_OnDestroy(server, killer, killerTeam, RenX::symbols->name(objectName), objectTeam, RenX::symbols->name(damageType), type);
+}
+
 void RenX::Plugin::RenX_OnCapture(Server &, const PlayerInfo &, std::string_view , const TeamType &) {
 	return;
 }
@@ -26,12 +26,14 @@
 
 #include "Jupiter/Plugin.h"
 #include "RenX.h"
+#include "RenX_Symbols.h"
 
 namespace RenX
 {
 
 	/** Forward declarations */
 	struct PlayerInfo;
+	struct PlayerDelta;
 	struct BuildingInfo;
 	class Plugin;
 	class Server;
@@ -50,6 +52,7 @@ namespace RenX
 		virtual void RenX_OnPlayerUUIDChange(Server &server, const PlayerInfo &player, std::string_view newUUID);
 		virtual void RenX_OnPlayerRDNS(Server &server, const PlayerInfo &player);
 		virtual void RenX_OnPlayerIdentify(Server &server, const PlayerInfo &player);
+		virtual void RenX_OnPlayerDelta(Server &server, const PlayerInfo &player, const PlayerDelta &delta);
 		virtual void RenX_OnServerCreate(Server &server);
 		virtual void RenX_OnServerFullyConnected(Server &server);
 		virtual void RenX_OnServerDisconnect(Server &server, RenX::DisconnectReason reason);
@@ -101,6 +104,15 @@ namespace RenX
 		virtual void RenX_OnDie(Server &server, std::string_view object, const TeamType &objectTeam, std::string_view damageType);
 		virtual void RenX_OnDestroy(Server &server, const PlayerInfo &player, std::string_view objectName, const TeamType &victimTeam, std::string_view damageType, ObjectType type);
 		virtual void RenX_OnDestroy(Server &server, std::string_view killer, const TeamType &killerTeam, std::string_view objectName, const TeamType &objectTeam, std::string_view damageType, ObjectType type);
+
+		/** Combat logs, carrying interned class names (see RenX_Symbols.h). These are what the server calls; by default, they call the overloads above. */
+		virtual void RenX_OnSuicide(Server &server, const PlayerInfo &player, Symbol damageType);
+		virtual void RenX_OnKill(Server &server, const PlayerInfo &player, const PlayerInfo &victim, Symbol damageType);
+		virtual void RenX_OnKill(Server &server, std::string_view killer, const TeamType &killerTeam, const PlayerInfo &victim, Symbol damageType);
+		virtual void RenX_OnDie(Server &server, const PlayerInfo &player, Symbol damageType);
+		virtual void RenX_OnDestroy(Server &server, const PlayerInfo &player, Symbol objectName, const TeamType &victimTeam, Symbol damageType, ObjectType type);
+		virtual void RenX_OnDestroy(Server &server, std::string_view killer, const TeamType &killerTeam, Symbol objectName, const TeamType &objectTeam, Symbol damageType, ObjectType type);
+
 		virtual void RenX_OnCapture(Server &server, const PlayerInfo &player, std::string_view building, const TeamType &oldTeam);
 		virtual void RenX_OnNeutralize(Server &server, const PlayerInfo &player, std::string_view building, const TeamType &oldTeam);
 		virtual void RenX_OnCharacterPurchase(Server &server, const PlayerInfo &player, std::string_view character);
@@ -0,0 +1,342 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include "RenX_RCONCodec.h"
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define RENX_RCONCODEC_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+/**
+ * Counts the leading bytes which can be copied without any processing: bytes other than backslash,
+ * and, if in_ascii_only is set, other than bytes with the high bit set.
+ */
+template<bool in_ascii_only>
+size_t plain_run(const char* in_begin, const char* in_end) {
+	const char* ptr = in_begin;
+
+#if defined RENX_RCONCODEC_SSE2
+	const __m128i backslash = _mm_set1_epi8('\\');
+	while (in_end - ptr >= 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)));
+		if constexpr (in_ascii_only) {
+			mask |= static_cast<unsigned int>(_mm_movemask_epi8(chunk)); // high bit of each byte
+		}
+
+		if (mask != 0) {
+			return (ptr - in_begin) + std::countr_zero(mask);
+		}
+
+		ptr += 16;
+	}
+#endif // RENX_RCONCODEC_SSE2
+
+	while (ptr != in_end) {
+		if (*ptr == '\\' || (in_ascii_only && (*ptr & 0x80) != 0)) {
+			break;
+		}
+
+		++ptr;
+	}
+
+	return ptr - in_begin;
+}
+
+constexpr char hex_upper[] = "0123456789ABCDEF";
+
+int hex_value(char in_char) {
+	if (in_char >= '0' && in_char <= '9') {
+		return in_char - '0';
+	}
+	if (in_char >= 'A' && in_char <= 'F') {
+		return in_char - 'A' + 10;
+	}
+	if (in_char >= 'a' && in_char <= 'f') {
+		return in_char - 'a' + 10;
+	}
+	return -1;
+}
+
+/** Parses exactly in_digits hex digits starting at in_ptr; returns -1 if there aren't enough valid digits */
+long parse_hex(const char* in_ptr, const char* in_end, size_t in_digits) {
+	if (static_cast<size_t>(in_end - in_ptr) < in_digits) {
+		return -1;
+	}
+
+	long result = 0;
+	for (size_t index = 0; index != in_digits; ++index) {
+		int digit = hex_value(in_ptr[index]);
+		if (digit < 0) {
+			return -1;
+		}
+		result = (result << 4) | digit;
+	}
+
+	return result;
+}
+
+/** Parses the 4 hex digits of a \uXXXX sequence starting at in_ptr; returns -1 if there aren't 4 valid digits */
+long parse_u16(const char* in_ptr, const char* in_end) {
+	if (in_end - in_ptr < 6 || in_ptr[0] != '\\' || in_ptr[1] != 'u') {
+		return -1;
+	}
+
+	return parse_hex(in_ptr + 2, in_end, 4);
+}
+
+char* encode_utf8(char32_t in_codepoint, char* out_ptr) {
+	if (in_codepoint < 0x80) {
+		*out_ptr++ = static_cast<char>(in_codepoint);
+	}
+	else if (in_codepoint < 0x800) {
+		*out_ptr++ = static_cast<char>(0xC0 | (in_codepoint >> 6));
+		*out_ptr++ = static_cast<char>(0x80 | (in_codepoint & 0x3F));
+	}
+	else if (in_codepoint < 0x10000) {
+		*out_ptr++ = static_cast<char>(0xE0 | (in_codepoint >> 12));
+		*out_ptr++ = static_cast<char>(0x80 | ((in_codepoint >> 6) & 0x3F));
+		*out_ptr++ = static_cast<char>(0x80 | (in_codepoint & 0x3F));
+	}
+	else {
+		*out_ptr++ = static_cast<char>(0xF0 | (in_codepoint >> 18));
+		*out_ptr++ = static_cast<char>(0x80 | ((in_codepoint >> 12) & 0x3F));
+		*out_ptr++ = static_cast<char>(0x80 | ((in_codepoint >> 6) & 0x3F));
+		*out_ptr++ = static_cast<char>(0x80 | (in_codepoint & 0x3F));
+	}
+
+	return out_ptr;
+}
+
+/**
+ * Unescapifies [in_begin, in_end) into out_ptr, returning the new end of the output.
+ * Output is never longer than input, so out_ptr may equal in_begin.
+ */
+char* unescapify(const char* in_begin, const char* in_end, char* out_ptr) {
+	const char* ptr = in_begin;
+	while (ptr != in_end) {
+		// Copy everything up to the next backslash in bulk
+		size_t run = plain_run<false>(ptr, in_end);
+		if (out_ptr != ptr) {
+			std::memmove(out_ptr, ptr, run);
+		}
+		out_ptr += run;
+		ptr += run;
+
+		if (ptr == in_end) {
+			break;
+		}
+
+		// ptr is at a backslash
+		if (in_end - ptr < 2) {
+			*out_ptr++ = *ptr++;
+			break;
+		}
+
+		char escaped = ptr[1];
+		switch (escaped) {
+		case '\\':
+		case '\'':
+		case '\"':
+		case '?':
+			*out_ptr++ = escaped;
+			ptr += 2;
+			continue;
+		case 'a':
+			*out_ptr++ = '\a';
+			ptr += 2;
+			continue;
+		case 'b':
+			*out_ptr++ = '\b';
+			ptr += 2;
+			continue;
+		case 'f':
+			*out_ptr++ = '\f';
+			ptr += 2;
+			continue;
+		case 'n':
+			*out_ptr++ = '\n';
+			ptr += 2;
+			continue;
+		case 'r':
+			*out_ptr++ = '\r';
+			ptr += 2;
+			continue;
+		case 't':
+			*out_ptr++ = '\t';
+			ptr += 2;
+			continue;
+		case 'v':
+			*out_ptr++ = '\v';
+			ptr += 2;
+			continue;
+		case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': {
+			// Octal byte: up to 3 digits, stopping early rather than overflowing a byte
+			unsigned int value = 0;
+			const char* digit = ptr + 1;
+			while (digit != in_end && digit != ptr + 4 && *digit >= '0' && *digit <= '7' && value * 8 + (*digit - '0') <= 0xFF) {
+				value = value * 8 + (*digit - '0');
+				++digit;
+			}
+
+			*out_ptr++ = static_cast<char>(value);
+			ptr = digit;
+			continue;
+		}
+		case 'x': {
+			// Hex byte: 1 or 2 digits
+			int high = in_end - ptr > 2 ? hex_value(ptr[2]) : -1;
+			if (high < 0) {
+				break;
+			}
+
+			int low = in_end - ptr > 3 ? hex_value(ptr[3]) : -1;
+			if (low < 0) {
+				*out_ptr++ = static_cast<char>(high);
+				ptr += 3;
+			}
+			else {
+				*out_ptr++ = static_cast<char>((high << 4) | low);
+				ptr += 4;
+			}
+			continue;
+		}
+		case 'U': {
+			// Codepoint: exactly 8 digits
+			long codepoint = parse_hex(ptr + 2, in_end, 8);
+			if (codepoint < 0 || codepoint > 0x10FFFF) {
+				break;
+			}
+
+			out_ptr = encode_utf8(static_cast<char32_t>(codepoint), out_ptr);
+			ptr += 10;
+			continue;
+		}
+		case 'u': {
+			long unit = parse_u16(ptr, in_end);
+			if (unit < 0) {
+				break;
+			}
+			ptr += 6;
+
+			char32_t codepoint = static_cast<char32_t>(unit);
+			if (unit >= 0xD800 && unit <= 0xDBFF) { // High surrogate; combine with a following low surrogate
+				long low = parse_u16(ptr, in_end);
+				if (low >= 0xDC00 && low <= 0xDFFF) {
+					codepoint = 0x10000 + ((static_cast<char32_t>(unit) - 0xD800) << 10) + (static_cast<char32_t>(low) - 0xDC00);
+					ptr += 6;
+				}
+			}
+
+			out_ptr = encode_utf8(codepoint, out_ptr);
+			continue;
+		}
+		default:
+			break;
+		}
+
+		// Unrecognized or malformed escape; copy the backslash as-is
+		*out_ptr++ = *ptr++;
+	}
+
+	return out_ptr;
+}
+}
+
+void RenX::escapifyRCON(std::string_view in_text, std::string& out_buffer) {
+	const char* ptr = in_text.data();
+	const char* end = ptr + in_text.size();
+	out_buffer.reserve(out_buffer.size() + in_text.size());
+
+	while (ptr != end) {
+		// Copy ASCII text without backslashes in bulk
+		size_t run = plain_run<true>(ptr, end);
+		out_buffer.append(ptr, run);
+		ptr += run;
+
+		if (ptr == end) {
+			break;
+		}
+
+		if (*ptr == '\\') { // backslash, which is used for escape sequencing
+			out_buffer.append("\\\\", 2);
+			++ptr;
+			continue;
+		}
+
+		// UTF-8 sequence
+		size_t length = end - ptr;
+		if (length < 2) {
+			break;
+		}
+
+		uint16_t value;
+		if ((*ptr & 0x40) == 0) { // This is an invalid 1 byte sequence; skip it
+			++ptr;
+			continue;
+		}
+
+		if ((*ptr & 0x20) != 0) {
+			if (length < 3) {
+				break;
+			}
+
+			if ((*ptr & 0x10) != 0) { // This is a 4 byte sequence, which we can not fit into a 16-bit codepoint. ignore it.
+				if (length < 4) {
+					break;
+				}
+
+				ptr += 4;
+				continue;
+			}
+
+			// This is a 3 byte sequence
+			value = static_cast<uint16_t>((ptr[0] & 0x0F) << 12);
+			value += static_cast<uint16_t>((ptr[1] & 0x3F) << 6);
+			value += static_cast<uint16_t>(ptr[2] & 0x3F);
+			ptr += 3;
+		}
+		else {
+			// This is a 2 byte sequence
+			value = static_cast<uint16_t>((ptr[0] & 0x1F) << 6);
+			value += static_cast<uint16_t>(ptr[1] & 0x3F);
+			ptr += 2;
+		}
+
+		// write escape sequence
+		char sequence[6]{ '\\', 'u', hex_upper[value >> 12], hex_upper[(value >> 8) & 0x0F], hex_upper[(value >> 4) & 0x0F], hex_upper[value & 0x0F] };
+		out_buffer.append(sequence, sizeof(sequence));
+	}
+}
+
+void RenX::unescapifyRCON(std::string_view in_text, std::string& out_buffer) {
+	size_t offset = out_buffer.size();
+	out_buffer.resize(offset + in_text.size());
+	char* out_end = unescapify(in_text.data(), in_text.data() + in_text.size(), out_buffer.data() + offset);
+	out_buffer.resize(out_end - out_buffer.data());
+}
+
+void RenX::unescapifyRCON(std::string& in_out_text) {
+	char* out_end = unescapify(in_out_text.data(), in_out_text.data() + in_out_text.size(), in_out_text.data());
+	in_out_text.resize(out_end - in_out_text.data());
+}
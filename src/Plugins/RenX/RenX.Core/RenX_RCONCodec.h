@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_RCONCODEC_H_HEADER
+#define _RENX_RCONCODEC_H_HEADER
+
+/**
+ * @file RenX_RCONCodec.h
+ * @brief Provides escaping and unescaping of text transmitted over RCON.
+ */
+
+#include <string>
+#include <string_view>
+#include "RenX.h"
+
+namespace RenX
+{
+	/**
+	* @brief Escapifies text so that it can be safely transmitted over RCON, appending the result to a buffer.
+	* Backslashes are doubled, and UTF-8 sequences are written as \uXXXX escapes. Sequences outside of the
+	* Basic Multilingual Plane, invalid lead bytes, and sequences truncated by the end of the text are dropped.
+	*
+	* @param in_text Text to escapify
+	* @param out_buffer Buffer to append the escapified text to; its existing contents are preserved
+	*/
+	RENX_API void escapifyRCON(std::string_view in_text, std::string& out_buffer);
+
+	/**
+	* @brief Unescapifies text received over RCON, appending the result to a buffer.
+	* Supported sequences are those of C++ literals: \\, the single-character escapes \a \b \f \n \r \t \v \' \" \?,
+	* octal bytes (\N, \NN, \NNN), hex bytes (\xN, \xNN), \uXXXX (including surrogate pairs), and \UXXXXXXXX.
+	* Octal and hex sequences are written as raw bytes, while \u and \U codepoints are encoded as UTF-8. Octal sequences
+	* end early rather than exceed a byte, and hex sequences never take more than 2 digits. Any other backslash, including
+	* one starting a malformed or out of range sequence, is copied as-is.
+	*
+	* @param in_text Text to unescapify
+	* @param out_buffer Buffer to append the unescapified text to; its existing contents are preserved
+	*/
+	RENX_API void unescapifyRCON(std::string_view in_text, std::string& out_buffer);
+
+	/**
+	* @brief Unescapifies text received over RCON in place. Unescaping never grows text, so this never allocates.
+	*
+	* @param in_out_text Text to unescapify
+	*/
+	RENX_API void unescapifyRCON(std::string& in_out_text);
+}
+
+#endif // _RENX_RCONCODEC_H_HEADER
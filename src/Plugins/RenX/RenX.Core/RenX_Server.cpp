@@ -16,15 +16,20 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include <algorithm>
+#include <atomic>
 #include <ctime>
+#include <charconv>
 #include "jessilib/split.hpp"
 #include "jessilib/word_split.hpp"
 #include "jessilib/unicode.hpp"
-#include "jessilib/unicode_sequence.hpp"
 #include "ServerManager.h"
 #include "IRC_Bot.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
+#include "RenX_EventRates.h"
+#include "RenX_PlayerIndex.h"
+#include "RenX_RCONCodec.h"
 #include "RenX_BuildingInfo.h"
 #include "RenX_GameCommand.h"
 #include "RenX_Functions.h"
@@ -32,6 +37,7 @@
 #include "RenX_BanDatabase.h"
 #include "RenX_ExemptionDatabase.h"
 #include "RenX_Tags.h"
+#include "RenX_Symbols.h"
 
 using namespace std::literals;
 
@@ -39,11 +45,47 @@ using namespace std::literals;
 #define CALL_RX_PLUGIN_EVENT(event, ...) \
 	{ for (auto plugin : RenX::getCore()->getPlugins()) { plugin->event(__VA_ARGS__); } }
 
+/** Formats a player ID as a "pid" target on the stack, for use in outbound commands */
+class pid_string {
+public:
+	explicit pid_string(int in_id) {
+		auto result = std::to_chars(m_buffer + 3, m_buffer + sizeof(m_buffer), in_id);
+		m_size = result.ptr - m_buffer;
+	}
+
+	operator std::string_view() const { return { m_buffer, m_size }; }
+
+private:
+	char m_buffer[16]{ 'p', 'i', 'd' };
+	size_t m_size;
+};
+
+/** Players parsed from lines which lack an ID; these aren't held by any server */
+struct DetachedPlayers {
+	RenX::PlayerInfo temp_players[4];
+	size_t temp_index = 0;
+	RenX::PlayerInfo null_player;
+};
+
+static DetachedPlayers& detached_players() {
+	static DetachedPlayers s_players;
+	return s_players;
+}
+
+void reset_detached_player_slots(size_t in_index) {
+	DetachedPlayers& detached = detached_players();
+	for (auto& player : detached.temp_players) {
+		player.slots.reset(in_index);
+	}
+	detached.null_player.slots.reset(in_index);
+}
+
 int RenX::Server::think() {
 	if (m_connected == false) {
 		// Not connected; attempt retry if needed
 		if (m_maxAttempts < 0 || m_attempts < m_maxAttempts) {
 			if (std::chrono::steady_clock::now() >= m_lastAttempt + m_delay) {
+				m_reconnectsMetric->add();
 				if (connect()) {
 					sendLogChan(IRCCOLOR "03[RenX]" IRCCOLOR " Socket successfully reconnected to Renegade-X server.");
 				}
@@ -92,24 +134,29 @@ int RenX::Server::think() {
 			}
 		};
 
-		// Connected and fine
-		if (m_sock.recv() > 0) { // Data received
-			cycle_player_rdns();
-
-			auto tokens = jessilib::split_view(m_sock.getBuffer(), '\n');
-			if (!tokens.empty()) {
-				m_lastActivity = std::chrono::steady_clock::now();
-				m_lastLine += tokens[0];
-				if (tokens.size() != 1) {
-					processLine(m_lastLine);
-					m_lastLine = tokens[tokens.size() - 1];
-
-					for (size_t index = 1; index != tokens.size() - 1; ++index) {
-						processLine(tokens[index]);
-					}
-				}
+		// Connected and fine; drain the socket until it would block, or until this tick's receive budget is spent
+		size_t received = 0;
+		int recv_result = 0;
+		while (received < m_receiveBudget && (recv_result = m_sock.recv()) > 0) { // Data received
+			m_lastActivity = std::chrono::steady_clock::now();
+			received += static_cast<size_t>(recv_result);
+			m_inbound.append(m_sock.getBuffer());
+			m_inbound.consumeLines([this](std::string_view line) {
+				auto process_start = std::chrono::steady_clock::now();
+				processLine(line);
+				m_processLineMetric->observe(std::chrono::steady_clock::now() - process_start);
+				m_linesMetric->add();
+			});
+
+			if (m_connected == false) { // Disconnected while processing lines
+				return 0;
 			}
 		}
+
+		if (received != 0) {
+			m_bytesReceivedMetric->add(received);
+			cycle_player_rdns();
+		}
 		else if (Jupiter::Socket::getLastError() == JUPITER_SOCK_EWOULDBLOCK) { // Operation would block (no new data)
 			cycle_player_rdns();
 
@@ -137,7 +184,11 @@ int RenX::Server::think() {
 
 		// Updating client and building lists, if there is a game in progress and it's time for an update
 		if (m_rconVersion >= 3 && this->players.size() != 0) {
-			if (m_clientUpdateRate != std::chrono::milliseconds::zero() && std::chrono::steady_clock::now() > m_lastClientListUpdate + m_clientUpdateRate) {
+			if (m_clientUpdateRate != std::chrono::milliseconds::zero() && std::chrono::steady_clock::now() > m_lastClientListUpdate + m_clientUpdateRateCurrent) {
+				if (m_adaptiveClientUpdate) {
+					adjustClientUpdateRate();
+				}
+
 				updateClientList();
 			}
 
@@ -156,6 +207,21 @@ int RenX::Server::think() {
 		if (m_awaitingPong == false && std::chrono::steady_clock::now() - m_lastSendActivity >= m_pingRate) {
 			startPing();
 		}
+
+		// Fail requests which the server never acknowledged (i.e: commands which don't exist), or never finished
+		// responding to (i.e: the end of the response was lost); otherwise, the rest of the requests would stall behind them
+		while (!m_requests.empty()) {
+			auto now = std::chrono::steady_clock::now();
+			const PendingRequest& request = m_requests.front();
+			if (m_requestExecuting ? now - request.executed < m_requestExecutionTimeout : now - request.sent < m_requestTimeout) {
+				break;
+			}
+
+			completeRequest(false);
+		}
+
+		// Send everything queued since the last tick
+		flushSocket();
 	}
 
 	return 0;
@@ -168,6 +234,10 @@ int RenX::Server::OnRehash() {
 	unsigned short oldPort = m_port;
 	int oldSteamFormat = m_steamFormat;
 	m_commands.clear();
+	m_ownedCommands.clear();
+	m_commandCopies.clear();
+	m_commandIndex.clear();
+	m_hiddenCommands.clear();
 	init(*RenX::getCore()->getConfig().getSection(m_configSection));
 	if (m_port == 0 || !m_hostname.empty()) {
 		m_hostname = oldHostname;
@@ -258,46 +328,174 @@ bool RenX::Server::isPure() const {
 }
 
 int RenX::Server::send(std::string_view command) {
-	return sendSocket("c"s + RenX::escapifyRCON(command) + '\n');
+	return sendSocket({ "c"sv, escapifyScratch(command), "\n"sv });
+}
+
+bool RenX::Server::request(std::string_view command, RenX::RCONCallback callback, const void *owner) {
+	return submitRequest({ "c"sv, escapifyScratch(command), "\n"sv }, command, std::move(callback), owner);
+}
+
+size_t RenX::Server::cancelRequests(const void *owner) {
+	size_t result = 0;
+	for (auto& request : m_requests) {
+		if (request.owner == owner && request.callback != nullptr) {
+			request.callback = nullptr;
+			++result;
+		}
+	}
+
+	return result;
+}
+
+bool RenX::Server::submitRequest(std::initializer_list<std::string_view> in_parts, std::string_view in_command, RenX::RCONCallback in_callback, const void *in_owner) {
+	if (!m_connected || sendSocket(in_parts) <= 0) {
+		return false;
+	}
+
+	PendingRequest& request = m_requests.emplace_back();
+	request.name = jessilib::word_split_once_view(in_command, ' ').first;
+	request.callback = std::move(in_callback);
+	request.response.command = in_command;
+	request.sent = std::chrono::steady_clock::now();
+	request.owner = in_owner;
+	return true;
+}
+
+void RenX::Server::completeRequest(bool in_completed) {
+	// Remove the request before calling back, since the callback may submit further requests
+	PendingRequest request = std::move(m_requests.front());
+	m_requests.pop_front();
+	m_requestExecuting = false;
+
+	request.response.completed = in_completed;
+	if (request.callback != nullptr) {
+		request.callback(*this, request.response);
+	}
+}
+
+void RenX::Server::failRequests() {
+	while (!m_requests.empty()) {
+		completeRequest(false);
+	}
 }
 
 int RenX::Server::sendSocket(std::string_view text) {
+	return sendSocket(std::initializer_list<std::string_view>{ text });
+}
+
+int RenX::Server::sendSocket(std::initializer_list<std::string_view> parts) {
+	size_t length = 0;
+	for (const auto& part : parts) {
+		length += part.size();
+	}
+
+	if (!m_connected) {
+		return -1;
+	}
+
+	if (m_outbound.size() + length > m_sendBufferSize) {
+		// Past the soft limit; make room by flushing early
+		flushSocket();
+		if (m_outbound.size() + length > m_sendBufferLimit) {
+			// The server has stopped reading; refuse rather than grow without bound. The ping timeout will reconnect.
+			return -1;
+		}
+	}
+
+	for (const auto& part : parts) {
+		m_outbound += part;
+	}
+
 	m_lastSendActivity = std::chrono::steady_clock::now();
-	return m_sock.send(text);
+	return static_cast<int>(length);
+}
+
+int RenX::Server::sendChat(std::initializer_list<std::string_view> parts) {
+	size_t length = 0;
+	for (const auto& part : parts) {
+		length += part.size();
+	}
+
+	if (m_outbound.size() + length > m_sendBufferSize) {
+		flushSocket();
+		if (!m_outbound.empty() && m_outbound.size() + length > m_sendBufferSize) {
+			// Socket can't keep up; chat is the only output which may be shed
+			return -1;
+		}
+	}
+
+	return sendSocket(parts);
+}
+
+std::string_view RenX::Server::escapifyScratch(std::string_view text) {
+	m_escapeBuffer.clear();
+	RenX::escapifyRCON(text, m_escapeBuffer);
+	return m_escapeBuffer;
+}
+
+int RenX::Server::flushSocket() {
+	size_t offset = 0;
+	while (offset != m_outbound.size()) {
+		int result = m_sock.send(std::string_view{ m_outbound }.substr(offset));
+		if (result <= 0) {
+			// Would block or failed; keep the remainder until the next flush, and leave error handling to the receive path
+			break;
+		}
+
+		offset += static_cast<size_t>(result);
+	}
+
+	m_outbound.erase(0, offset);
+	m_bytesSentMetric->add(offset);
+	updateSendQueueMetric();
+	return static_cast<int>(offset);
+}
+
+size_t RenX::Server::getPendingSendBytes() const {
+	return m_outbound.size();
+}
+
+bool RenX::Server::isSendBufferFull() const {
+	return m_outbound.size() >= m_sendBufferSize;
 }
 
 int RenX::Server::sendMessage(std::string_view message) {
-	std::string msg = RenX::escapifyRCON(message);
+	return sendEscapedMessage(escapifyScratch(message));
+}
+
+int RenX::Server::sendEscapedMessage(std::string_view msg) {
 	if (m_neverSay) {
 		int result = 0;
-		if (this->players.size() != 0) {
-			for (auto node = this->players.begin(); node != this->players.end(); ++node) {
-				if (node->isBot == false) {
-					result += sendSocket(string_printf("chostprivatesay pid%d %.*s\n", node->id, msg.size(),
-						msg.data()));
+		for (const auto& player : this->players) {
+			if (player.isBot == false) {
+				int sent = sendChat({ "chostprivatesay "sv, pid_string{ player.id }, " "sv, msg, "\n"sv });
+				if (sent < 0) {
+					return sent;
 				}
+
+				result += sent;
 			}
 		}
 		return result;
 	}
 
-	return sendSocket("chostsay "s + msg + '\n');
+	return sendChat({ "chostsay "sv, msg, "\n"sv });
 }
 
 int RenX::Server::sendMessage(const RenX::PlayerInfo &player, std::string_view message) {
-	return sendSocket("chostprivatesay pid"s + string_printf("%d ", player.id) + RenX::escapifyRCON(message) + '\n');
+	return sendChat({ "chostprivatesay "sv, pid_string{ player.id }, " "sv, escapifyScratch(message), "\n"sv });
 }
 
 int RenX::Server::sendAdminMessage(std::string_view message) {
-	return sendSocket("camsg "s + RenX::escapifyRCON(message) + '\n');
+	return sendChat({ "camsg "sv, escapifyScratch(message), "\n"sv });
 }
 
 int RenX::Server::sendAdminMessage(const RenX::PlayerInfo &player, std::string_view message) {
-	return sendSocket("cpamsg pid"s + string_printf("%d ", player.id) + RenX::escapifyRCON(message) + '\n');
+	return sendChat({ "cpamsg "sv, pid_string{ player.id }, " "sv, escapifyScratch(message), "\n"sv });
 }
 
 int RenX::Server::sendWarnMessage(const RenX::PlayerInfo &player, std::string_view message) {
-	return sendSocket("cwarn pid"s + string_printf("%d ", player.id) + RenX::escapifyRCON(message) + '\n');
+	return sendSocket({ "cwarn "sv, pid_string{ player.id }, " "sv, escapifyScratch(message), "\n"sv });
 }
 
 int RenX::Server::sendData(std::string_view data) {
@@ -354,31 +552,105 @@ std::chrono::milliseconds RenX::Server::getGameTime(const RenX::PlayerInfo &play
 }
 
 size_t RenX::Server::getBotCount() const {
-	size_t count = 0;
+	return m_bot_count;
+}
 
-	for (auto node = this->players.begin(); node != this->players.end(); ++node) {
-		if (node->isBot) {
-			++count;
-		}
+size_t RenX::Server::getHumanCount() const {
+	return this->players.size() - m_bot_count;
+}
+
+size_t RenX::Server::getTeamPlayerCount(RenX::TeamType team, bool includeBots) const {
+	const TeamAggregate& aggregate = m_teams[static_cast<size_t>(team)];
+	if (includeBots) {
+		return aggregate.players;
 	}
 
-	return count;
-	//return RenX::Server::bot_count;
+	return aggregate.players - aggregate.bots;
 }
 
-std::vector<const RenX::PlayerInfo*> RenX::Server::activePlayers(bool includeBots) const {
-	std::vector<const RenX::PlayerInfo*> result;
-	result.reserve(players.size());
+double RenX::Server::getTeamScore(RenX::TeamType team) const {
+	return m_teams[static_cast<size_t>(team)].score;
+}
 
-	// Build list of active players
-	for (auto& player : players) {
-		// Filter teamless players and bots (if applicable)
-		if (player.team != TeamType::None && (includeBots || !player.isBot)) {
-			result.push_back(&player);
-		}
+size_t RenX::Server::getActivePlayerCount(bool includeBots) const {
+	return getTeamPlayerCount(TeamType::GDI, includeBots)
+		+ getTeamPlayerCount(TeamType::Nod, includeBots)
+		+ getTeamPlayerCount(TeamType::Other, includeBots);
+}
+
+RenX::Server::ActivePlayers RenX::Server::activePlayers(bool includeBots) const {
+	return { this->players, getActivePlayerCount(includeBots), includeBots };
+}
+
+RenX::Server::ActivePlayers::iterator::iterator(std::list<RenX::PlayerInfo>::const_iterator in_itr, std::list<RenX::PlayerInfo>::const_iterator in_end, bool in_includeBots)
+	: m_itr{ in_itr },
+	m_end{ in_end },
+	m_includeBots{ in_includeBots } {
+	skip();
+}
+
+RenX::Server::ActivePlayers::iterator::value_type RenX::Server::ActivePlayers::iterator::operator*() const {
+	return &*m_itr;
+}
+
+RenX::Server::ActivePlayers::iterator RenX::Server::ActivePlayers::begin() const {
+	return { m_players->begin(), m_players->end(), m_includeBots };
+}
+
+RenX::Server::ActivePlayers::iterator RenX::Server::ActivePlayers::end() const {
+	return { m_players->end(), m_players->end(), m_includeBots };
+}
+
+void RenX::Server::ActivePlayers::iterator::skip() {
+	// Filter teamless players and bots (if applicable)
+	while (m_itr != m_end
+		&& (m_itr->team == TeamType::None || (!m_includeBots && m_itr->isBot))) {
+		++m_itr;
 	}
+}
 
-	return result;
+void RenX::Server::aggregatePlayer(const RenX::PlayerInfo &player) {
+	if (player.id == 0) {
+		return;
+	}
+
+	TeamAggregate& aggregate = m_teams[static_cast<size_t>(player.team)];
+	++aggregate.players;
+	aggregate.score += player.score();
+	if (player.isBot) {
+		++aggregate.bots;
+		++m_bot_count;
+	}
+}
+
+void RenX::Server::unaggregatePlayer(const RenX::PlayerInfo &player) {
+	if (player.id == 0) {
+		return;
+	}
+
+	TeamAggregate& aggregate = m_teams[static_cast<size_t>(player.team)];
+	--aggregate.players;
+	aggregate.score -= player.score();
+	if (player.isBot) {
+		--aggregate.bots;
+		--m_bot_count;
+	}
+}
+
+void RenX::Server::setPlayerTeam(RenX::PlayerInfo &player, RenX::TeamType team) {
+	if (player.team != team) {
+		unaggregatePlayer(player);
+		player.team = team;
+		aggregatePlayer(player);
+	}
+}
+
+void RenX::Server::setPlayerScore(RenX::PlayerInfo &player, double score) {
+	if (player.id != 0) {
+		m_teams[static_cast<size_t>(player.team)].score += score - player.score();
+	}
+
+	player.score() = score;
 }
 
 RenX::PlayerInfo *RenX::Server::getPlayer(int id) const {
@@ -471,12 +743,12 @@ std::string RenX::Server::formatSteamID(uint64_t id) const {
 }
 
 void RenX::Server::kickPlayer(int id, std::string_view in_reason) {
-	std::string reason = RenX::escapifyRCON(in_reason);
+	std::string_view reason = escapifyScratch(in_reason);
 
 	if (reason.empty())
-		sendSocket(string_printf("ckick pid%d\n", id));
+		sendSocket({ "ckick "sv, pid_string{ id }, "\n"sv });
 	else
-		sendSocket(string_printf("ckick pid%d %.*s\n", id, reason.size(), reason.data()));
+		sendSocket({ "ckick "sv, pid_string{ id }, " "sv, reason, "\n"sv });
 }
 
 void RenX::Server::kickPlayer(const RenX::PlayerInfo &player, std::string_view reason) {
@@ -486,14 +758,14 @@ void RenX::Server::kickPlayer(const RenX::PlayerInfo &player, std::string_view r
 }
 
 void RenX::Server::forceKickPlayer(int id, std::string_view in_reason) {
-	std::string reason = RenX::escapifyRCON(in_reason);
+	std::string_view reason = escapifyScratch(in_reason);
 
 	if (reason.empty()) {
-		sendSocket(string_printf("cfkick pid%d You were kicked from the server.\n", id));
+		sendSocket({ "cfkick "sv, pid_string{ id }, " You were kicked from the server.\n"sv });
 		return;
 	}
 
-	sendSocket(string_printf("cfkick pid%d %.*s\n", id, reason.size(), reason.data()));
+	sendSocket({ "cfkick "sv, pid_string{ id }, " "sv, reason, "\n"sv });
 }
 
 void RenX::Server::forceKickPlayer(const RenX::PlayerInfo &player, std::string_view reason) {
@@ -517,6 +789,7 @@ void RenX::Server::banCheck(RenX::PlayerInfo &player) {
 		return;
 	}
 
+	auto check_start = std::chrono::steady_clock::now();
 	uint32_t netmask;
 
 	RenX::BanDatabase::Entry* last_to_expire[7]; // TODO: what the fuck is this?
@@ -575,6 +848,7 @@ void RenX::Server::banCheck(RenX::PlayerInfo &player) {
 			}
 		}
 	}
+	m_banCheckMetric->observe(std::chrono::steady_clock::now() - check_start);
 
 	char timeStr[256];
 	if (last_to_expire[0] != nullptr) { // Game ban
@@ -676,8 +950,8 @@ void RenX::Server::banCheck(RenX::PlayerInfo &player) {
 
 void RenX::Server::banPlayer(int id, std::string_view banner, std::string_view reason) {
 	if (m_rconBan) {
-		std::string out_reason = RenX::escapifyRCON(reason);
-		sendSocket(string_printf("ckickban pid%d %.*s\n", id, out_reason.size(), out_reason.data()));
+		std::string_view out_reason = escapifyScratch(reason);
+		sendSocket({ "ckickban "sv, pid_string{ id }, " "sv, out_reason, "\n"sv });
 	}
 	else {
 		RenX::PlayerInfo *player = getPlayer(id);
@@ -695,9 +969,8 @@ void RenX::Server::banPlayer(const RenX::PlayerInfo &player, std::string_view ba
 
 		if (length == std::chrono::seconds::zero()) {
 			if (m_rconBan) {
-				std::string out_reason = RenX::escapifyRCON(reason);
-				sendSocket(string_printf("ckickban pid%d %.*s\n", player.id, out_reason.size(),
-					out_reason.data()));
+				std::string_view out_reason = escapifyScratch(reason);
+				sendSocket({ "ckickban "sv, pid_string{ player.id }, " "sv, out_reason, "\n"sv });
 			}
 			else if (!banner.empty()) {
 				forceKickPlayer(player, string_printf("You are permanently banned from %.*s by %.*s for: %.*s", m_ban_from_str.size(),
@@ -731,14 +1004,14 @@ bool RenX::Server::removePlayer(int id) {
 				plugin->RenX_OnPlayerDelete(*this, *node);
 			}
 
-			if (node->isBot) {
-				--m_bot_count;
-			}
+			unaggregatePlayer(*node);
 
 			if (node->rdns_pending) {
 				--m_player_rdns_resolutions_pending;
 			}
 
+			RenX::playerIndex->remove(*node);
+			RenX::eventRates->forget(*node);
 			this->players.erase(node);
 			return true;
 		}
@@ -763,25 +1036,67 @@ bool RenX::Server::fetchClientList() {
 		&& sendSocket("cbotvarlist KILLS\xA0""DEATHS\xA0""SCORE\xA0""CREDITS\xA0""CHARACTER\xA0""VEHICLE\xA0""PLAYERLOG\n"sv) > 0;
 }
 
-bool RenX::Server::updateClientList() {
+bool RenX::Server::updateClientList(std::function<void(RenX::Server &server)> callback, const void *owner) {
 	m_lastClientListUpdate = std::chrono::steady_clock::now();
 
-	int result = 0;
-	if (this->players.size() != getBotCount()) {
-		if (m_rconVersion >= 4)
-			result = sendSocket("cclientvarlist ID SCORE CREDITS PING\n"sv) > 0;
-		else
-			result = sendSocket("cclientvarlist ID\xA0""SCORE\xA0""CREDITS\xA0""PING\n"sv) > 0;
+	std::string_view client_line = m_rconVersion >= 4 ? "cclientvarlist ID SCORE CREDITS PING\n"sv : "cclientvarlist ID\xA0""SCORE\xA0""CREDITS\xA0""PING\n"sv;
+	std::string_view bot_line = m_rconVersion >= 4 ? "cbotvarlist ID SCORE CREDITS\n"sv : "cbotvarlist ID\xA0""SCORE\xA0""CREDITS\n"sv;
+	bool send_clients = getHumanCount() != 0;
+	bool send_bots = getBotCount() != 0;
+
+	if (callback == nullptr) {
+		int result = 0;
+		if (send_clients) {
+			result = sendSocket(client_line) > 0;
+		}
+
+		if (send_bots) {
+			result |= sendSocket(bot_line) > 0;
+		}
+
+		return result != 0;
 	}
 
-	if (getBotCount() != 0) {
-		if (m_rconVersion >= 4)
-			result |= sendSocket("cbotvarlist ID SCORE CREDITS\n"sv) > 0;
-		else
-			result |= sendSocket("cbotvarlist ID\xA0""SCORE\xA0""CREDITS\n"sv) > 0;
+	// Responses arrive in the order requested, so only the last list needs to call back
+	RenX::RCONCallback list_callback = [callback = std::move(callback)](RenX::Server &server, const RenX::RCONResponse &response) {
+		if (response.completed) {
+			callback(server);
+		}
+	};
+
+	bool result = false;
+	if (send_clients) {
+		result = submitRequest({ client_line }, "clientvarlist"sv, send_bots ? nullptr : list_callback, owner);
 	}
 
-	return result != 0;
+	if (send_bots) {
+		result |= submitRequest({ bot_line }, "botvarlist"sv, list_callback, owner);
+	}
+
+	return result;
+}
+
+void RenX::Server::onCombatEvent() {
+	++m_combatEvents;
+
+	// Bring a backed off refresh forward, rather than waiting out the rest of the long interval
+	if (m_adaptiveClientUpdate && m_clientUpdateRateCurrent > m_clientUpdateRate) {
+		m_clientUpdateRateCurrent = m_clientUpdateRate;
+	}
+}
+
+void RenX::Server::adjustClientUpdateRate() {
+	if (m_combatEvents != 0) {
+		// Shorten the interval in proportion to recent combat, down to the configured rate
+		m_clientUpdateRateCurrent = std::max(m_clientUpdateRate, m_clientUpdateRateCurrent / (1 + m_combatEvents));
+	}
+	else if (m_clientListChanges == 0) {
+		// Nothing moved; back off
+		m_clientUpdateRateCurrent = std::min(m_clientUpdateRateMax, m_clientUpdateRateCurrent * 2);
+	}
+
+	m_combatEvents = 0;
+	m_clientListChanges = 0;
 }
 
 bool RenX::Server::updateBuildingList() {
@@ -814,7 +1129,7 @@ bool RenX::Server::gameoverStop() {
 }
 
 void RenX::Server::gameoverWhenEmpty() {
-	if (this->players.size() == this->getBotCount()) {
+	if (this->getHumanCount() == 0) {
 		gameover();
 		return;
 	}
@@ -1050,20 +1365,37 @@ std::string_view RenX::Server::getName() const {
 	return m_serverName;
 }
 
+uint64_t RenX::Server::getID() const {
+	return m_id;
+}
+
 const RenX::Map &RenX::Server::getMap() const {
 	return m_map;
 }
 
 RenX::GameCommand *RenX::Server::getCommand(unsigned int index) const {
-	return m_commands[index].get();
+	return m_commands[index];
 }
 
 RenX::GameCommand *RenX::Server::getCommand(std::string_view trigger) const {
-	for (const auto& command : m_commands) {
-		if (command->matches(trigger)) {
-			return command.get();
+	auto itr = m_commandIndex.find(trigger);
+	if (itr != m_commandIndex.end()) {
+		return itr->second;
+	}
+
+	RenX::GameCommand *command = RenX::getCore()->getCommand(trigger);
+	if (command == nullptr || m_hiddenCommands.find(command) == m_hiddenCommands.end()) {
+		return command;
+	}
+
+	// The core's first match is hidden here; another shared command may still use the trigger. Hidden commands are
+	// never in m_commands, and owned commands would have matched above, so the first match is the visible one.
+	for (const auto& server_command : m_commands) {
+		if (server_command->matches(trigger)) {
+			return server_command;
 		}
 	}
+
 	return nullptr;
 }
 
@@ -1073,22 +1405,21 @@ size_t RenX::Server::getCommandCount() const {
 
 RenX::GameCommand *RenX::Server::triggerCommand(std::string_view trigger, RenX::PlayerInfo &player, std::string_view parameters) {
 	RenX::GameCommand::active_server = this;
-	for (const auto& command : m_commands) {
-		if (command->matches(trigger)) {
-			if (player.access >= command->getAccessLevel()) {
-				command->trigger(this, &player, parameters);
-			}
-			else {
-				sendMessage(player, "Access Denied."sv);
-			}
-
-			// TODO: avoiding modifying behavior for now, but this probably doesn't need to be called on access denied
-			for (const auto& plugin : getCore()->getPlugins()) {
-				plugin->RenX_OnCommandTriggered(*this, trigger, player, parameters, *command);
-			}
+	RenX::GameCommand *command = getCommand(trigger);
+	if (command != nullptr) {
+		if (player.access >= command->getAccessLevel()) {
+			command->trigger(this, &player, parameters);
+		}
+		else {
+			sendMessage(player, "Access Denied."sv);
+		}
 
-			return command.get();
+		// TODO: avoiding modifying behavior for now, but this probably doesn't need to be called on access denied
+		for (const auto& plugin : getCore()->getPlugins()) {
+			plugin->RenX_OnCommandTriggered(*this, trigger, player, parameters, *command);
 		}
+
+		return command;
 	}
 
 	// TODO: do we need to set active_server on the return above as well?
@@ -1120,29 +1451,85 @@ void RenX::Server::addCommand(RenX::GameCommand* in_command) {
 		}
 	}
 
-	m_commands.push_back(std::move(command));
+	indexCommand(command.get());
+	m_commands.push_back(command.get());
+	m_ownedCommands.push_back(std::move(command));
+}
+
+void RenX::Server::addSharedCommand(RenX::GameCommand *in_command) {
+	std::string_view trigger = in_command->getTrigger();
+	bool configured = (m_commandAccessLevels != nullptr && !m_commandAccessLevels->get(trigger).empty())
+		|| (m_commandAliases != nullptr && !m_commandAliases->get(trigger).empty());
+
+	if (configured) {
+		// Copied (or disabled) for this server; the shared command must not be found through the core's index
+		m_hiddenCommands.insert(in_command);
+		size_t owned_count = m_ownedCommands.size();
+		addCommand(in_command->copy());
+		if (m_ownedCommands.size() != owned_count) {
+			m_commandCopies.emplace(in_command, m_ownedCommands.back().get());
+		}
+		return;
+	}
+
+	m_commands.push_back(in_command);
+}
+
+void RenX::Server::releaseSharedCommand(RenX::GameCommand *in_command) {
+	auto copy = m_commandCopies.find(in_command);
+	if (copy != m_commandCopies.end()) {
+		removeCommand(copy->second);
+	}
+
+	auto itr = std::find(m_commands.begin(), m_commands.end(), in_command);
+	if (itr != m_commands.end()) {
+		m_commands.erase(itr);
+	}
+	m_hiddenCommands.erase(in_command);
 }
 
 bool RenX::Server::removeCommand(RenX::GameCommand *command) {
-	for (auto itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
-		if (itr->get() == command) {
-			m_commands.erase(itr);
+	auto itr = std::find(m_commands.begin(), m_commands.end(), command);
+	if (itr == m_commands.end()) {
+		return false;
+	}
+	m_commands.erase(itr);
+
+	for (auto owned_itr = m_ownedCommands.begin(); owned_itr != m_ownedCommands.end(); ++owned_itr) {
+		if (owned_itr->get() == command) {
+			std::erase_if(m_commandCopies, [command](const auto& entry) { return entry.second == command; });
+			m_ownedCommands.erase(owned_itr);
+			rebuildCommandIndex();
 			return true;
 		}
 	}
 
-	return false;
+	// Shared command; keep it from being found through the core's index
+	m_hiddenCommands.insert(command);
+	return true;
 }
 
 bool RenX::Server::removeCommand(std::string_view trigger) {
-	for (auto itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
-		if ((*itr)->matches(trigger)) {
-			m_commands.erase(itr);
-			return true;
-		}
+	RenX::GameCommand *command = getCommand(trigger);
+	if (command == nullptr) {
+		return false;
 	}
 
-	return false;
+	return removeCommand(command);
+}
+
+void RenX::Server::indexCommand(RenX::GameCommand *command) {
+	// First command added for a trigger wins, matching the order commands are searched in
+	for (size_t index = 0; index != command->getTriggerCount(); ++index) {
+		m_commandIndex.try_emplace(static_cast<std::string>(command->getTrigger(index)), command);
+	}
+}
+
+void RenX::Server::rebuildCommandIndex() {
+	m_commandIndex.clear();
+	for (const auto& command : m_ownedCommands) {
+		indexCommand(command.get());
+	}
 }
 
 void RenX::Server::setUUIDFunction(RenX::Server::uuid_func func) {
@@ -1188,6 +1575,7 @@ void RenX::Server::sendPubChan(const char *fmt, ...) const {
 	}
 	message += vstring_printf(fmt, args);
 
+	m_ircMessagesMetric->add(serverManager->size());
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		serverManager->getServer(i)->messageChannels(m_logChanType, message);
 	}
@@ -1201,6 +1589,7 @@ void RenX::Server::sendPubChan(std::string_view msg) const {
 		message = prefix;
 		message += ' ';
 		message += msg;
+		m_ircMessagesMetric->add(serverManager->size());
 		for (size_t i = 0; i != serverManager->size(); i++) {
 			serverManager->getServer(i)->messageChannels(m_logChanType, message);
 		}
@@ -1208,6 +1597,7 @@ void RenX::Server::sendPubChan(std::string_view msg) const {
 		return;
 	}
 
+	m_ircMessagesMetric->add(serverManager->size());
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		serverManager->getServer(i)->messageChannels(m_logChanType, msg);
 	}
@@ -1223,6 +1613,7 @@ void RenX::Server::sendAdmChan(const char *fmt, ...) const {
 	}
 	message += vstring_printf(fmt, args);
 
+	m_ircMessagesMetric->add(serverManager->size());
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		serverManager->getServer(i)->messageChannels(m_adminLogChanType, message);
 	}
@@ -1236,6 +1627,7 @@ void RenX::Server::sendAdmChan(std::string_view msg) const {
 		message = prefix;
 		message += ' ';
 		message += msg;
+		m_ircMessagesMetric->add(serverManager->size());
 		for (size_t i = 0; i != serverManager->size(); i++) {
 			serverManager->getServer(i)->messageChannels(m_adminLogChanType, message);
 		}
@@ -1243,6 +1635,7 @@ void RenX::Server::sendAdmChan(std::string_view msg) const {
 		return;
 	}
 
+	m_ircMessagesMetric->add(serverManager->size());
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		serverManager->getServer(i)->messageChannels(m_adminLogChanType, msg);
 	}
@@ -1259,6 +1652,7 @@ void RenX::Server::sendLogChan(const char *fmt, ...) const {
 	message += vstring_printf(fmt, args);
 
 	IRC_Bot* server;
+	m_ircMessagesMetric->add(serverManager->size() * 2);
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		server = serverManager->getServer(i);
 		server->messageChannels(m_logChanType, message);
@@ -1275,6 +1669,7 @@ void RenX::Server::sendLogChan(std::string_view msg) const {
 		message = prefix;
 		message += ' ';
 		message += msg;
+		m_ircMessagesMetric->add(serverManager->size() * 2);
 		for (size_t i = 0; i != serverManager->size(); i++)
 		{
 			server = serverManager->getServer(i);
@@ -1285,6 +1680,7 @@ void RenX::Server::sendLogChan(std::string_view msg) const {
 		return;
 	}
 
+	m_ircMessagesMetric->add(serverManager->size() * 2);
 	for (size_t i = 0; i != serverManager->size(); i++) {
 		server = serverManager->getServer(i);
 		server->messageChannels(m_logChanType, msg);
@@ -1312,9 +1708,8 @@ struct parsed_player_token {
 	bool isPlayer{}; // i.e: they appear on the player list; not "ai"
 };
 
-// TODO: consider a simplified & more specific parser for RCON escape sequences
 void process_escape_sequences(std::string& out_string) {
-	jessilib::apply_cpp_escape_sequences(out_string);
+	RenX::unescapifyRCON(out_string);
 }
 
 void RenX::Server::processLine(std::string_view line) {
@@ -1326,10 +1721,9 @@ void RenX::Server::processLine(std::string_view line) {
 	auto tokens_view = jessilib::split_view(in_line, m_rconVersion == 3 ? RenX::DelimC3 : RenX::DelimC);
 	std::vector<std::string> tokens;
 
+	tokens.reserve(tokens_view.size());
 	for (auto& token : tokens_view) {
-		std::string parsed_token = std::string(token);
-		process_escape_sequences(parsed_token);
-		tokens.push_back(std::move(parsed_token));
+		RenX::unescapifyRCON(token, tokens.emplace_back());
 	}
 
 	// Safety checker for getting a token at an index
@@ -1342,19 +1736,116 @@ void RenX::Server::processLine(std::string_view line) {
 	};
 
 	auto consume_tokens_as_command_list_format = [&tokens, this]() {
-		for (auto& token : tokens) {
-			m_commandListFormat.push_back(static_cast<std::string>(token));
+		compileCommandListFormat(tokens);
+	};
+
+	// Fetches a row's value for a column of the compiled list format, or nullptr if the column isn't in this response
+	auto column_get = [&tokens, this](ListColumn in_column) -> const std::string* {
+		size_t index = m_commandListFormat[static_cast<size_t>(in_column)];
+		if (index < tokens.size()) {
+			return &tokens[index];
+		}
+
+		return nullptr;
+	};
+
+	auto column_get_ref = [&column_get](ListColumn in_column) -> std::string_view {
+		const std::string *value = column_get(in_column);
+		if (value != nullptr) {
+			return *value;
+		}
+
+		return {};
+	};
+
+	// Columns shared by clientvarlist and botvarlist rows; only fields which differ are written, and are recorded in out_delta
+	auto parse_player_columns = [this, &column_get](RenX::PlayerInfo *player, RenX::PlayerDelta &out_delta) {
+		const std::string *value;
+
+		value = column_get(ListColumn::Kills);
+		if (value != nullptr) {
+			unsigned int kills = Jupiter::from_string<unsigned int>(*value);
+			if (kills != player->kills()) {
+				out_delta.fields |= RenX::PlayerField::Kills;
+				out_delta.kills = player->kills();
+				player->kills() = kills;
+			}
+		}
+
+		value = column_get(ListColumn::Deaths);
+		if (value != nullptr) {
+			unsigned int deaths = Jupiter::from_string<unsigned int>(*value);
+			if (deaths != player->deaths()) {
+				out_delta.fields |= RenX::PlayerField::Deaths;
+				out_delta.deaths = player->deaths();
+				player->deaths() = deaths;
+			}
+		}
+
+		value = column_get(ListColumn::Score);
+		if (value != nullptr) {
+			double score = Jupiter::from_string<double>(*value);
+			if (score != player->score()) {
+				out_delta.fields |= RenX::PlayerField::Score;
+				out_delta.score = player->score();
+				setPlayerScore(*player, score);
+			}
+		}
+
+		value = column_get(ListColumn::Credits);
+		if (value != nullptr) {
+			double credits = Jupiter::from_string<double>(*value);
+			if (credits != player->credits()) {
+				out_delta.fields |= RenX::PlayerField::Credits;
+				out_delta.credits = player->credits();
+				player->credits() = credits;
+			}
+		}
+
+		value = column_get(ListColumn::Character);
+		if (value != nullptr) {
+			RenX::Symbol character = RenX::symbols->intern(*value);
+			if (character != player->character_id) {
+				out_delta.fields |= RenX::PlayerField::Character;
+				player->character_id = character;
+			}
+		}
+
+		value = column_get(ListColumn::Vehicle);
+		if (value != nullptr) {
+			RenX::Symbol vehicle = RenX::symbols->intern(*value);
+			if (vehicle != player->vehicle_id) {
+				out_delta.fields |= RenX::PlayerField::Vehicle;
+				player->vehicle_id = vehicle;
+			}
 		}
 	};
 
-	auto tokens_as_command_table = [&tokens, this]() {
-		std::unordered_map<std::string_view, std::string_view> table;
-		size_t total_tokens = std::min(tokens.size(), m_commandListFormat.size());
-		for (size_t index = 0; index != total_tokens; ++index) {
-			table[m_commandListFormat[index]] = tokens[index];
+	auto dispatch_player_delta = [this, &xPlugins](RenX::PlayerInfo *player, const RenX::PlayerDelta &delta) {
+		if (delta.fields == 0) {
+			return;
 		}
 
-		return table;
+		if ((delta.fields & (RenX::PlayerField::Score | RenX::PlayerField::Credits | RenX::PlayerField::Ping)) != 0) {
+			++m_clientListChanges;
+		}
+
+		for (const auto& plugin : xPlugins) {
+			plugin->RenX_OnPlayerDelta(*this, *player, delta);
+		}
+	};
+
+	auto parse_team_column = [this, &column_get](RenX::PlayerInfo *player) {
+		const std::string *value = column_get(ListColumn::TeamNum);
+		if (value != nullptr) {
+			setPlayerTeam(*player, RenX::getTeam(Jupiter::from_string<int>(*value)));
+			return;
+		}
+
+		value = column_get(ListColumn::Team);
+		if (value != nullptr) {
+			setPlayerTeam(*player, RenX::getTeam(*value));
+		}
 	};
 
 	/** Local functions */
@@ -1365,9 +1856,9 @@ void RenX::Server::processLine(std::string_view line) {
 			for (auto node = this->players.begin(); node != this->players.end(); ++node)
 			{
 				if (node->team == team)
-					++node->wins;
+					++node->wins();
 				else
-					++node->loses;
+					++node->loses();
 			}
 		}
 	};
@@ -1381,24 +1872,9 @@ void RenX::Server::processLine(std::string_view line) {
 			wipePlayers();
 		else
 		{
-			for (auto node = this->players.begin(); node != this->players.end(); ++node)
-			{
-				node->score = 0.0f;
-				node->credits = 0.0f;
-				node->kills = 0;
-				node->deaths = 0;
-				node->suicides = 0;
-				node->headshots = 0;
-				node->vehicleKills = 0;
-				node->buildingKills = 0;
-				node->defenceKills = 0;
-				node->beaconPlacements = 0;
-				node->beaconDisarms = 0;
-				node->proxy_placements = 0;
-				node->proxy_disarms = 0;
-				node->captures = 0;
-				node->steals = 0;
-				node->stolen = 0;
+			stats.resetMatch();
+			for (auto& team : m_teams) {
+				team.score = 0.0;
 			}
 		}
 	};
@@ -1465,15 +1941,14 @@ void RenX::Server::processLine(std::string_view line) {
 		return result;
 	};
 	auto get_next_temp_playerinfo = [](std::string_view name, RenX::TeamType team, bool isBot) {
-		static RenX::PlayerInfo s_temp_players[4];
-		static size_t s_temp_player_index{ 0 };
+		DetachedPlayers& detached = detached_players();
 
 		// Go to next temp player
-		++s_temp_player_index;
-		if (s_temp_player_index >= sizeof(s_temp_players) / sizeof(RenX::PlayerInfo)) {
-			s_temp_player_index = 0;
+		++detached.temp_index;
+		if (detached.temp_index >= std::size(detached.temp_players)) {
+			detached.temp_index = 0;
 		}
-		RenX::PlayerInfo *temp_player = &s_temp_players[s_temp_player_index];
+		RenX::PlayerInfo *temp_player = &detached.temp_players[detached.temp_index];
 
 		// Populate temp player with input data
 		temp_player->name = name;
@@ -1487,8 +1962,7 @@ void RenX::Server::processLine(std::string_view line) {
 		if (id == 0) {
 			if (name.empty()) {
 				// Bad parse; return null player
-				static RenX::PlayerInfo s_null_player;
-				return &s_null_player;
+				return &detached_players().null_player;
 			}
 
 			return get_next_temp_playerinfo(name, team, isBot);
@@ -1498,7 +1972,7 @@ void RenX::Server::processLine(std::string_view line) {
 		if (player == nullptr)
 		{
 			// Initialize a new player
-			this->players.emplace_back();
+			this->players.emplace_back(stats);
 			player = &this->players.back();
 			player->id = id;
 			player->name = name;
@@ -1523,14 +1997,14 @@ void RenX::Server::processLine(std::string_view line) {
 			//	this->players.add(r);
 
 			player->uuid = m_calc_uuid(*player);
+			RenX::playerIndex->update(*this, *player);
+			aggregatePlayer(*player);
 
 			if (player->isBot == false)
 			{
 				RenX::exemptionDatabase->exemption_check(*player);
 				banCheck(*player);
 			}
-			else
-				++m_bot_count;
 
 			for (const auto& plugin : xPlugins) {
 				plugin->RenX_OnPlayerCreate(*this, *player);
@@ -1539,7 +2013,7 @@ void RenX::Server::processLine(std::string_view line) {
 		else
 		{
 			bool recalcUUID = false;
-			player->team = team;
+			setPlayerTeam(*player, team);
 			if (player->ip32 == 0 && !ip.empty())
 			{
 				player->ip = ip;
@@ -1568,6 +2042,7 @@ void RenX::Server::processLine(std::string_view line) {
 			}
 			if (recalcUUID)
 			{
+				RenX::playerIndex->update(*this, *player);
 				setUUIDIfDifferent(*player, m_calc_uuid(*player));
 				if (player->isBot == false)
 				{
@@ -1620,6 +2095,11 @@ void RenX::Server::processLine(std::string_view line) {
 		switch (header)
 		{
 		case 'r':
+			if (m_requestExecuting) {
+				auto& row = m_requests.front().response.rows.emplace_back(tokens);
+				row[0].erase(0, 1);
+			}
+
 			if (jessilib::equalsi(m_lastCommand, "clientlist"sv))
 			{
 				// ID | IP | Steam ID | Admin Status | Team | Name
@@ -1652,7 +2132,7 @@ void RenX::Server::processLine(std::string_view line) {
 			}
 			else if (jessilib::equalsi(m_lastCommand, "clientvarlist"sv))
 			{
-				if (m_commandListFormat.empty()) {
+				if (!m_commandListFormatCompiled) {
 					consume_tokens_as_command_list_format();
 				}
 				else
@@ -1662,78 +2142,52 @@ void RenX::Server::processLine(std::string_view line) {
 					rPlayerLog�Kills�PlayerKills�BotKills�Deaths�Score�Credits�Character�BoundVehicle�Vehicle�Spy�RemoteC4�ATMine�KDR�Ping�Admin�Steam�IP�ID�Name�Team�TeamNum
 					rGDI,256,EKT-J�0�0�0�0�0�5217.9629�Rx_FamilyInfo_GDI_Soldier���False�0�0�0.0000�8�None�0x0110000104AE0666�127.0.0.1�256�EKT-J�GDI�0
 					*/
-					auto table = tokens_as_command_table();
-
-					auto table_get = [&table](std::string_view  in_key) -> std::string_view* {
-						auto value = table.find(in_key);
-						if (value != table.end()) {
-							return &value->second;
-						}
-
-						return nullptr;
-					};
-
-					auto table_get_ref = [&table](std::string_view  in_key, std::string_view  in_default_value) -> std::string_view  {
-						auto value = table.find(in_key);
-						if (value != table.end()) {
-							return value->second;
-						}
-
-						return in_default_value;
-					};
-
-					auto parse = [&table_get](RenX::PlayerInfo *player) {
-						std::string_view *value;
-
-						value = table_get("KILLS"sv);
-						if (value != nullptr)
-							player->kills = Jupiter::from_string<unsigned int>(*value);
-
-						value = table_get("DEATHS"sv);
-						if (value != nullptr)
-							player->deaths = Jupiter::from_string<unsigned int>(*value);
-
-						value = table_get("SCORE"sv);
-						if (value != nullptr)
-							player->score = Jupiter::from_string<double>(*value);
-
-						value = table_get("CREDITS"sv);
-						if (value != nullptr)
-							player->credits = Jupiter::from_string<double>(*value);
-
-						value = table_get("CHARACTER"sv);
-						if (value != nullptr)
-							player->character = *value;
+					auto parse = [&column_get, &parse_player_columns, &dispatch_player_delta](RenX::PlayerInfo *player) {
+						const std::string *value;
+						RenX::PlayerDelta delta;
 
-						value = table_get("VEHICLE"sv);
-						if (value != nullptr)
-							player->vehicle = *value;
+						parse_player_columns(player, delta);
 
-						value = table_get("PING"sv);
+						value = column_get(ListColumn::Ping);
 						if (value != nullptr)
-							player->ping = Jupiter::from_string<unsigned short>(*value);
+						{
+							unsigned short ping = Jupiter::from_string<unsigned short>(*value);
+							if (ping != player->ping)
+							{
+								delta.fields |= RenX::PlayerField::Ping;
+								delta.ping = player->ping;
+								player->ping = ping;
+							}
+						}
 
-						value = table_get("ADMIN"sv);
+						value = column_get(ListColumn::Admin);
 						if (value != nullptr)
 						{
-							if (*value == "None"sv)
-								player->adminType = "";
-							else
-								player->adminType = *value;
+							std::string_view adminType = *value;
+							if (adminType == "None"sv)
+								adminType = ""sv;
+
+							if (adminType != player->adminType)
+							{
+								delta.fields |= RenX::PlayerField::Admin;
+								player->adminType = adminType;
+							}
 						}
+
+						dispatch_player_delta(player, delta);
 					};
-					std::string_view *value = table_get("PLAYERLOG"sv);
+					const std::string *value = column_get(ListColumn::PlayerLog);
 					if (value != nullptr) {
 						auto parsed_token = parsePlayerData(*value);
 						parse(getPlayerOrAdd(parsed_token.name, parsed_token.id, parsed_token.team, false,
-							Jupiter::from_string<unsigned long long>(table_get_ref("STEAM"sv, ""sv)),
-							table_get_ref("IP"sv, ""sv),
-							table_get_ref("HWID"sv, ""sv)));
+							Jupiter::from_string<unsigned long long>(column_get_ref(ListColumn::Steam)),
+							column_get_ref(ListColumn::IP),
+							column_get_ref(ListColumn::HWID)));
 					}
 					else
 					{
-						std::string_view *name = table_get("NAME"sv);
-						value = table_get("ID"sv);
+						const std::string *name = column_get(ListColumn::Name);
+						value = column_get(ListColumn::ID);
 
 						if (value != nullptr)
 						{
@@ -1742,16 +2196,16 @@ void RenX::Server::processLine(std::string_view line) {
 							{
 								if (player->name.empty())
 								{
-									player->name = table_get_ref("NAME"sv, ""sv);
+									player->name = column_get_ref(ListColumn::Name);
 									process_escape_sequences(player->name);
 								}
 								if (player->ip.empty())
-									player->ip = table_get_ref("IP"sv, ""sv);
+									player->ip = column_get_ref(ListColumn::IP);
 								if (player->hwid.empty())
-									player->hwid = table_get_ref("HWID"sv, ""sv);
+									player->hwid = column_get_ref(ListColumn::HWID);
 								if (player->steamid == 0)
 								{
-									uint64_t steamid = Jupiter::from_string<uint64_t>(table_get_ref("STEAM"sv, ""sv));
+									uint64_t steamid = Jupiter::from_string<uint64_t>(column_get_ref(ListColumn::Steam));
 									if (steamid != 0)
 									{
 										player->steamid = steamid;
@@ -1759,17 +2213,9 @@ void RenX::Server::processLine(std::string_view line) {
 									}
 								}
 
-								value = table_get("TEAMNUM"sv);
-								if (value != nullptr)
-									player->team = RenX::getTeam(Jupiter::from_string<int>(*value));
-								else
-								{
-									value = table_get("TEAM"sv);
-									if (value != nullptr)
-										player->team = RenX::getTeam(*value);
-								}
-
+								parse_team_column(player);
 								parse(player);
+								RenX::playerIndex->update(*this, *player);
 							}
 							// I *could* try and fetch a player by name, but that seems like it *could* open a security hole.
 							// In addition, would I update their ID?
@@ -1780,12 +2226,12 @@ void RenX::Server::processLine(std::string_view line) {
 							if (player != nullptr)
 							{
 								if (player->ip.empty())
-									player->ip = table_get_ref("IP"sv, ""sv);
+									player->ip = column_get_ref(ListColumn::IP);
 								if (player->hwid.empty())
-									player->hwid = table_get_ref("HWID"sv, ""sv);
+									player->hwid = column_get_ref(ListColumn::HWID);
 								if (player->steamid == 0)
 								{
-									uint64_t steamid = Jupiter::from_string<uint64_t>(table_get_ref("STEAM"sv, ""sv));
+									uint64_t steamid = Jupiter::from_string<uint64_t>(column_get_ref(ListColumn::Steam));
 									if (steamid != 0)
 									{
 										player->steamid = steamid;
@@ -1793,17 +2239,9 @@ void RenX::Server::processLine(std::string_view line) {
 									}
 								}
 
-								value = table_get("TEAMNUM"sv);
-								if (value != nullptr)
-									player->team = RenX::getTeam(Jupiter::from_string<int>(*value));
-								else
-								{
-									value = table_get("TEAM"sv);
-									if (value != nullptr)
-										player->team = RenX::getTeam(*value);
-								}
-
+								parse_team_column(player);
 								parse(player);
+								RenX::playerIndex->update(*this, *player);
 							}
 							// No other way to identify player -- worthless command format.
 						}
@@ -1812,7 +2250,7 @@ void RenX::Server::processLine(std::string_view line) {
 			}
 			else if (jessilib::equalsi(m_lastCommand, "botlist"sv)) {
 				// Team,ID,Name
-				if (m_commandListFormat.empty()) {
+				if (!m_commandListFormatCompiled) {
 					consume_tokens_as_command_list_format();
 				}
 				else {
@@ -1820,7 +2258,7 @@ void RenX::Server::processLine(std::string_view line) {
 				}
 			}
 			else if (jessilib::equalsi(m_lastCommand, "botvarlist"sv)) {
-				if (m_commandListFormat.empty()) {
+				if (!m_commandListFormatCompiled) {
 					consume_tokens_as_command_list_format();
 				}
 				else
@@ -1830,55 +2268,12 @@ void RenX::Server::processLine(std::string_view line) {
 					rPlayerLog�Kills�PlayerKills�BotKills�Deaths�Score�Credits�Character�BoundVehicle�Vehicle�Spy�RemoteC4�ATMine�KDR�Ping�Admin�Steam�IP�ID�Name�Team�TeamNum
 					rGDI,256,EKT-J�0�0�0�0�0�5217.9629�Rx_FamilyInfo_GDI_Soldier���False�0�0�0.0000�8�None�0x0110000104AE0666�127.0.0.1�256�EKT-J�GDI�0
 					*/
-					auto table = tokens_as_command_table();
-
-					auto table_get = [&table](std::string_view  in_key) -> std::string_view* {
-						auto value = table.find(in_key);
-						if (value != table.end()) {
-							return &value->second;
-						}
-
-						return nullptr;
-					};
-
-					auto table_get_ref = [&table](std::string_view  in_key, std::string_view  in_default_value) -> std::string_view  {
-						auto value = table.find(in_key);
-						if (value != table.end()) {
-							return value->second;
-						}
-
-						return in_default_value;
-					};
-
-					auto parse = [&table_get](RenX::PlayerInfo *player)
-					{
-						std::string_view *value;
-
-						value = table_get("KILLS"sv);
-						if (value != nullptr)
-							player->kills = Jupiter::from_string<unsigned int>(*value);
-
-						value = table_get("DEATHS"sv);
-						if (value != nullptr)
-							player->deaths = Jupiter::from_string<unsigned int>(*value);
-
-						value = table_get("SCORE"sv);
-						if (value != nullptr)
-							player->score = Jupiter::from_string<double>(*value);
-
-						value = table_get("CREDITS"sv);
-						if (value != nullptr)
-							player->credits = Jupiter::from_string<double>(*value);
-
-						value = table_get("CHARACTER"sv);
-						if (value != nullptr)
-							player->character = *value;
-
-						value = table_get("VEHICLE"sv);
-						if (value != nullptr)
-							player->vehicle = *value;
+					auto parse = [&parse_player_columns, &dispatch_player_delta](RenX::PlayerInfo *player) {
+						RenX::PlayerDelta delta;
+						parse_player_columns(player, delta);
+						dispatch_player_delta(player, delta);
 					};
-					std::string_view *value = table_get("PLAYERLOG"sv);
+					const std::string *value = column_get(ListColumn::PlayerLog);
 					if (value != nullptr) {
 						auto parsed_token = parsePlayerData(*value);
 						parse(getPlayerOrAdd(parsed_token.name, parsed_token.id, parsed_token.team, true, 0ULL,
@@ -1886,8 +2281,8 @@ void RenX::Server::processLine(std::string_view line) {
 					}
 					else
 					{
-						std::string_view *name = table_get("NAME"sv);
-						value = table_get("ID"sv);
+						const std::string *name = column_get(ListColumn::Name);
+						value = column_get(ListColumn::ID);
 
 						if (value != nullptr)
 						{
@@ -1896,20 +2291,11 @@ void RenX::Server::processLine(std::string_view line) {
 							{
 								if (player->name.empty())
 								{
-									player->name = table_get_ref("NAME"sv, ""sv);
+									player->name = column_get_ref(ListColumn::Name);
 									process_escape_sequences(player->name);
 								}
 
-								value = table_get("TEAMNUM"sv);
-								if (value != nullptr)
-									player->team = RenX::getTeam(Jupiter::from_string<int>(*value));
-								else
-								{
-									value = table_get("TEAM"sv);
-									if (value != nullptr)
-										player->team = RenX::getTeam(*value);
-								}
-
+								parse_team_column(player);
 								parse(player);
 							}
 						}
@@ -1918,16 +2304,7 @@ void RenX::Server::processLine(std::string_view line) {
 							RenX::PlayerInfo *player = getPlayerByName(*name);
 							if (player != nullptr)
 							{
-								value = table_get("TEAMNUM"sv);
-								if (value != nullptr)
-									player->team = RenX::getTeam(Jupiter::from_string<int>(*value));
-								else
-								{
-									value = table_get("TEAM"sv);
-									if (value != nullptr)
-										player->team = RenX::getTeam(*value);
-								}
-
+								parse_team_column(player);
 								parse(player);
 							}
 							// No other way to identify player -- worthless command format.
@@ -1939,7 +2316,7 @@ void RenX::Server::processLine(std::string_view line) {
 				|| jessilib::equalsi(m_lastCommand, "buildinginfo"sv)
 				|| jessilib::equalsi(m_lastCommand, "blist"sv)
 				|| jessilib::equalsi(m_lastCommand, "buildinglist"sv)) {
-				if (m_commandListFormat.empty()) {
+				if (!m_commandListFormatCompiled) {
 					consume_tokens_as_command_list_format();
 				}
 				else {
@@ -1948,21 +2325,10 @@ void RenX::Server::processLine(std::string_view line) {
 					rBuilding�Health�MaxHealth�Armor MaxArmor Team�Capturable Destroyed
 					rRx_Building_Refinery_GDI�2000�2000�2000 2000 GDI�False False
 					*/
-					auto table = tokens_as_command_table();
-
-					auto table_get = [&table](std::string_view  in_key) -> std::string_view* {
-						auto value = table.find(in_key);
-						if (value != table.end()) {
-							return &value->second;
-						}
-
-						return nullptr;
-					};
-
-					std::string_view *value;
+					const std::string *value;
 					RenX::BuildingInfo *building;
 
-					value = table_get("Building"sv);
+					value = column_get(ListColumn::Building);
 					if (value != nullptr)
 					{
 						building = getBuildingByName(*value);
@@ -1973,31 +2339,31 @@ void RenX::Server::processLine(std::string_view line) {
 							building->name = *value;
 						}
 
-						value = table_get("Health"sv);
+						value = column_get(ListColumn::Health);
 						if (value != nullptr)
 							building->health = Jupiter::from_string<int>(*value);
 
-						value = table_get("MaxHealth"sv);
+						value = column_get(ListColumn::MaxHealth);
 						if (value != nullptr)
 							building->max_health = Jupiter::from_string<int>(*value);
 
-						value = table_get("Team"sv);
+						value = column_get(ListColumn::Team);
 						if (value != nullptr)
 							building->team = RenX::getTeam(*value);
 
-						value = table_get("Capturable"sv);
+						value = column_get(ListColumn::Capturable);
 						if (value != nullptr)
 							building->capturable = Jupiter::from_string<bool>(*value);
 
-						value = table_get("Destroyed"sv);
+						value = column_get(ListColumn::Destroyed);
 						if (value != nullptr)
 							building->destroyed = Jupiter::from_string<bool>(*value);
 
-						value = table_get("Armor"sv);
+						value = column_get(ListColumn::Armor);
 						if (value != nullptr)
 							building->armor = Jupiter::from_string<int>(*value);
 
-						value = table_get("MaxArmor"sv);
+						value = column_get(ListColumn::MaxArmor);
 						if (value != nullptr)
 							building->max_armor = Jupiter::from_string<int>(*value);
 					}
@@ -2123,9 +2489,9 @@ void RenX::Server::processLine(std::string_view line) {
 						RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(4));
 						std::string_view objectType = getToken(2);
 						if (objectType.ends_with("Beacon"))
-							++player->beaconPlacements;
+							++player->beaconPlacements();
 						else if (objectType == "Rx_Weapon_DeployedProxyC4"sv)
-							++player->proxy_placements;
+							++player->proxy_placements();
 						for (const auto& plugin : xPlugins) {
 							plugin->RenX_OnDeploy(*this, *player, objectType);
 						}
@@ -2137,9 +2503,9 @@ void RenX::Server::processLine(std::string_view line) {
 						RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(4));
 						std::string_view objectType = getToken(2);
 						if (objectType.ends_with("Beacon"))
-							++player->beaconDisarms;
+							++player->beaconDisarms();
 						else if (objectType == "Rx_Weapon_DeployedProxyC4"sv)
-							++player->proxy_disarms;
+							++player->proxy_disarms();
 
 						if (getToken(5) == "owned by"sv) {
 							RenX::PlayerInfo *victim = parseGetPlayerOrAdd(getToken(6));
@@ -2211,7 +2577,7 @@ void RenX::Server::processLine(std::string_view line) {
 						std::string_view building = teamBuildingToken.second;
 						TeamType oldTeam = RenX::getTeam(teamBuildingToken.first);
 						RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(6));
-						player->captures++;
+						player->captures()++;
 						for (const auto& plugin : xPlugins) {
 							plugin->RenX_OnCapture(*this, *player, building, oldTeam);
 						}
@@ -2236,33 +2602,41 @@ void RenX::Server::processLine(std::string_view line) {
 						// "vehicle" | Vehicle | "by" | Player
 						std::string_view type = getToken(2);
 						std::string_view obj = getToken(3);
+
+						// Interned before the hooks run, so that translating the purchase's name is cached
+						RenX::Symbol objSymbol = RenX::symbols->intern(obj);
 						if (type == "character"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
+							RenX::eventRates->record(*this, *player, RenX::RateEvent::Purchases);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnCharacterPurchase(*this, *player, obj);
 							}
-							player->character = obj;
+							player->character_id = objSymbol;
 						}
 						else if (type == "item"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
+							RenX::eventRates->record(*this, *player, RenX::RateEvent::Purchases);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnItemPurchase(*this, *player, obj);
 							}
 						}
 						else if (type == "weapon"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
+							RenX::eventRates->record(*this, *player, RenX::RateEvent::Purchases);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnWeaponPurchase(*this, *player, obj);
 							}
 						}
 						else if (type == "refill"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(obj);
+							RenX::eventRates->record(*this, *player, RenX::RateEvent::Purchases);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnRefillPurchase(*this, *player);
 							}
 						}
 						else if (type == "vehicle"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
+							RenX::eventRates->record(*this, *player, RenX::RateEvent::Purchases);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnVehiclePurchase(*this, *player, obj);
 							}
@@ -2283,7 +2657,7 @@ void RenX::Server::processLine(std::string_view line) {
 						else if (getToken(2) == "player"sv) {
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(3));
 							std::string_view character = getToken(5);
-							player->character = character;
+							player->character_id = RenX::symbols->intern(character);
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnSpawn(*this, *player, character);
 							}
@@ -2352,20 +2726,22 @@ void RenX::Server::processLine(std::string_view line) {
 						else if (type == "character"sv)
 						{
 							std::string_view character = getToken(3);
+							RenX::Symbol characterSymbol = RenX::symbols->intern(character);
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnCharacterCrate(*this, *player, character);
 							}
-							player->character = character;
+							player->character_id = characterSymbol;
 						}
 						else if (type == "spy"sv)
 						{
 							std::string_view character = getToken(3);
+							RenX::Symbol characterSymbol = RenX::symbols->intern(character);
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(5));
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnSpyCrate(*this, *player, character);
 							}
-							player->character = character;
+							player->character_id = characterSymbol;
 						}
 						else if (type == "refill"sv)
 						{
@@ -2433,50 +2809,56 @@ void RenX::Server::processLine(std::string_view line) {
 						{
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(playerToken);
 							std::string_view type = getToken(4);
-							std::string_view damageType;
 							if (type == "by"sv)
 							{
-								damageType = getToken(7);
+								onCombatEvent();
+								RenX::Symbol damageSymbol = RenX::symbols->intern(getToken(7));
 								std::string_view killerData = getToken(5);
 								auto parsed_token = parsePlayerData(killerData);
 								if (!parsed_token.isPlayer || parsed_token.id == 0)
 								{
-									player->deaths++;
+									player->deaths()++;
+									RenX::eventRates->record(*this, *player, RenX::RateEvent::Deaths);
 									for (const auto& plugin : xPlugins) {
-										plugin->RenX_OnKill(*this, parsed_token.name, parsed_token.team, *player, damageType);
+										plugin->RenX_OnKill(*this, parsed_token.name, parsed_token.team, *player, damageSymbol);
 									}
 								}
 								else
 								{
-									player->deaths++;
+									player->deaths()++;
+									RenX::eventRates->record(*this, *player, RenX::RateEvent::Deaths);
 									RenX::PlayerInfo *killer = getPlayerOrAdd(parsed_token.name, parsed_token.id, parsed_token.team, parsed_token.isBot, 0, ""sv, ""sv);
-									killer->kills++;
-									if (damageType == "Rx_DmgType_Headshot"sv) {
-										killer->headshots++;
+									killer->kills()++;
+									RenX::eventRates->record(*this, *killer, RenX::RateEvent::Kills);
+									if (damageSymbol == RenX::Symbols::DmgType_Headshot) {
+										killer->headshots()++;
+										RenX::eventRates->record(*this, *killer, RenX::RateEvent::Headshots);
 									}
 									for (const auto& plugin : xPlugins) {
-										plugin->RenX_OnKill(*this, *killer, *player, damageType);
+										plugin->RenX_OnKill(*this, *killer, *player, damageSymbol);
 									}
 								}
 							}
 							else if (type == "died by"sv)
 							{
-								player->deaths++;
-								damageType = getToken(5);
+								player->deaths()++;
+								RenX::eventRates->record(*this, *player, RenX::RateEvent::Deaths);
+								RenX::Symbol damageSymbol = RenX::symbols->intern(getToken(5));
 								for (const auto& plugin : xPlugins) {
-									plugin->RenX_OnDie(*this, *player, damageType);
+									plugin->RenX_OnDie(*this, *player, damageSymbol);
 								}
 							}
 							else if (type == "suicide by"sv)
 							{
-								player->deaths++;
-								player->suicides++;
-								damageType = getToken(5);
+								player->deaths()++;
+								player->suicides()++;
+								RenX::eventRates->record(*this, *player, RenX::RateEvent::Deaths);
+								RenX::Symbol damageSymbol = RenX::symbols->intern(getToken(5));
 								for (const auto& plugin : xPlugins) {
-									plugin->RenX_OnSuicide(*this, *player, damageType);
+									plugin->RenX_OnSuicide(*this, *player, damageSymbol);
 								}
 							}
-							player->character = ""sv;
+							player->character_id = 0;
 						}
 						onAction();
 					}
@@ -2489,7 +2871,7 @@ void RenX::Server::processLine(std::string_view line) {
 						if (byLine == "by"sv)
 						{
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(4));
-							player->steals++;
+							player->steals()++;
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnSteal(*this, *player, vehicle);
 							}
@@ -2498,8 +2880,8 @@ void RenX::Server::processLine(std::string_view line) {
 						{
 							RenX::PlayerInfo *victim = parseGetPlayerOrAdd(getToken(4));
 							RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(6));
-							player->steals++;
-							victim->stolen++;
+							player->steals()++;
+							victim->stolen()++;
 							for (const auto& plugin : xPlugins) {
 								plugin->RenX_OnSteal(*this, *player, vehicle, *victim);
 							}
@@ -2526,13 +2908,15 @@ void RenX::Server::processLine(std::string_view line) {
 							std::string_view objectName = getToken(3);
 							if (getToken(4) == "by"sv)
 							{
+								onCombatEvent();
 								std::string_view killerToken = getToken(5);
 								auto parsed_token = parsePlayerData(killerToken);
-								std::string_view damageType = getToken(7);
+								RenX::Symbol damageSymbol = RenX::symbols->intern(getToken(7));
 
 								if (!parsed_token.isPlayer || parsed_token.id == 0) {
+									RenX::Symbol objectSymbol = RenX::symbols->intern(objectName);
 									for (const auto& plugin : xPlugins) {
-										plugin->RenX_OnDestroy(*this, parsed_token.name, parsed_token.team, objectName, RenX::getEnemy(parsed_token.team), damageType, type);
+										plugin->RenX_OnDestroy(*this, parsed_token.name, parsed_token.team, objectSymbol, RenX::getEnemy(parsed_token.team), damageSymbol, type);
 									}
 								}
 								else {
@@ -2540,10 +2924,11 @@ void RenX::Server::processLine(std::string_view line) {
 									switch (type)
 									{
 									case RenX::ObjectType::Vehicle:
-										player->vehicleKills++;
+										player->vehicleKills()++;
+										RenX::eventRates->record(*this, *player, RenX::RateEvent::VehicleKills);
 										break;
 									case RenX::ObjectType::Building:
-										player->buildingKills++;
+										player->buildingKills()++;
 										{
 											auto internalsStr = "_Internals"sv;
 											RenX::BuildingInfo *building;
@@ -2562,13 +2947,14 @@ void RenX::Server::processLine(std::string_view line) {
 
 										break;
 									case RenX::ObjectType::Defence:
-										player->defenceKills++;
+										player->defenceKills()++;
 										break;
 									default:
 										break;
 									}
+									RenX::Symbol objectSymbol = RenX::symbols->intern(objectName);
 									for (const auto& plugin : xPlugins) {
-										plugin->RenX_OnDestroy(*this, *player, objectName, RenX::getEnemy(player->team), damageType, type);
+										plugin->RenX_OnDestroy(*this, *player, objectSymbol, RenX::getEnemy(player->team), damageSymbol, type);
 									}
 								}
 							}
@@ -2825,7 +3211,7 @@ void RenX::Server::processLine(std::string_view line) {
 						// Player | "joined" | Team | "score" | Score | "last round score" | Score | "time" | Timestamp
 						// Player | "joined" | Team | "left" | Old Team | "score" | Score | "last round score" | Score | "time" | Timestamp
 						RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(2));
-						player->character = ""sv;
+						player->character_id = 0;
 						if (getToken(5) == "left"sv)
 						{
 							RenX::TeamType oldTeam = RenX::getTeam(getToken(6));
@@ -2843,6 +3229,9 @@ void RenX::Server::processLine(std::string_view line) {
 
 						RenX::PlayerInfo *player = parseGetPlayerOrAdd(getToken(2 + offset));
 						player->hwid = getToken(4 + offset);
+						if (player->id != 0) { // Temporary players are not indexed
+							RenX::playerIndex->update(*this, *player);
+						}
 
 						if (player->isBot == false) {
 							banCheck(*player);
@@ -2873,7 +3262,7 @@ void RenX::Server::processLine(std::string_view line) {
 							removePlayer(*player);
 						}
 
-						if (m_gameover_when_empty && this->players.size() == getBotCount())
+						if (m_gameover_when_empty && getHumanCount() == 0)
 							gameover();
 					}
 					else if (subHeader == "Kick;"sv)
@@ -2992,6 +3381,16 @@ void RenX::Server::processLine(std::string_view line) {
 							{
 								m_lastCommand = split_command_line.first;
 								m_lastCommandParams = split_command_line.second;
+
+								// Commands execute in the order sent; if this is the oldest request, its response follows
+								if (m_requestExecuting) {
+									completeRequest(true);
+								}
+
+								if (!m_requests.empty() && jessilib::equalsi(m_requests.front().name, m_lastCommand)) {
+									m_requestExecuting = true;
+									m_requests.front().executed = std::chrono::steady_clock::now();
+								}
 							}
 						}
 					}
@@ -3494,7 +3893,10 @@ void RenX::Server::processLine(std::string_view line) {
 				for (const auto& plugin : xPlugins) {
 					plugin->RenX_OnCommand(*this, raw);
 				}
-				m_commandListFormat.clear();
+				if (m_requestExecuting) {
+					completeRequest(true);
+				}
+				m_commandListFormatCompiled = false;
 				m_lastCommand = ""sv;
 				m_lastCommandParams = ""sv;
 			}
@@ -3506,6 +3908,9 @@ void RenX::Server::processLine(std::string_view line) {
 				for (const auto& plugin : xPlugins) {
 					plugin->RenX_OnError(*this, raw);
 				}
+				if (m_requestExecuting) {
+					m_requests.front().response.errors.emplace_back(raw);
+				}
 			}
 			break;
 
@@ -3592,6 +3997,9 @@ void RenX::Server::disconnect(RenX::DisconnectReason reason) {
 		plugin->RenX_OnServerDisconnect(*this, reason);
 	}
 
+	flushSocket();
+	m_outbound.clear();
+	updateSendQueueMetric();
 	m_sock.close();
 	wipeData();
 }
@@ -3601,8 +4009,11 @@ bool RenX::Server::connect() {
 	if (m_sock.connect(m_hostname.c_str(), m_port, m_clientHostname.empty() ? nullptr : m_clientHostname.c_str()))
 	{
 		m_sock.setBlocking(false);
-		sendSocket(string_printf("a%.*s\n", m_pass.size(), m_pass.data()));
+		m_inbound.clear();
+		m_outbound.clear();
+		updateSendQueueMetric();
 		m_connected = true;
+		sendSocket(string_printf("a%.*s\n", m_pass.size(), m_pass.data()));
 		m_attempts = 0;
 		return true;
 	}
@@ -3612,11 +4023,13 @@ bool RenX::Server::connect() {
 }
 
 bool RenX::Server::reconnect(RenX::DisconnectReason reason) {
+	m_reconnectsMetric->add();
 	disconnect(static_cast<RenX::DisconnectReason>(static_cast<unsigned int>(reason) | 0x01));
 	return connect();
 }
 
 void RenX::Server::wipeData() {
+	failRequests();
 	wipePlayers();
 	m_reliable = false;
 	m_team_mode = 3;
@@ -3626,8 +4039,6 @@ void RenX::Server::wipeData() {
 	m_match_state = 1;
 	m_subscribed = false;
 	m_fully_connected = false;
-	m_bot_count = 0;
-	m_player_rdns_resolutions_pending = 0;
 	this->buildings.clear();
 	this->mutators.clear();
 	this->maps.clear();
@@ -3641,9 +4052,13 @@ void RenX::Server::wipePlayers() {
 		for (const auto& plugin : RenX::getCore()->getPlugins()) {
 			plugin->RenX_OnPlayerDelete(*this, this->players.front());
 		}
+		RenX::playerIndex->remove(this->players.front());
+		RenX::eventRates->forget(this->players.front());
 		this->players.pop_front();
 	}
 
+	m_bot_count = 0;
+	m_teams.fill({});
 	m_player_rdns_resolutions_pending = 0;
 }
 
@@ -3653,6 +4068,61 @@ void RenX::Server::startPing() {
 	m_awaitingPong = true;
 }
 
+void RenX::Server::acquireMetrics() {
+	std::string labels = MetricsRegistry::label("server"sv, m_configSection);
+	m_linesMetric = &metricsRegistry->counter("renx_rcon_lines_total"sv, "RCON lines received"sv, labels);
+	m_bytesReceivedMetric = &metricsRegistry->counter("renx_rcon_received_bytes_total"sv, "RCON bytes received"sv, labels);
+	m_bytesSentMetric = &metricsRegistry->counter("renx_rcon_sent_bytes_total"sv, "RCON bytes sent"sv, labels);
+	m_reconnectsMetric = &metricsRegistry->counter("renx_rcon_reconnects_total"sv, "RCON reconnection attempts"sv, labels);
+	m_ircMessagesMetric = &metricsRegistry->counter("renx_irc_messages_sent_total"sv, "IRC channel messages sent, per IRC connection"sv, labels);
+	m_sendQueueMetric = &metricsRegistry->gauge("renx_rcon_send_queue_bytes"sv, "RCON bytes queued but not yet sent, as of the last flush"sv, labels);
+	m_processLineMetric = &metricsRegistry->histogram("renx_rcon_process_line_seconds"sv, "Time taken to process an RCON line"sv, MetricsRegistry::durationBounds(), labels);
+	m_banCheckMetric = &metricsRegistry->histogram("renx_ban_check_seconds"sv, "Time taken to check a player against the ban database"sv, MetricsRegistry::durationBounds(), labels);
+}
+
+void RenX::Server::releaseMetrics() {
+	m_outbound.clear();
+	updateSendQueueMetric();
+
+	metricsRegistry->release(*m_linesMetric);
+	metricsRegistry->release(*m_bytesReceivedMetric);
+	metricsRegistry->release(*m_bytesSentMetric);
+	metricsRegistry->release(*m_reconnectsMetric);
+	metricsRegistry->release(*m_ircMessagesMetric);
+	metricsRegistry->release(*m_sendQueueMetric);
+	metricsRegistry->release(*m_processLineMetric);
+	metricsRegistry->release(*m_banCheckMetric);
+}
+
+void RenX::Server::updateSendQueueMetric() {
+	if (m_outbound.size() != m_reportedSendQueue) {
+		m_sendQueueMetric->add(static_cast<double>(m_outbound.size()) - static_cast<double>(m_reportedSendQueue));
+		m_reportedSendQueue = m_outbound.size();
+	}
+}
+
+void RenX::Server::compileCommandListFormat(const std::vector<std::string>& in_header) {
+	// Column names, in ListColumn order
+	static constexpr std::string_view column_names[]{
+		"PlayerLog"sv, "Kills"sv, "Deaths"sv, "Score"sv, "Credits"sv, "Character"sv, "Vehicle"sv, "Ping"sv, "Admin"sv,
+		"Steam"sv, "IP"sv, "HWID"sv, "ID"sv, "Name"sv, "Team"sv, "TeamNum"sv,
+		"Building"sv, "Health"sv, "MaxHealth"sv, "Armor"sv, "MaxArmor"sv, "Capturable"sv, "Destroyed"sv
+	};
+	static_assert(std::size(column_names) == static_cast<size_t>(ListColumn::Count));
+
+	m_commandListFormat.fill(SIZE_MAX);
+	for (size_t index = 0; index != in_header.size(); ++index) {
+		for (size_t column = 0; column != std::size(column_names); ++column) {
+			if (jessilib::equalsi(in_header[index], column_names[column])) {
+				m_commandListFormat[column] = index;
+				break;
+			}
+		}
+	}
+
+	m_commandListFormatCompiled = true;
+}
+
 unsigned int RenX::Server::getVersion() const {
 	return m_rconVersion;
 }
@@ -3672,13 +4142,16 @@ std::string_view RenX::Server::getRCONUsername() const {
 RenX::Server::Server(Jupiter::Socket &&socket, std::string_view configurationSection) : Server(configurationSection) {
 	m_sock = std::move(socket);
 	m_hostname = m_sock.getRemoteHostname();
-	sendSocket(string_printf("a%.*s\n", m_pass.size(), m_pass.data()));
 	m_connected = true;
+	sendSocket(string_printf("a%.*s\n", m_pass.size(), m_pass.data()));
 }
 
 RenX::Server::Server(std::string_view configurationSection) {
+	static std::atomic<uint64_t> s_next_id{ 1 };
+	m_id = s_next_id++;
 	m_configSection = configurationSection;
 	m_calc_uuid = RenX::default_uuid_func;
+	acquireMetrics();
 	init(*RenX::getCore()->getConfig().getSection(m_configSection));
 	for (const auto& plugin : RenX::getCore()->getPlugins()) {
 		plugin->RenX_OnServerCreate(*this);
@@ -3712,16 +4185,24 @@ void RenX::Server::init(const Jupiter::Config &config) {
 	m_neverSay = config.get<bool>("NeverSay"sv, false);
 	m_resolve_player_rdns = config.get<bool>("ResolvePlayerRDNS"sv, true);
 	m_clientUpdateRate = std::chrono::milliseconds(config.get<long long>("ClientUpdateRate"sv, 2500));
+	m_clientUpdateRateMax = std::max(m_clientUpdateRate, std::chrono::milliseconds(config.get<long long>("ClientUpdateRateMax"sv, m_clientUpdateRate.count() * 4)));
+	m_clientUpdateRateCurrent = m_clientUpdateRate;
+	m_adaptiveClientUpdate = config.get<bool>("AdaptiveClientUpdate"sv, false);
 	m_buildingUpdateRate = std::chrono::milliseconds(config.get<long long>("BuildingUpdateRate"sv, 7500));
 	m_pingRate = std::chrono::milliseconds(config.get<long long>("PingUpdateRate"sv, 60000));
 	m_pingTimeoutThreshold = std::chrono::milliseconds(config.get<long long>("PingTimeoutThreshold"sv, 10000));
+	m_requestTimeout = std::chrono::milliseconds(config.get<long long>("RequestTimeout"sv, 30000));
+	m_requestExecutionTimeout = std::chrono::milliseconds(config.get<long long>("RequestExecutionTimeout"sv, 60000));
+	m_receiveBudget = config.get<size_t>("ReceiveBudget"sv, 65536);
+	m_sendBufferSize = config.get<size_t>("SendBufferSize"sv, 65536);
+	m_sendBufferLimit = std::max(m_sendBufferSize, config.get<size_t>("SendBufferLimit"sv, m_sendBufferSize * 16));
 
 	Jupiter::Config &commandsFile = RenX::getCore()->getCommandsFile();
 	m_commandAccessLevels = commandsFile.getSection(m_configSection);
 	m_commandAliases = commandsFile.getSection(m_configSection + ".Aliases"s);
 
 	for (const auto& command : RenX::GameMasterCommandList) {
-		addCommand(command->copy());
+		addSharedCommand(command);
 	}
 
 	auto load_basic_commands = [this, &commandsFile](std::string section_prefix)
@@ -3751,6 +4232,13 @@ RenX::Server::~Server() {
 	if (RenX::GameCommand::active_server == nullptr)
 		RenX::GameCommand::active_server = RenX::GameCommand::selected_server;
 
+	flushSocket();
 	m_sock.close();
+
+	// Callbacks may belong to plugins which have already been unloaded; drop pending requests without calling them
+	m_requests.clear();
+	m_requestExecuting = false;
+
 	wipeData();
+	releaseMetrics();
 }
@@ -24,15 +24,27 @@
  * @brief Defines the Server class.
  */
 
+#include <array>
 #include <chrono>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include "jessilib/unicode.hpp"
 #include "Jupiter/TCPSocket.h"
 #include "Jupiter/Config.h"
 #include "Jupiter/Thinker.h"
 #include "Jupiter/Rehash.h"
+#include "Metrics.h"
 #include "RenX.h"
+#include "RenX_DataSlot.h"
+#include "RenX_LineBuffer.h"
 #include "RenX_Map.h"
+#include "RenX_PlayerStats.h"
 
 /** DLL Linkage Nagging */
 #if defined _MSC_VER
@@ -47,6 +59,21 @@ namespace RenX
 	struct BuildingInfo;
 	class GameCommand;
 	class Core;
+	class Server;
+
+	/**
+	* @brief Response to an RCON command submitted through Server::request().
+	*/
+	struct RCONResponse
+	{
+		std::string command; /** Command line which was submitted */
+		std::vector<std::vector<std::string>> rows; /** Unescaped tokens of each response row; list commands start with a header row */
+		std::vector<std::string> errors; /** Error lines received while the command was executing */
+		bool completed = false; /** True if the server finished executing the command; false if it timed out or the connection was lost */
+	};
+
+	/** Called when an RCON request completes or fails */
+	using RCONCallback = std::function<void(RenX::Server &server, const RenX::RCONResponse &response)>;
 
 	/**
 	* @brief Represents a connection to an individiaul Renegade-X server.
@@ -81,11 +108,13 @@ namespace RenX
 		virtual bool OnBadRehash(bool removed);
 
 	public: // RenX::Server
+		RenX::StatsTable stats; /** Counters of the players in the server, one row per player; must outlive players */
 		std::list<RenX::PlayerInfo> players; /** A list of players in the server */
 		std::vector<std::unique_ptr<RenX::BuildingInfo>> buildings; /** A list of buildings in the server */
 		std::vector<std::string> mutators; /** A list of buildings the server is running */
 		std::vector<RenX::Map> maps; /** A list of maps in the server's rotation */
 		Jupiter::Config varData; /** Variable data. */
+		mutable RenX::SlotStorage slots; /** Values of registered ServerSlots */
 
 		/**
 		* @brief Checks if the server is connected to RCON.
@@ -222,32 +251,95 @@ namespace RenX
 		* @brief Sends a command to the server.
 		*
 		* @param commmand Command to send.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int send(std::string_view command);
 
 		/**
-		 * @brief Sends text over the socket
+		* @brief Sends a command to the server, and calls a function with its response.
+		* Requests are pipelined: any number may be in flight, and each is matched to its response in the order sent,
+		* using the server's echo of each command executed by this connection.
+		* Note: Commands with the same name sent through send() while a request is in flight may be mistaken for the request.
+		*
+		* @param command Command to send
+		* @param callback Function to call when the response is complete, or the request fails
+		* @param owner Object which the callback belongs to (i.e: the plugin which sent the request), for cancellation
+		* @return True if the command was queued, false otherwise (in which case the callback is never called).
+		*/
+		bool request(std::string_view command, RenX::RCONCallback callback, const void *owner = nullptr);
+
+		/**
+		* @brief Drops the callbacks of every pending request which belongs to an owner; the requests themselves still complete.
+		* Called for each RenX::Plugin when it is destroyed, so that plugins may be unloaded with requests in flight.
+		*
+		* @param owner Owner whose callbacks to drop
+		* @return Number of callbacks dropped
+		*/
+		size_t cancelRequests(const void *owner);
+
+		/**
+		 * @brief Queues text to be sent over the socket.
+		 * Queued text is sent once per think(), or sooner if the send buffer fills up. Past the send buffer's soft
+		 * limit only chat is refused, so that commands (i.e: kicks and bans) are kept; past its hard limit, when the
+		 * server has stopped reading, everything is refused.
 		 *
 		 * @param text Text to send
-		 * @return The number of bytes sent on success, less than or equal to zero otherwise.
+		 * @return The number of bytes queued, or less than zero if the server is not connected or the send buffer is at its hard limit.
 		 */
 		 int sendSocket(std::string_view text);
 
+		/**
+		 * @brief Queues the concatenation of several pieces of text to be sent over the socket, without building a temporary string.
+		 *
+		 * @param parts Pieces of text to send
+		 * @return The number of bytes queued, or less than zero if nothing was queued; see sendSocket(std::string_view).
+		 */
+		int sendSocket(std::initializer_list<std::string_view> parts);
+
+		/**
+		* @brief Sends as much queued text as the socket will currently accept.
+		*
+		* @return The number of bytes sent.
+		*/
+		int flushSocket();
+
+		/**
+		* @brief Fetches the number of bytes queued but not yet sent over the socket.
+		*
+		* @return Number of queued bytes.
+		*/
+		size_t getPendingSendBytes() const;
+
+		/**
+		* @brief Checks if the send buffer is full. While full, in-game chat messages are refused unless the socket accepts some of the queued data;
+		* commands are still queued. Plugins producing large amounts of output may check this to hold back their own output.
+		*
+		* @return True if the send buffer is full, false otherwise.
+		*/
+		bool isSendBufferFull() const;
+
 		/**
 		* @brief Sends an in-game message to the server.
 		*
 		* @param message Message to send in-game.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendMessage(std::string_view message);
 
+		/**
+		* @brief Sends an in-game message which has already been escaped with RenX::escapifyRCON().
+		*
+		* @param message Escaped message to send in-game.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
+		*/
+		int sendEscapedMessage(std::string_view message);
+
 		/**
 		* @brief Sends an in-game message to a player in the server.
 		*
 		* @param player Data of the player to send a message to.
 		* @param message Message to send in-game.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendMessage(const RenX::PlayerInfo &player, std::string_view message);
 
@@ -255,7 +347,7 @@ namespace RenX
 		* @brief Sends an in-game admin message to the server.
 		*
 		* @param message Message to send in-game.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendAdminMessage(std::string_view message);
 
@@ -264,7 +356,7 @@ namespace RenX
 		*
 		* @param player Data of the player to send a message to.
 		* @param message Message to send in-game.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendAdminMessage(const RenX::PlayerInfo &player, std::string_view message);
 
@@ -273,7 +365,7 @@ namespace RenX
 		*
 		* @param player Data of the player to send a message to.
 		* @param message Message to send in-game.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendWarnMessage(const RenX::PlayerInfo &player, std::string_view message);
 
@@ -281,7 +373,7 @@ namespace RenX
 		* @brief Sends data to the server.
 		*
 		* @param data String of data to send.
-		* @return The number of bytes sent on success, less than or equal to zero otherwise.
+		* @return The number of bytes queued on success, less than or equal to zero otherwise.
 		*/
 		int sendData(std::string_view data);
 
@@ -348,12 +440,91 @@ namespace RenX
 		size_t getBotCount() const;
 
 		/**
-		 * @brief Builds a list of all active players (i.e: players who have a team)
+		* @brief Fetches the number of human (non-bot) players in the server.
+		*
+		* @return Number of humans in the server.
+		*/
+		size_t getHumanCount() const;
+
+		/**
+		* @brief Fetches the number of players on a team.
+		*
+		* @param team Team to count players on
+		* @param includeBots Specifies whether or not to count bots
+		* @return Number of players on the team.
+		*/
+		size_t getTeamPlayerCount(RenX::TeamType team, bool includeBots = true) const;
+
+		/**
+		* @brief Fetches the sum of the scores of every player on a team.
+		*
+		* @param team Team to sum scores of
+		* @return Sum of the team's player scores.
+		*/
+		double getTeamScore(RenX::TeamType team) const;
+
+		/**
+		* @brief Fetches the number of active players (i.e: players who have a team)
+		*
+		* @param includeBots Specifies whether or not to count bots
+		* @return Number of active players
+		*/
+		size_t getActivePlayerCount(bool includeBots = true) const;
+
+		/**
+		* @brief Iterable view of the active players in a server (i.e: players who have a team), which skips inactive players in place.
+		* Iterators dereference to const RenX::PlayerInfo*, and are invalidated when players join or part.
+		*/
+		class RENX_API ActivePlayers
+		{
+		public:
+			class RENX_API iterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = const RenX::PlayerInfo*;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = value_type;
+
+				value_type operator*() const;
+				iterator& operator++() { ++m_itr; skip(); return *this; }
+				iterator operator++(int) { iterator result = *this; ++*this; return result; }
+				bool operator==(const iterator& rhs) const { return m_itr == rhs.m_itr; }
+				bool operator!=(const iterator& rhs) const { return m_itr != rhs.m_itr; }
+
+			private:
+				friend class ActivePlayers;
+				iterator(std::list<RenX::PlayerInfo>::const_iterator in_itr, std::list<RenX::PlayerInfo>::const_iterator in_end, bool in_includeBots);
+				void skip();
+
+				std::list<RenX::PlayerInfo>::const_iterator m_itr;
+				std::list<RenX::PlayerInfo>::const_iterator m_end;
+				bool m_includeBots;
+			};
+
+			iterator begin() const;
+			iterator end() const;
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+		private:
+			friend class Server;
+			ActivePlayers(const std::list<RenX::PlayerInfo>& in_players, size_t in_size, bool in_includeBots)
+				: m_players{ &in_players }, m_size{ in_size }, m_includeBots{ in_includeBots } {}
+
+			const std::list<RenX::PlayerInfo>* m_players;
+			size_t m_size;
+			bool m_includeBots;
+		};
+
+		/**
+		 * @brief Fetches a view of all active players (i.e: players who have a team); this does not allocate.
 		 *
-		 * @param includeBots Specifies whether or not to include bots in the returned list
-		 * @return List of active players
+		 * @param includeBots Specifies whether or not to include bots in the view
+		 * @return View of active players
 		 */
-		std::vector<const RenX::PlayerInfo*> activePlayers(bool includeBots = true) const;
+		ActivePlayers activePlayers(bool includeBots = true) const;
 
 		/**
 		* @brief Fetches a player's data based on their ID number.
@@ -488,9 +659,11 @@ namespace RenX
 		* @brief Sends a patrial client list request.
 		* Note: This only updates score, credits, and ping for known players.
 		*
+		* @param callback Optional function to call once every list which was requested has been processed; not called if the request fails
+		* @param owner Object which the callback belongs to, for cancellation; see cancelRequests()
 		* @return True on success, false otherwise.
 		*/
-		bool updateClientList();
+		bool updateClientList(std::function<void(RenX::Server &server)> callback = nullptr, const void *owner = nullptr);
 
 		/**
 		* @brief Sends a building list request.
@@ -843,6 +1016,14 @@ namespace RenX
 		*/
 		std::string_view getName() const;
 
+		/**
+		* @brief Fetches this server's ID. IDs are never reused, so they may be held to find the server later (i.e: from
+		* a timer or a worker thread) without risk of finding another server which took its place.
+		*
+		* @return ID of this server; never 0.
+		*/
+		uint64_t getID() const;
+
 		/**
 		* @brief Fetches the current map.
 		*
@@ -883,12 +1064,30 @@ namespace RenX
 		RenX::GameCommand *triggerCommand(std::string_view trigger, RenX::PlayerInfo &player, std::string_view parameters);
 
 		/**
-		* @brief Adds a command to the server's game command list.
+		* @brief Adds a command to the server's game command list. The server takes ownership of the command.
+		* Triggers of commands owned by the server take precedence over those of shared commands.
 		*
 		* @param command Command to add.
 		*/
 		void addCommand(RenX::GameCommand *command);
 
+		/**
+		* @brief Adds a master command to the server's game command list.
+		* If the server configures an access level or aliases for the command, it receives its own copy of it.
+		* Otherwise, the master command itself is used, and is found through the core's shared trigger index.
+		*
+		* @param command Master command to add
+		*/
+		void addSharedCommand(RenX::GameCommand *command);
+
+		/**
+		* @brief Drops every reference to a master command which is being destroyed, including the server's copy of it.
+		* Commands are matched by pointer, so other commands using the same triggers are unaffected.
+		*
+		* @param command Master command to release
+		*/
+		void releaseSharedCommand(RenX::GameCommand *command);
+
 		/**
 		* @brief Adds a command to the server's game command list.
 		*
@@ -1062,9 +1261,111 @@ namespace RenX
 
 	/** Private members */
 	private:
+		/** Columns which may be requested in list responses (clientvarlist, botvarlist, binfo) */
+		enum class ListColumn : size_t {
+			PlayerLog, Kills, Deaths, Score, Credits, Character, Vehicle, Ping, Admin, Steam, IP, HWID, ID, Name, Team, TeamNum,
+			Building, Health, MaxHealth, Armor, MaxArmor, Capturable, Destroyed,
+			Count
+		};
+
 		void init(const Jupiter::Config &config);
 		void wipePlayers();
+
+		/**
+		* @brief Adds a player in the server to, or removes one from, the server's aggregates (bot count, team sizes, team scores).
+		* Temporary players (ID 0) are not in the server, and are ignored.
+		*/
+		void aggregatePlayer(const RenX::PlayerInfo &player);
+		void unaggregatePlayer(const RenX::PlayerInfo &player);
+
+		/**
+		* @brief Updates a player's team or score, keeping the server's aggregates up to date.
+		*/
+		void setPlayerTeam(RenX::PlayerInfo &player, RenX::TeamType team);
+		void setPlayerScore(RenX::PlayerInfo &player, double score);
 		void startPing();
+		void acquireMetrics();
+		void releaseMetrics();
+		void updateSendQueueMetric();
+
+		/** An RCON command awaiting its response */
+		struct PendingRequest
+		{
+			std::string name; /** Command name, which is matched against the echo of each command executed */
+			RenX::RCONCallback callback;
+			RenX::RCONResponse response;
+			std::chrono::steady_clock::time_point sent;
+			std::chrono::steady_clock::time_point executed; /** When the server echoed the command; only set while executing */
+			const void *owner;
+		};
+
+		/**
+		* @brief Queues raw command text to the server, and tracks a response to it.
+		*
+		* @param in_parts Parts of the line to send, including the "c" header and line terminator
+		* @param in_command Unescaped command line, for matching and reporting
+		* @param in_callback Function to call with the response
+		* @return True if the line was queued, false otherwise.
+		*/
+		bool submitRequest(std::initializer_list<std::string_view> in_parts, std::string_view in_command, RenX::RCONCallback in_callback, const void *in_owner);
+
+		/**
+		* @brief Removes the oldest request, and calls its callback.
+		*
+		* @param in_completed True if the server finished executing the command
+		*/
+		void completeRequest(bool in_completed);
+
+		/** Fails every pending request; used when the connection is lost */
+		void failRequests();
+
+		/**
+		* @brief Compiles the header row of a list response into column indexes, so that rows can be decoded without lookups by name.
+		*
+		* @param in_header Tokens of the header row
+		*/
+		void compileCommandListFormat(const std::vector<std::string>& in_header);
+
+		/**
+		* @brief Queues an in-game chat command, unless the send buffer is still full after flushing.
+		* Only chat is shed under backpressure; see sendSocket().
+		*
+		* @param parts Pieces of the command to send
+		* @return The number of bytes queued on success, less than zero if the send buffer is full.
+		*/
+		int sendChat(std::initializer_list<std::string_view> parts);
+
+		/**
+		* @brief Escapifies text for RCON into a reused buffer.
+		*
+		* @param text Text to escapify
+		* @return View of the escapified text, valid until the next call
+		*/
+		std::string_view escapifyScratch(std::string_view text);
+
+		/**
+		* @brief Adds each of a command's triggers to the server's trigger index, without replacing existing entries.
+		*
+		* @param command Command to index
+		*/
+		void indexCommand(RenX::GameCommand *command);
+
+		/**
+		* @brief Rebuilds the server's trigger index from the commands it owns.
+		*/
+		void rebuildCommandIndex();
+
+		/**
+		* @brief Adjusts the client list refresh interval based on activity since the previous refresh.
+		* The interval backs off while scores, credits, and pings are stable, and shortens as kills and destructions occur.
+		*/
+		void adjustClientUpdateRate();
+
+		/**
+		* @brief Counts a kill or destruction towards the client list refresh rate.
+		* If the refresh interval has backed off, the next refresh is rescheduled to the configured rate from the previous refresh.
+		*/
+		void onCombatEvent();
 
 		/** Tracking variables */
 		bool m_gameover_when_empty = false;
@@ -1098,7 +1399,17 @@ namespace RenX
 		int m_mineLimit = 0;
 		int m_timeLimit = 0;
 		size_t m_bot_count = 0;
+		struct TeamAggregate
+		{
+			size_t players = 0;
+			size_t bots = 0;
+			double score = 0.0;
+		};
+		std::array<TeamAggregate, 4> m_teams{}; /** Indexed by TeamType */
 		size_t m_player_rdns_resolutions_pending = 0;
+		size_t m_clientListChanges = 0; /** Players whose score, credits, or ping changed since the last client list refresh */
+		unsigned int m_combatEvents = 0; /** Kills and destructions since the last client list refresh */
+		uint64_t m_id;
 		unsigned int m_rconVersion = 0;
 		unsigned int m_gameVersionNumber = 0;
 		double m_crateRespawnAfterPickup = 0.0;
@@ -1110,16 +1421,36 @@ namespace RenX
 		std::chrono::steady_clock::time_point m_lastActivity = std::chrono::steady_clock::now();
 		std::chrono::steady_clock::time_point m_lastSendActivity = std::chrono::steady_clock::now();
 		std::chrono::steady_clock::time_point m_gameover_time;
-		std::string m_lastLine;
+		RenX::LineBuffer m_inbound; /** Received data not yet processed as lines */
+		std::string m_outbound; /** Commands queued by sendSocket(), not yet sent */
+		std::string m_escapeBuffer; /** Reused by escapifyScratch() */
 		std::string m_rconUser;
 		std::string m_gameVersion;
 		std::string m_serverName;
 		std::string m_lastCommand;
 		std::string m_lastCommandParams;
+		std::deque<PendingRequest> m_requests; /** Requests in the order they were sent */
+		bool m_requestExecuting = false; /** True if the oldest request has been echoed, and its response is being received */
 		RenX::Map m_map;
 		Jupiter::TCPSocket m_sock;
-		std::vector<std::string> m_commandListFormat;
-		std::vector<std::unique_ptr<RenX::GameCommand>> m_commands;
+		bool m_commandListFormatCompiled = false;
+		std::array<size_t, static_cast<size_t>(ListColumn::Count)> m_commandListFormat; /** Token index of each ListColumn; SIZE_MAX if not present */
+		std::vector<RenX::GameCommand*> m_commands; /** Every command on this server, in the order added; either shared or in m_ownedCommands */
+		std::vector<std::unique_ptr<RenX::GameCommand>> m_ownedCommands; /** Copies configured for this server, and server-specific commands */
+		std::unordered_map<std::string, RenX::GameCommand*, jessilib::text_hashi, jessilib::text_equali> m_commandIndex; /** Case-insensitive trigger/alias lookup into m_ownedCommands; checked before the core's shared index */
+		std::unordered_set<const RenX::GameCommand*> m_hiddenCommands; /** Shared commands which are disabled, copied, or removed on this server */
+		std::unordered_map<const RenX::GameCommand*, RenX::GameCommand*> m_commandCopies; /** Shared command -> this server's copy of it, in m_ownedCommands */
+
+		/** Metrics; shared by servers with the same configuration section (i.e: servers accepted by RenX.Listen) */
+		MetricsRegistry::Counter* m_linesMetric;
+		MetricsRegistry::Counter* m_bytesReceivedMetric;
+		MetricsRegistry::Counter* m_bytesSentMetric;
+		MetricsRegistry::Counter* m_reconnectsMetric;
+		MetricsRegistry::Counter* m_ircMessagesMetric;
+		MetricsRegistry::Gauge* m_sendQueueMetric;
+		MetricsRegistry::Histogram* m_processLineMetric;
+		MetricsRegistry::Histogram* m_banCheckMetric;
+		size_t m_reportedSendQueue = 0; /** Size of m_outbound last added to m_sendQueueMetric */
 
 		/** Configuration variables */
 		bool m_rconBan;
@@ -1131,6 +1462,7 @@ namespace RenX
 		bool m_localNameBan;
 		bool m_neverSay;
 		bool m_resolve_player_rdns;
+		bool m_adaptiveClientUpdate;
 		unsigned short m_port;
 		int m_logChanType;
 		int m_adminLogChanType;
@@ -1138,9 +1470,16 @@ namespace RenX
 		int m_steamFormat; /** 16 = hex, 10 = base 10, 8 = octal, -2 = SteamID 2, -3 = SteamID 3 */
 		std::chrono::milliseconds m_delay;
 		std::chrono::milliseconds m_clientUpdateRate;
+		std::chrono::milliseconds m_clientUpdateRateMax;
+		std::chrono::milliseconds m_clientUpdateRateCurrent;
 		std::chrono::milliseconds m_buildingUpdateRate;
 		std::chrono::milliseconds m_pingRate;
 		std::chrono::milliseconds m_pingTimeoutThreshold;
+		std::chrono::milliseconds m_requestTimeout;
+		std::chrono::milliseconds m_requestExecutionTimeout;
+		size_t m_receiveBudget; /** Maximum bytes to read from m_sock per think() */
+		size_t m_sendBufferSize; /** Soft limit of bytes held in m_outbound; past it, chat is refused */
+		size_t m_sendBufferLimit; /** Hard limit of bytes held in m_outbound; past it, all sends are refused */
 		std::string m_clientHostname;
 		std::string m_hostname;
 		std::string m_pass;
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include "RenX_Symbols.h"
+#include "RenX_Functions.h"
+
+using namespace std::literals;
+
+RenX::SymbolTable g_symbols;
+RenX::SymbolTable *RenX::symbols = &g_symbols;
+
+const RenX::Symbol RenX::Symbols::DmgType_Headshot = g_symbols.intern("Rx_DmgType_Headshot"sv);
+
+RenX::SymbolTable::SymbolTable() {
+	intern(""sv);
+}
+
+RenX::Symbol RenX::SymbolTable::intern(std::string_view in_name) {
+	auto itr = m_index.find(in_name);
+	if (itr != m_index.end()) {
+		return itr->second;
+	}
+
+	Symbol result = static_cast<Symbol>(m_names.size());
+	const std::string& name = m_names.emplace_back(in_name);
+	m_index.emplace(name, result);
+	m_translations.emplace_back();
+	m_translated.push_back(false);
+	return result;
+}
+
+bool RenX::SymbolTable::find(std::string_view in_name, Symbol& out_symbol) const {
+	auto itr = m_index.find(in_name);
+	if (itr == m_index.end()) {
+		return false;
+	}
+
+	out_symbol = itr->second;
+	return true;
+}
+
+std::string_view RenX::SymbolTable::name(Symbol in_symbol) const {
+	if (in_symbol >= m_names.size()) {
+		return {};
+	}
+
+	return m_names[in_symbol];
+}
+
+std::string_view RenX::SymbolTable::translated(Symbol in_symbol) {
+	if (in_symbol >= m_names.size()) {
+		return {};
+	}
+
+	if (!m_translated[in_symbol]) {
+		// Translate the interned copy, since the translation may view part of the name
+		m_translations[in_symbol] = RenX::translateNameUncached(m_names[in_symbol]);
+		m_translated[in_symbol] = true;
+	}
+
+	return m_translations[in_symbol];
+}
+
+void RenX::SymbolTable::clearTranslations() {
+	std::fill(m_translated.begin(), m_translated.end(), false);
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_SYMBOLS_H_HEADER
+#define _RENX_SYMBOLS_H_HEADER
+
+/**
+ * @file RenX_Symbols.h
+ * @brief Interns the class names reported by servers (i.e: weapons, damage types, characters, vehicles).
+ */
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "RenX.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace RenX
+{
+	/** Identifies an interned class name; 0 is always the empty name */
+	using Symbol = uint32_t;
+
+	/**
+	* @brief Maps class names to small stable IDs, and caches their translated names.
+	* Interned names are never freed, so views of them remain valid for the lifetime of RenX.Core.
+	*/
+	class RENX_API SymbolTable
+	{
+	public:
+		/**
+		* @brief Fetches the ID of a name, interning it if it is new.
+		*
+		* @param in_name Class name to intern
+		* @return ID of the name
+		*/
+		Symbol intern(std::string_view in_name);
+
+		/**
+		* @brief Fetches the ID of a name without interning it.
+		*
+		* @param in_name Class name to search for
+		* @param out_symbol Set to the ID of the name, if it is interned
+		* @return True if the name is interned, false otherwise.
+		*/
+		bool find(std::string_view in_name, Symbol& out_symbol) const;
+
+		/**
+		* @brief Fetches the name of an ID.
+		*
+		* @param in_symbol ID to fetch the name of
+		* @return Interned name, or an empty view if the ID is invalid.
+		*/
+		std::string_view name(Symbol in_symbol) const;
+
+		/**
+		* @brief Fetches the translated name of an ID (see RenX::translateName()), translating it on first use.
+		*
+		* @param in_symbol ID to fetch the translated name of
+		* @return Translated name
+		*/
+		std::string_view translated(Symbol in_symbol);
+
+		/**
+		* @brief Discards every cached translation. Called when the translations are reloaded.
+		*/
+		void clearTranslations();
+
+		/**
+		* @brief Fetches the number of interned names, including the empty name.
+		*
+		* @return Number of interned names
+		*/
+		size_t size() const { return m_names.size(); }
+
+		SymbolTable();
+		SymbolTable(const SymbolTable&) = delete;
+		SymbolTable& operator=(const SymbolTable&) = delete;
+
+	private:
+		std::deque<std::string> m_names; /** Indexed by Symbol; deque so that names never move */
+		std::unordered_map<std::string_view, Symbol> m_index; /** Keys view m_names */
+		std::vector<std::string_view> m_translations;
+		std::vector<bool> m_translated;
+	};
+
+	/** Well-known symbols, interned when RenX.Core is loaded */
+	namespace Symbols
+	{
+		RENX_API extern const Symbol DmgType_Headshot;
+	}
+
+	RENX_API extern RenX::SymbolTable *symbols;
+}
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_SYMBOLS_H_HEADER
@@ -484,8 +484,8 @@ void TagsImp::processTags(std::string& msg, const RenX::Server *server, const Re
 		}
 		PROCESS_TAG(this->INTERNAL_UUID_TAG, player->uuid);
 		PROCESS_TAG(this->INTERNAL_ID_TAG, string_printf("%d", player->id));
-		PROCESS_TAG(this->INTERNAL_CHARACTER_TAG, RenX::translateName(player->character));
-		PROCESS_TAG(this->INTERNAL_VEHICLE_TAG, RenX::translateName(player->vehicle));
+		PROCESS_TAG(this->INTERNAL_CHARACTER_TAG, player->characterName());
+		PROCESS_TAG(this->INTERNAL_VEHICLE_TAG, player->vehicleName());
 		PROCESS_TAG(this->INTERNAL_ADMIN_TAG, player->adminType);
 		PROCESS_TAG(this->INTERNAL_PREFIX_TAG, player->formatNamePrefix);
 		PROCESS_TAG(this->INTERNAL_GAME_PREFIX_TAG, player->gamePrefix);
@@ -493,25 +493,25 @@ void TagsImp::processTags(std::string& msg, const RenX::Server *server, const Re
 		PROCESS_TAG(this->INTERNAL_TEAM_SHORT_TAG, RenX::getTeamName(player->team));
 		PROCESS_TAG(this->INTERNAL_TEAM_LONG_TAG, RenX::getFullTeamName(player->team));
 		PROCESS_TAG(this->INTERNAL_PING_TAG, string_printf("%hu", player->ping));
-		PROCESS_TAG(this->INTERNAL_SCORE_TAG, string_printf("%.0f", player->score));
-		PROCESS_TAG(this->INTERNAL_SCORE_PER_MINUTE_TAG, string_printf("%.2f", get_ratio(static_cast<double>(player->score), static_cast<double>((std::chrono::steady_clock::now() - player->joinTime).count()) / 60.0)));
-		PROCESS_TAG(this->INTERNAL_CREDITS_TAG, string_printf("%.0f", player->credits));
-		PROCESS_TAG(this->INTERNAL_KILLS_TAG, string_printf("%u", player->kills));
-		PROCESS_TAG(this->INTERNAL_DEATHS_TAG, string_printf("%u", player->deaths));
-		PROCESS_TAG(this->INTERNAL_KDR_TAG, string_printf("%.2f", get_ratio(static_cast<double>(player->kills), static_cast<double>(player->deaths))));
-		PROCESS_TAG(this->INTERNAL_SUICIDES_TAG, string_printf("%u", player->suicides));
-		PROCESS_TAG(this->INTERNAL_HEADSHOTS_TAG, string_printf("%u", player->headshots));
-		PROCESS_TAG(this->INTERNAL_HEADSHOT_KILL_RATIO_TAG, string_printf("%.2f", get_ratio(player->headshots, player->kills)));
-		PROCESS_TAG(this->INTERNAL_VEHICLE_KILLS_TAG, string_printf("%u", player->vehicleKills));
-		PROCESS_TAG(this->INTERNAL_BUILDING_KILLS_TAG, string_printf("%u", player->buildingKills));
-		PROCESS_TAG(this->INTERNAL_DEFENCE_KILLS_TAG, string_printf("%u", player->defenceKills));
-		PROCESS_TAG(this->INTERNAL_WINS_TAG, string_printf("%u", player->wins));
-		PROCESS_TAG(this->INTERNAL_LOSSES_TAG, string_printf("%u", player->loses));
-		PROCESS_TAG(this->INTERNAL_BEACON_PLACEMENTS_TAG, string_printf("%u", player->beaconPlacements));
-		PROCESS_TAG(this->INTERNAL_BEACON_DISARMS_TAG, string_printf("%u", player->beaconDisarms));
-		PROCESS_TAG(this->INTERNAL_CAPTURES_TAG, string_printf("%u", player->captures));
-		PROCESS_TAG(this->INTERNAL_STEALS_TAG, string_printf("%u", player->steals));
-		PROCESS_TAG(this->INTERNAL_STOLEN_TAG, string_printf("%u", player->stolen));
+		PROCESS_TAG(this->INTERNAL_SCORE_TAG, string_printf("%.0f", player->score()));
+		PROCESS_TAG(this->INTERNAL_SCORE_PER_MINUTE_TAG, string_printf("%.2f", get_ratio(static_cast<double>(player->score()), static_cast<double>((std::chrono::steady_clock::now() - player->joinTime).count()) / 60.0)));
+		PROCESS_TAG(this->INTERNAL_CREDITS_TAG, string_printf("%.0f", player->credits()));
+		PROCESS_TAG(this->INTERNAL_KILLS_TAG, string_printf("%u", player->kills()));
+		PROCESS_TAG(this->INTERNAL_DEATHS_TAG, string_printf("%u", player->deaths()));
+		PROCESS_TAG(this->INTERNAL_KDR_TAG, string_printf("%.2f", get_ratio(static_cast<double>(player->kills()), static_cast<double>(player->deaths()))));
+		PROCESS_TAG(this->INTERNAL_SUICIDES_TAG, string_printf("%u", player->suicides()));
+		PROCESS_TAG(this->INTERNAL_HEADSHOTS_TAG, string_printf("%u", player->headshots()));
+		PROCESS_TAG(this->INTERNAL_HEADSHOT_KILL_RATIO_TAG, string_printf("%.2f", get_ratio(player->headshots(), player->kills())));
+		PROCESS_TAG(this->INTERNAL_VEHICLE_KILLS_TAG, string_printf("%u", player->vehicleKills()));
+		PROCESS_TAG(this->INTERNAL_BUILDING_KILLS_TAG, string_printf("%u", player->buildingKills()));
+		PROCESS_TAG(this->INTERNAL_DEFENCE_KILLS_TAG, string_printf("%u", player->defenceKills()));
+		PROCESS_TAG(this->INTERNAL_WINS_TAG, string_printf("%u", player->wins()));
+		PROCESS_TAG(this->INTERNAL_LOSSES_TAG, string_printf("%u", player->loses()));
+		PROCESS_TAG(this->INTERNAL_BEACON_PLACEMENTS_TAG, string_printf("%u", player->beaconPlacements()));
+		PROCESS_TAG(this->INTERNAL_BEACON_DISARMS_TAG, string_printf("%u", player->beaconDisarms()));
+		PROCESS_TAG(this->INTERNAL_CAPTURES_TAG, string_printf("%u", player->captures()));
+		PROCESS_TAG(this->INTERNAL_STEALS_TAG, string_printf("%u", player->steals()));
+		PROCESS_TAG(this->INTERNAL_STOLEN_TAG, string_printf("%u", player->stolen()));
 		PROCESS_TAG(this->INTERNAL_ACCESS_TAG, string_printf("%d", player->access));
 	}
 	if (victim != nullptr)
@@ -528,8 +528,8 @@ void TagsImp::processTags(std::string& msg, const RenX::Server *server, const Re
 		}
 		PROCESS_TAG(this->INTERNAL_VICTIM_UUID_TAG, victim->uuid);
 		PROCESS_TAG(this->INTERNAL_VICTIM_ID_TAG, string_printf("%d", victim->id));
-		PROCESS_TAG(this->INTERNAL_VICTIM_CHARACTER_TAG, RenX::translateName(victim->character));
-		PROCESS_TAG(this->INTERNAL_VICTIM_VEHICLE_TAG, RenX::translateName(victim->vehicle));
+		PROCESS_TAG(this->INTERNAL_VICTIM_CHARACTER_TAG, victim->characterName());
+		PROCESS_TAG(this->INTERNAL_VICTIM_VEHICLE_TAG, victim->vehicleName());
 		PROCESS_TAG(this->INTERNAL_VICTIM_ADMIN_TAG, victim->adminType);
 		PROCESS_TAG(this->INTERNAL_VICTIM_PREFIX_TAG, victim->formatNamePrefix);
 		PROCESS_TAG(this->INTERNAL_VICTIM_GAME_PREFIX_TAG, victim->gamePrefix);
@@ -537,25 +537,25 @@ void TagsImp::processTags(std::string& msg, const RenX::Server *server, const Re
 		PROCESS_TAG(this->INTERNAL_VICTIM_TEAM_SHORT_TAG, RenX::getTeamName(victim->team));
 		PROCESS_TAG(this->INTERNAL_VICTIM_TEAM_LONG_TAG, RenX::getFullTeamName(victim->team));
 		PROCESS_TAG(this->INTERNAL_VICTIM_PING_TAG, string_printf("%hu", victim->ping));
-		PROCESS_TAG(this->INTERNAL_VICTIM_SCORE_TAG, string_printf("%.0f", victim->score));
-		PROCESS_TAG(this->INTERNAL_VICTIM_SCORE_PER_MINUTE_TAG, string_printf("%.2f", get_ratio(static_cast<double>(victim->score), static_cast<double>((std::chrono::steady_clock::now() - victim->joinTime).count()) / 60.0)));
-		PROCESS_TAG(this->INTERNAL_VICTIM_CREDITS_TAG, string_printf("%.0f", victim->credits));
-		PROCESS_TAG(this->INTERNAL_VICTIM_KILLS_TAG, string_printf("%u", victim->kills));
-		PROCESS_TAG(this->INTERNAL_VICTIM_DEATHS_TAG, string_printf("%u", victim->deaths));
-		PROCESS_TAG(this->INTERNAL_VICTIM_KDR_TAG, string_printf("%.2f", get_ratio(static_cast<double>(victim->kills), static_cast<double>(victim->deaths))));
-		PROCESS_TAG(this->INTERNAL_VICTIM_SUICIDES_TAG, string_printf("%u", victim->suicides));
-		PROCESS_TAG(this->INTERNAL_VICTIM_HEADSHOTS_TAG, string_printf("%u", victim->headshots));
-		PROCESS_TAG(this->INTERNAL_VICTIM_HEADSHOT_KILL_RATIO_TAG, string_printf("%.2f", get_ratio(victim->headshots, victim->kills)));
-		PROCESS_TAG(this->INTERNAL_VICTIM_VEHICLE_KILLS_TAG, string_printf("%u", victim->vehicleKills));
-		PROCESS_TAG(this->INTERNAL_VICTIM_BUILDING_KILLS_TAG, string_printf("%u", victim->buildingKills));
-		PROCESS_TAG(this->INTERNAL_VICTIM_DEFENCE_KILLS_TAG, string_printf("%u", victim->defenceKills));
-		PROCESS_TAG(this->INTERNAL_VICTIM_WINS_TAG, string_printf("%u", victim->wins));
-		PROCESS_TAG(this->INTERNAL_VICTIM_LOSSES_TAG, string_printf("%u", victim->loses));
-		PROCESS_TAG(this->INTERNAL_VICTIM_BEACON_PLACEMENTS_TAG, string_printf("%u", victim->beaconPlacements));
-		PROCESS_TAG(this->INTERNAL_VICTIM_BEACON_DISARMS_TAG, string_printf("%u", victim->beaconDisarms));
-		PROCESS_TAG(this->INTERNAL_VICTIM_CAPTURES_TAG, string_printf("%u", victim->captures));
-		PROCESS_TAG(this->INTERNAL_VICTIM_STEALS_TAG, string_printf("%u", victim->steals));
-		PROCESS_TAG(this->INTERNAL_VICTIM_STOLEN_TAG, string_printf("%u", victim->stolen));
+		PROCESS_TAG(this->INTERNAL_VICTIM_SCORE_TAG, string_printf("%.0f", victim->score()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_SCORE_PER_MINUTE_TAG, string_printf("%.2f", get_ratio(static_cast<double>(victim->score()), static_cast<double>((std::chrono::steady_clock::now() - victim->joinTime).count()) / 60.0)));
+		PROCESS_TAG(this->INTERNAL_VICTIM_CREDITS_TAG, string_printf("%.0f", victim->credits()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_KILLS_TAG, string_printf("%u", victim->kills()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_DEATHS_TAG, string_printf("%u", victim->deaths()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_KDR_TAG, string_printf("%.2f", get_ratio(static_cast<double>(victim->kills()), static_cast<double>(victim->deaths()))));
+		PROCESS_TAG(this->INTERNAL_VICTIM_SUICIDES_TAG, string_printf("%u", victim->suicides()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_HEADSHOTS_TAG, string_printf("%u", victim->headshots()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_HEADSHOT_KILL_RATIO_TAG, string_printf("%.2f", get_ratio(victim->headshots(), victim->kills())));
+		PROCESS_TAG(this->INTERNAL_VICTIM_VEHICLE_KILLS_TAG, string_printf("%u", victim->vehicleKills()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_BUILDING_KILLS_TAG, string_printf("%u", victim->buildingKills()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_DEFENCE_KILLS_TAG, string_printf("%u", victim->defenceKills()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_WINS_TAG, string_printf("%u", victim->wins()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_LOSSES_TAG, string_printf("%u", victim->loses()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_BEACON_PLACEMENTS_TAG, string_printf("%u", victim->beaconPlacements()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_BEACON_DISARMS_TAG, string_printf("%u", victim->beaconDisarms()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_CAPTURES_TAG, string_printf("%u", victim->captures()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_STEALS_TAG, string_printf("%u", victim->steals()));
+		PROCESS_TAG(this->INTERNAL_VICTIM_STOLEN_TAG, string_printf("%u", victim->stolen()));
 		PROCESS_TAG(this->INTERNAL_VICTIM_ACCESS_TAG, string_printf("%d", victim->access));
 	}
 	if (building != nullptr)
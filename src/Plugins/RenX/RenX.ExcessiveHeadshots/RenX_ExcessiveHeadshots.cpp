@@ -22,6 +22,7 @@
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
 #include "RenX_Functions.h"
+#include "RenX_EventRates.h"
 
 using namespace std::literals;
 
@@ -31,23 +32,46 @@ bool RenX_ExcessiveHeadshotsPlugin::initialize() {
 	RenX_ExcessiveHeadshotsPlugin::minKD = this->config.get<double>("KillDeathRatio"sv, 5.0);
 	RenX_ExcessiveHeadshotsPlugin::minKPS = this->config.get<double>("KillsPerSecond"sv, 0.5);
 	RenX_ExcessiveHeadshotsPlugin::minFlags = this->config.get<unsigned int>("Flags"sv, 4);
+	RenX_ExcessiveHeadshotsPlugin::burstHeadshots = this->config.get<unsigned int>("BurstHeadshots"sv, 0);
+	RenX_ExcessiveHeadshotsPlugin::burstWindow = std::chrono::seconds(this->config.get<long long>("BurstWindow"sv, 20));
+
+	// Bursts of headshots are caught by a threshold on a sliding window, rather than from lifetime totals
+	if (burstSubscribed) {
+		RenX::eventRates->unsubscribe(burstSubscription);
+		burstSubscribed = false;
+	}
+
+	if (burstHeadshots != 0 && burstWindow > std::chrono::seconds::zero()) {
+		burstSubscription = RenX::eventRates->subscribe(RenX::RateEvent::Headshots, burstWindow, burstHeadshots,
+			[this](RenX::Server &server, const RenX::PlayerInfo &player, unsigned int) {
+				this->ban(server, player);
+			});
+		burstSubscribed = true;
+	}
+
 	return true;
 }
 
+RenX_ExcessiveHeadshotsPlugin::~RenX_ExcessiveHeadshotsPlugin() {
+	if (burstSubscribed) {
+		RenX::eventRates->unsubscribe(burstSubscription);
+	}
+}
+
 int RenX_ExcessiveHeadshotsPlugin::OnRehash() {
 	RenX::Plugin::OnRehash();
 	return this->initialize() ? 0 : -1;
 }
 
 void RenX_ExcessiveHeadshotsPlugin::RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, std::string_view damageType) {
-	if (player.kills < 3)
+	if (player.kills() < 3)
 		return;
 
 	if (damageType == "Rx_DmgType_Headshot"sv) {
 		unsigned int flags = 0;
 		std::chrono::milliseconds game_time = server.getGameTime(player);
-		double kps = game_time == std::chrono::milliseconds::zero() ? static_cast<double>(player.kills) : static_cast<double>(player.kills) / static_cast<double>(game_time.count());
-		if (player.kills >= RenX_ExcessiveHeadshotsPlugin::minKills) flags++;
+		double kps = game_time == std::chrono::milliseconds::zero() ? static_cast<double>(player.kills()) : static_cast<double>(player.kills()) / static_cast<double>(game_time.count());
+		if (player.kills() >= RenX_ExcessiveHeadshotsPlugin::minKills) flags++;
 		if (RenX::getHeadshotKillRatio(player) >= RenX_ExcessiveHeadshotsPlugin::ratio) flags++;
 		if (RenX::getKillDeathRatio(player) >= RenX_ExcessiveHeadshotsPlugin::minKD) flags++;
 		if (kps >= RenX_ExcessiveHeadshotsPlugin::minKPS) flags++;
@@ -55,16 +79,24 @@ void RenX_ExcessiveHeadshotsPlugin::RenX_OnKill(RenX::Server &server, const RenX
 		if (game_time <= RenX_ExcessiveHeadshotsPlugin::maxGameTime) flags++;
 
 		if (flags >= RenX_ExcessiveHeadshotsPlugin::minFlags)
-		{
-			server.banPlayer(player, "Jupiter Bot"sv, "Aimbot detected"sv);
-			server.sendPubChan(IRCCOLOR "13[Aimbot]" IRCCOLOR " %.*s was banned from the server! Kills: %u - Deaths: %u - Headshots: %u", player.name.size(), player.name.data(), player.kills, player.deaths, player.headshots);
-			std::string_view steamid = server.formatSteamID(player);
-			server.sendAdmChan(IRCCOLOR "13[Aimbot]" IRCCOLOR " %.*s was banned from the server! Kills: %u - Deaths: %u - Headshots: %u - IP: " IRCBOLD "%.*s" IRCBOLD " - Steam ID: " IRCBOLD "%.*s" IRCBOLD, player.name.size(), player.name.data(), player.kills, player.deaths, player.headshots, player.ip.size(), player.ip.data(), steamid.size(),
-				steamid.data());
-		}
+			this->ban(server, player);
 	}
 }
 
+void RenX_ExcessiveHeadshotsPlugin::ban(RenX::Server &server, const RenX::PlayerInfo &player) {
+	// The burst and flag checks can both trip on the same kill; only ban and announce once
+	bool &alreadyBanned = banned.get(player);
+	if (alreadyBanned)
+		return;
+	alreadyBanned = true;
+
+	server.banPlayer(player, "Jupiter Bot"sv, "Aimbot detected"sv);
+	server.sendPubChan(IRCCOLOR "13[Aimbot]" IRCCOLOR " %.*s was banned from the server! Kills: %u - Deaths: %u - Headshots: %u", player.name.size(), player.name.data(), player.kills(), player.deaths(), player.headshots());
+	std::string_view steamid = server.formatSteamID(player);
+	server.sendAdmChan(IRCCOLOR "13[Aimbot]" IRCCOLOR " %.*s was banned from the server! Kills: %u - Deaths: %u - Headshots: %u - IP: " IRCBOLD "%.*s" IRCBOLD " - Steam ID: " IRCBOLD "%.*s" IRCBOLD, player.name.size(), player.name.data(), player.kills(), player.deaths(), player.headshots(), player.ip.size(), player.ip.data(), steamid.size(),
+		steamid.data());
+}
+
 
 // Plugin instantiation and entry point.
 RenX_ExcessiveHeadshotsPlugin pluginInstance;
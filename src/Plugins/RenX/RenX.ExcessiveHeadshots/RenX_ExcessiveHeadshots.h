@@ -22,6 +22,7 @@
 #include <chrono>
 #include "Jupiter/Plugin.h"
 #include "RenX_Plugin.h"
+#include "RenX_DataSlot.h"
 
 class RenX_ExcessiveHeadshotsPlugin : public RenX::Plugin
 {
@@ -31,13 +32,23 @@ public: // RenX::Plugin
 public: // Jupiter::Plugin
 	virtual bool initialize() override;
 	int OnRehash() override;
+	~RenX_ExcessiveHeadshotsPlugin();
+
 private:
+	/** Bans a player at most once, no matter how many checks they trip */
+	void ban(RenX::Server &server, const RenX::PlayerInfo &player);
+
 	unsigned int minFlags = 4;
 	double ratio = 0.5;
 	double minKD = 5.0;
 	double minKPS = 0.1;
 	unsigned int minKills = 10;
 	std::chrono::seconds maxGameTime = std::chrono::seconds(180);
+	unsigned int burstHeadshots = 0;
+	std::chrono::seconds burstWindow = std::chrono::seconds(20);
+	bool burstSubscribed = false;
+	size_t burstSubscription = 0;
+	RenX::PlayerSlot<bool> banned;
 };
 
 #endif // _EXCESSIVEHEADSHOTS_H_HEADER
\ No newline at end of file
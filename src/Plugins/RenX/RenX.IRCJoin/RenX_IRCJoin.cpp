@@ -19,6 +19,7 @@
 #include "Jupiter/IRC_Client.h"
 #include "RenX_Core.h"
 #include "RenX_Server.h"
+#include "RenX_Broadcast.h"
 #include "RenX_IRCJoin.h"
 #include "RenX_Tags.h"
 
@@ -42,24 +43,14 @@ bool RenX_IRCJoinPlugin::initialize() {
 
 void RenX_IRCJoinPlugin::OnJoin(Jupiter::IRC::Client *source, std::string_view channel, std::string_view nick) {
 	if (!RenX_IRCJoinPlugin::joinFmt.empty()) {
-		RenX::Server *server;
 		int type = source->getChannel(channel)->getType();
 		std::string msg = RenX_IRCJoinPlugin::joinFmt;
 		RenX::replace_tag(msg, RenX_IRCJoinPlugin::nameTag, nick);
 		RenX::replace_tag(msg, RenX_IRCJoinPlugin::chanTag, channel);
 
-		auto checkType = [&] {
-			if (this->publicOnly)
-				return server->isPublicLogChanType(type);
-			else
-				return server->isLogChanType(type);
-		};
-		for (unsigned int i = 0; i != RenX::getCore()->getServerCount(); i++) {
-			server = RenX::getCore()->getServer(i);
-			if (checkType() && (RenX_IRCJoinPlugin::joinMsgAlways || server->players.size() != server->getBotCount())) {
-				server->sendMessage(msg);
-			}
-		}
+		RenX::broadcast(msg, [this, type](const RenX::Server &server) {
+			return checkType(server, type) && (RenX_IRCJoinPlugin::joinMsgAlways || server.getHumanCount() != 0);
+		});
 	}
 }
 
@@ -68,7 +59,6 @@ void RenX_IRCJoinPlugin::OnPart(Jupiter::IRC::Client *source, std::string_view c
 		int access = source->getAccessLevel(channel, nick);
 
 		if (access >= RenX_IRCJoinPlugin::minAccessPartMessage && (RenX_IRCJoinPlugin::maxAccessPartMessage == -1 || access <= RenX_IRCJoinPlugin::maxAccessPartMessage)) {
-			RenX::Server *server;
 			int type = source->getChannel(channel)->getType();
 
 			std::string msg;
@@ -80,24 +70,21 @@ void RenX_IRCJoinPlugin::OnPart(Jupiter::IRC::Client *source, std::string_view c
 			RenX::replace_tag(msg, RenX_IRCJoinPlugin::chanTag, channel);
 			RenX::replace_tag(msg, RenX_IRCJoinPlugin::partReasonTag, reason);
 
-			auto checkType = [&]() {
-				if (this->publicOnly) {
-					return server->isPublicLogChanType(type);
-				}
-				else {
-					return server->isLogChanType(type);
-				}
-			};
-			for (unsigned int i = 0; i != RenX::getCore()->getServerCount(); i++) {
-				server = RenX::getCore()->getServer(i);
-				if (checkType() && (RenX_IRCJoinPlugin::partMsgAlways || server->players.size() != server->getBotCount())) {
-					server->sendMessage(msg);
-				}
-			}
+			RenX::broadcast(msg, [this, type](const RenX::Server &server) {
+				return checkType(server, type) && (RenX_IRCJoinPlugin::partMsgAlways || server.getHumanCount() != 0);
+			});
 		}
 	}
 }
 
+bool RenX_IRCJoinPlugin::checkType(const RenX::Server &server, int type) const {
+	if (this->publicOnly) {
+		return server.isPublicLogChanType(type);
+	}
+
+	return server.isLogChanType(type);
+}
+
 int RenX_IRCJoinPlugin::OnRehash()
 {
 	RenX::Plugin::OnRehash();
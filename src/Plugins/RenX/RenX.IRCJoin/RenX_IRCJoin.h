@@ -31,6 +31,8 @@ public: // Jupiter::Plugin
 	int OnRehash() override;
 
 private:
+	bool checkType(const RenX::Server &server, int type) const;
+
 	// Config Variables
 	bool publicOnly;
 	bool joinMsgAlways;
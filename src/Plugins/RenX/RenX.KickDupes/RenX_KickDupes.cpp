@@ -21,11 +21,13 @@
 #include "RenX_Server.h"
 #include "RenX_Functions.h"
 #include "RenX_PlayerInfo.h"
+#include "RenX_PlayerIndex.h"
 #include "RenX_KickDupes.h"
 
 using namespace std::literals;
 
 bool RenX_KickDupesPlugin::initialize() {
+	m_fleetWide = this->config.get<bool>("FleetWide"sv, false);
 	return true;
 }
 
@@ -41,14 +43,29 @@ void RenX_KickDupesPlugin::RenX_OnPlayerIdentify(RenX::Server &in_server, const
 		return;
 	}
 
-	// Check to see if any other players on the server have the same HWID
+	// Check to see if any other players on the server (or on any server, if fleet-wide) have the same HWID
+	auto matches = RenX::playerIndex->findByHWID(in_player.hwid);
+	if (matches.size() <= s_tolerance) {
+		// Common case: too few players with this HWID to kick anyone
+		return;
+	}
+
+	// Collect first, since kicking may update the index
+	std::vector<RenX::PlayerLocation> duplicates;
+	for (const auto& match : matches) {
+		const RenX::PlayerLocation& location = match.second;
+		if (location.player != &in_player
+			&& (m_fleetWide || location.server == &in_server)
+			&& jessilib::findi(location.server->getGameVersion(), "-DEV"sv) == std::string::npos) {
+			duplicates.push_back(location);
+		}
+	}
+
+	// Two players have the same HWID, but are separate players; kick the pre-existing players if there's too many.
 	size_t hits{};
-	for (auto& player : in_server.players) {
-		if (player.hwid == in_player.hwid && player.id != in_player.id) {
-			// Two players have the same HWID, but separate player IDs; kick the pre-existing player if there's too many.
-			if (++hits > s_tolerance) {
-				in_server.forceKickPlayer(player, "Ghost client detected"sv);
-			}
+	for (const auto& location : duplicates) {
+		if (++hits > s_tolerance) {
+			location.server->forceKickPlayer(*location.player, "Ghost client detected"sv);
 		}
 	}
 }
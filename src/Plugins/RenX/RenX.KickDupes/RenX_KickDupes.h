@@ -32,6 +32,7 @@ public: // RenX::Plugin
 
 private:
 	static constexpr size_t s_tolerance{ 1 };
+	bool m_fleetWide = false;
 };
 
 #endif // _RENX_KICKDUPES_H_HEADER
@@ -17,13 +17,16 @@
  */
 
 #include "Jupiter/IRC_Client.h"
+#include "StartupTasks.h"
 #include "RenX_Ladder_All_Time.h"
 
 using namespace std::literals;
 
 bool RenX_Ladder_All_TimePlugin::initialize() {
-	// Load database
-	this->database.process_file(this->config.get("LadderDatabase"sv, "Ladder.db"sv));
+	// Load database; nothing reads it until after it is loaded
+	startupTasks->add("ladder database"sv, [this, filename = std::string{ this->config.get("LadderDatabase"sv, "Ladder.db"sv) }] {
+		this->database.process_file(filename);
+	});
 	this->database.setName(this->config.get("DatabaseName"sv, "All-Time"sv));
 	this->database.setOutputTimes(this->config.get<bool>("OutputTimes"sv, true));
 
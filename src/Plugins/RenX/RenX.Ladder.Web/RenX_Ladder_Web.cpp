@@ -16,46 +16,68 @@
  * Written by Jessica James <jessica.aj@outlook.com>
  */
 
+#include <algorithm>
+#include <cctype>
 #include "jessilib/unicode.hpp"
 #include "jessilib/http_query.hpp"
 #include "Jupiter/IRC_Client.h"
 #include "Jupiter/HTTP.h"
 #include "HTTPServer.h"
+#include "JSONWriter.h"
 #include "RenX_Tags.h"
 #include "RenX_Ladder_Web.h"
 
 using namespace std::literals;
 
+static constexpr std::string_view CONTENT_TYPE_APPLICATION_JSON = "application/json"sv;
+
 bool RenX_Ladder_WebPlugin::initialize() {
 	RenX_Ladder_WebPlugin::ladder_page_name = this->config.get("LadderPageName"sv, ""sv);
 	RenX_Ladder_WebPlugin::search_page_name = this->config.get("SearchPageName"sv, "search"sv);
 	RenX_Ladder_WebPlugin::profile_page_name = this->config.get("ProfilePageName"sv, "profile"sv);
+	RenX_Ladder_WebPlugin::ladder_json_page_name = this->config.get("LadderJSONPageName"sv, "ladder_json"sv);
+	RenX_Ladder_WebPlugin::profile_json_page_name = this->config.get("ProfileJSONPageName"sv, "profile_json"sv);
 	RenX_Ladder_WebPlugin::web_hostname = this->config.get("Hostname"sv, ""sv);
 	RenX_Ladder_WebPlugin::web_path = this->config.get("Path"sv, "/"sv);
 
+	std::chrono::milliseconds cache_time = std::chrono::seconds(this->config.get<long long>("CacheTime"sv, 60));
+
 	this->init();
 
 	/** Initialize content */
 	Jupiter::HTTP::Server &server = getHTTPServer();
 
-	std::unique_ptr<Jupiter::HTTP::Server::Content> content = std::make_unique<Jupiter::HTTP::Server::Content>(RenX_Ladder_WebPlugin::ladder_page_name, handle_ladder_page);
+	std::unique_ptr<Jupiter::HTTP::Server::Content> content = std::make_unique<CachedContent>(RenX_Ladder_WebPlugin::ladder_page_name, handle_ladder_page, "ladder"sv, cache_time);
 	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
 	content->type = Jupiter::HTTP::Content::Type::Text::HTML;
 	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
 	server.hook(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, std::move(content));
 
-	content = std::make_unique<Jupiter::HTTP::Server::Content>(RenX_Ladder_WebPlugin::search_page_name, handle_search_page);
+	content = std::make_unique<CachedContent>(RenX_Ladder_WebPlugin::search_page_name, handle_search_page, "ladder"sv, cache_time);
 	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
 	content->type = Jupiter::HTTP::Content::Type::Text::HTML;
 	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
 	server.hook(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, std::move(content));
 
-	content = std::make_unique<Jupiter::HTTP::Server::Content>(RenX_Ladder_WebPlugin::profile_page_name, handle_profile_page);
+	content = std::make_unique<CachedContent>(RenX_Ladder_WebPlugin::profile_page_name, handle_profile_page, "ladder"sv, cache_time);
 	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
 	content->type = Jupiter::HTTP::Content::Type::Text::HTML;
 	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
 	server.hook(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, std::move(content));
 
+	// JSON API
+	content = std::make_unique<CachedContent>(RenX_Ladder_WebPlugin::ladder_json_page_name, handle_ladder_json_page, "ladder"sv, cache_time);
+	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
+	content->type = CONTENT_TYPE_APPLICATION_JSON;
+	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
+	server.hook(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, std::move(content));
+
+	content = std::make_unique<CachedContent>(RenX_Ladder_WebPlugin::profile_json_page_name, handle_profile_json_page, "ladder"sv, cache_time);
+	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
+	content->type = CONTENT_TYPE_APPLICATION_JSON;
+	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
+	server.hook(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, std::move(content));
+
 	return true;
 }
 
@@ -64,6 +86,8 @@ RenX_Ladder_WebPlugin::~RenX_Ladder_WebPlugin() {
 	server.remove(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, RenX_Ladder_WebPlugin::ladder_page_name);
 	server.remove(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, RenX_Ladder_WebPlugin::search_page_name);
 	server.remove(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, RenX_Ladder_WebPlugin::profile_page_name);
+	server.remove(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, RenX_Ladder_WebPlugin::ladder_json_page_name);
+	server.remove(RenX_Ladder_WebPlugin::web_hostname, RenX_Ladder_WebPlugin::web_path, RenX_Ladder_WebPlugin::profile_json_page_name);
 }
 
 void RenX_Ladder_WebPlugin::init() {
@@ -76,6 +100,7 @@ void RenX_Ladder_WebPlugin::init() {
 	RenX_Ladder_WebPlugin::web_ladder_table_header_filename = static_cast<std::string>(this->config.get("LadderTableHeaderFilename"sv, "RenX.Ladder.Web.Ladder.Table.Header.html"sv));
 	RenX_Ladder_WebPlugin::web_ladder_table_footer_filename = static_cast<std::string>(this->config.get("LadderTableFooterFilename"sv, "RenX.Ladder.Web.Ladder.Table.Footer.html"sv));
 	RenX_Ladder_WebPlugin::entries_per_page = this->config.get<size_t>("EntriesPerPage"sv, 50);
+	RenX_Ladder_WebPlugin::max_json_entries = std::max<size_t>(this->config.get<size_t>("MaxJSONEntries"sv, 500), 1);
 	RenX_Ladder_WebPlugin::min_search_name_length = this->config.get<size_t>("MinSearchNameLength"sv, 3);
 
 	RenX_Ladder_WebPlugin::entry_table_row = this->config.get("EntryTableRow"sv, R"html(<tr><td class="data-col-a">{RANK}</td><td class="data-col-b"><a href="profile?id={STEAM}&database={OBJECT}">{NAME}</a></td><td class="data-col-a">{SCORE}</td><td class="data-col-b">{SPM}</td><td class="data-col-a">{GAMES}</td><td class="data-col-b">{WINS}</td><td class="data-col-a">{LOSSES}</td><td class="data-col-b">{WLR}</td><td class="data-col-a">{KILLS}</td><td class="data-col-b">{DEATHS}</td><td class="data-col-a">{KDR}</td></tr>)html"sv);
@@ -144,9 +169,25 @@ void RenX_Ladder_WebPlugin::init() {
 	}
 }
 
+int RenX_Ladder_WebPlugin::think() {
+	// Cached pages are stale once any database changes
+	uint64_t revision = RenX::ladder_databases.size();
+	for (const auto& database : RenX::ladder_databases) {
+		revision += database->getRevision();
+	}
+
+	if (revision != RenX_Ladder_WebPlugin::ladder_revision) {
+		RenX_Ladder_WebPlugin::ladder_revision = revision;
+		invalidateHTTPCache("ladder"sv);
+	}
+
+	return Jupiter::Plugin::think();
+}
+
 int RenX_Ladder_WebPlugin::OnRehash() {
 	RenX::Plugin::OnRehash();
 	this->init();
+	invalidateHTTPCache("ladder"sv);
 	return 0;
 }
 
@@ -234,6 +275,64 @@ std::string generate_page_buttons(RenX::LadderDatabase *db) {
 	return result;
 }
 
+/** Appends a value to a query string, percent-encoding everything but unreserved characters */
+static void append_query_value(std::string& out_query, std::string_view in_value) {
+	static constexpr char hex_digits[] = "0123456789ABCDEF";
+	for (char chr : in_value) {
+		auto byte = static_cast<unsigned char>(chr);
+		if (std::isalnum(byte) || chr == '-' || chr == '_' || chr == '.' || chr == '~') {
+			out_query += chr;
+		}
+		else {
+			out_query += '%';
+			out_query += hex_digits[byte >> 4];
+			out_query += hex_digits[byte & 0x0F];
+		}
+	}
+}
+
+/** Appends a search page button linking to the page of matches beginning at an index */
+static void append_search_page_button(std::string& out_result, RenX::LadderDatabase *db, std::string_view name, size_t start_index, size_t count, std::string_view label) {
+	out_result += R"html(<span class="leaderboard-page"><a href="?name=)html"sv;
+	append_query_value(out_result, name);
+	out_result += string_printf("&start=%zu", start_index);
+	if (count != pluginInstance.getEntriesPerPage()) {
+		out_result += string_printf("&count=%zu", count);
+	}
+	if (db != RenX::default_ladder_database) {
+		out_result += "&database="sv;
+		append_query_value(out_result, db->getName());
+	}
+	out_result += R"html(">)html"sv;
+	out_result += label;
+	out_result += R"html(</a></span>)html"sv;
+}
+
+/** Previous and next page buttons for a page of search results */
+static std::string generate_search_page_buttons(RenX::LadderDatabase *db, std::string_view name, size_t start_index, size_t count, size_t total) {
+	std::string result;
+	if (count == 0 || (start_index == 0 && total <= count)) {
+		// Every match fits on one page
+		return result;
+	}
+
+	result = R"html(<div id="leaderboard-paging">)html"sv;
+	if (start_index != 0) {
+		append_search_page_button(result, db, name, start_index > count ? start_index - count : 0, count, "Previous"sv);
+	}
+
+	if (start_index < total) {
+		result += string_printf(R"html(<span class="leaderboard-page">%zu - %zu of %zu</span>)html", start_index + 1, std::min(start_index + count, total), total);
+	}
+
+	if (total > count && start_index < total - count) {
+		append_search_page_button(result, db, name, start_index + count, count, "Next"sv);
+	}
+
+	result += R"html(</div>)html"sv;
+	return result;
+}
+
 /** Ladder page */
 
 std::string RenX_Ladder_WebPlugin::generate_entry_table(RenX::LadderDatabase *db, uint8_t format, size_t index, size_t count) {
@@ -340,20 +439,20 @@ std::string* RenX_Ladder_WebPlugin::generate_search_page(RenX::LadderDatabase *d
 	// append rows
 	std::string row;
 	row.reserve(256);
-	RenX::LadderDatabase::Entry *node = db->getHead();
-	while (node != nullptr) {
-		if (jessilib::findi(node->most_recent_name, name) != std::string::npos) { // match found
-			row = RenX_Ladder_WebPlugin::entry_table_row;
-			RenX::replace_tag(row, RenX::tags->INTERNAL_OBJECT_TAG, db->getName());
-			RenX::processTags(row, *node);
-			result->append(row);
-		}
-		node = node->next;
+	RenX::LadderDatabase::SearchResults results = db->searchPlayerEntriesByPartName(name, start_index, count);
+	for (const auto& match : results.entries) {
+		row = RenX_Ladder_WebPlugin::entry_table_row;
+		RenX::replace_tag(row, RenX::tags->INTERNAL_OBJECT_TAG, db->getName());
+		RenX::processTags(row, *match.first);
+		result->append(row);
 	}
 	
 	if ((format & this->FLAG_INCLUDE_DATA_FOOTER) != 0) // Data footer
 		result->append(RenX_Ladder_WebPlugin::ladder_table_footer);
 
+	// search page buttons
+	result->append(generate_search_page_buttons(db, name, start_index, count, results.total));
+
 	if ((format & this->FLAG_INCLUDE_PAGE_FOOTER) != 0) // Footer
 		result->append(RenX_Ladder_WebPlugin::footer);
 
@@ -424,6 +523,172 @@ std::string* RenX_Ladder_WebPlugin::generate_profile_page(RenX::LadderDatabase *
 	return result;
 }
 
+/** JSON API */
+
+void write_entry_json(JSONWriter &json, const RenX::LadderDatabase::Entry &entry, size_t index) {
+	json.member("Rank"sv, index + 1);
+	json.member("SteamID"sv, std::to_string(entry.steam_id)); // Too large for double-precision consumers
+	json.member("Name"sv, entry.most_recent_name);
+	json.member("Score"sv, entry.total_score);
+	json.member("Kills"sv, entry.total_kills);
+	json.member("Deaths"sv, entry.total_deaths);
+	json.member("Headshots"sv, entry.total_headshot_kills);
+	json.member("Games"sv, entry.total_games);
+	json.member("Wins"sv, entry.total_wins);
+	json.member("Losses"sv, entry.total_games - entry.total_wins);
+	json.member("GameTime"sv, entry.total_game_time);
+	json.member("LastGame"sv, static_cast<long long>(entry.last_game));
+}
+
+void write_error_json(std::string &out_json, std::string_view in_error) {
+	JSONWriter json{ out_json };
+	json.beginObject();
+	json.member("Error"sv, in_error);
+	json.endObject();
+}
+
+std::string* RenX_Ladder_WebPlugin::generate_ladder_json(RenX::LadderDatabase *db, size_t start_index, size_t count, std::string_view name) {
+	// count comes straight from the query string; cap it, and never reserve past the end of the ladder
+	if (count == 0 || count > max_json_entries) {
+		count = max_json_entries;
+	}
+
+	if (name.empty()) {
+		size_t total = db->getEntries();
+		count = std::min(count, start_index < total ? total - start_index : 0);
+	}
+
+	std::string* result = new std::string();
+	result->reserve(256 + count * 256);
+
+	JSONWriter json{ *result };
+	json.beginObject();
+	json.member("Database"sv, db->getName());
+	json.member("Start"sv, start_index);
+	json.key("Entries"sv).beginArray();
+
+	size_t total;
+	if (name.empty()) {
+		total = db->getEntries();
+		RenX::LadderDatabase::Entry *node = start_index < total ? db->getPlayerEntryByIndex(start_index) : nullptr;
+		for (size_t index = start_index; node != nullptr && index != start_index + count; node = node->next, ++index) {
+			json.beginObject();
+			write_entry_json(json, *node, index);
+			json.endObject();
+		}
+	}
+	else {
+		RenX::LadderDatabase::SearchResults results = db->searchPlayerEntriesByPartName(name, start_index, count);
+		total = results.total;
+		for (const auto& match : results.entries) {
+			json.beginObject();
+			write_entry_json(json, *match.first, match.second);
+			json.endObject();
+		}
+	}
+
+	json.endArray();
+	json.member("Total"sv, total);
+	json.endObject();
+	return result;
+}
+
+std::string* RenX_Ladder_WebPlugin::generate_profile_json(RenX::LadderDatabase *db, uint64_t steam_id) {
+	std::string* result = new std::string();
+	auto entry_and_index = db->getPlayerEntryAndIndex(steam_id);
+	RenX::LadderDatabase::Entry *entry = entry_and_index.first;
+	if (entry == nullptr) {
+		write_error_json(*result, "Player not found"sv);
+		return result;
+	}
+
+	result->reserve(2048);
+	JSONWriter json{ *result };
+	json.beginObject();
+	json.member("Database"sv, db->getName());
+	write_entry_json(json, *entry, entry_and_index.second);
+	json.member("BuildingKills"sv, entry->total_building_kills);
+	json.member("DefenceKills"sv, entry->total_defence_kills);
+	json.member("VehicleKills"sv, entry->total_vehicle_kills);
+	json.member("Captures"sv, entry->total_captures);
+	json.member("BeaconPlacements"sv, entry->total_beacon_placements);
+	json.member("BeaconDisarms"sv, entry->total_beacon_disarms);
+	json.member("ProxyPlacements"sv, entry->total_proxy_placements);
+	json.member("ProxyDisarms"sv, entry->total_proxy_disarms);
+
+	json.key("GDI"sv).beginObject();
+	json.member("Score"sv, entry->total_gdi_score);
+	json.member("Games"sv, entry->total_gdi_games);
+	json.member("Wins"sv, entry->total_gdi_wins);
+	json.member("Ties"sv, entry->total_gdi_ties);
+	json.member("GameTime"sv, entry->total_gdi_game_time);
+	json.member("Kills"sv, entry->total_gdi_kills);
+	json.member("Deaths"sv, entry->total_gdi_deaths);
+	json.member("Headshots"sv, entry->total_gdi_headshots);
+	json.member("VehicleKills"sv, entry->total_gdi_vehicle_kills);
+	json.member("BuildingKills"sv, entry->total_gdi_building_kills);
+	json.member("DefenceKills"sv, entry->total_gdi_defence_kills);
+	json.member("BeaconPlacements"sv, entry->total_gdi_beacon_placements);
+	json.member("BeaconDisarms"sv, entry->total_gdi_beacon_disarms);
+	json.member("ProxyPlacements"sv, entry->total_gdi_proxy_placements);
+	json.member("ProxyDisarms"sv, entry->total_gdi_proxy_disarms);
+	json.endObject();
+
+	json.key("Nod"sv).beginObject();
+	json.member("Score"sv, entry->total_nod_score);
+	json.member("Games"sv, entry->total_nod_games);
+	json.member("Wins"sv, entry->total_nod_wins);
+	json.member("Ties"sv, entry->total_nod_ties);
+	json.member("GameTime"sv, entry->total_nod_game_time);
+	json.member("Kills"sv, entry->total_nod_kills);
+	json.member("Deaths"sv, entry->total_nod_deaths);
+	json.member("Headshots"sv, entry->total_nod_headshots);
+	json.member("VehicleKills"sv, entry->total_nod_vehicle_kills);
+	json.member("BuildingKills"sv, entry->total_nod_building_kills);
+	json.member("DefenceKills"sv, entry->total_nod_defence_kills);
+	json.member("BeaconPlacements"sv, entry->total_nod_beacon_placements);
+	json.member("BeaconDisarms"sv, entry->total_nod_beacon_disarms);
+	json.member("ProxyPlacements"sv, entry->total_nod_proxy_placements);
+	json.member("ProxyDisarms"sv, entry->total_nod_proxy_disarms);
+	json.endObject();
+
+	json.key("Top"sv).beginObject();
+	json.member("Score"sv, entry->top_score);
+	json.member("Kills"sv, entry->top_kills);
+	json.member("Deaths"sv, entry->most_deaths);
+	json.member("Headshots"sv, entry->top_headshot_kills);
+	json.member("VehicleKills"sv, entry->top_vehicle_kills);
+	json.member("BuildingKills"sv, entry->top_building_kills);
+	json.member("DefenceKills"sv, entry->top_defence_kills);
+	json.member("Captures"sv, entry->top_captures);
+	json.member("GameTime"sv, entry->top_game_time);
+	json.member("BeaconPlacements"sv, entry->top_beacon_placements);
+	json.member("BeaconDisarms"sv, entry->top_beacon_disarms);
+	json.member("ProxyPlacements"sv, entry->top_proxy_placements);
+	json.member("ProxyDisarms"sv, entry->top_proxy_disarms);
+	json.endObject();
+
+	// Neighbours on the ladder, for navigation
+	json.key("Previous"sv);
+	if (entry->prev != nullptr) {
+		json.value(std::to_string(entry->prev->steam_id));
+	}
+	else {
+		json.null();
+	}
+
+	json.key("Next"sv);
+	if (entry->next != nullptr) {
+		json.value(std::to_string(entry->next->steam_id));
+	}
+	else {
+		json.null();
+	}
+
+	json.endObject();
+	return result;
+}
+
 /** Content functions */
 
 std::string* generate_no_db_page(const query_table_type& query_params) {
@@ -562,6 +827,56 @@ std::string* handle_profile_page(std::string_view query_string) {
 	return pluginInstance.generate_profile_page(db, format, steam_id, table);
 }
 
+RenX::LadderDatabase *find_ladder_database(const query_table_type& in_table) {
+	std::string_view db_name = get_table_value(in_table, "database"sv, {});
+	if (db_name.empty()) {
+		return RenX::default_ladder_database;
+	}
+
+	for (const auto& database : RenX::ladder_databases) {
+		if (jessilib::equalsi(std::string_view{database->getName()}, db_name)) {
+			return database;
+		}
+	}
+
+	return nullptr;
+}
+
+std::string* handle_ladder_json_page(std::string_view query_string) {
+	auto parsed_query = parse_query_string(query_string);
+	auto& table = parsed_query.second;
+	RenX::LadderDatabase *db = find_ladder_database(table);
+	if (db == nullptr) {
+		std::string* result = new std::string();
+		write_error_json(*result, "No such database exists"sv);
+		return result;
+	}
+
+	size_t start_index = from_table_value<size_t>(table, "start"sv, 0);
+	size_t count = from_table_value<size_t>(table, "count"sv, pluginInstance.getEntriesPerPage());
+	std::string_view name = get_table_value(table, "name"sv, {});
+	if (!name.empty() && name.size() < pluginInstance.getMinSearchNameLength()) {
+		std::string* result = new std::string();
+		write_error_json(*result, "Search name is too short"sv);
+		return result;
+	}
+
+	return pluginInstance.generate_ladder_json(db, start_index, count, name);
+}
+
+std::string* handle_profile_json_page(std::string_view query_string) {
+	auto parsed_query = parse_query_string(query_string);
+	auto& table = parsed_query.second;
+	RenX::LadderDatabase *db = find_ladder_database(table);
+	if (db == nullptr) {
+		std::string* result = new std::string();
+		write_error_json(*result, "No such database exists"sv);
+		return result;
+	}
+
+	return pluginInstance.generate_profile_json(db, from_table_value<uint64_t>(table, "id"sv, 0));
+}
+
 extern "C" JUPITER_EXPORT Jupiter::Plugin *getPlugin() {
 	return &pluginInstance;
 }
@@ -42,6 +42,8 @@ public:
 	std::string* generate_ladder_page(RenX::LadderDatabase *db, uint8_t format, size_t start_index, size_t count, const query_table_type& query_params);
 	std::string* generate_search_page(RenX::LadderDatabase *db, uint8_t format, size_t start_index, size_t count, std::string_view name, const query_table_type& query_params);
 	std::string* generate_profile_page(RenX::LadderDatabase *db, uint8_t format, uint64_t steam_id, const query_table_type& query_params);
+	std::string* generate_ladder_json(RenX::LadderDatabase *db, size_t start_index, size_t count, std::string_view name);
+	std::string* generate_profile_json(RenX::LadderDatabase *db, uint64_t steam_id);
 	inline size_t getEntriesPerPage() const { return this->entries_per_page; }
 	inline size_t getMinSearchNameLength() const { return this->min_search_name_length; };
 
@@ -49,6 +51,7 @@ public:
 	~RenX_Ladder_WebPlugin();
 
 public: // Jupiter::Plugin
+	int think() override;
 	int OnRehash() override;
 
 private:
@@ -56,8 +59,11 @@ private:
 
 	/** Configuration variables */
 	size_t entries_per_page;
+	size_t max_json_entries;
 	size_t min_search_name_length;
+	uint64_t ladder_revision = 0; /** Sum of the revisions of all ladder databases, as of the last think() */
 	std::string ladder_page_name, search_page_name, profile_page_name, ladder_table_header, ladder_table_footer;
+	std::string ladder_json_page_name, profile_json_page_name;
 	std::string web_hostname;
 	std::string web_path;
 	std::string web_header_filename;
@@ -72,5 +78,7 @@ private:
 std::string* handle_ladder_page(std::string_view query_string);
 std::string* handle_search_page(std::string_view query_string);
 std::string* handle_profile_page(std::string_view query_string);
+std::string* handle_ladder_json_page(std::string_view query_string);
+std::string* handle_profile_json_page(std::string_view query_string);
 
 #endif // _RENX_LADDER_WEB_H
\ No newline at end of file
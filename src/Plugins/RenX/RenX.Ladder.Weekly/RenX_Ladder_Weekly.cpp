@@ -18,14 +18,17 @@
 
 #include <ctime>
 #include "Jupiter/IRC_Client.h"
+#include "StartupTasks.h"
 #include "RenX_Ladder_Weekly.h"
 
 using namespace std::literals;
 
 bool RenX_Ladder_Weekly_TimePlugin::initialize() {
 	time_t current_time = time(0);
-	// Load database
-	this->database.process_file(this->config.get("LadderDatabase"sv, "Ladder.Weekly.db"sv));
+	// Load database; nothing reads it until after it is loaded
+	startupTasks->add("ladder database"sv, [this, filename = std::string{ this->config.get("LadderDatabase"sv, "Ladder.Weekly.db"sv) }] {
+		this->database.process_file(filename);
+	});
 	this->database.setName(this->config.get("DatabaseName"sv, "Weekly"sv));
 	this->database.setOutputTimes(this->config.get<bool>("OutputTimes"sv, false));
 
@@ -18,14 +18,17 @@
 
 #include <ctime>
 #include "Jupiter/IRC_Client.h"
+#include "StartupTasks.h"
 #include "RenX_Ladder_Yearly.h"
 
 using namespace std::literals;
 
 bool RenX_Ladder_Yearly_TimePlugin::initialize() {
 	time_t current_time = time(0);
-	// Load database
-	this->database.process_file(this->config.get("LadderDatabase"sv, "Ladder.Yearly.db"sv));
+	// Load database; nothing reads it until after it is loaded
+	startupTasks->add("ladder database"sv, [this, filename = std::string{ this->config.get("LadderDatabase"sv, "Ladder.Yearly.db"sv) }] {
+		this->database.process_file(filename);
+	});
 	this->database.setName(this->config.get("DatabaseName"sv, "Yearly"sv));
 	this->database.setOutputTimes(this->config.get<bool>("OutputTimes"sv, false));
 
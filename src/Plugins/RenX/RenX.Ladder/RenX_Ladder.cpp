@@ -54,23 +54,12 @@ void RenX_LadderPlugin::RenX_OnServerFullyConnected(RenX::Server &server) {
 /** Wait until the client list has been updated to update the ladder */
 
 void RenX_LadderPlugin::RenX_OnGameOver(RenX::Server &server, RenX::WinType winType, const RenX::TeamType &team, int gScore, int nScore) {
-	if (server.isRanked() && server.isReliable() && server.players.size() != server.getBotCount()) {
-		char chr = static_cast<char>(team);
-		server.varData[this->name].set("t"sv, std::string(&chr, 1));
-		server.varData[this->name].set("w"sv, "1"s);
-		server.updateClientList();
-	}
-}
-
-void RenX_LadderPlugin::RenX_OnCommand(RenX::Server &server, std::string_view ) {
-	if (jessilib::equalsi(server.getCurrentRCONCommand(), "clientvarlist"sv)) {
-		if (server.varData[this->name].get("w"sv, "0"sv) == "1"sv) {
-			server.varData[this->name].set("w"sv, "0"s);
-			RenX::TeamType team = static_cast<RenX::TeamType>(server.varData[this->name].get("t"sv, "\0"sv)[0]);
+	if (server.isRanked() && server.isReliable() && server.getHumanCount() != 0) {
+		server.updateClientList([team](RenX::Server &in_server) {
 			for (const auto& database : RenX::ladder_databases) {
-				database->updateLadder(server, team);
+				database->updateLadder(in_server, team);
 			}
-		}
+		}, this);
 	}
 }
 
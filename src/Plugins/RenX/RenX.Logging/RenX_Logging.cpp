@@ -1353,7 +1353,7 @@ void RenX_LoggingPlugin::RenX_OnExplode(RenX::Server &server, std::string_view o
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType)
+void RenX_LoggingPlugin::RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol damageType)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::suicidePublic)
@@ -1365,12 +1365,12 @@ void RenX_LoggingPlugin::RenX_OnSuicide(RenX::Server &server, const RenX::Player
 	if (!msg.empty())
 	{
 		RenX::processTags(msg, &server, &player);
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, std::string_view damageType)
+void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, RenX::Symbol damageType)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::killPublic)
@@ -1382,12 +1382,12 @@ void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, const RenX::PlayerInf
 	if (!msg.empty())
 	{
 		RenX::processTags(msg, &server, &player, &victim);
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, std::string_view damageType)
+void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, RenX::Symbol damageType)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::killPublic)
@@ -1403,12 +1403,12 @@ void RenX_LoggingPlugin::RenX_OnKill(RenX::Server &server, std::string_view kill
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_TEAM_COLOR_TAG, RenX::getTeamColor(killerTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_TEAM_SHORT_TAG, RenX::getTeamName(killerTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_TEAM_LONG_TAG, RenX::getFullTeamName(killerTeam));
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType)
+void RenX_LoggingPlugin::RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol damageType)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::diePublic)
@@ -1420,7 +1420,7 @@ void RenX_LoggingPlugin::RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo
 	if (!msg.empty())
 	{
 		RenX::processTags(msg, &server, &player);
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
@@ -1446,7 +1446,7 @@ void RenX_LoggingPlugin::RenX_OnDie(RenX::Server &server, std::string_view objec
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view objectName, const RenX::TeamType &objectTeam, std::string_view damageType, RenX::ObjectType type)
+void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol objectName, const RenX::TeamType &objectTeam, RenX::Symbol damageType, RenX::ObjectType type)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::destroyPublic)
@@ -1473,8 +1473,8 @@ void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, const RenX::Player
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_COLOR_TAG, RenX::getTeamColor(objectTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_SHORT_TAG, RenX::getTeamName(objectTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_LONG_TAG, RenX::getFullTeamName(objectTeam));
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_OBJECT_TAG, RenX::translateName(objectName));
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_OBJECT_TAG, RenX::symbols->translated(objectName));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
@@ -1943,7 +1943,7 @@ void RenX_LoggingPlugin::RenX_OnDonate(RenX::Server &server, const RenX::PlayerI
 	}
 }
 
-void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, std::string_view objectName, const RenX::TeamType &objectTeam, std::string_view damageType, RenX::ObjectType type)
+void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, RenX::Symbol objectName, const RenX::TeamType &objectTeam, RenX::Symbol damageType, RenX::ObjectType type)
 {
 	logFuncType func;
 	if (RenX_LoggingPlugin::destroyPublic)
@@ -1974,8 +1974,8 @@ void RenX_LoggingPlugin::RenX_OnDestroy(RenX::Server &server, std::string_view k
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_COLOR_TAG, RenX::getTeamColor(objectTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_SHORT_TAG, RenX::getTeamName(objectTeam));
 		RenX::replace_tag(msg, RenX::tags->INTERNAL_VICTIM_TEAM_LONG_TAG, RenX::getFullTeamName(objectTeam));
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_OBJECT_TAG, RenX::translateName(objectName));
-		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::translateName(damageType));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_OBJECT_TAG, RenX::symbols->translated(objectName));
+		RenX::replace_tag(msg, RenX::tags->INTERNAL_WEAPON_TAG, RenX::symbols->translated(damageType));
 		(server.*func)(msg);
 	}
 }
@@ -59,13 +59,13 @@ public: // RenX::Plugin
 	void RenX_OnDisarm(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view object) override;
 	void RenX_OnExplode(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view object) override;
 	void RenX_OnExplode(RenX::Server &server, std::string_view object) override;
-	void RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) override;
-	void RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, std::string_view damageType) override;
-	void RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, std::string_view damageType) override;
-	void RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) override;
+	void RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol damageType) override;
+	void RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, RenX::Symbol damageType) override;
+	void RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, RenX::Symbol damageType) override;
+	void RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol damageType) override;
 	void RenX_OnDie(RenX::Server &server, std::string_view object, const RenX::TeamType &objectTeam, std::string_view damageType) override;
-	void RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view objectName, const RenX::TeamType &objectTeam, std::string_view damageType, RenX::ObjectType type) override;
-	void RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, std::string_view objectName, const RenX::TeamType &objectTeam, std::string_view damageType, RenX::ObjectType type) override;
+	void RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, RenX::Symbol objectName, const RenX::TeamType &objectTeam, RenX::Symbol damageType, RenX::ObjectType type) override;
+	void RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, RenX::Symbol objectName, const RenX::TeamType &objectTeam, RenX::Symbol damageType, RenX::ObjectType type) override;
 	void RenX_OnCapture(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &oldTeam) override;
 	void RenX_OnNeutralize(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &oldTeam) override;
 	void RenX_OnCharacterPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view character) override;
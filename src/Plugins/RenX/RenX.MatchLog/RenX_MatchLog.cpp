@@ -0,0 +1,377 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include "jessilib/unicode.hpp"
+#include "jessilib/word_split.hpp"
+#include "Console_Command.h"
+#include "RenX_MatchLog.h"
+#include "RenX_Core.h"
+#include "RenX_Server.h"
+#include "RenX_PlayerInfo.h"
+#include "RenX_Functions.h"
+
+using namespace std::literals;
+
+/** RenX_MatchLogPlugin */
+
+bool RenX_MatchLogPlugin::initialize() {
+	m_store.setMaxMatches(this->config.get<size_t>("MaxMatches"sv, 1000));
+	if (!m_store.initialize(static_cast<std::string>(this->config.get("DatabaseFile"sv, "RenX.MatchLog.db"sv)))) {
+		return false;
+	}
+
+	// Matches already in progress are recorded from now on; anything else waits for the next map
+	RenX::Core *core = RenX::getCore();
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		RenX::Server &server = *core->getServer(index);
+		if (server.isMatchInProgress() && m_recorders.find(server) == nullptr) {
+			m_recorders.set(server, MatchStore::Recorder{ server.getName(), server.getMap().name });
+		}
+	}
+
+	return true;
+}
+
+int RenX_MatchLogPlugin::OnRehash() {
+	RenX::Plugin::OnRehash();
+	m_store.setMaxMatches(this->config.get<size_t>("MaxMatches"sv, 1000));
+	return 0;
+}
+
+RenX_MatchLogPlugin::~RenX_MatchLogPlugin() {
+	// Keep matches in progress; they're sealed without a winner
+	RenX::Core *core = RenX::getCore();
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		seal(*core->getServer(index), RenX::TeamType::None);
+	}
+}
+
+void RenX_MatchLogPlugin::record(RenX::Server &server, MatchStore::EventType type, RenX::TeamType team, std::string_view actor, std::string_view target, std::string_view detail, uint32_t value) {
+	// Recorders only exist between map start and game over; events outside of a match (i.e: post-game chat) are dropped
+	if (m_recorders.find(server) == nullptr) {
+		return;
+	}
+
+	m_recorders.get(server).record(type, team, actor, target, detail, value);
+}
+
+void RenX_MatchLogPlugin::seal(RenX::Server &server, RenX::TeamType winner) {
+	const MatchStore::Recorder *recorder = m_recorders.find(server);
+	if (recorder == nullptr) {
+		return;
+	}
+
+	if (!recorder->empty()) {
+		m_store.add(recorder->seal(winner));
+	}
+
+	m_recorders.reset(server);
+}
+
+void RenX_MatchLogPlugin::RenX_OnMapStart(RenX::Server &server, std::string_view map) {
+	seal(server, RenX::TeamType::None);
+	m_recorders.set(server, MatchStore::Recorder{ server.getName(), map });
+}
+
+void RenX_MatchLogPlugin::RenX_OnGameOver(RenX::Server &server, RenX::WinType, const RenX::TeamType &team, int, int) {
+	seal(server, team);
+}
+
+void RenX_MatchLogPlugin::RenX_OnServerDisconnect(RenX::Server &server, RenX::DisconnectReason) {
+	seal(server, RenX::TeamType::None);
+}
+
+void RenX_MatchLogPlugin::RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, std::string_view damageType) {
+	record(server, MatchStore::EventType::Kill, player.team, player.name, victim.name, damageType, 0);
+}
+
+void RenX_MatchLogPlugin::RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, std::string_view damageType) {
+	record(server, MatchStore::EventType::Kill, killerTeam, killer, victim.name, damageType, 0);
+}
+
+void RenX_MatchLogPlugin::RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) {
+	record(server, MatchStore::EventType::Death, player.team, player.name, {}, damageType, 0);
+}
+
+void RenX_MatchLogPlugin::RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) {
+	record(server, MatchStore::EventType::Suicide, player.team, player.name, {}, damageType, 0);
+}
+
+void RenX_MatchLogPlugin::RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view objectName, const RenX::TeamType &, std::string_view damageType, RenX::ObjectType type) {
+	record(server, MatchStore::EventType::Destroy, player.team, player.name, objectName, damageType, static_cast<uint32_t>(type));
+}
+
+void RenX_MatchLogPlugin::RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, std::string_view objectName, const RenX::TeamType &, std::string_view damageType, RenX::ObjectType type) {
+	record(server, MatchStore::EventType::Destroy, killerTeam, killer, objectName, damageType, static_cast<uint32_t>(type));
+}
+
+void RenX_MatchLogPlugin::RenX_OnCapture(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &) {
+	record(server, MatchStore::EventType::Capture, player.team, player.name, building, {}, static_cast<uint32_t>(CaptureType::Capture));
+}
+
+void RenX_MatchLogPlugin::RenX_OnNeutralize(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &) {
+	record(server, MatchStore::EventType::Capture, player.team, player.name, building, {}, static_cast<uint32_t>(CaptureType::Neutralize));
+}
+
+void RenX_MatchLogPlugin::RenX_OnCharacterPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view character) {
+	record(server, MatchStore::EventType::Purchase, player.team, player.name, {}, character, static_cast<uint32_t>(PurchaseType::Character));
+}
+
+void RenX_MatchLogPlugin::RenX_OnItemPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view item) {
+	record(server, MatchStore::EventType::Purchase, player.team, player.name, {}, item, static_cast<uint32_t>(PurchaseType::Item));
+}
+
+void RenX_MatchLogPlugin::RenX_OnWeaponPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view weapon) {
+	record(server, MatchStore::EventType::Purchase, player.team, player.name, {}, weapon, static_cast<uint32_t>(PurchaseType::Weapon));
+}
+
+void RenX_MatchLogPlugin::RenX_OnRefillPurchase(RenX::Server &server, const RenX::PlayerInfo &player) {
+	record(server, MatchStore::EventType::Purchase, player.team, player.name, {}, "Refill"sv, static_cast<uint32_t>(PurchaseType::Refill));
+}
+
+void RenX_MatchLogPlugin::RenX_OnVehiclePurchase(RenX::Server &server, const RenX::PlayerInfo &owner, std::string_view vehicle) {
+	record(server, MatchStore::EventType::Purchase, owner.team, owner.name, {}, vehicle, static_cast<uint32_t>(PurchaseType::Vehicle));
+}
+
+// Only the length of chat messages is recorded; never their contents
+
+void RenX_MatchLogPlugin::RenX_OnChat(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view message) {
+	record(server, MatchStore::EventType::Chat, player.team, player.name, {}, {}, static_cast<uint32_t>(message.size()));
+}
+
+void RenX_MatchLogPlugin::RenX_OnTeamChat(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view message) {
+	record(server, MatchStore::EventType::Chat, player.team, player.name, {}, "Team"sv, static_cast<uint32_t>(message.size()));
+}
+
+// Plugin instantiation and entry point.
+RenX_MatchLogPlugin pluginInstance;
+
+/** Commands */
+
+static constexpr std::string_view event_type_names[]{ "kill"sv, "death"sv, "suicide"sv, "purchase"sv, "destroy"sv, "capture"sv, "chat"sv };
+static constexpr std::string_view event_type_list = "kill, death, suicide, purchase, destroy, capture, chat"sv;
+
+static bool parse_event_type(std::string_view in_name, MatchStore::EventType &out_type) {
+	for (size_t index = 0; index != static_cast<size_t>(MatchStore::EventType::Count); ++index) {
+		if (jessilib::equalsi(in_name, event_type_names[index])) {
+			out_type = static_cast<MatchStore::EventType>(index);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static double elapsed_milliseconds(std::chrono::steady_clock::time_point in_start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - in_start).count();
+}
+
+// Match Top Command
+
+MatchTopGenericCommand::MatchTopGenericCommand() {
+	this->addTrigger("matchtop"sv);
+}
+
+AsyncCommands::Work MatchTopGenericCommand::prepare(std::string_view parameters) {
+	auto split_parameters = jessilib::word_split_view(parameters, WHITESPACE_SV);
+	MatchStore::EventType type;
+	if (split_parameters.empty() || !parse_event_type(split_parameters[0], type)) {
+		return [](const std::atomic<bool>&) {
+			return new Jupiter::GenericCommand::ResponseLine(jessilib::join<std::string>("Error: Invalid parameters. Event types: "sv, event_type_list), GenericCommand::DisplayType::PrivateError);
+		};
+	}
+
+	MatchStore::Column group_by = MatchStore::Column::Actor;
+	std::string_view group_name = "actor"sv;
+	size_t parameter = 1;
+	if (parameter < split_parameters.size()) {
+		std::string_view group = split_parameters[parameter];
+		if (jessilib::equalsi(group, "target"sv)) {
+			group_by = MatchStore::Column::Target;
+			group_name = "target"sv;
+			++parameter;
+		}
+		else if (jessilib::equalsi(group, "detail"sv)) {
+			group_by = MatchStore::Column::Detail;
+			group_name = "detail"sv;
+			++parameter;
+		}
+		else if (jessilib::equalsi(group, "actor"sv)) {
+			++parameter;
+		}
+	}
+
+	size_t count = 5;
+	if (parameter < split_parameters.size()) {
+		count = std::clamp<size_t>(Jupiter::asUnsignedInt(split_parameters[parameter++], 10), 1, 25);
+	}
+
+	size_t matches = 1;
+	if (parameter < split_parameters.size()) {
+		matches = Jupiter::asUnsignedInt(split_parameters[parameter], 10);
+	}
+
+	const MatchStore &store = pluginInstance.getStore();
+	if (store.getMatchCount() == 0) {
+		return [](const std::atomic<bool>&) {
+			return new Jupiter::GenericCommand::ResponseLine("Error: No matches have been recorded."sv, GenericCommand::DisplayType::PrivateError);
+		};
+	}
+
+	// Scanning a season of matches takes a while, so it's done on a worker thread over a snapshot
+	return [snapshot = store.getSnapshot(matches), type, group_by, count, type_name = static_cast<std::string>(split_parameters[0]), group_name](const std::atomic<bool>& cancelled) {
+		auto start = std::chrono::steady_clock::now();
+		std::vector<MatchStore::Tally> tallies = MatchStore::top(snapshot, type, group_by, count, &cancelled);
+		double query_time = elapsed_milliseconds(start);
+
+		std::string result = string_printf("Top %.*s by %.*s over the last %zu match(es) (%.3f ms):",
+			static_cast<int>(type_name.size()), type_name.data(),
+			static_cast<int>(group_name.size()), group_name.data(),
+			snapshot.size(), query_time);
+		if (tallies.empty()) {
+			result += " None"sv;
+		}
+
+		size_t rank = 0;
+		for (const auto& tally : tallies) {
+			result += string_printf(" %zu. %.*s (%llu)", ++rank, static_cast<int>(tally.name.size()), tally.name.data(), static_cast<unsigned long long>(tally.count));
+		}
+
+		return new Jupiter::GenericCommand::ResponseLine(result, GenericCommand::DisplayType::PublicSuccess);
+	};
+}
+
+std::string_view MatchTopGenericCommand::getHelp(std::string_view ) {
+	static constexpr std::string_view defaultHelp = "Lists the most frequent players or objects involved in an event type over recent matches. Syntax: matchtop <event> [actor | target | detail] [count] [matches]"sv;
+	return defaultHelp;
+}
+
+GENERIC_COMMAND_INIT(MatchTopGenericCommand)
+GENERIC_COMMAND_AS_CONSOLE_COMMAND(MatchTopGenericCommand)
+
+// Match Timeline Command
+
+MatchTimelineGenericCommand::MatchTimelineGenericCommand() {
+	this->addTrigger("matchtimeline"sv);
+}
+
+Jupiter::GenericCommand::ResponseLine *MatchTimelineGenericCommand::trigger(std::string_view parameters) {
+	static constexpr size_t max_buckets = 60;
+	auto split_parameters = jessilib::word_split_view(parameters, WHITESPACE_SV);
+	MatchStore::EventType type;
+	if (split_parameters.empty() || !parse_event_type(split_parameters[0], type)) {
+		return new Jupiter::GenericCommand::ResponseLine(jessilib::join<std::string>("Error: Invalid parameters. Event types: "sv, event_type_list), GenericCommand::DisplayType::PrivateError);
+	}
+
+	std::chrono::seconds bucket{ 60 };
+	if (split_parameters.size() > 1) {
+		bucket = std::chrono::seconds{ std::max(Jupiter::asUnsignedInt(split_parameters[1], 10), 1U) };
+	}
+
+	size_t match = 0;
+	if (split_parameters.size() > 2) {
+		match = Jupiter::asUnsignedInt(split_parameters[2], 10);
+	}
+
+	const MatchStore &store = pluginInstance.getStore();
+	const MatchStore::Segment *segment = store.getMatch(match);
+	if (segment == nullptr) {
+		return new Jupiter::GenericCommand::ResponseLine("Error: No such match has been recorded."sv, GenericCommand::DisplayType::PrivateError);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<uint64_t> buckets = store.timeline(type, bucket, match, max_buckets);
+	double query_time = elapsed_milliseconds(start);
+
+	if (buckets.empty()) {
+		return new Jupiter::GenericCommand::ResponseLine(string_printf("Error: Bucket too small; this match needs at least %u seconds per bucket.",
+			static_cast<unsigned int>(segment->duration / 1000 / max_buckets + 1)), GenericCommand::DisplayType::PrivateError);
+	}
+
+	std::string result = string_printf("%.*s per %us on %.*s (%.3f ms):",
+		static_cast<int>(split_parameters[0].size()), split_parameters[0].data(),
+		static_cast<unsigned int>(bucket.count()),
+		static_cast<int>(segment->map.size()), segment->map.data(),
+		query_time);
+	for (uint64_t count : buckets) {
+		result += string_printf(" %llu", static_cast<unsigned long long>(count));
+	}
+
+	return new Jupiter::GenericCommand::ResponseLine(result, GenericCommand::DisplayType::PublicSuccess);
+}
+
+std::string_view MatchTimelineGenericCommand::getHelp(std::string_view ) {
+	static constexpr std::string_view defaultHelp = "Counts an event type over time in a recorded match, where match 0 is the most recent. Syntax: matchtimeline <event> [bucket seconds] [match]"sv;
+	return defaultHelp;
+}
+
+GENERIC_COMMAND_INIT(MatchTimelineGenericCommand)
+GENERIC_COMMAND_AS_CONSOLE_COMMAND(MatchTimelineGenericCommand)
+
+// Match Log Info Command
+
+MatchLogInfoGenericCommand::MatchLogInfoGenericCommand() {
+	this->addTrigger("matchloginfo"sv);
+}
+
+AsyncCommands::Work MatchLogInfoGenericCommand::prepare(std::string_view ) {
+	const MatchStore &store = pluginInstance.getStore();
+	size_t matches = store.getMatchCount();
+	size_t bytes = store.getStorageSize();
+	uint64_t events = store.getEventCount();
+
+	std::string memory_info = string_printf("In memory: %zu matches - Events: %llu - Storage: %zu bytes - Per match: %.0f bytes - Per event: %.2f bytes",
+		matches, static_cast<unsigned long long>(events), bytes,
+		matches == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(matches),
+		events == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(events));
+
+	// The database file keeps every match, so it is what grows over a season
+	size_t file_matches = store.getFileMatchCount();
+	uint64_t file_events = store.getFileEventCount();
+	uint64_t file_size = store.getFileSize();
+	std::string file_info = string_printf("On disk: %zu matches - Events: %llu - File: %llu bytes - Per event: %.2f bytes - Loaded in: %lld ms",
+		file_matches, static_cast<unsigned long long>(file_events), static_cast<unsigned long long>(file_size),
+		file_events == 0 ? 0.0 : static_cast<double>(file_size) / static_cast<double>(file_events),
+		static_cast<long long>(store.getLoadTime().count()));
+
+	// Worst-case query latency: matchtop over every match held in memory, on a worker thread over a snapshot
+	return [snapshot = store.getSnapshot(0), memory_info = std::move(memory_info), file_info = std::move(file_info)](const std::atomic<bool>& cancelled) {
+		auto *response = new Jupiter::GenericCommand::ResponseLine(memory_info, GenericCommand::DisplayType::PublicSuccess);
+		response->next = new Jupiter::GenericCommand::ResponseLine(file_info, GenericCommand::DisplayType::PublicSuccess);
+
+		auto start = std::chrono::steady_clock::now();
+		MatchStore::top(snapshot, MatchStore::EventType::Kill, MatchStore::Column::Actor, 5, &cancelled);
+		std::string result = string_printf("Full scan (matchtop kill over %zu matches): %.3f ms", snapshot.size(), elapsed_milliseconds(start));
+		response->next->next = new Jupiter::GenericCommand::ResponseLine(result, GenericCommand::DisplayType::PublicSuccess);
+
+		return response;
+	};
+}
+
+std::string_view MatchLogInfoGenericCommand::getHelp(std::string_view ) {
+	static constexpr std::string_view defaultHelp = "Displays the number of recorded matches in memory and on disk, the storage they use, and the time taken to query all of them. Syntax: matchloginfo"sv;
+	return defaultHelp;
+}
+
+GENERIC_COMMAND_INIT(MatchLogInfoGenericCommand)
+GENERIC_COMMAND_AS_CONSOLE_COMMAND(MatchLogInfoGenericCommand)
+
+extern "C" JUPITER_EXPORT Jupiter::Plugin *getPlugin() {
+	return &pluginInstance;
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_MATCHLOG_H_HEADER
+#define _RENX_MATCHLOG_H_HEADER
+
+#include "Jupiter/Plugin.h"
+#include "IRC_Command.h"
+#include "AsyncCommands.h"
+#include "RenX_Plugin.h"
+#include "RenX_DataSlot.h"
+#include "RenX_MatchStore.h"
+
+/** DLL Linkage Nagging */
+#if defined _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+class RenX_MatchLogPlugin : public RenX::Plugin
+{
+public: // RenX::Plugin
+	void RenX_OnMapStart(RenX::Server &server, std::string_view map) override;
+	void RenX_OnGameOver(RenX::Server &server, RenX::WinType winType, const RenX::TeamType &team, int gScore, int nScore) override;
+	void RenX_OnServerDisconnect(RenX::Server &server, RenX::DisconnectReason reason) override;
+
+	void RenX_OnKill(RenX::Server &server, const RenX::PlayerInfo &player, const RenX::PlayerInfo &victim, std::string_view damageType) override;
+	void RenX_OnKill(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, const RenX::PlayerInfo &victim, std::string_view damageType) override;
+	void RenX_OnDie(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) override;
+	void RenX_OnSuicide(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view damageType) override;
+	void RenX_OnDestroy(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view objectName, const RenX::TeamType &victimTeam, std::string_view damageType, RenX::ObjectType type) override;
+	void RenX_OnDestroy(RenX::Server &server, std::string_view killer, const RenX::TeamType &killerTeam, std::string_view objectName, const RenX::TeamType &objectTeam, std::string_view damageType, RenX::ObjectType type) override;
+	void RenX_OnCapture(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &oldTeam) override;
+	void RenX_OnNeutralize(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view building, const RenX::TeamType &oldTeam) override;
+	void RenX_OnCharacterPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view character) override;
+	void RenX_OnItemPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view item) override;
+	void RenX_OnWeaponPurchase(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view weapon) override;
+	void RenX_OnRefillPurchase(RenX::Server &server, const RenX::PlayerInfo &player) override;
+	void RenX_OnVehiclePurchase(RenX::Server &server, const RenX::PlayerInfo &owner, std::string_view vehicle) override;
+	void RenX_OnChat(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view message) override;
+	void RenX_OnTeamChat(RenX::Server &server, const RenX::PlayerInfo &player, std::string_view message) override;
+
+public: // Jupiter::Plugin
+	virtual bool initialize() override;
+	int OnRehash() override;
+	~RenX_MatchLogPlugin();
+
+public: // RenX_MatchLogPlugin
+	/** Values of the Value column for Purchase events */
+	enum class PurchaseType : uint32_t
+	{
+		Character,
+		Item,
+		Weapon,
+		Refill,
+		Vehicle
+	};
+
+	/** Values of the Value column for Capture events */
+	enum class CaptureType : uint32_t
+	{
+		Capture,
+		Neutralize
+	};
+
+	MatchStore &getStore() { return m_store; }
+
+private:
+	void record(RenX::Server &server, MatchStore::EventType type, RenX::TeamType team, std::string_view actor, std::string_view target, std::string_view detail, uint32_t value);
+	void seal(RenX::Server &server, RenX::TeamType winner);
+
+	MatchStore m_store;
+	RenX::ServerSlot<MatchStore::Recorder> m_recorders; /** Match in progress on each server; only set by RenX_OnMapStart (or initialize), and unset between matches */
+};
+
+GENERIC_ASYNC_GENERIC_COMMAND(MatchTopGenericCommand)
+GENERIC_GENERIC_COMMAND(MatchTimelineGenericCommand)
+GENERIC_ASYNC_GENERIC_COMMAND(MatchLogInfoGenericCommand)
+
+/** Re-enable warnings */
+#if defined _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _RENX_MATCHLOG_H_HEADER
@@ -0,0 +1,367 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include "Jupiter/DataBuffer.h"
+#include "RenX_MatchStore.h"
+
+/** Column encoding */
+
+static void push_varint(std::string &out_column, uint32_t in_value) {
+	while (in_value >= 0x80) {
+		out_column += static_cast<char>(in_value | 0x80);
+		in_value >>= 7;
+	}
+
+	out_column += static_cast<char>(in_value);
+}
+
+/** Segment */
+
+std::vector<uint32_t> MatchStore::Segment::decode(Column in_column) const {
+	std::vector<uint32_t> result;
+	result.reserve(events);
+
+	const std::string &column = columns[static_cast<size_t>(in_column)];
+	uint32_t value = 0;
+	unsigned int shift = 0;
+	for (char chr : column) {
+		value |= static_cast<uint32_t>(static_cast<unsigned char>(chr) & 0x7F) << shift;
+		if ((chr & 0x80) != 0) {
+			shift += 7;
+			continue;
+		}
+
+		result.push_back(value);
+		value = 0;
+		shift = 0;
+	}
+
+	// Times are stored as deltas from the previous event
+	if (in_column == Column::Time) {
+		for (size_t index = 1; index < result.size(); ++index) {
+			result[index] += result[index - 1];
+		}
+	}
+
+	return result;
+}
+
+size_t MatchStore::Segment::size() const {
+	size_t result = 0;
+	for (const auto& column : columns) {
+		result += column.size();
+	}
+
+	for (const auto& string : strings) {
+		result += string.size();
+	}
+
+	return result;
+}
+
+/** Recorder */
+
+MatchStore::Recorder::Recorder(std::string_view in_server, std::string_view in_map)
+	: m_server{ in_server },
+	m_map{ in_map } {
+}
+
+uint32_t MatchStore::Recorder::intern(std::string_view in_string) {
+	auto itr = m_string_indexes.find(in_string);
+	if (itr != m_string_indexes.end()) {
+		return itr->second;
+	}
+
+	uint32_t index = static_cast<uint32_t>(m_strings.size());
+	m_strings.emplace_back(in_string);
+	m_string_indexes.emplace(in_string, index);
+	return index;
+}
+
+void MatchStore::Recorder::record(EventType in_type, RenX::TeamType in_team, std::string_view in_actor, std::string_view in_target, std::string_view in_detail, uint32_t in_value) {
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+	record(elapsed, in_type, in_team, in_actor, in_target, in_detail, in_value);
+}
+
+void MatchStore::Recorder::record(std::chrono::milliseconds in_time, EventType in_type, RenX::TeamType in_team, std::string_view in_actor, std::string_view in_target, std::string_view in_detail, uint32_t in_value) {
+	m_columns[static_cast<size_t>(Column::Time)].push_back(static_cast<uint32_t>(in_time.count()));
+	m_columns[static_cast<size_t>(Column::Type)].push_back(static_cast<uint32_t>(in_type));
+	m_columns[static_cast<size_t>(Column::Team)].push_back(static_cast<uint32_t>(in_team));
+	m_columns[static_cast<size_t>(Column::Actor)].push_back(intern(in_actor));
+	m_columns[static_cast<size_t>(Column::Target)].push_back(intern(in_target));
+	m_columns[static_cast<size_t>(Column::Detail)].push_back(intern(in_detail));
+	m_columns[static_cast<size_t>(Column::Value)].push_back(in_value);
+}
+
+MatchStore::Segment MatchStore::Recorder::seal(RenX::TeamType in_winner) const {
+	Segment result;
+	result.server = m_server;
+	result.map = m_map;
+	result.start_time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(m_start_time.time_since_epoch()).count());
+	result.duration = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count());
+	result.winner = static_cast<uint8_t>(in_winner);
+	result.events = static_cast<uint32_t>(m_columns[0].size());
+	result.strings = m_strings;
+
+	for (size_t index = 0; index != static_cast<size_t>(Column::Count); ++index) {
+		const auto& values = m_columns[index];
+		std::string& column = result.columns[index];
+		column.reserve(values.size());
+
+		if (index == static_cast<size_t>(Column::Time)) {
+			uint32_t last = 0;
+			for (uint32_t value : values) {
+				push_varint(column, value - last);
+				last = value;
+			}
+		}
+		else {
+			for (uint32_t value : values) {
+				push_varint(column, value);
+			}
+		}
+	}
+
+	return result;
+}
+
+/** MatchStore */
+
+constexpr uint8_t match_store_version = 1;
+
+void MatchStore::process_header(FILE *file) {
+	int chr = fgetc(file);
+	if (chr != EOF) {
+		m_read_version = static_cast<uint8_t>(chr);
+	}
+}
+
+void MatchStore::create_header(FILE *file) {
+	fputc(match_store_version, file);
+}
+
+void MatchStore::process_data(Jupiter::DataBuffer &buffer, FILE *, fpos_t) {
+	if (m_read_version != match_store_version) {
+		return;
+	}
+
+	Segment segment;
+	segment.server = buffer.pop<std::string>();
+	segment.map = buffer.pop<std::string>();
+	segment.start_time = buffer.pop<uint64_t>();
+	segment.duration = buffer.pop<uint32_t>();
+	segment.winner = buffer.pop<uint8_t>();
+	segment.events = buffer.pop<uint32_t>();
+
+	for (size_t strings = buffer.pop<size_t>(); strings != 0; --strings) {
+		segment.strings.push_back(buffer.pop<std::string>());
+	}
+
+	for (auto& column : segment.columns) {
+		column = buffer.pop<std::string>();
+	}
+
+	++m_file_match_count;
+	m_file_event_count += segment.events;
+	m_storage_size += segment.size();
+	m_event_count += segment.events;
+	m_segments.push_back(std::make_shared<const Segment>(std::move(segment)));
+	trim();
+}
+
+void MatchStore::write(const Segment &in_segment) {
+	FILE *file = fopen(m_filename.c_str(), "ab");
+	if (file == nullptr) {
+		return;
+	}
+
+	fseek(file, 0, SEEK_END);
+	if (ftell(file) == 0) {
+		create_header(file);
+	}
+
+	Jupiter::DataBuffer buffer;
+	buffer.push(in_segment.server);
+	buffer.push(in_segment.map);
+	buffer.push(in_segment.start_time);
+	buffer.push(in_segment.duration);
+	buffer.push(in_segment.winner);
+	buffer.push(in_segment.events);
+
+	buffer.push(in_segment.strings.size());
+	for (const auto& string : in_segment.strings) {
+		buffer.push(string);
+	}
+
+	for (const auto& column : in_segment.columns) {
+		buffer.push(column);
+	}
+
+	buffer.push_to(file);
+	fclose(file);
+
+	++m_file_match_count;
+	m_file_event_count += in_segment.events;
+}
+
+void MatchStore::add(Segment in_segment) {
+	if (!m_filename.empty()) {
+		write(in_segment);
+	}
+
+	m_storage_size += in_segment.size();
+	m_event_count += in_segment.events;
+	m_segments.push_back(std::make_shared<const Segment>(std::move(in_segment)));
+	trim();
+}
+
+void MatchStore::trim() {
+	while (m_max_matches != 0 && m_segments.size() > m_max_matches) {
+		m_storage_size -= m_segments.front()->size();
+		m_event_count -= m_segments.front()->events;
+		m_segments.pop_front();
+	}
+}
+
+const MatchStore::Segment* MatchStore::getMatch(size_t in_match) const {
+	if (in_match >= m_segments.size()) {
+		return nullptr;
+	}
+
+	return m_segments[m_segments.size() - in_match - 1].get();
+}
+
+MatchStore::Snapshot MatchStore::getSnapshot(size_t in_matches) const {
+	if (in_matches == 0 || in_matches > m_segments.size()) {
+		in_matches = m_segments.size();
+	}
+
+	return { m_segments.rbegin(), m_segments.rbegin() + in_matches };
+}
+
+std::vector<MatchStore::Tally> MatchStore::top(EventType in_type, Column in_group_by, size_t in_count, size_t in_matches) const {
+	return top(getSnapshot(in_matches), in_type, in_group_by, in_count);
+}
+
+std::vector<MatchStore::Tally> MatchStore::top(const Snapshot& in_snapshot, EventType in_type, Column in_group_by, size_t in_count, const std::atomic<bool>* in_cancelled) {
+	std::unordered_map<std::string_view, uint64_t> counts;
+
+	// Only the type column and the grouped column are decoded
+	for (const auto& segment : in_snapshot) {
+		if (in_cancelled != nullptr && *in_cancelled) {
+			return {};
+		}
+
+		std::vector<uint32_t> types = segment->decode(Column::Type);
+		std::vector<uint32_t> groups = segment->decode(in_group_by);
+		size_t events = std::min(types.size(), groups.size());
+		for (size_t index = 0; index != events; ++index) {
+			if (types[index] == static_cast<uint32_t>(in_type)
+				&& groups[index] != 0
+				&& groups[index] < segment->strings.size()) {
+				++counts[segment->strings[groups[index]]];
+			}
+		}
+	}
+
+	std::vector<Tally> result;
+	result.reserve(counts.size());
+	for (const auto& count : counts) {
+		result.push_back({ count.first, count.second });
+	}
+
+	in_count = std::min(in_count, result.size());
+	std::partial_sort(result.begin(), result.begin() + in_count, result.end(), [](const Tally& lhs, const Tally& rhs) {
+		if (lhs.count != rhs.count) {
+			return lhs.count > rhs.count;
+		}
+
+		return lhs.name < rhs.name;
+	});
+	result.resize(in_count);
+
+	return result;
+}
+
+std::vector<uint64_t> MatchStore::timeline(EventType in_type, std::chrono::milliseconds in_bucket, size_t in_match, size_t in_max_buckets) const {
+	std::vector<uint64_t> result;
+	const Segment *segment = getMatch(in_match);
+	if (segment == nullptr || in_bucket.count() <= 0) {
+		return result;
+	}
+
+	std::vector<uint32_t> times = segment->decode(Column::Time);
+	uint64_t length = segment->duration;
+	if (!times.empty()) {
+		length = std::max<uint64_t>(length, times.back());
+	}
+
+	// Checked before anything is allocated, since the bucket length comes from user input
+	uint64_t bucket = static_cast<uint64_t>(in_bucket.count());
+	uint64_t bucket_count = length / bucket + 1;
+	if (bucket_count > in_max_buckets) {
+		return result;
+	}
+
+	std::vector<uint32_t> types = segment->decode(Column::Type);
+	result.resize(static_cast<size_t>(bucket_count));
+
+	size_t events = std::min(times.size(), types.size());
+	for (size_t index = 0; index != events; ++index) {
+		if (types[index] == static_cast<uint32_t>(in_type)) {
+			++result[static_cast<size_t>(times[index] / bucket)];
+		}
+	}
+
+	return result;
+}
+
+void MatchStore::setMaxMatches(size_t in_max_matches) {
+	m_max_matches = in_max_matches;
+	trim();
+}
+
+bool MatchStore::initialize(std::string in_filename) {
+	m_filename = std::move(in_filename);
+	if (m_filename.empty()) {
+		return true;
+	}
+
+	m_segments.clear();
+	m_storage_size = 0;
+	m_event_count = 0;
+	m_file_match_count = 0;
+	m_file_event_count = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	this->process_file(m_filename);
+	m_load_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	return true;
+}
+
+uint64_t MatchStore::getFileSize() const {
+	if (m_filename.empty()) {
+		return 0;
+	}
+
+	std::error_code error;
+	uintmax_t result = std::filesystem::file_size(m_filename, error);
+	return error ? 0 : static_cast<uint64_t>(result);
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _RENX_MATCHSTORE_H_HEADER
+#define _RENX_MATCHSTORE_H_HEADER
+
+/**
+ * @file RenX_MatchStore.h
+ * @brief Provides the column-oriented event store behind RenX.MatchLog.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Jupiter/Database.h"
+#include "RenX.h"
+
+/**
+* @brief Append-only store of per-match event logs.
+* Each match is sealed into a segment which stores its events column by column; each column is delta and/or
+* varint encoded, so that a typical event takes a handful of bytes, and so that queries only decode the columns they use.
+*/
+class MatchStore : public Jupiter::Database
+{
+public: // Jupiter::Database
+	void process_data(Jupiter::DataBuffer &buffer, FILE *file, fpos_t pos) override;
+	void process_header(FILE *file) override;
+	void create_header(FILE *file) override;
+
+public: // MatchStore
+	enum class EventType : uint8_t
+	{
+		Kill,
+		Death,
+		Suicide,
+		Purchase,
+		Destroy,
+		Capture,
+		Chat,
+		Count
+	};
+
+	enum class Column : size_t
+	{
+		Time, // Milliseconds since the match started
+		Type, // EventType
+		Team, // Team of the actor
+		Actor, // String index; player or object which caused the event
+		Target, // String index; victim, object destroyed, or building captured
+		Detail, // String index; damage type, or item purchased
+		Value, // Type-specific; see RenX_MatchLogPlugin
+		Count
+	};
+
+	/**
+	* @brief Events of a single match, sealed into encoded columns.
+	*/
+	struct Segment
+	{
+		std::string server;
+		std::string map;
+		uint64_t start_time = 0; /** Seconds since the UNIX epoch */
+		uint32_t duration = 0; /** Milliseconds */
+		uint8_t winner = 0; /** RenX::TeamType of the winning team */
+		uint32_t events = 0;
+		std::vector<std::string> strings; /** Strings referenced by the Actor, Target, and Detail columns; 0 is always the empty string */
+		std::string columns[static_cast<size_t>(Column::Count)];
+
+		/**
+		* @brief Decodes a column.
+		*
+		* @param in_column Column to decode
+		* @return Values of the column, one per event
+		*/
+		std::vector<uint32_t> decode(Column in_column) const;
+
+		/**
+		* @brief Fetches the number of bytes used to store this segment's events and strings.
+		*
+		* @return Size of the segment in bytes
+		*/
+		size_t size() const;
+	};
+
+	/**
+	* @brief Events of a match in progress; appended to as they happen, then sealed into a Segment.
+	*/
+	class Recorder
+	{
+	public:
+		void record(EventType in_type, RenX::TeamType in_team, std::string_view in_actor, std::string_view in_target, std::string_view in_detail, uint32_t in_value);
+
+		/** Records an event at an explicit time since the start of the match (i.e: when replaying events); times must not decrease */
+		void record(std::chrono::milliseconds in_time, EventType in_type, RenX::TeamType in_team, std::string_view in_actor, std::string_view in_target, std::string_view in_detail, uint32_t in_value);
+		bool empty() const { return m_columns[0].empty(); }
+		Segment seal(RenX::TeamType in_winner) const;
+
+		Recorder() = default;
+		Recorder(std::string_view in_server, std::string_view in_map);
+
+	private:
+		uint32_t intern(std::string_view in_string);
+
+		std::string m_server;
+		std::string m_map;
+		std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+		std::chrono::system_clock::time_point m_start_time = std::chrono::system_clock::now();
+		std::vector<uint32_t> m_columns[static_cast<size_t>(Column::Count)];
+		/** Hashes std::string and std::string_view alike, so that intern() can look up views without copying them */
+		struct StringHash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view in_string) const { return std::hash<std::string_view>{}(in_string); }
+		};
+
+		std::vector<std::string> m_strings{ std::string{} };
+		std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> m_string_indexes{ { std::string{}, 0 } };
+	};
+
+	/** Stored matches are shared with snapshots, so that queries may run on other threads while matches are added or trimmed */
+	using SegmentPtr = std::shared_ptr<const Segment>;
+	using Snapshot = std::vector<SegmentPtr>;
+
+	struct Tally
+	{
+		std::string_view name;
+		uint64_t count;
+	};
+
+	/**
+	* @brief Counts events of a type by the string in one of their columns, and returns the most frequent strings.
+	*
+	* @param in_type Type of event to count
+	* @param in_group_by Column to group events by (Actor, Target, or Detail)
+	* @param in_count Maximum number of results
+	* @param in_matches Number of most recent matches to count over, or 0 for all stored matches
+	* @return Most frequent strings, in descending order of count
+	*/
+	std::vector<Tally> top(EventType in_type, Column in_group_by, size_t in_count, size_t in_matches) const;
+
+	/**
+	* @brief Counts events of a type over a snapshot; safe to call from any thread.
+	*
+	* @param in_snapshot Matches to count over (see getSnapshot())
+	* @param in_type Type of event to count
+	* @param in_group_by Column to group events by (Actor, Target, or Detail)
+	* @param in_count Maximum number of results
+	* @param in_cancelled Optional flag which stops the count when set
+	* @return Most frequent strings, in descending order of count, or an empty vector if cancelled. Names view the snapshot's strings.
+	*/
+	static std::vector<Tally> top(const Snapshot& in_snapshot, EventType in_type, Column in_group_by, size_t in_count, const std::atomic<bool>* in_cancelled = nullptr);
+
+	/**
+	* @brief Counts events of a type in fixed-length time buckets across a match.
+	*
+	* @param in_type Type of event to count
+	* @param in_bucket Length of each bucket
+	* @param in_match Index of the match, where 0 is the most recent
+	* @param in_max_buckets Maximum number of buckets to return
+	* @return Number of events in each bucket, or an empty vector if there is no such match or it needs more than in_max_buckets buckets
+	*/
+	std::vector<uint64_t> timeline(EventType in_type, std::chrono::milliseconds in_bucket, size_t in_match, size_t in_max_buckets) const;
+
+	/**
+	* @brief Stores a sealed match, and appends it to the database file.
+	*
+	* @param in_segment Sealed match to store
+	*/
+	void add(Segment in_segment);
+
+	/**
+	* @brief Fetches a stored match.
+	*
+	* @param in_match Index of the match, where 0 is the most recent
+	* @return Stored match if one exists, nullptr otherwise
+	*/
+	const Segment* getMatch(size_t in_match) const;
+
+	/**
+	* @brief Shares the most recent matches, for querying off the main thread.
+	*
+	* @param in_matches Number of most recent matches to share, or 0 for every stored match
+	* @return Shared matches, most recent first
+	*/
+	Snapshot getSnapshot(size_t in_matches) const;
+
+	size_t getMatchCount() const { return m_segments.size(); }
+	size_t getStorageSize() const { return m_storage_size; }
+	uint64_t getEventCount() const { return m_event_count; }
+
+	/** Totals over every match in the database file, including those trimmed from memory */
+	size_t getFileMatchCount() const { return m_file_match_count; }
+	uint64_t getFileEventCount() const { return m_file_event_count; }
+	uint64_t getFileSize() const;
+
+	/** Time taken to read the database file during initialize() */
+	std::chrono::milliseconds getLoadTime() const { return m_load_time; }
+
+	void setMaxMatches(size_t in_max_matches);
+	bool initialize(std::string in_filename);
+
+private:
+	void trim();
+	void write(const Segment &in_segment);
+
+	std::string m_filename;
+	uint8_t m_read_version = 0;
+	size_t m_max_matches = 0;
+	size_t m_storage_size = 0;
+	uint64_t m_event_count = 0;
+	size_t m_file_match_count = 0;
+	uint64_t m_file_event_count = 0;
+	std::chrono::milliseconds m_load_time{};
+	std::deque<SegmentPtr> m_segments; /** Oldest first */
+};
+
+#endif // _RENX_MATCHSTORE_H_HEADER
\ No newline at end of file
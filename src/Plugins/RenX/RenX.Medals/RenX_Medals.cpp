@@ -17,10 +17,11 @@
  */
 
 #include <ctime>
+#include <memory>
 #include "jessilib/word_split.hpp"
 #include "jessilib/unicode.hpp"
-#include "Jupiter/Timer.h"
 #include "Jupiter/IRC_Client.h"
+#include "StartupTasks.h"
 #include "RenX_Medals.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
@@ -30,6 +31,12 @@
 
 using namespace std::literals;
 
+/** Medal counts and per-game flags; defined ahead of pluginInstance so that they outlive its destructor */
+RenX::PlayerSlot<unsigned long> g_recs_slot;
+RenX::PlayerSlot<unsigned long> g_noobs_slot;
+RenX::PlayerSlot<bool> g_gave_rec_slot;
+RenX::PlayerSlot<bool> g_gave_noob_slot;
+
 bool RenX_MedalsPlugin::initialize()
 {
 	this->INTERNAL_RECS_TAG = RenX::getUniqueInternalTag();
@@ -42,6 +49,11 @@ bool RenX_MedalsPlugin::initialize()
 
 RenX_MedalsPlugin::~RenX_MedalsPlugin()
 {
+	// Pending congratulations call into this plugin
+	for (TimerWheel::TimerId id : m_congratTimers) {
+		timerWheel->cancel(id);
+	}
+
 	RenX::Core *core = RenX::getCore();
 	size_t sCount = core->getServerCount();
 	RenX::Server *server;
@@ -51,8 +63,8 @@ RenX_MedalsPlugin::~RenX_MedalsPlugin()
 		if (server->players.size() != 0) {
 			for (auto node = server->players.begin(); node != server->players.end(); ++node) {
 				if (!node->uuid.empty() && !node->isBot) {
-					RenX_MedalsPlugin::medalsFile[node->uuid].set("Recs"sv, node->varData[this->getName()].get("Recs"sv, ""s));
-					RenX_MedalsPlugin::medalsFile[node->uuid].set("Noobs"sv, node->varData[this->getName()].get("Noobs"sv, ""s));
+					RenX_MedalsPlugin::medalsFile[node->uuid].set("Recs"sv, std::to_string(getRecs(*node)));
+					RenX_MedalsPlugin::medalsFile[node->uuid].set("Noobs"sv, std::to_string(getNoobs(*node)));
 				}
 			}
 		}
@@ -61,38 +73,36 @@ RenX_MedalsPlugin::~RenX_MedalsPlugin()
 	RenX_MedalsPlugin::medalsFile.write(RenX_MedalsPlugin::medalsFileName);
 }
 
-struct CongratPlayerData
-{
-	RenX::Server *server;
-	std::string playerName;
-	unsigned int type;
-};
-
-void congratPlayer(unsigned int, void *params)
+void congratPlayer(RenX::Server *server, std::string_view playerName, unsigned int type)
 {
-	CongratPlayerData *congratPlayerData = reinterpret_cast<CongratPlayerData *>(params);
-
-	if (RenX::getCore()->hasServer(congratPlayerData->server) && congratPlayerData->server->isConnected())
+	if (RenX::getCore()->hasServer(server) && server->isConnected())
 	{
-		switch (congratPlayerData->type)
+		switch (type)
 		{
 		case 0:
-			congratPlayerData->server->sendMessage(jessilib::join<std::string>(congratPlayerData->playerName, " has been recommended for having the highest score last game!"sv));
+			server->sendMessage(jessilib::join<std::string>(playerName, " has been recommended for having the highest score last game!"sv));
 			break;
 		case 1:
-			congratPlayerData->server->sendMessage(jessilib::join<std::string>(congratPlayerData->playerName, " has been recommended for having the most kills last game!"sv));
+			server->sendMessage(jessilib::join<std::string>(playerName, " has been recommended for having the most kills last game!"sv));
 			break;
 		case 2:
-			congratPlayerData->server->sendMessage(jessilib::join<std::string>(congratPlayerData->playerName, " has been recommended for having the most vehicle kills last game!"sv));
+			server->sendMessage(jessilib::join<std::string>(playerName, " has been recommended for having the most vehicle kills last game!"sv));
 			break;
 		case 3:
-			congratPlayerData->server->sendMessage(jessilib::join<std::string>(congratPlayerData->playerName, " has been recommended for having the highest Kill-Death ratio last game!"sv));
+			server->sendMessage(jessilib::join<std::string>(playerName, " has been recommended for having the highest Kill-Death ratio last game!"sv));
 			break;
 		default:
 			break;
 		}
 	}
-	delete congratPlayerData;
+}
+
+void RenX_MedalsPlugin::scheduleCongrat(std::chrono::milliseconds delay, RenX::Server &server, const RenX::PlayerInfo &player, unsigned int type)
+{
+	// The name is shared rather than copied, since a std::string may not fit inline in a timer callback (i.e: MSVC debug builds)
+	m_congratTimers.push_back(timerWheel->schedule(delay, [server = &server, playerName = std::make_shared<const std::string>(player.name), type]() {
+		congratPlayer(server, *playerName, type);
+	}));
 }
 
 void RenX_MedalsPlugin::RenX_SanitizeTags(std::string& fmt) {
@@ -114,15 +124,15 @@ void RenX_MedalsPlugin::RenX_ProcessTags(std::string& msg, const RenX::Server *s
 
 void RenX_MedalsPlugin::RenX_OnPlayerCreate(RenX::Server &, const RenX::PlayerInfo &player) {
 	if (!player.uuid.empty() && player.isBot == false) {
-		player.varData[this->getName()].set("Recs"sv, RenX_MedalsPlugin::medalsFile.get(player.uuid, "Recs"s));
-		player.varData[this->getName()].set("Noobs"sv, RenX_MedalsPlugin::medalsFile.get(player.uuid, "Noobs"s));
+		g_recs_slot.set(player, Jupiter::from_string<unsigned long>(RenX_MedalsPlugin::medalsFile.get(player.uuid, "Recs"sv)));
+		g_noobs_slot.set(player, Jupiter::from_string<unsigned long>(RenX_MedalsPlugin::medalsFile.get(player.uuid, "Noobs"sv)));
 	}
 }
 
 void RenX_MedalsPlugin::RenX_OnPlayerDelete(RenX::Server &, const RenX::PlayerInfo &player) {
 	if (!player.uuid.empty() && player.isBot == false) {
-		RenX_MedalsPlugin::medalsFile[player.uuid].set("Recs"sv, player.varData[this->getName()].get("Recs"sv, ""s));
-		RenX_MedalsPlugin::medalsFile[player.uuid].set("Noobs"sv, player.varData[this->getName()].get("Noobs"sv, ""s));
+		RenX_MedalsPlugin::medalsFile[player.uuid].set("Recs"sv, std::to_string(getRecs(player)));
+		RenX_MedalsPlugin::medalsFile[player.uuid].set("Noobs"sv, std::to_string(getNoobs(player)));
 	}
 }
 
@@ -155,7 +165,7 @@ void RenX_MedalsPlugin::RenX_OnJoin(RenX::Server &server, const RenX::PlayerInfo
 
 void RenX_MedalsPlugin::RenX_OnGameOver(RenX::Server &server, RenX::WinType winType, const RenX::TeamType &team, int gScore, int nScore)
 {
-	if (server.isReliable() && server.players.size() != server.getBotCount())
+	if (server.isReliable() && server.getHumanCount() != 0)
 	{
 		RenX::PlayerInfo *bestScore = &server.players.front();
 		RenX::PlayerInfo *mostKills = &server.players.front();
@@ -164,55 +174,44 @@ void RenX_MedalsPlugin::RenX_OnGameOver(RenX::Server &server, RenX::WinType winT
 
 		for (auto node = server.players.begin(); node != server.players.end(); ++node)
 		{
-			if (node->score > bestScore->score)
+			if (node->score() > bestScore->score())
 				bestScore = &*node;
 
-			if (node->kills > mostKills->kills)
+			if (node->kills() > mostKills->kills())
 				mostKills = &*node;
 
-			if (node->vehicleKills > mostVehicleKills->vehicleKills)
+			if (node->vehicleKills() > mostVehicleKills->vehicleKills())
 				mostVehicleKills = &*node;
 
 			if (RenX::getKillDeathRatio(*node) > RenX::getKillDeathRatio(*bestKD))
 				bestKD = &*node;
 		}
 
-		CongratPlayerData *congratPlayerData;
+		// Forget congratulations which have already been sent
+		std::erase_if(m_congratTimers, [](TimerWheel::TimerId id) { return !timerWheel->isPending(id); });
 
 		/** +1 for best score */
-		if (!bestScore->uuid.empty() && bestScore->isBot == false && bestScore->score > 0)
+		if (!bestScore->uuid.empty() && bestScore->isBot == false && bestScore->score() > 0)
 		{
 			addRec(*bestScore);
 
-			congratPlayerData = new CongratPlayerData();
-			congratPlayerData->server = &server;
-			congratPlayerData->playerName = bestScore->name;
-			congratPlayerData->type = 0;
-			new Jupiter::Timer(1, killCongratDelay, congratPlayer, congratPlayerData, false);
+			scheduleCongrat(killCongratDelay, server, *bestScore, 0);
 		}
 
 		/** +1 for most kills */
-		if (!mostKills->uuid.empty() && mostKills->isBot == false && mostKills->kills > 0)
+		if (!mostKills->uuid.empty() && mostKills->isBot == false && mostKills->kills() > 0)
 		{
 			addRec(*mostKills);
 
-			congratPlayerData = new CongratPlayerData();
-			congratPlayerData->server = &server;
-			congratPlayerData->playerName = mostKills->name;
-			congratPlayerData->type = 1;
-			new Jupiter::Timer(1, killCongratDelay, congratPlayer, congratPlayerData, false);
+			scheduleCongrat(killCongratDelay, server, *mostKills, 1);
 		}
 
 		/** +1 for most Vehicle kills */
-		if (!mostVehicleKills->uuid.empty() && mostVehicleKills->isBot == false && mostVehicleKills->vehicleKills > 0)
+		if (!mostVehicleKills->uuid.empty() && mostVehicleKills->isBot == false && mostVehicleKills->vehicleKills() > 0)
 		{
 			addRec(*mostVehicleKills);
 
-			congratPlayerData = new CongratPlayerData();
-			congratPlayerData->server = &server;
-			congratPlayerData->playerName = mostVehicleKills->name;
-			congratPlayerData->type = 2;
-			new Jupiter::Timer(1, vehicleKillCongratDelay, congratPlayer, congratPlayerData, false);
+			scheduleCongrat(vehicleKillCongratDelay, server, *mostVehicleKills, 2);
 		}
 
 		/** +1 for best K/D ratio */
@@ -220,11 +219,7 @@ void RenX_MedalsPlugin::RenX_OnGameOver(RenX::Server &server, RenX::WinType winT
 		{
 			addRec(*bestKD);
 
-			congratPlayerData = new CongratPlayerData();
-			congratPlayerData->server = &server;
-			congratPlayerData->playerName = bestKD->name;
-			congratPlayerData->type = 3;
-			new Jupiter::Timer(1, kdrCongratDelay, congratPlayer, congratPlayerData, false);
+			scheduleCongrat(kdrCongratDelay, server, *bestKD, 3);
 		}
 	}
 
@@ -258,24 +253,34 @@ void RenX_MedalsPlugin::init()
 	RenX_MedalsPlugin::vehicleKillCongratDelay = std::chrono::seconds(this->config.get<long long>("VehicleKillCongratDelay"sv, 60));
 	RenX_MedalsPlugin::kdrCongratDelay = std::chrono::seconds(this->config.get<long long>("KDRCongratDelay"sv, 60));
 	RenX_MedalsPlugin::medalsFileName = this->config.get("MedalsFile"sv, "Medals.ini"sv);
-	RenX_MedalsPlugin::medalsFile.read(RenX_MedalsPlugin::medalsFileName);
 	RenX_MedalsPlugin::firstSection = RenX_MedalsPlugin::config.get("FirstSection"sv);
 	RenX_MedalsPlugin::recsTag = RenX_MedalsPlugin::config.get("RecsTag"sv, "{RECS}"sv);
 	RenX_MedalsPlugin::noobTag = RenX_MedalsPlugin::config.get("NoobsTag"sv, "{NOOBS}"sv);
 	RenX_MedalsPlugin::worthTag = RenX_MedalsPlugin::config.get("WorthTag"sv, "{WORTH}"sv);
 
-	RenX::Core *core = RenX::getCore();
-	size_t server_count = core->getServerCount();
-	RenX::Server *server;
-	for (size_t index = 0; index < server_count; ++index) {
-		server = core->getServer(index);
-		if (server->players.size() != server->getBotCount()) {
-			for (auto node = server->players.begin(); node != server->players.end(); ++node) {
-				node->varData[this->getName()].set("Recs"sv, RenX_MedalsPlugin::medalsFile[node->name].get("Recs"sv, ""s));
-				node->varData[this->getName()].set("Noobs"sv, RenX_MedalsPlugin::medalsFile[node->name].get("Noobs"sv, ""s));
+	// medalsFile is only otherwise accessed from events, which are not processed until after it is committed
+	auto load = [this] {
+		RenX_MedalsPlugin::medalsFile.read(RenX_MedalsPlugin::medalsFileName);
+	};
+
+	auto commit = [this] {
+		RenX::Core *core = RenX::getCore();
+		size_t server_count = core->getServerCount();
+		RenX::Server *server;
+		for (size_t index = 0; index < server_count; ++index) {
+			server = core->getServer(index);
+			if (server->getHumanCount() != 0) {
+				for (auto node = server->players.begin(); node != server->players.end(); ++node) {
+					if (!node->uuid.empty() && !node->isBot) {
+						g_recs_slot.set(*node, Jupiter::from_string<unsigned long>(RenX_MedalsPlugin::medalsFile.get(node->uuid, "Recs"sv)));
+						g_noobs_slot.set(*node, Jupiter::from_string<unsigned long>(RenX_MedalsPlugin::medalsFile.get(node->uuid, "Noobs"sv)));
+					}
+				}
 			}
 		}
-	}
+	};
+
+	startupTasks->add("medals file"sv, std::move(load), std::move(commit));
 }
 
 /** Game Commands */
@@ -362,13 +367,13 @@ void RecGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player, std
 			addNoob(*player);
 			source->sendMessage(*player, "You can't recommend yourself, you noob! (+1 noob)"sv);
 		}
-		else if (!player->varData["RenX.Medals"sv].get("gr"sv).empty() && player->adminType.empty()) {
+		else if (g_gave_rec_slot.get(*player) && player->adminType.empty()) {
 			source->sendMessage(*player, "You can only give one recommendation per game."sv);
 		}
 		else {
 			addRec(*target);
 			source->sendMessage(string_printf("%.*s has recommended %.*s!", player->name.size(), player->name.data(), target->name.size(), target->name.data()));
-			player->varData["RenX.Medals"sv].set("gr"sv, "1"s);
+			g_gave_rec_slot.set(*player, true);
 		}
 	}
 	else RecsGameCommand_instance.trigger(source, player, parameters);
@@ -406,13 +411,13 @@ void NoobGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player, st
 		else if (target->isBot) {
 			source->sendMessage(*player, "Error: Bots can not receive n00bs."sv);
 		}
-		else if (!player->varData["RenX.Medals"sv].get("gn"sv).empty() && player->adminType.empty()) {
+		else if (g_gave_noob_slot.get(*player) && player->adminType.empty()) {
 			source->sendMessage(*player, "You can only give one noob per game."sv);
 		}
 		else {
 			addNoob(*target);
 			source->sendMessage(string_printf("%.*s has noob'd %.*s!", player->name.size(), player->name.data(), target->name.size(), target->name.data()));
-			player->varData["RenX.Medals"sv].set("gn"sv, "1"s);
+			g_gave_noob_slot.set(*player, true);
 		}
 	}
 	else RecsGameCommand_instance.trigger(source, player, parameters);
@@ -428,24 +433,24 @@ GAME_COMMAND_INIT(NoobGameCommand)
 
 void addRec(const RenX::PlayerInfo &player, int amount) {
 	if (!jessilib::starts_withi(player.uuid, "Player"sv) && !player.isBot) {
-		player.varData[pluginInstance.getName()].set("Recs"sv, static_cast<std::string>(string_printf("%u", getRecs(player) + amount)));
+		g_recs_slot.get(player) += amount;
 	}
 }
 
 void addNoob(const RenX::PlayerInfo &player, int amount) {
 	if (!jessilib::starts_withi(player.uuid, "Player"sv) && !player.isBot) {
-		player.varData[pluginInstance.getName()].set("Noobs"sv,static_cast<std::string>(string_printf("%u", getNoobs(player) + amount)));
+		g_noobs_slot.get(player) += amount;
 	}
 }
 
 unsigned long getRecs(const RenX::PlayerInfo &player)
 {
-	return player.varData[pluginInstance.getName()].get<unsigned long>("Recs"sv);
+	return g_recs_slot.get(player);
 }
 
 unsigned long getNoobs(const RenX::PlayerInfo &player)
 {
-	return player.varData[pluginInstance.getName()].get<unsigned long>("Noobs"sv);
+	return g_noobs_slot.get(player);
 }
 
 int getWorth(const RenX::PlayerInfo &player)
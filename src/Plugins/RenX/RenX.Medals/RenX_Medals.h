@@ -20,7 +20,9 @@
 #define _RENX_MEDALS_H_HEADER
 
 #include <chrono>
+#include <vector>
 #include "Jupiter/Plugin.h"
+#include "TimerWheel.h"
 #include "RenX_Plugin.h"
 #include "RenX_GameCommand.h"
 
@@ -67,6 +69,9 @@ public:
 	Jupiter::INIConfig medalsFile;
 
 private:
+	void scheduleCongrat(std::chrono::milliseconds delay, RenX::Server &server, const RenX::PlayerInfo &player, unsigned int type);
+
+	std::vector<TimerWheel::TimerId> m_congratTimers;
 	std::string INTERNAL_RECS_TAG;
 	std::string INTERNAL_NOOB_TAG;
 	std::string INTERNAL_WORTH_TAG;
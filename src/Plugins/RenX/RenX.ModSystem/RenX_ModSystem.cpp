@@ -41,6 +41,7 @@ bool RenX_ModSystemPlugin::initialize() {
 	m_atmDefault = this->config.get("ATMDefault"sv);
 	m_moderatorGroup = this->config.get("Moderator"sv, "Moderator"sv);
 	m_administratorGroup = this->config.get("Administrator"sv, "Administrator"sv);
+	m_writeDelay = std::chrono::milliseconds(this->config.get<long long>("WriteDelay"sv, 5000));
 
 	ModGroup *group;
 	static constexpr std::string_view dotLockSteam = ".LockSteam"sv;
@@ -108,12 +109,17 @@ bool RenX_ModSystemPlugin::initialize() {
 		return false;
 	}
 
+	for (auto& group_entry : groups) {
+		m_groupsByName.try_emplace(group_entry.name, &group_entry);
+	}
+	compileRoster();
+
 	RenX::Core *core = RenX::getCore();
 	size_t server_count = core->getServerCount();
 	RenX::Server *server;
 	while (server_count != 0) {
 		server = core->getServer(--server_count);
-		if (server->players.size() != server->getBotCount()) {
+		if (server->getHumanCount() != 0) {
 			for (auto node = server->players.begin(); node != server->players.end(); ++node) {
 				auth(*server, *node, true);
 			}
@@ -166,71 +172,49 @@ int RenX_ModSystemPlugin::auth(RenX::Server &server, const RenX::PlayerInfo &pla
 		return 0;
 
 	const ModGroup *group;
-	if (!player.uuid.empty()) {
-		Jupiter::Config *section = this->config.getSection(player.uuid);
-		if (section != nullptr) {
-			std::string_view groupName = section->get("Group"sv);
-
-			if (groupName.empty()) {
-				group = &RenX_ModSystemPlugin::groups.front();
-			}
-			else {
-				group = getGroupByName(groupName);
-				if (group == nullptr)
-					group = &RenX_ModSystemPlugin::groups.front();
-			}
-
-			auto sectionAuth = [&] {
-				player.varData[this->name].set("Group"sv, group->name);
-				player.formatNamePrefix = section->get("Prefix"sv, group->prefix);
-				player.gamePrefix = section->get("GamePrefix"sv, group->gamePrefix);
-				player.access = section->get<int>("Access"sv, group->access);
-				if (player.access != 0)
+	const ModEntry *entry = getModByUUID(player.uuid);
+	if (entry != nullptr) {
+		group = entry->group;
+
+		auto sectionAuth = [&] {
+			m_playerGroup.set(player, group);
+			player.formatNamePrefix = entry->prefix;
+			player.gamePrefix = entry->gamePrefix;
+			player.access = entry->access;
+			if (player.access != 0)
+			{
+				server.sendMessage(player, string_printf("You are now authenticated with access level %d; group: %.*s.", player.access, group->name.size(), group->name.data()));
+				if (server.isDevBot() && player.access > 1)
 				{
-					server.sendMessage(player, string_printf("You are now authenticated with access level %d; group: %.*s.", player.access, group->name.size(), group->name.data()));
-					if (server.isDevBot() && player.access > 1)
-					{
-						if (server.getVersion() >= 4)
-							server.sendData(string_printf("dset_dev %d\n", player.id));
-						else
-							server.sendData(string_printf("d%d\n", player.id));
-					}
+					if (server.getVersion() >= 4)
+						server.sendData(string_printf("dset_dev %d\n", player.id));
+					else
+						server.sendData(string_printf("d%d\n", player.id));
 				}
-				std::string playerName = RenX::getFormattedPlayerName(player);
-				server.sendLogChan(IRCCOLOR "03[Authentication] " IRCBOLD "%.*s" IRCBOLD IRCCOLOR " is now authenticated with access level %d; group: %.*s.", playerName.size(),
-					playerName.data(), player.access, group->name.size(), group->name.data());
-				return player.access;
-			};
-
-			if (forceAuth)
-				return sectionAuth();
-
-			bool lockSteam_l = section->get<bool>("LockSteam"sv, group->lockSteam);
-			bool lockIP_l = section->get<bool>("LockIP"sv, group->lockIP);
-			bool lockName_l = section->get<bool>("LockName"sv, group->lockName);
-			bool kickLockMismatch_l = section->get<bool>("KickLockMismatch"sv, group->kickLockMismatch);
-			bool autoAuthSteam_l = section->get<bool>("AutoAuthSteam"sv, group->autoAuthSteam);
-			bool autoAuthIP_l = section->get<bool>("AutoAuthIP"sv, group->autoAuthIP);
+			}
+			std::string playerName = RenX::getFormattedPlayerName(player);
+			server.sendLogChan(IRCCOLOR "03[Authentication] " IRCBOLD "%.*s" IRCBOLD IRCCOLOR " is now authenticated with access level %d; group: %.*s.", playerName.size(),
+				playerName.data(), player.access, group->name.size(), group->name.data());
+			return player.access;
+		};
 
-			uint64_t steamid = Jupiter::from_string<uint64_t>(section->get("SteamID"sv));
-			std::string_view ip = section->get("LastIP"sv);
-			std::string_view name = section->get("Name"sv);
+		if (forceAuth)
+			return sectionAuth();
 
-			if ((lockSteam_l == false || player.steamid == steamid) && (lockIP_l == false || player.ip == ip) && (lockName_l == false || jessilib::equalsi(player.name, name)))
-			{
-				if (checkAuto == false || (autoAuthSteam_l && player.steamid == steamid) || (autoAuthIP_l && player.ip == ip))
-					return sectionAuth();
-			}
-			else if (kickLockMismatch_l)
-			{
-				server.kickPlayer(player, "Moderator entry lock mismatch"sv);
-				return -1;
-			}
+		if ((entry->lockSteam == false || player.steamid == entry->steamid) && (entry->lockIP == false || player.ip == entry->lastIP) && (entry->lockName == false || jessilib::equalsi(player.name, entry->name)))
+		{
+			if (checkAuto == false || (entry->autoAuthSteam && player.steamid == entry->steamid) || (entry->autoAuthIP && player.ip == entry->lastIP))
+				return sectionAuth();
+		}
+		else if (entry->kickLockMismatch)
+		{
+			server.kickPlayer(player, "Moderator entry lock mismatch"sv);
+			return -1;
 		}
 	}
 	group = this->getDefaultGroup();
 
-	player.varData[this->name].set("Group"sv, group->name);
+	m_playerGroup.set(player, group);
 	player.formatNamePrefix = group->prefix;
 	player.gamePrefix = group->gamePrefix;
 	return player.access = group->access;
@@ -240,7 +224,7 @@ void RenX_ModSystemPlugin::tempAuth(RenX::Server &server, const RenX::PlayerInfo
 	if (group == nullptr)
 		group = this->getDefaultGroup();
 
-	player.varData[name].set("Group"sv, group->name);
+	m_playerGroup.set(player, group);
 	player.formatNamePrefix = group->prefix;
 	player.gamePrefix = group->gamePrefix;
 	player.access = group->access;
@@ -250,27 +234,163 @@ void RenX_ModSystemPlugin::tempAuth(RenX::Server &server, const RenX::PlayerInfo
 }
 
 bool RenX_ModSystemPlugin::set(RenX::PlayerInfo &player, ModGroup &group) {
-	bool r = this->config[player.uuid].set("Group"sv, group.name);
-	this->config[player.uuid].set("SteamID"sv, static_cast<std::string>(string_printf("%llu", player.steamid)));
-	this->config[player.uuid].set("LastIP"sv, static_cast<std::string>(player.ip));
-	this->config[player.uuid].set("Name"sv, player.name);
-	this->config.write();
-
+	Jupiter::Config &section = this->config[player.uuid];
+	bool r = section.set("Group"sv, group.name);
+	section.set("SteamID"sv, static_cast<std::string>(string_printf("%llu", player.steamid)));
+	section.set("LastIP"sv, static_cast<std::string>(player.ip));
+	section.set("Name"sv, player.name);
+
+	compileEntry(section);
+	markConfigDirty();
 	return r;
 }
 
 bool RenX_ModSystemPlugin::removeModSection(std::string_view section) {
-	return config.removeSection(section) && config.write();
+	auto entry = m_roster.find(section);
+	if (entry != m_roster.end()) {
+		unindexEntry(entry->second);
+		m_roster.erase(entry);
+	}
+
+	if (!config.removeSection(section)) {
+		return false;
+	}
+
+	markConfigDirty();
+	return true;
 }
 
-RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getGroupByName(std::string_view name, ModGroup *defaultGroup) const {
-	for (const auto& group : groups) {
-		if (jessilib::equalsi(group.name, name)) {
-			return const_cast<ModGroup*>(&group);
+const RenX_ModSystemPlugin::ModEntry *RenX_ModSystemPlugin::getModByUUID(std::string_view uuid) const {
+	if (uuid.empty()) {
+		return nullptr;
+	}
+
+	auto entry = m_roster.find(uuid);
+	if (entry == m_roster.end()) {
+		return nullptr;
+	}
+
+	return &entry->second;
+}
+
+const RenX_ModSystemPlugin::ModEntry *RenX_ModSystemPlugin::getModBySteamID(uint64_t steamid) const {
+	if (steamid == 0) {
+		return nullptr;
+	}
+
+	auto entry = m_rosterBySteamID.find(steamid);
+	if (entry == m_rosterBySteamID.end()) {
+		return nullptr;
+	}
+
+	return entry->second;
+}
+
+const RenX_ModSystemPlugin::ModEntry *RenX_ModSystemPlugin::getModByIP(std::string_view ip) const {
+	if (ip.empty()) {
+		return nullptr;
+	}
+
+	auto entry = m_rosterByIP.find(ip);
+	if (entry == m_rosterByIP.end()) {
+		return nullptr;
+	}
+
+	return entry->second;
+}
+
+const RenX_ModSystemPlugin::ModEntry *RenX_ModSystemPlugin::getModByName(std::string_view name) const {
+	for (const auto& entry : m_roster) {
+		if (jessilib::equalsi(entry.second.name, name)) {
+			return &entry.second;
 		}
 	}
 
-	return defaultGroup;
+	return nullptr;
+}
+
+void RenX_ModSystemPlugin::writeConfig() {
+	if (m_configDirty) {
+		m_configDirty = false;
+		this->config.write();
+	}
+}
+
+void RenX_ModSystemPlugin::markConfigDirty() {
+	if (!m_configDirty) {
+		m_configDirty = true;
+		m_configWriteTime = std::chrono::steady_clock::now() + m_writeDelay;
+	}
+}
+
+void RenX_ModSystemPlugin::compileRoster() {
+	m_roster.clear();
+	m_rosterBySteamID.clear();
+	m_rosterByIP.clear();
+
+	for (const auto& section : this->config.getSections()) {
+		compileEntry(section.second);
+	}
+}
+
+void RenX_ModSystemPlugin::compileEntry(const Jupiter::Config &section) {
+	auto result = m_roster.try_emplace(section.getName());
+	ModEntry &entry = result.first->second;
+	if (!result.second) {
+		// Entry is being recompiled; remove stale index keys
+		unindexEntry(entry);
+	}
+
+	entry.uuid = section.getName();
+	entry.group = getGroupByName(section.get("Group"sv), getDefaultGroup());
+	entry.lockSteam = section.get<bool>("LockSteam"sv, entry.group->lockSteam);
+	entry.lockIP = section.get<bool>("LockIP"sv, entry.group->lockIP);
+	entry.lockName = section.get<bool>("LockName"sv, entry.group->lockName);
+	entry.kickLockMismatch = section.get<bool>("KickLockMismatch"sv, entry.group->kickLockMismatch);
+	entry.autoAuthSteam = section.get<bool>("AutoAuthSteam"sv, entry.group->autoAuthSteam);
+	entry.autoAuthIP = section.get<bool>("AutoAuthIP"sv, entry.group->autoAuthIP);
+	entry.access = section.get<int>("Access"sv, entry.group->access);
+	entry.steamid = Jupiter::from_string<uint64_t>(section.get("SteamID"sv));
+	entry.lastIP = section.get("LastIP"sv);
+	entry.name = section.get("Name"sv);
+	entry.prefix = section.get("Prefix"sv, entry.group->prefix);
+	entry.gamePrefix = section.get("GamePrefix"sv, entry.group->gamePrefix);
+
+	indexEntry(entry);
+}
+
+void RenX_ModSystemPlugin::indexEntry(const ModEntry &entry) {
+	if (entry.steamid != 0) {
+		m_rosterBySteamID.emplace(entry.steamid, &entry);
+	}
+
+	if (!entry.lastIP.empty()) {
+		m_rosterByIP.emplace(entry.lastIP, &entry);
+	}
+}
+
+void RenX_ModSystemPlugin::unindexEntry(const ModEntry &entry) {
+	auto erase_from = [&entry](auto& index, const auto& key) {
+		auto range = index.equal_range(key);
+		for (auto itr = range.first; itr != range.second; ++itr) {
+			if (itr->second == &entry) {
+				index.erase(itr);
+				return;
+			}
+		}
+	};
+
+	erase_from(m_rosterBySteamID, entry.steamid);
+	erase_from(m_rosterByIP, std::string_view{ entry.lastIP });
+}
+
+RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getGroupByName(std::string_view name, ModGroup *defaultGroup) const {
+	auto group = m_groupsByName.find(name);
+	if (group == m_groupsByName.end()) {
+		return defaultGroup;
+	}
+
+	return group->second;
 }
 
 RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getGroupByAccess(int access, ModGroup *defaultGroup) const {
@@ -292,13 +412,27 @@ RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getGroupByIndex(size_t ind
 }
 
 int RenX_ModSystemPlugin::getConfigAccess(std::string_view uuid) const {
-	Jupiter::Config *section = this->config.getSection(uuid);
-
-	if (section == nullptr) {
+	const ModEntry *entry = getModByUUID(uuid);
+	if (entry == nullptr) {
 		return RenX_ModSystemPlugin::groups.front().access;
 	}
 
-	return section->get<int>("Access"sv, getGroupByName(section->get("Group"sv),const_cast<ModGroup *>(&groups.front()))->access);
+	return entry->access;
+}
+
+const RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getPlayerGroup(const RenX::PlayerInfo &player) const {
+	const ModGroup * const *group = m_playerGroup.find(player);
+	return group != nullptr ? *group : nullptr;
+}
+
+void RenX_ModSystemPlugin::resetPlayerGroups() {
+	RenX::Core *core = RenX::getCore();
+	for (size_t index = 0; index != core->getServerCount(); ++index) {
+		RenX::Server *server = core->getServer(index);
+		for (auto node = server->players.begin(); node != server->players.end(); ++node) {
+			m_playerGroup.reset(*node);
+		}
+	}
 }
 
 size_t RenX_ModSystemPlugin::getGroupCount() const {
@@ -322,15 +456,17 @@ RenX_ModSystemPlugin::ModGroup *RenX_ModSystemPlugin::getAdministratorGroup() co
 }
 
 RenX_ModSystemPlugin::~RenX_ModSystemPlugin() {
+	writeConfig();
+
 	RenX::Core *core = RenX::getCore();
 	size_t server_count = core->getServerCount();
 	RenX::Server *server;
 	while (server_count != 0) {
 		server = core->getServer(--server_count);
-		if (server->players.size() != server->getBotCount()) {
+		if (server->getHumanCount() != 0) {
 			for (auto node = server->players.begin(); node != server->players.end(); ++node) {
 				if (node->isBot == false) {
-					node->varData[RenX_ModSystemPlugin::name].remove("Group"sv);
+					m_playerGroup.reset(*node);
 					node->gamePrefix.clear();
 					node->formatNamePrefix.clear();
 					if (node->adminType == game_administrator_name)
@@ -344,6 +480,10 @@ RenX_ModSystemPlugin::~RenX_ModSystemPlugin() {
 		}
 	}
 
+	m_roster.clear();
+	m_rosterBySteamID.clear();
+	m_rosterByIP.clear();
+	m_groupsByName.clear();
 	RenX_ModSystemPlugin::groups.clear();
 }
 
@@ -355,11 +495,24 @@ void RenX_ModSystemPlugin::RenX_OnPlayerCreate(RenX::Server &server, const RenX:
 
 void RenX_ModSystemPlugin::RenX_OnPlayerDelete(RenX::Server &server, const RenX::PlayerInfo &player) {
 	if (RenX_ModSystemPlugin::groups.size() != 0 && !player.isBot && !player.uuid.empty()) {
-		Jupiter::Config *section = this->config.getSection(player.uuid);
-		if (section != nullptr) {
-			section->set("SteamID"sv, static_cast<std::string>(string_printf("%llu", player.steamid)));
-			section->set("LastIP"sv, static_cast<std::string>(player.ip));
-			section->set("Name"sv, player.name);
+		auto entry = m_roster.find(player.uuid);
+		if (entry != m_roster.end()) {
+			ModEntry &mod = entry->second;
+			if (mod.steamid != player.steamid || mod.lastIP != player.ip || mod.name != player.name) {
+				Jupiter::Config *section = this->config.getSection(player.uuid);
+				if (section != nullptr) {
+					section->set("SteamID"sv, static_cast<std::string>(string_printf("%llu", player.steamid)));
+					section->set("LastIP"sv, static_cast<std::string>(player.ip));
+					section->set("Name"sv, player.name);
+					markConfigDirty();
+				}
+
+				unindexEntry(mod);
+				mod.steamid = player.steamid;
+				mod.lastIP = player.ip;
+				mod.name = player.name;
+				indexEntry(mod);
+			}
 		}
 	}
 }
@@ -410,9 +563,26 @@ void RenX_ModSystemPlugin::RenX_OnAdminLogout(RenX::Server &server, const RenX::
 	}
 }
 
+int RenX_ModSystemPlugin::think()
+{
+	if (m_configDirty && std::chrono::steady_clock::now() >= m_configWriteTime) {
+		writeConfig();
+	}
+
+	return Jupiter::Plugin::think();
+}
+
 int RenX_ModSystemPlugin::OnRehash()
 {
+	// Don't lose pending changes when the config is reloaded
+	writeConfig();
+
 	RenX::Plugin::OnRehash();
+	m_roster.clear();
+	m_rosterBySteamID.clear();
+	m_rosterByIP.clear();
+	m_groupsByName.clear();
+	resetPlayerGroups();
 	RenX_ModSystemPlugin::groups.clear();
 	return this->initialize() ? 0 : -1;
 }
@@ -465,7 +635,7 @@ void AuthIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::str
 							RenX_ModSystemPlugin::ModGroup *defaultGroup = pluginInstance.getDefaultGroup();
 							if (pluginInstance.auth(*server, *player) == -1)
 								source->sendNotice(nick, "Error: Player failed to pass strict lock checks. Player kicked."sv);
-							else if (defaultGroup->name == player->varData[pluginInstance.getName()].get("Group"sv))
+							else if (defaultGroup == pluginInstance.getPlayerGroup(*player))
 								source->sendNotice(nick, "Error: Failed to authenticate player."sv);
 							else
 								source->sendNotice(nick, "Player authenticated successfully."sv);
@@ -744,19 +914,19 @@ void DelIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::stri
 							source->sendNotice(nick, "Player has been removed from the moderator list."sv);
 						else
 						{
-							for (auto& section : pluginInstance.getConfig().getSections())
-							{
-								if (jessilib::equalsi(section.second.get("Name"sv), parameters_view)) {
-									if (pluginInstance.removeModSection(section.first))
-										source->sendNotice(nick, "Player has been removed from the moderator list."sv);
-									else
-										source->sendNotice(nick, "Error: Unknown error occurred."sv);
-
-									return;
-								}
+							const RenX_ModSystemPlugin::ModEntry *entry = pluginInstance.getModByName(parameters_view);
+							if (entry == nullptr) {
+								source->sendNotice(nick, "Error: Player not found."sv);
+							}
+							else {
+								std::string uuid = entry->uuid;
+								if (pluginInstance.removeModSection(uuid))
+									source->sendNotice(nick, "Player has been removed from the moderator list."sv);
+								else
+									source->sendNotice(nick, "Error: Unknown error occurred."sv);
 							}
 
-							source->sendNotice(nick, "Error: Player not found."sv);
+							return;
 						}
 					}
 					else if (player->isBot)
@@ -826,7 +996,7 @@ void ForceAuthIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std
 						{
 							RenX_ModSystemPlugin::ModGroup *defaultGroup = pluginInstance.getDefaultGroup();
 							pluginInstance.auth(*server, *player, false, true);
-							if (defaultGroup->name == player->varData[pluginInstance.getName()].get("Group"sv))
+							if (defaultGroup == pluginInstance.getPlayerGroup(*player))
 								source->sendNotice(nick, "Error: Failed to authenticate player."sv);
 							else
 								source->sendNotice(nick, "Player authenticated successfully."sv);
@@ -867,9 +1037,9 @@ void ModListIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::
 		msg += string_printf(IRCNORMAL " (Access: %d): ", node->access);
 		msgBaseSize = msg.size();
 
-		for (auto& section : pluginInstance.getConfig().getSections()) {
-			if (jessilib::equalsi(section.second.get("Group"sv), node->name)) {
-				msg += section.second.get("Name"sv, section.second.getName());
+		for (const auto& entry : pluginInstance.getRoster()) {
+			if (entry.second.group == &*node) {
+				msg += entry.second.name.empty() ? entry.second.uuid : entry.second.name;
 				msg += ", "sv;
 			}
 		}
@@ -925,7 +1095,7 @@ void AuthGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player, st
 				RenX_ModSystemPlugin::ModGroup *defaultGroup = pluginInstance.getDefaultGroup();
 				if (pluginInstance.auth(*source, *player) == -1)
 					source->sendMessage(*player, "Error: Player failed to pass strict lock checks. Player kicked."sv);
-				else if (defaultGroup->name == player->varData[pluginInstance.getName()].get("Group"sv))
+				else if (defaultGroup == pluginInstance.getPlayerGroup(*player))
 					source->sendMessage(*player, "Error: Failed to authenticate player."sv);
 				else
 					source->sendMessage(*player, "Player authenticated successfully."sv);
@@ -1036,7 +1206,7 @@ void ForceAuthGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *playe
 			{
 				RenX_ModSystemPlugin::ModGroup *defaultGroup = pluginInstance.getDefaultGroup();
 				pluginInstance.auth(*source, *player, false, true);
-				if (defaultGroup->name == player->varData[pluginInstance.getName()].get("Group"sv))
+				if (defaultGroup == pluginInstance.getPlayerGroup(*player))
 					source->sendMessage(*player, "Error: Failed to authenticate player."sv);
 				else
 					source->sendMessage(*player, "Player authenticated successfully."sv);
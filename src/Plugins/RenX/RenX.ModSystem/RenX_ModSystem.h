@@ -19,7 +19,10 @@
 #if !defined _RENX_MODSYSTEM_H_HEADER
 #define _RENX_MODSYSTEM_H_HEADER
 
+#include <chrono>
 #include <list>
+#include <unordered_map>
+#include "jessilib/unicode.hpp"
 #include "Jupiter/Plugin.h"
 #include "IRC_Command.h"
 #include "RenX_Plugin.h"
@@ -43,6 +46,25 @@ public:
 	};
 	std::list<ModGroup> groups;
 
+	/** A configured moderator, with settings inherited from their group already resolved */
+	struct ModEntry
+	{
+		std::string uuid;
+		const ModGroup *group;
+		bool lockSteam;
+		bool lockIP;
+		bool lockName;
+		bool kickLockMismatch;
+		bool autoAuthSteam;
+		bool autoAuthIP;
+		int access;
+		uint64_t steamid;
+		std::string lastIP;
+		std::string name;
+		std::string prefix;
+		std::string gamePrefix;
+	};
+
 	/**
 	* @brief Calls resetAccess() on all players in a server.
 	*
@@ -77,6 +99,50 @@ public:
 	bool removeModSection(std::string_view section);
 
 	int getConfigAccess(std::string_view uuid) const;
+
+	/**
+	* @brief Fetches a moderator's entry from the roster.
+	*
+	* @param uuid UUID of the moderator
+	* @return Moderator's entry if one exists, nullptr otherwise.
+	*/
+	const ModEntry *getModByUUID(std::string_view uuid) const;
+
+	/**
+	* @brief Fetches a moderator's entry from the roster, based on their last known Steam ID.
+	*
+	* @param steamid Steam ID of the moderator
+	* @return A moderator's entry if one exists, nullptr otherwise.
+	*/
+	const ModEntry *getModBySteamID(uint64_t steamid) const;
+
+	/**
+	* @brief Fetches a moderator's entry from the roster, based on their last known IP address.
+	*
+	* @param ip IP address of the moderator
+	* @return A moderator's entry if one exists, nullptr otherwise.
+	*/
+	const ModEntry *getModByIP(std::string_view ip) const;
+
+	/**
+	* @brief Fetches a moderator's entry from the roster, based on their last known name.
+	*
+	* @param name Name of the moderator (case insensitive)
+	* @return A moderator's entry if one exists, nullptr otherwise.
+	*/
+	const ModEntry *getModByName(std::string_view name) const;
+
+	/**
+	* @brief Fetches the moderator roster, keyed by UUID.
+	*
+	* @return Moderator roster
+	*/
+	const auto& getRoster() const { return m_roster; }
+
+	/**
+	* @brief Writes any pending changes to the config file.
+	*/
+	void writeConfig();
 	size_t getGroupCount() const;
 	ModGroup *getGroupByName(std::string_view name, ModGroup *defaultGroup = nullptr) const;
 	ModGroup *getGroupByAccess(int access, ModGroup *defaultGroup = nullptr) const;
@@ -86,6 +152,14 @@ public:
 	ModGroup *getModeratorGroup() const;
 	ModGroup *getAdministratorGroup() const;
 
+	/**
+	* @brief Fetches the group a player was last authenticated with.
+	*
+	* @param player Player to fetch the group of
+	* @return Player's group if they have been authenticated since the last rehash, nullptr otherwise
+	*/
+	const ModGroup *getPlayerGroup(const RenX::PlayerInfo &player) const;
+
 	virtual bool initialize() override;
 	~RenX_ModSystemPlugin();
 
@@ -100,9 +174,25 @@ public: // RenX::Plugin
 	void RenX_OnAdminLogout(RenX::Server &server, const RenX::PlayerInfo &player) override;
 
 public: // Jupiter::Plugin
+	int think() override;
 	int OnRehash() override;
 
 private:
+	void compileRoster();
+	void compileEntry(const Jupiter::Config &section);
+	void indexEntry(const ModEntry &entry);
+	void unindexEntry(const ModEntry &entry);
+	void markConfigDirty();
+	void resetPlayerGroups();
+
+	std::unordered_map<std::string, ModGroup*, jessilib::text_hashi, jessilib::text_equali> m_groupsByName;
+	RenX::PlayerSlot<const ModGroup*> m_playerGroup; /** Points into groups; reset whenever groups is cleared */
+	std::unordered_map<std::string, ModEntry, jessilib::text_hashi, jessilib::text_equali> m_roster; /** Keyed by UUID */
+	std::unordered_multimap<uint64_t, const ModEntry*> m_rosterBySteamID;
+	std::unordered_multimap<std::string_view, const ModEntry*> m_rosterByIP; /** Keys view ModEntry::lastIP */
+	bool m_configDirty = false;
+	std::chrono::steady_clock::time_point m_configWriteTime;
+	std::chrono::milliseconds m_writeDelay;
 	bool m_lockSteam;
 	bool m_lockIP;
 	bool m_lockName;
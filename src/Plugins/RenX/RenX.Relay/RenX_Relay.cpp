@@ -21,6 +21,7 @@
 #include "RenX_Functions.h"
 #include "RenX_Server.h"
 #include "RenX_PlayerInfo.h"
+#include "RenX_PlayerIndex.h"
 
 using namespace std::literals;
 
@@ -31,6 +32,7 @@ static constexpr std::string_view Rx_Delim = "\x02"sv;
 constexpr const char g_blank_steamid[] = "0x0000000000000000";
 constexpr std::chrono::steady_clock::duration g_reconnect_delay = std::chrono::seconds{15 }; // game server: 120s
 constexpr std::chrono::steady_clock::duration g_activity_timeout = std::chrono::seconds{ 120 }; // game server: 120s
+constexpr size_t g_receive_budget = 65536; // Maximum bytes read from each upstream per tick
 
 int RenX_RelayPlugin::think() {
 	for (auto& server_pair : m_server_info_map) {
@@ -68,44 +70,47 @@ int RenX_RelayPlugin::think() {
 			}
 			else {
 				// Connected and fine
-				if (upstream_socket->recv() > 0) { // Data received
-					auto tokens = jessilib::split_view(upstream_socket->getBuffer(), '\n');
-					if (!tokens.empty()) {
-						server_info.m_last_activity = std::chrono::steady_clock::now();
-						server_info.m_last_line += tokens[0];
-						if (tokens.size() != 1) {
-							// Process upstream message received
-							process_upstream_message(server, server_info.m_last_line, server_info);
-							server_info.m_last_line = tokens[tokens.size() - 1];
-
-							for (size_t index = 1; index != tokens.size() - 1; ++index) {
-								process_upstream_message(server, tokens[index], server_info);
-							}
-						}
-					}
-				}
-				else if (Jupiter::Socket::getLastError() == JUPITER_SOCK_EWOULDBLOCK) { // Operation would block (no new data)
-					if (std::chrono::steady_clock::now() - server_info.m_last_activity >= g_activity_timeout) {
-						upstream_disconnected(*server, server_info);
+				// Drain the socket until it would block, or until this tick's receive budget is spent
+				size_t received = 0;
+				int recv_result = 0;
+				while (received < g_receive_budget && (recv_result = upstream_socket->recv()) > 0) { // Data received
+					server_info.m_last_activity = std::chrono::steady_clock::now();
+					received += static_cast<size_t>(recv_result);
+					server_info.m_inbound.append(upstream_socket->getBuffer());
+					server_info.m_inbound.consumeLines([this, server, &server_info](std::string_view line) {
+						// Process upstream message received
+						process_upstream_message(server, line, server_info);
+					});
+
+					if (!server_info.m_connected) { // Disconnected while processing messages
+						break;
 					}
 				}
-				else { // This is a serious error
-					upstream_disconnected(*server, server_info);
 
-					server->sendLogChan(IRCCOLOR "07[Warning]" IRCCOLOR " Connection to %.*s lost. Reconnection attempt in progress.", upstream_name.size(), upstream_name.data());
-					if (upstream_socket->connect(server_info.m_settings->m_upstream_hostname.c_str(), server_info.m_settings->m_upstream_port)) {
-						upstream_connected(*server, server_info);
-						server->sendLogChan(IRCCOLOR "06[Progress]" IRCCOLOR " Connection to %.*s reestablished. Initializing Renegade-X RCON protocol...", upstream_name.size(), upstream_name.data());
-					}
-					else {
-						server->sendLogChan(IRCCOLOR "04[Error]" IRCCOLOR " Connection to %.*s lost. Reconnection attempt failed.", upstream_name.size(), upstream_name.data());
+				if (received == 0) { // No data received
+					if (Jupiter::Socket::getLastError() == JUPITER_SOCK_EWOULDBLOCK) { // Operation would block (no new data)
+						if (std::chrono::steady_clock::now() - server_info.m_last_activity >= g_activity_timeout) {
+							upstream_disconnected(*server, server_info);
+						}
 					}
+					else { // This is a serious error
+						upstream_disconnected(*server, server_info);
 
-					// Update our timings
-					server_info.m_last_connect_attempt = std::chrono::steady_clock::now();
-					server_info.m_last_activity = server_info.m_last_connect_attempt;
+						server->sendLogChan(IRCCOLOR "07[Warning]" IRCCOLOR " Connection to %.*s lost. Reconnection attempt in progress.", upstream_name.size(), upstream_name.data());
+						if (upstream_socket->connect(server_info.m_settings->m_upstream_hostname.c_str(), server_info.m_settings->m_upstream_port)) {
+							upstream_connected(*server, server_info);
+							server->sendLogChan(IRCCOLOR "06[Progress]" IRCCOLOR " Connection to %.*s reestablished. Initializing Renegade-X RCON protocol...", upstream_name.size(), upstream_name.data());
+						}
+						else {
+							server->sendLogChan(IRCCOLOR "04[Error]" IRCCOLOR " Connection to %.*s lost. Reconnection attempt failed.", upstream_name.size(), upstream_name.data());
+						}
 
-					return 0;
+						// Update our timings
+						server_info.m_last_connect_attempt = std::chrono::steady_clock::now();
+						server_info.m_last_activity = server_info.m_last_connect_attempt;
+
+						return 0;
+					}
 				}
 			}
 		}
@@ -388,14 +393,7 @@ void RenX_RelayPlugin::process_renx_message(RenX::Server& server, upstream_serve
 			return nullptr;
 		}
 
-		// Search players
-		for (const auto& player : server.players) {
-			if (player.ip32 == ip32) {
-				return &player;
-			}
-		}
-
-		return nullptr;
+		return RenX::playerIndex->findByIP(server, ip32);
 	};
 
 	auto findPlayerByHWID = [&server](std::string_view in_hwid) -> const RenX::PlayerInfo* {
@@ -403,13 +401,7 @@ void RenX_RelayPlugin::process_renx_message(RenX::Server& server, upstream_serve
 			return nullptr;
 		}
 
-		for (const auto& player : server.players) {
-			if (player.hwid == in_hwid) {
-				return &player;
-			}
-		}
-
-		return nullptr;
+		return RenX::playerIndex->findByHWID(server, in_hwid);
 	};
 
 	auto findPlayerBySteamID = [&server](std::string_view in_steamid) -> const RenX::PlayerInfo* {
@@ -419,13 +411,7 @@ void RenX_RelayPlugin::process_renx_message(RenX::Server& server, upstream_serve
 			return nullptr;
 		}
 
-		for (const auto& player : server.players) {
-			if (player.steamid == steamid) {
-				return &player;
-			}
-		}
-
-		return nullptr;
+		return RenX::playerIndex->findBySteamID(server, steamid);
 	};
 
 	if (settings.m_sanitize_names) {
@@ -636,6 +622,7 @@ int RenX_RelayPlugin::send_downstream(RenX::Server& in_server, std::string_view
 void RenX_RelayPlugin::upstream_connected(RenX::Server& in_server, upstream_server_info& in_server_info) {
 	in_server_info.m_connected = true;
 	in_server_info.m_socket->setBlocking(false);
+	in_server_info.m_inbound.clear();
 	in_server_info.m_last_connect_attempt = std::chrono::steady_clock::now();
 	in_server_info.m_last_activity = in_server_info.m_last_connect_attempt;
 
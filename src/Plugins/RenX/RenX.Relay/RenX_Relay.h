@@ -12,6 +12,7 @@
 #include "Jupiter/Plugin.h"
 #include "Jupiter/TCPSocket.h"
 #include "RenX_Plugin.h"
+#include "RenX_LineBuffer.h"
 
 class RenX_RelayPlugin : public RenX::Plugin
 {
@@ -63,7 +64,7 @@ private:
 		bool m_connected{};
 		std::chrono::steady_clock::time_point m_last_connect_attempt{};
 		std::chrono::steady_clock::time_point m_last_activity{};
-		std::string m_last_line;
+		RenX::LineBuffer m_inbound; // Received data not yet processed as messages
 		std::deque<UpstreamCommand> m_response_queue; // Contains both real & fake commands
 		bool m_processing_command{};
 		const upstream_settings* m_settings; // weak_ptr to upstream_settings owned by m_configured_upstreams
@@ -23,6 +23,7 @@
 #include "Jupiter/IRC_Client.h"
 #include "Jupiter/HTTP.h"
 #include "HTTPServer.h"
+#include "JSONWriter.h"
 #include "RenX_Core.h"
 #include "RenX_Server.h"
 #include "RenX_Functions.h"
@@ -36,64 +37,6 @@ static constexpr std::string_view CONTENT_TYPE_APPLICATION_JSON = "application/j
 constexpr std::string_view server_list_game_header = "<html><body>"sv;
 constexpr std::string_view server_list_game_footer = "\n</body></html>"sv;
 
-// TODO: can probably replace with some of the jessilib stuff
-std::string jsonify(std::string_view in_str) {
-	const unsigned char *ptr = reinterpret_cast<const unsigned char *>(in_str.data());
-	const unsigned char *end_ptr = ptr + in_str.size();
-	std::string result;
-
-	while (ptr < end_ptr) {
-		if (*ptr == '\\') { // backslash
-			result += '\\';
-			result += '\\';
-		}
-		else if (*ptr == '\"') { // quotation
-			result += '\\';
-			result += '\"';
-		}
-		else if (*ptr < 0x20) { // control characters
-			char buffer[2]; // control codes are only ever going to be at most 2 characters
-			if (std::to_chars(buffer, buffer + sizeof(buffer), *ptr, 16).ec == std::errc{}) {
-				result += "\\u00"sv;
-				if (*ptr > 0xF) {
-					result += buffer[0];
-					result += buffer[1];
-				}
-				else {
-					result += '0';
-					result += buffer[0];
-				}
-			};
-		}
-		else if ((*ptr & 0x80) != 0) { // UTF-8 sequence; copy to bypass above processing
-			result += *ptr;
-			if ((*ptr & 0x40) != 0) {
-				// this is a 2+ byte sequence
-
-				if ((*ptr & 0x20) != 0) {
-					// this is a 3+ byte sequence
-
-					if ((*ptr & 0x10) != 0) {
-						// this is a 4 byte sequnce
-						result += *++ptr;
-					}
-
-					result += *++ptr;
-				}
-
-				result += *++ptr;
-			}
-		}
-		else { // Character in standard ASCII table
-			result += *ptr;
-		}
-
-		++ptr;
-	}
-
-	return result;
-}
-
 bool RenX_ServerListPlugin::initialize() {
 	m_web_hostname = this->config.get("Hostname"sv, ""sv);
 	m_web_path = this->config.get("Path"sv, "/"sv);
@@ -102,6 +45,7 @@ bool RenX_ServerListPlugin::initialize() {
 	m_server_page_name = this->config.get("ServerPageName"sv, "server"sv);
 	m_metadata_page_name = this->config.get("MetadataPageName"sv, "metadata"sv);
 	m_metadata_prometheus_page_name = this->config.get("MetadataPrometheusPageName"sv, "metadata_prometheus"sv);
+	std::chrono::milliseconds cache_time = std::chrono::seconds(this->config.get<long long>("CacheTime"sv, 5));
 
 	/** Initialize content */
 	Jupiter::HTTP::Server &server = getHTTPServer();
@@ -115,19 +59,17 @@ bool RenX_ServerListPlugin::initialize() {
 	server.hook(m_web_hostname, m_web_path, std::move(content));
 
 	// Server list (long) page
-	content = std::make_unique<Jupiter::HTTP::Server::Content>(m_server_list_long_page_name, handle_server_list_long_page);
+	content = std::make_unique<CachedContent>(m_server_list_long_page_name, handle_server_list_long_page, "servers"sv, cache_time);
 	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
 	content->type = CONTENT_TYPE_APPLICATION_JSON;
 	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
-	content->free_result = true;
 	server.hook(m_web_hostname, m_web_path, std::move(content));
 
 	// Server page (GUIDs)
-	content = std::make_unique<Jupiter::HTTP::Server::Content>(m_server_page_name, handle_server_page);
+	content = std::make_unique<CachedContent>(m_server_page_name, handle_server_page, "servers"sv, cache_time);
 	content->language = Jupiter::HTTP::Content::Language::ENGLISH;
 	content->type = CONTENT_TYPE_APPLICATION_JSON;
 	content->charset = Jupiter::HTTP::Content::Type::Text::Charset::UTF8;
-	content->free_result = true;
 	server.hook(m_web_hostname, m_web_path, std::move(content));
 
 	// Metadata page
@@ -159,7 +101,7 @@ RenX_ServerListPlugin::~RenX_ServerListPlugin() {
 
 size_t RenX_ServerListPlugin::getListedPlayerCount(const RenX::Server& server) {
 	size_t player_limit = static_cast<size_t>(std::max(server.getPlayerLimit(), 0));
-	return std::min(server.activePlayers(false).size(), player_limit);
+	return std::min(server.getActivePlayerCount(false), player_limit);
 }
 
 std::string* RenX_ServerListPlugin::getServerListJSON() {
@@ -174,305 +116,158 @@ std::string* RenX_ServerListPlugin::getMetadataPrometheus() {
 	return &m_metadata_prometheus;
 }
 
-constexpr const char *json_bool_as_cstring(bool in) {
-	return in ? "true" : "false";
-}
-
-std::string RenX_ServerListPlugin::server_as_json(const RenX::Server &server) {
+void RenX_ServerListPlugin::server_as_json(JSONWriter &json, const RenX::Server &server) {
 	ListServerInfo serverInfo = getListServerInfo(server);
 
 	if (serverInfo.hostname.empty()) {
-		return "null"s;
+		json.null();
+		return;
 	}
 
-	std::string server_name = jsonify(server.getName());
-	std::string server_map = jsonify(server.getMap().name);
-	std::string server_version = jsonify(server.getGameVersion());
-	std::string_view server_hostname = serverInfo.hostname;
-	unsigned short server_port = serverInfo.port;
-	std::string server_prefix = jsonify(serverInfo.namePrefix);
+	json.beginObject();
+	json.member("Name"sv, server.getName());
 
 	// Some members we only include if they're populated
-	if (!server_prefix.empty()) {
-		server_prefix = jessilib::join<std::string>(R"json("NamePrefix":")json"sv, server_prefix, "\","sv);
+	if (!serverInfo.namePrefix.empty()) {
+		json.member("NamePrefix"sv, serverInfo.namePrefix);
 	}
 
-	std::string server_attributes;
-	if (!serverInfo.attributes.empty()) {
-		server_attributes.reserve(16 * serverInfo.attributes.size() + 16);
-		server_attributes = R"json("Attributes":[)json";
+	json.member("Current Map"sv, server.getMap().name);
+	json.member("Bots"sv, server.getBotCount());
+	json.member("Players"sv, getListedPlayerCount(server));
+	json.member("Game Version"sv, server.getGameVersion());
 
+	if (!serverInfo.attributes.empty()) {
+		json.key("Attributes"sv).beginArray();
 		for (std::string_view attribute : serverInfo.attributes) {
-			server_attributes += '\"';
-			server_attributes += attribute;
-			server_attributes += "\",";
+			json.value(attribute);
 		}
-
-		server_attributes.back() = ']';
-		server_attributes += ',';
+		json.endArray();
 	}
 
-	// Build block
-	std::string server_json_block = string_printf(R"json({"Name":"%.*s",%.*s"Current Map":"%.*s","Bots":%u,"Players":%u,"Game Version":"%.*s",%.*s"Variables":{"Mine Limit":%d,"bSteamRequired":%s,"bPrivateMessageTeamOnly":%s,"bPassworded":%s,"bAllowPrivateMessaging":%s,"bRanked":%s,"Game Type":%d,"Player Limit":%d,"Vehicle Limit":%d,"bAutoBalanceTeams":%s,"Team Mode":%d,"bSpawnCrates":%s,"CrateRespawnAfterPickup":%f,"Time Limit":%d},"Port":%u,"IP":"%.*s")json",
-		server_name.size(), server_name.data(),
-		server_prefix.size(), server_prefix.data(),
-		server_map.size(), server_map.data(),
-		server.getBotCount(),
-		getListedPlayerCount(server),
-		server_version.size(), server_version.data(),
-		server_attributes.size(), server_attributes.data(),
-		server.getMineLimit(),
-		json_bool_as_cstring(server.isSteamRequired()),
-		json_bool_as_cstring(server.isPrivateMessageTeamOnly()),
-		json_bool_as_cstring(server.isPassworded()),
-		json_bool_as_cstring(server.isPrivateMessagingEnabled()),
-		json_bool_as_cstring(server.isRanked()),
-		server.getGameType(),
-		server.getPlayerLimit(),
-		server.getVehicleLimit(),
-		json_bool_as_cstring(server.getTeamMode() == 3),
-		server.getTeamMode(),
-		json_bool_as_cstring(server.isCratesEnabled()),
-		server.getCrateRespawnDelay(),
-		server.getTimeLimit(),
-		server_port,
-		server_hostname.size(), server_hostname.data());
-
-	server_json_block += '}';
-
-	return server_json_block;
+	json.key("Variables"sv).beginObject();
+	json.member("Mine Limit"sv, server.getMineLimit());
+	json.member("bSteamRequired"sv, server.isSteamRequired());
+	json.member("bPrivateMessageTeamOnly"sv, server.isPrivateMessageTeamOnly());
+	json.member("bPassworded"sv, server.isPassworded());
+	json.member("bAllowPrivateMessaging"sv, server.isPrivateMessagingEnabled());
+	json.member("bRanked"sv, server.isRanked());
+	json.member("Game Type"sv, server.getGameType());
+	json.member("Player Limit"sv, server.getPlayerLimit());
+	json.member("Vehicle Limit"sv, server.getVehicleLimit());
+	json.member("bAutoBalanceTeams"sv, server.getTeamMode() == 3);
+	json.member("Team Mode"sv, server.getTeamMode());
+	json.member("bSpawnCrates"sv, server.isCratesEnabled());
+	json.member("CrateRespawnAfterPickup"sv, server.getCrateRespawnDelay());
+	json.member("Time Limit"sv, server.getTimeLimit());
+	json.endObject();
+
+	json.member("Port"sv, serverInfo.port);
+	json.member("IP"sv, serverInfo.hostname);
+	json.endObject();
 }
 
-std::string RenX_ServerListPlugin::server_as_server_details_json(const RenX::Server& server) {
-	std::string server_json_block;
-
-	server_json_block = '{';
-
-	// Levels
+void write_levels_json(JSONWriter &json, const RenX::Server &server) {
 	if (server.maps.size() != 0) {
-		server_json_block += "\"Levels\":["sv;
-
-		server_json_block += "{\"Name\":\""sv;
-		server_json_block += jsonify(server.maps[0].name);
-		server_json_block += "\",\"GUID\":\""sv;
-		server_json_block += RenX::formatGUID(server.maps[0]);
-		server_json_block += "\"}"sv;
-
-		for (size_t index = 1; index != server.maps.size(); ++index) {
-			server_json_block += ",{\"Name\":\""sv;
-			server_json_block += jsonify(server.maps[index].name);
-			server_json_block += "\",\"GUID\":\""sv;
-			server_json_block += RenX::formatGUID(server.maps[index]);
-			server_json_block += "\"}"sv;
+		json.key("Levels"sv).beginArray();
+		for (const auto& map : server.maps) {
+			json.beginObject();
+			json.member("Name"sv, map.name);
+			json.member("GUID"sv, RenX::formatGUID(map));
+			json.endObject();
 		}
-
-		server_json_block += ']';
+		json.endArray();
 	}
+}
 
-	// Mutators
+void write_mutators_json(JSONWriter &json, const RenX::Server &server) {
 	if (server.mutators.size() != 0) {
-		if (server.maps.size() != 0)
-			server_json_block += ","sv;
-		server_json_block += "\"Mutators\":["sv;
-
-		server_json_block += "{\"Name\":\""sv;
-		server_json_block += jsonify(server.mutators[0]);
-		server_json_block += "\"}"sv;
-
-		for (size_t index = 1; index != server.mutators.size(); ++index) {
-			server_json_block += ",{\"Name\":\""sv;
-			server_json_block += jsonify(server.mutators[index]);
-			server_json_block += "\"}"sv;
+		json.key("Mutators"sv).beginArray();
+		for (const auto& mutator : server.mutators) {
+			json.beginObject();
+			json.member("Name"sv, mutator);
+			json.endObject();
 		}
-
-		server_json_block += ']';
+		json.endArray();
 	}
+}
 
-	// Player List
-	if (server.players.size() != 0 && server.players.size() != server.getBotCount()) {
-		server_json_block += ",\"PlayerList\":["sv;
-
-		auto node = server.players.begin();
-
-		if (node != server.players.end()) {
-			server_json_block += "{\"Name\":\""sv;
-			server_json_block += jsonify(node->name);
-			server_json_block += "\", \"isBot\":"sv;
-			server_json_block += json_bool_as_cstring(node->isBot);
-			server_json_block += ", \"Team\":"sv;
-			server_json_block += std::to_string(static_cast<int>(node->team));
-			server_json_block += "}"sv;
-
-			++node;
-		}
-
-		while (node != server.players.end()) {
-			server_json_block += ",{\"Name\":\""sv;
-			server_json_block += jsonify(node->name);
-			server_json_block += "\", \"isBot\":"sv;
-			server_json_block += json_bool_as_cstring(node->isBot);
-			server_json_block += ", \"Team\":"sv;
-			server_json_block += std::to_string(static_cast<int>(node->team));
-			server_json_block += "}"sv;
+void RenX_ServerListPlugin::server_as_server_details_json(JSONWriter &json, const RenX::Server& server) {
+	json.beginObject();
+	write_levels_json(json, server);
+	write_mutators_json(json, server);
 
-			++node;
+	// Player List
+	if (server.getHumanCount() != 0) {
+		json.key("PlayerList"sv).beginArray();
+		for (const auto& player : server.players) {
+			json.beginObject();
+			json.member("Name"sv, player.name);
+			json.member("isBot"sv, player.isBot);
+			json.member("Team"sv, static_cast<int>(player.team));
+			json.endObject();
 		}
-
-		server_json_block += "]"sv;
+		json.endArray();
 	}
 
-	server_json_block += '}';
-	return server_json_block;
+	json.endObject();
 }
 
-std::string RenX_ServerListPlugin::server_as_long_json(const RenX::Server &server) {
+void RenX_ServerListPlugin::server_as_long_json(JSONWriter &json, const RenX::Server &server) {
 	ListServerInfo serverInfo = getListServerInfo(server);
-
-	std::string server_name = jsonify(server.getName());
-	std::string server_map = jsonify(server.getMap().name);
-	std::string server_version = jsonify(server.getGameVersion());
-	std::string_view server_hostname = serverInfo.hostname;
-	unsigned short server_port = serverInfo.port;
-	std::string server_prefix = jsonify(serverInfo.namePrefix);
-	std::vector<const RenX::PlayerInfo*> activePlayers = server.activePlayers(false);
-
-	std::string server_attributes = "[]";
-	if (!serverInfo.attributes.empty()) {
-		server_attributes.reserve(16 * serverInfo.attributes.size() + 16);
-		server_attributes = "[";
-
-		const char* comma = "\n";
-		for (std::string_view attribute : serverInfo.attributes) {
-			server_attributes += comma;
-			comma = ",\n";
-
-			server_attributes += "\t\t\t\"";
-			server_attributes += attribute;
-			server_attributes += "\"";
-		}
-
-		server_attributes += "\n\t\t],";
-	}
-
-	std::string server_json_block = string_printf(R"json({
-		"Name": "%.*s",
-		"NamePrefix": "%.*s",
-		"Current Map": "%.*s",
-		"Bots": %u,
-		"Players": %u,
-		"Game Version": "%.*s",
-		"Attributes": %.*s,
-		"Variables": {
-			"Mine Limit": %d,
-			"bSteamRequired": %s,
-			"bPrivateMessageTeamOnly": %s,
-			"bPassworded": %s,
-			"bAllowPrivateMessaging": %s,
-			"Player Limit": %d,
-			"Vehicle Limit": %d,
-			"bAutoBalanceTeams": %s,
-			"Team Mode": %d,
-			"bSpawnCrates": %s,
-			"CrateRespawnAfterPickup": %f,
-			"Time Limit": %d
-		},
-		"Port": %u,
-		"IP": "%.*s")json",
-		server_name.size(), server_name.data(),
-		server_prefix.size(), server_prefix.data(),
-		server_map.size(), server_map.data(),
-		server.getBotCount(),
-		activePlayers.size(),
-		server_version.size(), server_version.data(),
-		server_attributes.size(), server_attributes.data(),
-
-		server.getMineLimit(),
-		json_bool_as_cstring(server.isSteamRequired()),
-		json_bool_as_cstring(server.isPrivateMessageTeamOnly()),
-		json_bool_as_cstring(server.isPassworded()),
-		json_bool_as_cstring(server.isPrivateMessagingEnabled()),
-		server.getPlayerLimit(),
-		server.getVehicleLimit(),
-		json_bool_as_cstring(server.getTeamMode() == 3),
-		server.getTeamMode(),
-		json_bool_as_cstring(server.isCratesEnabled()),
-		server.getCrateRespawnDelay(),
-		server.getTimeLimit(),
-
-		server_port,
-		server_hostname.size(), server_hostname.data());
-
-	// Level Rotation
-	if (server.maps.size() != 0) {
-		server_json_block += ",\n\t\t\"Levels\": ["sv;
-
-		server_json_block += "\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-		server_json_block += jsonify(server.maps[0].name);
-		server_json_block += "\",\n\t\t\t\t\"GUID\": \""sv;
-		server_json_block += RenX::formatGUID(server.maps[0]);
-		server_json_block += "\"\n\t\t\t}"sv;
-
-		for (size_t index = 1; index != server.maps.size(); ++index) {
-			server_json_block += ",\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-			server_json_block += jsonify(server.maps[index].name);
-			server_json_block += "\",\n\t\t\t\t\"GUID\": \""sv;
-			server_json_block += RenX::formatGUID(server.maps[index]);
-			server_json_block += "\"\n\t\t\t}"sv;
-		}
-
-		server_json_block += "\n\t\t]"sv;
-	}
-
-	// Mutators
-	if (server.mutators.size() != 0) {
-		server_json_block += ",\n\t\t\"Mutators\": ["sv;
-
-		server_json_block += "\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-		server_json_block += jsonify(server.mutators[0]);
-		server_json_block += "\"\n\t\t\t}"sv;
-
-		for (size_t index = 1; index != server.mutators.size(); ++index) {
-			server_json_block += ",\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-			server_json_block += jsonify(server.mutators[index]);
-			server_json_block += "\"\n\t\t\t}"sv;
-		}
-
-		server_json_block += "\n\t\t]"sv;
+	RenX::Server::ActivePlayers activePlayers = server.activePlayers(false);
+
+	json.beginObject();
+	json.member("Name"sv, server.getName());
+	json.member("NamePrefix"sv, serverInfo.namePrefix);
+	json.member("Current Map"sv, server.getMap().name);
+	json.member("Bots"sv, server.getBotCount());
+	json.member("Players"sv, activePlayers.size());
+	json.member("Game Version"sv, server.getGameVersion());
+
+	json.key("Attributes"sv).beginArray();
+	for (std::string_view attribute : serverInfo.attributes) {
+		json.value(attribute);
 	}
+	json.endArray();
+
+	json.key("Variables"sv).beginObject();
+	json.member("Mine Limit"sv, server.getMineLimit());
+	json.member("bSteamRequired"sv, server.isSteamRequired());
+	json.member("bPrivateMessageTeamOnly"sv, server.isPrivateMessageTeamOnly());
+	json.member("bPassworded"sv, server.isPassworded());
+	json.member("bAllowPrivateMessaging"sv, server.isPrivateMessagingEnabled());
+	json.member("Player Limit"sv, server.getPlayerLimit());
+	json.member("Vehicle Limit"sv, server.getVehicleLimit());
+	json.member("bAutoBalanceTeams"sv, server.getTeamMode() == 3);
+	json.member("Team Mode"sv, server.getTeamMode());
+	json.member("bSpawnCrates"sv, server.isCratesEnabled());
+	json.member("CrateRespawnAfterPickup"sv, server.getCrateRespawnDelay());
+	json.member("Time Limit"sv, server.getTimeLimit());
+	json.endObject();
+
+	json.member("Port"sv, serverInfo.port);
+	json.member("IP"sv, serverInfo.hostname);
+
+	write_levels_json(json, server);
+	write_mutators_json(json, server);
 
 	// Player List
 	if (activePlayers.size() != 0) {
-		server_json_block += ",\n\t\t\"PlayerList\": ["sv;
-
-		auto node = activePlayers.begin();
-
-		// Add first player to JSON
-		server_json_block += "\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-		server_json_block += jsonify((*node)->name);
-		server_json_block += "\"\n\t\t\t}"sv;
-		++node;
-
-		// Add remaining players to JSON
-		while (node != activePlayers.end()) {
-			server_json_block += ",\n\t\t\t{\n\t\t\t\t\"Name\": \""sv;
-			server_json_block += jsonify((*node)->name);
-			server_json_block += "\"\n\t\t\t}"sv;
-			++node;
+		json.key("PlayerList"sv).beginArray();
+		for (const RenX::PlayerInfo* player : activePlayers) {
+			json.beginObject();
+			json.member("Name"sv, player->name);
+			json.endObject();
 		}
-
-		server_json_block += "\n\t\t]"sv;
+		json.endArray();
 	}
 
-	server_json_block += "\n\t}"sv;
-
-	return static_cast<std::string>(server_json_block);
+	json.endObject();
 }
 
 void RenX_ServerListPlugin::addServerToServerList(RenX::Server &server) {
-	std::string server_json_block;
-
 	// append to server_list_json
-	server_json_block = server_as_json(server);
 	if (m_server_list_json.size() <= 2) {
 		m_server_list_json = '[';
 	}
@@ -480,7 +275,9 @@ void RenX_ServerListPlugin::addServerToServerList(RenX::Server &server) {
 		m_server_list_json.pop_back(); // remove trailing ']'.
 		m_server_list_json += ',';
 	}
-	m_server_list_json += server_json_block;
+
+	JSONWriter json{ m_server_list_json };
+	server_as_json(json, server);
 	m_server_list_json += ']';
 
 	// Also update metadata so it reflects the now added server
@@ -489,33 +286,20 @@ void RenX_ServerListPlugin::addServerToServerList(RenX::Server &server) {
 
 void RenX_ServerListPlugin::updateServerList() {
 	const auto& servers = RenX::getCore()->getServers();
-	size_t index = 0;
-	RenX::Server *server;
 
-	// regenerate server_list_json
+	// Cached pages are generated from the same data
+	invalidateHTTPCache("servers"sv);
 
-	m_server_list_json = '[';
-
-	while (index != servers.size()) {
-		server = servers[index];
-		if (server->isConnected() && server->isFullyConnected()) {
-			m_server_list_json += server_as_json(*server);
-
-			++index;
-			break;
-		}
-		++index;
-	}
-	while (index != servers.size()) {
-		server = servers[index];
+	// regenerate server_list_json; clearing keeps the buffer's capacity
+	m_server_list_json.clear();
+	JSONWriter json{ m_server_list_json };
+	json.beginArray();
+	for (RenX::Server *server : servers) {
 		if (server->isConnected() && server->isFullyConnected()) {
-			m_server_list_json += ',';
-			m_server_list_json += server_as_json(*server);
+			server_as_json(json, *server);
 		}
-		++index;
 	}
-
-	m_server_list_json += ']';
+	json.endArray();
 
 	// Also update metadata so that it reflects any changes
 	updateMetadata();
@@ -534,24 +318,29 @@ void RenX_ServerListPlugin::updateMetadata() {
 		}
 	}
 
-	// TODO: not rely on StringS
-	m_metadata_json = string_printf(R"json({"player_count":%zu,"server_count":%u})json",
-		player_count, server_count);
+	m_metadata_json.clear();
+	JSONWriter json{ m_metadata_json };
+	json.beginObject();
+	json.member("player_count"sv, player_count);
+	json.member("server_count"sv, server_count);
+	json.endObject();
 
 	m_metadata_prometheus = string_printf("player_count %zu\nserver_count %u\n",
 		player_count, server_count);
 }
 
 void RenX_ServerListPlugin::markDetailsStale(RenX::Server& in_server) {
-	in_server.varData[this->name].remove("j"sv);
+	m_details_json.reset(in_server);
 }
 
-void RenX_ServerListPlugin::touchDetails(RenX::Server& in_server) {
-	auto& server_varData = in_server.varData[this->name];
-	if (server_varData.get("j"sv).empty()) {
-		auto server_json_block = server_as_server_details_json(in_server);
-		server_varData.set("j"sv, server_json_block);
+const std::string& RenX_ServerListPlugin::touchDetails(RenX::Server& in_server) {
+	std::string& server_json_block = m_details_json.get(in_server);
+	if (server_json_block.empty()) {
+		JSONWriter json{ server_json_block };
+		server_as_server_details_json(json, in_server);
 	}
+
+	return server_json_block;
 }
 
 std::string_view RenX_ServerListPlugin::getListServerAddress(const RenX::Server& server) {
@@ -634,35 +423,17 @@ std::string* handle_server_list_page(std::string_view) {
 
 std::string* handle_server_list_long_page(std::string_view) {
 	const auto& servers = RenX::getCore()->getServers();
-	size_t index = 0;
-	RenX::Server *server;
 	std::string *server_list_long_json = new std::string;
-	server_list_long_json->reserve(256 * servers.size());
+	server_list_long_json->reserve(1024 * servers.size());
 
-	// regenerate server_list_json
-
-	*server_list_long_json = "["sv;
-
-	while (index != servers.size()) {
-		server = servers[index];
+	JSONWriter json{ *server_list_long_json, true };
+	json.beginArray();
+	for (RenX::Server *server : servers) {
 		if (server->isConnected() && server->isFullyConnected()) {
-			*server_list_long_json += "\n\t"sv;
-			*server_list_long_json += pluginInstance.server_as_long_json(*server);
-			++index;
-			break;
+			pluginInstance.server_as_long_json(json, *server);
 		}
-		++index;
 	}
-	while (index != servers.size()) {
-		server = servers[index];
-		if (server->isConnected() && server->isFullyConnected()) {
-			*server_list_long_json += ",\n\t"sv;
-			*server_list_long_json += pluginInstance.server_as_long_json(*server);
-		}
-		++index;
-	}
-
-	*server_list_long_json += "\n]"sv;
+	json.endArray();
 
 	return server_list_long_json;
 }
@@ -711,8 +482,7 @@ std::string* handle_server_page(std::string_view query_string) {
 	}
 
 	// return server data
-	pluginInstance.touchDetails(*server);
-	return new std::string(server->varData[pluginInstance.getName()].get("j"sv));
+	return new std::string(pluginInstance.touchDetails(*server));
 }
 
 std::string* handle_metadata_page(std::string_view) {
@@ -21,6 +21,8 @@
 
 #include "Jupiter/Plugin.h"
 #include "RenX_Plugin.h"
+#include "RenX_DataSlot.h"
+#include "JSONWriter.h"
 
 class RenX_ServerListPlugin : public RenX::Plugin
 {
@@ -42,12 +44,12 @@ public: // RenX_ServerListPlugin
 	void updateServerList();
 	void updateMetadata();
 	void markDetailsStale(RenX::Server& in_server);
-	void touchDetails(RenX::Server& in_server);
+	const std::string& touchDetails(RenX::Server& in_server);
 	std::string_view getListServerAddress(const RenX::Server& server);
 	ListServerInfo getListServerInfo(const RenX::Server& server);
-	std::string server_as_json(const RenX::Server &server);
-	std::string server_as_server_details_json(const RenX::Server& server);
-	std::string server_as_long_json(const RenX::Server &server);
+	void server_as_json(JSONWriter &json, const RenX::Server &server);
+	void server_as_server_details_json(JSONWriter &json, const RenX::Server& server);
+	void server_as_long_json(JSONWriter &json, const RenX::Server &server);
 
 	virtual bool initialize() override;
 	~RenX_ServerListPlugin();
@@ -63,6 +65,7 @@ private:
 	std::string m_server_list_json, m_metadata_json, m_metadata_prometheus;
 	std::string m_web_hostname, m_web_path;
 	std::string m_server_list_page_name, m_server_list_long_page_name, m_server_page_name, m_metadata_page_name, m_metadata_prometheus_page_name;
+	RenX::ServerSlot<std::string> m_details_json; // Cached server details block; empty when stale
 };
 
 std::string* handle_server_list_page(std::string_view);
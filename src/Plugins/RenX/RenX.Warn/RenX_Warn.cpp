@@ -38,7 +38,7 @@ int RenX_WarnPlugin::OnRehash() {
 // Plugin instantiation and entry point.
 RenX_WarnPlugin pluginInstance;
 
-static constexpr std::string_view WARNS_KEY = "w"sv;
+RenX::PlayerSlot<int> g_warns_slot;
 
 // Warn IRC Command
 
@@ -74,7 +74,7 @@ void WarnIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::str
 		if (server != nullptr) {
 			player = server->getPlayerByPartName(name);
 			if (player != nullptr) {
-				int warns = player->varData[pluginInstance.getName()].get<int>(WARNS_KEY) + 1;
+				int warns = g_warns_slot.get(*player) + 1;
 				if (warns > pluginInstance.m_maxWarns) {
 					switch (pluginInstance.m_warnAction) {
 					case -1:
@@ -88,7 +88,7 @@ void WarnIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::str
 					}
 				}
 				else {
-					player->varData[pluginInstance.getName()].set(WARNS_KEY, std::to_string(warns));
+					g_warns_slot.set(*player, warns);
 					server->sendWarnMessage(*player, string_printf("You have been warned by %.*s@IRC for: %.*s. You have %d warnings.", nick.size(),
 						nick.data(), reason.size(), reason.data(), warns));
 					source->sendNotice(nick, string_printf("%.*s has been warned; they now have %d warnings.", player->name.size(), player->name.data(), warns));
@@ -136,7 +136,7 @@ void PardonIRCCommand::trigger(IRC_Bot *source, std::string_view channel, std::s
 		if (server != nullptr) {
 			player = server->getPlayerByPartName(parameters);
 			if (player != nullptr) {
-				player->varData[pluginInstance.getName()].remove(WARNS_KEY);
+				g_warns_slot.reset(*player);
 				server->sendMessage(*player, string_printf("You have been pardoned by %.*s@IRC; your warnings have been reset.", nick.size(),
 					nick.data()));
 				source->sendNotice(nick, string_printf("%.*s has been pardoned; their warnings have been reset.", player->name.size(), player->name.data()));
@@ -168,7 +168,7 @@ void WarnGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player, st
 
 		RenX::PlayerInfo *target = source->getPlayerByPartName(name);
 		if (target != nullptr) {
-			int warns = target->varData[pluginInstance.getName()].get<int>(WARNS_KEY) + 1;
+			int warns = g_warns_slot.get(*target) + 1;
 			if (warns > pluginInstance.m_maxWarns) {
 				switch (pluginInstance.m_warnAction)
 				{
@@ -183,7 +183,7 @@ void WarnGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player, st
 				}
 			}
 			else {
-				target->varData[pluginInstance.getName()].set(WARNS_KEY, std::to_string(warns));
+				g_warns_slot.set(*target, warns);
 				source->sendWarnMessage(*target, string_printf("You have been warned by %.*s for: %.*s. You have %d warnings.", player->name.size(), player->name.data(), reason.size(), reason.data(), warns));
 				source->sendMessage(*player, string_printf("%.*s has been warned; they now have %d warnings.", target->name.size(), target->name.data(), warns));
 			}
@@ -213,7 +213,7 @@ void PardonGameCommand::trigger(RenX::Server *source, RenX::PlayerInfo *player,
 	if (!parameters.empty()) {
 		RenX::PlayerInfo *target = source->getPlayerByPartName(parameters);
 		if (target != nullptr) {
-			target->varData[pluginInstance.getName()].remove(WARNS_KEY);
+			g_warns_slot.reset(*target);
 			source->sendMessage(*target, string_printf("You have been pardoned by %.*s@IRC; your warnings have been reset.", player->name.size(), player->name.data()));
 			source->sendMessage(*player, string_printf("%.*s has been pardoned; their warnings have been reset.", target->name.size(), target->name.data()));
 		}
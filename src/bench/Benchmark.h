@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+#if !defined _BENCHMARK_H_HEADER
+#define _BENCHMARK_H_HEADER
+
+/**
+ * @file Benchmark.h
+ * @brief Minimal timing helpers shared by the standalone benchmark programs.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <utility>
+
+namespace Benchmark
+{
+#if !defined __GNUC__
+	/** Written by keep() on compilers without GNU inline asm; volatile, so the writes can't be discarded */
+	inline volatile size_t sink;
+#endif
+
+	/**
+	* @brief Runs a function repeatedly until at least in_min_duration has elapsed.
+	*
+	* @param in_function Function to run; it is called with no arguments
+	* @param in_min_duration Minimum total running time
+	* @return Pair of (iterations run, seconds elapsed)
+	*/
+	template<typename FunctionT>
+	std::pair<size_t, double> run(FunctionT&& in_function, std::chrono::milliseconds in_min_duration = std::chrono::milliseconds{ 500 }) {
+		using clock = std::chrono::steady_clock;
+		size_t iterations = 0;
+		clock::time_point start = clock::now();
+		clock::duration elapsed{};
+		do {
+			in_function();
+			++iterations;
+			elapsed = clock::now() - start;
+		} while (elapsed < in_min_duration);
+
+		return { iterations, std::chrono::duration<double>(elapsed).count() };
+	}
+
+	/**
+	* @brief Prints the throughput of a run in MB/s.
+	*
+	* @param in_name Name of the benchmark
+	* @param in_bytes_per_iteration Bytes processed by each iteration
+	* @param in_result Result returned by run()
+	*/
+	inline void report_bytes(std::string_view in_name, size_t in_bytes_per_iteration, std::pair<size_t, double> in_result) {
+		double bytes = static_cast<double>(in_bytes_per_iteration) * in_result.first;
+		std::printf("%-40.*s %10.1f MB/s\n", static_cast<int>(in_name.size()), in_name.data(), bytes / in_result.second / 1e6);
+	}
+
+	/**
+	* @brief Prints the rate of a run in operations per second.
+	*
+	* @param in_name Name of the benchmark
+	* @param in_operations_per_iteration Operations performed by each iteration
+	* @param in_result Result returned by run()
+	*/
+	inline void report_operations(std::string_view in_name, size_t in_operations_per_iteration, std::pair<size_t, double> in_result) {
+		double operations = static_cast<double>(in_operations_per_iteration) * in_result.first;
+		std::printf("%-40.*s %10.3f Mops/s\n", static_cast<int>(in_name.size()), in_name.data(), operations / in_result.second / 1e6);
+	}
+
+	/**
+	* @brief Prints the rate of a run in operations per second, for operations too slow to report in Mops/s.
+	*
+	* @param in_name Name of the benchmark
+	* @param in_operations_per_iteration Operations performed by each iteration
+	* @param in_result Result returned by run()
+	*/
+	inline void report_rate(std::string_view in_name, size_t in_operations_per_iteration, std::pair<size_t, double> in_result) {
+		double operations = static_cast<double>(in_operations_per_iteration) * in_result.first;
+		std::printf("%-40.*s %10.0f /s\n", static_cast<int>(in_name.size()), in_name.data(), operations / in_result.second);
+	}
+
+	/**
+	* @brief Prevents the compiler from discarding a computation whose result is otherwise unused.
+	*
+	* @param in_value Value derived from the computation (e.g. an output size)
+	*/
+	inline void keep(size_t in_value) {
+#if defined __GNUC__
+		// Empty asm which claims to read the value; costs nothing, but the value must be computed
+		asm volatile("" : : "r"(in_value) : "memory");
+#else
+		sink = in_value;
+#endif
+	}
+}
+
+#endif // _BENCHMARK_H_HEADER
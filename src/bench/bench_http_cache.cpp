@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+/**
+ * @file bench_http_cache.cpp
+ * @brief Measures the request rate of CachedContent on hits and misses, against generating every page.
+ * This covers the cache layer only; the rate of the HTTP server as a whole depends on Jupiter's socket handling.
+ */
+
+#include <string>
+#include "Benchmark.h"
+#include "HTTPCache.h"
+
+using namespace std::literals;
+
+namespace {
+// Roughly the size and shape of a RenX.Ladder.Web page of 50 entries
+std::string* generate_page(std::string_view) {
+	std::string* result = new std::string();
+	result->reserve(48 * 1024);
+	*result += "<html><head><title>Ladder</title></head><body><table>"sv;
+	for (size_t index = 0; index != 50; ++index) {
+		*result += "<tr><td>"sv;
+		*result += std::to_string(index + 1);
+		*result += "</td><td><a href=\"profile?id="sv;
+		*result += std::to_string(76561198000000000ULL + index * 7919);
+		*result += "\">Player "sv;
+		*result += std::to_string(index * 31);
+		*result += "</a></td>"sv;
+		for (size_t column = 0; column != 24; ++column) {
+			*result += "<td>"sv;
+			*result += std::to_string((index + 3) * (column + 11) * 97 % 10007);
+			*result += "</td>"sv;
+		}
+		*result += "</tr>\n"sv;
+	}
+	*result += "</table></body></html>"sv;
+	return result;
+}
+}
+
+int main() {
+	CachedContent content{ "ladder"s, generate_page, "bench"sv, std::chrono::hours{ 1 } };
+	std::shared_ptr<const CachedResponse> response = content.fetch("start=0"sv);
+	std::printf("page: %zu bytes; gzip: %zu bytes; deflate: %zu bytes\n", response->body.size(), response->gzip.size(), response->deflate.size());
+
+	auto uncached = Benchmark::run([]() {
+		std::string* page = generate_page(""sv);
+		Benchmark::keep(page->size());
+		delete page;
+	});
+	Benchmark::report_rate("uncached (generate every request)"sv, 1, uncached);
+
+	auto miss = Benchmark::run([&content]() {
+		invalidateHTTPCache("bench"sv);
+		std::string* page = content.execute("start=0"sv);
+		Benchmark::keep(page->size());
+		delete page;
+	});
+	Benchmark::report_rate("miss (generate, compress, tag)"sv, 1, miss);
+
+	auto hit = Benchmark::run([&content]() {
+		std::string* page = content.execute("start=0"sv);
+		Benchmark::keep(page->size());
+		delete page;
+	});
+	Benchmark::report_rate("hit (copy of identity body)"sv, 1, hit);
+
+	auto negotiated = Benchmark::run([&content]() {
+		std::shared_ptr<const CachedResponse> cached = content.fetch("start=0"sv);
+		std::string_view encoding;
+		const std::string& variant = cached->select("gzip, deflate, br"sv, encoding);
+		Benchmark::keep(variant.size() + encoding.size());
+	});
+	Benchmark::report_rate("hit (fetch, select gzip)"sv, 1, negotiated);
+
+	auto not_modified = Benchmark::run([&content, &response]() {
+		std::shared_ptr<const CachedResponse> cached = content.fetch("start=0"sv);
+		Benchmark::keep(cached->matches(response->etag));
+	});
+	Benchmark::report_rate("hit (fetch, If-None-Match -> 304)"sv, 1, not_modified);
+	return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+/**
+ * @file bench_json_writer.cpp
+ * @brief Measures JSONWriter string escaping throughput, and serialization of a server-list-shaped document.
+ */
+
+#include <string>
+#include "Benchmark.h"
+#include "JSONWriter.h"
+
+using namespace std::literals;
+
+namespace {
+std::string repeat(std::string_view in_text, size_t in_size) {
+	std::string result;
+	while (result.size() < in_size) {
+		result += in_text;
+	}
+	return result;
+}
+
+void bench_escape(std::string_view in_name, const std::string& in_text) {
+	std::string buffer;
+	auto result = Benchmark::run([&]() {
+		buffer.clear();
+		JSONWriter::escape(buffer, in_text);
+		Benchmark::keep(buffer.size());
+	});
+	Benchmark::report_bytes(in_name, in_text.size(), result);
+}
+
+// Roughly the shape of RenX.ServerList's long server list: one object per server, with a nested player array
+void write_server_list(JSONWriter& json, size_t in_server_count, size_t in_player_count) {
+	json.beginArray();
+	for (size_t server = 0; server != in_server_count; ++server) {
+		json.beginObject();
+		json.member("Name"sv, "Totem Arts \"Marathon\" Server #1 | Discord: discord.gg/renx"sv);
+		json.member("Current Map"sv, "CNC-Field_X"sv);
+		json.member("Bots"sv, 0);
+		json.member("Players"sv, in_player_count);
+		json.member("Game Version"sv, "Open Beta 5.48.285"sv);
+		json.key("Variables"sv).beginObject();
+		json.member("Mine Limit"sv, 30);
+		json.member("bSteamRequired"sv, true);
+		json.member("bPrivateMessageTeamOnly"sv, false);
+		json.member("bPassworded"sv, false);
+		json.member("bAllowPrivateMessaging"sv, true);
+		json.member("Player Limit"sv, 64);
+		json.member("Vehicle Limit"sv, 14);
+		json.member("bAutoBalanceTeams"sv, true);
+		json.member("Team Mode"sv, 6);
+		json.member("bSpawnCrates"sv, true);
+		json.member("CrateRespawnAfterPickup"sv, 35.0);
+		json.member("Time Limit"sv, 40);
+		json.endObject();
+		json.member("Port"sv, 7777);
+		json.member("IP"sv, "127.0.0.1"sv);
+		json.key("PlayerList"sv).beginArray();
+		for (size_t player = 0; player != in_player_count; ++player) {
+			json.beginObject();
+			json.member("Name"sv, "[TAG] Some\\Player <3"sv);
+			json.endObject();
+		}
+		json.endArray();
+		json.endObject();
+	}
+	json.endArray();
+}
+
+void bench_document(std::string_view in_name, bool in_pretty) {
+	std::string buffer;
+	auto result = Benchmark::run([&]() {
+		buffer.clear();
+		JSONWriter json{ buffer, in_pretty };
+		write_server_list(json, 64, 32);
+		Benchmark::keep(buffer.size());
+	});
+	Benchmark::report_bytes(in_name, buffer.size(), result);
+}
+}
+
+int main() {
+	constexpr size_t text_size = 64 * 1024;
+	const std::string ascii = repeat("[Nod] Player: anyone got a tech for the airstrip? gg wp "sv, text_size);
+	const std::string utf8 = repeat("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ok "sv, text_size);
+	const std::string dense = repeat("\"C:\\a\\b\"\n"sv, text_size);
+
+	bench_escape("escape (ascii)"sv, ascii);
+	bench_escape("escape (utf-8)"sv, utf8);
+	bench_escape("escape (quotes, backslashes)"sv, dense);
+	bench_document("server list (compact)"sv, false);
+	bench_document("server list (pretty)"sv, true);
+	return 0;
+}
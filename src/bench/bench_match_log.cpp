@@ -0,0 +1,147 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+/**
+ * @file bench_match_log.cpp
+ * @brief Reports RenX.MatchLog storage and query latency over a synthetic season of matches.
+ * Usage: bench_match_log [matches] [database file]. Without a database file, only in-memory figures are reported.
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include "Benchmark.h"
+#include "RenX_MatchStore.h"
+
+using namespace std::literals;
+
+namespace {
+constexpr size_t players_per_match = 40;
+constexpr std::chrono::minutes match_length{ 35 };
+
+const std::string_view damage_types[]{ "Rx_DmgType_Headshot"sv, "Rx_DmgType_AutoRifle"sv, "Rx_DmgType_Shotgun"sv, "Rx_DmgType_RamjetRifle"sv,
+	"Rx_DmgType_MarksmanRifle"sv, "Rx_DmgType_Pistol"sv, "Rx_DmgType_MammothTank"sv, "Rx_DmgType_FlameTank"sv, "Rx_DmgType_Artillery"sv };
+const std::string_view purchases[]{ "Rx_FamilyInfo_GDI_Hotwire"sv, "Rx_FamilyInfo_Nod_Technician"sv, "Rx_FamilyInfo_GDI_Havoc"sv,
+	"Rx_FamilyInfo_Nod_Sakura"sv, "Rx_Vehicle_GDI_MammothTank"sv, "Rx_Vehicle_Nod_StealthTank"sv, "Refill"sv };
+const std::string_view objects[]{ "Rx_Building_Barracks"sv, "Rx_Building_HandOfNod"sv, "Rx_Building_PowerPlant_GDI"sv,
+	"Rx_Building_PowerPlant_Nod"sv, "Rx_Vehicle_GDI_Humvee"sv, "Rx_Vehicle_Nod_Buggy"sv, "Rx_Defence_Turret"sv };
+
+/** Generates a match with roughly the event mix of a full 40 player server */
+MatchStore::Segment generate_match(std::mt19937& in_engine, const std::vector<std::string>& in_players, size_t in_match) {
+	MatchStore::Recorder recorder{ "Server "s + std::to_string(in_match % 3), "CNC-Field"sv };
+	std::uniform_int_distribution<size_t> player_distribution{ 0, in_players.size() - 1 };
+	std::discrete_distribution<int> type_distribution{ 30, 30, 2, 30, 6, 1, 12 }; // Weights per MatchStore::EventType
+	std::exponential_distribution<double> gap_distribution{ 2.0 }; // ~2 events per second
+
+	double time = 0.0;
+	const double end = std::chrono::duration<double>(match_length).count();
+	while (time < end) {
+		time += gap_distribution(in_engine);
+		std::chrono::milliseconds at{ static_cast<long long>(time * 1000.0) };
+		size_t actor = player_distribution(in_engine);
+		RenX::TeamType team = actor % 2 == 0 ? RenX::TeamType::GDI : RenX::TeamType::Nod;
+		auto type = static_cast<MatchStore::EventType>(type_distribution(in_engine));
+		switch (type) {
+		case MatchStore::EventType::Kill:
+			recorder.record(at, type, team, in_players[actor], in_players[player_distribution(in_engine)], damage_types[in_engine() % std::size(damage_types)], 0);
+			break;
+		case MatchStore::EventType::Death:
+		case MatchStore::EventType::Suicide:
+			recorder.record(at, type, team, in_players[actor], {}, damage_types[in_engine() % std::size(damage_types)], 0);
+			break;
+		case MatchStore::EventType::Purchase:
+			recorder.record(at, type, team, in_players[actor], {}, purchases[in_engine() % std::size(purchases)], 0);
+			break;
+		case MatchStore::EventType::Destroy:
+			recorder.record(at, type, team, in_players[actor], objects[in_engine() % std::size(objects)], damage_types[in_engine() % std::size(damage_types)], 1);
+			break;
+		case MatchStore::EventType::Capture:
+			recorder.record(at, type, team, in_players[actor], "Rx_Building_Silo"sv, {}, 0);
+			break;
+		default:
+			recorder.record(at, type, team, in_players[actor], {}, {}, static_cast<uint32_t>(in_engine() % 80));
+			break;
+		}
+	}
+
+	return recorder.seal(RenX::TeamType::GDI);
+}
+
+double milliseconds_since(std::chrono::steady_clock::time_point in_start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - in_start).count();
+}
+
+void bench_top(const MatchStore& in_store, size_t in_matches) {
+	auto result = Benchmark::run([&]() {
+		Benchmark::keep(in_store.top(MatchStore::EventType::Kill, MatchStore::Column::Actor, 5, in_matches).size());
+	}, std::chrono::milliseconds{ 200 });
+	std::printf("matchtop kill actor over %6zu matches  %10.3f ms\n", in_matches, result.second * 1000.0 / result.first);
+}
+}
+
+int main(int argc, char* argv[]) {
+	// Default: 3 servers running back-to-back 35 minute matches for 90 days
+	size_t match_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 3 * 90 * 24 * 60 / 35;
+	std::string filename = argc > 2 ? argv[2] : std::string{};
+	if (!filename.empty()) {
+		std::filesystem::remove(filename);
+	}
+
+	std::mt19937 engine{ 48 };
+	std::vector<std::string> players;
+	for (size_t index = 0; index != players_per_match * 25; ++index) {
+		players.push_back("Player"s + std::to_string(index));
+	}
+
+	MatchStore store;
+	store.initialize(filename);
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t match = 0; match != match_count; ++match) {
+		// Each match draws its players from a rotating slice of the season's player base
+		std::vector<std::string> match_players{ players.begin() + (match % 25) * players_per_match, players.begin() + (match % 25 + 1) * players_per_match };
+		store.add(generate_match(engine, match_players, match));
+	}
+	double record_time = milliseconds_since(start);
+
+	std::printf("Season: %zu matches, %llu events (recorded, sealed%s in %.0f ms)\n", store.getMatchCount(),
+		static_cast<unsigned long long>(store.getEventCount()), filename.empty() ? "" : ", and written", record_time);
+	std::printf("Storage: %.2f MB in memory - %.0f bytes per match - %.2f bytes per event\n",
+		store.getStorageSize() / 1e6, static_cast<double>(store.getStorageSize()) / store.getMatchCount(),
+		static_cast<double>(store.getStorageSize()) / store.getEventCount());
+
+	if (!filename.empty()) {
+		MatchStore reloaded;
+		reloaded.initialize(filename);
+		std::printf("File: %.2f MB - %.2f bytes per event - reloaded %zu matches in %lld ms\n", reloaded.getFileSize() / 1e6,
+			static_cast<double>(reloaded.getFileSize()) / std::max<uint64_t>(reloaded.getFileEventCount(), 1),
+			reloaded.getFileMatchCount(), static_cast<long long>(reloaded.getLoadTime().count()));
+	}
+
+	for (size_t matches : { size_t{ 1 }, size_t{ 100 }, size_t{ 1000 }, size_t{ 0 } }) {
+		bench_top(store, matches == 0 ? store.getMatchCount() : matches);
+	}
+
+	auto result = Benchmark::run([&]() {
+		Benchmark::keep(store.timeline(MatchStore::EventType::Purchase, std::chrono::minutes{ 1 }, 0, 60).size());
+	}, std::chrono::milliseconds{ 200 });
+	std::printf("matchtimeline purchase per minute       %10.3f ms\n", result.second * 1000.0 / result.first);
+	return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+/**
+ * @file bench_rcon_codec.cpp
+ * @brief Measures RCON escape/unescape throughput over chat-like ASCII, mixed UTF-8, and escape-dense text.
+ */
+
+#include <string>
+#include "Benchmark.h"
+#include "RenX_RCONCodec.h"
+
+using namespace std::literals;
+
+namespace {
+std::string repeat(std::string_view in_text, size_t in_size) {
+	std::string result;
+	while (result.size() < in_size) {
+		result += in_text;
+	}
+	return result;
+}
+
+void bench_escapify(std::string_view in_name, const std::string& in_text) {
+	std::string buffer;
+	auto result = Benchmark::run([&]() {
+		buffer.clear();
+		RenX::escapifyRCON(in_text, buffer);
+		Benchmark::keep(buffer.size());
+	});
+	Benchmark::report_bytes(in_name, in_text.size(), result);
+}
+
+void bench_unescapify(std::string_view in_name, const std::string& in_text) {
+	std::string escaped;
+	RenX::escapifyRCON(in_text, escaped);
+
+	std::string buffer;
+	auto result = Benchmark::run([&]() {
+		buffer.clear();
+		RenX::unescapifyRCON(escaped, buffer);
+		Benchmark::keep(buffer.size());
+	});
+	Benchmark::report_bytes(in_name, escaped.size(), result);
+}
+}
+
+int main() {
+	constexpr size_t text_size = 64 * 1024;
+	const std::string ascii = repeat("[Nod] Player: anyone got a tech for the airstrip? gg wp "sv, text_size);
+	const std::string utf8 = repeat("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ok "sv, text_size);
+	const std::string dense = repeat("C:\\a\\b\\"sv, text_size);
+
+	bench_escapify("escapify (ascii)"sv, ascii);
+	bench_escapify("escapify (utf-8)"sv, utf8);
+	bench_escapify("escapify (backslashes)"sv, dense);
+	bench_unescapify("unescapify (ascii)"sv, ascii);
+	bench_unescapify("unescapify (utf-8)"sv, utf8);
+	bench_unescapify("unescapify (backslashes)"sv, dense);
+	return 0;
+}
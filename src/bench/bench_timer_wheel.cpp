@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+/**
+ * @file bench_timer_wheel.cpp
+ * @brief Measures TimerWheel scheduling, cancellation, and firing with 100k pending timers, against a
+ * list of heap-allocated timers which is scanned every tick (as Jupiter::Timer::check() does).
+ */
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "TimerWheel.h"
+
+using namespace std::literals;
+
+namespace {
+constexpr size_t timer_count = 100'000;
+constexpr std::chrono::milliseconds max_delay{ 10min };
+
+using clock_type = TimerWheel::clock;
+
+double nanoseconds_per(clock_type::time_point in_start, size_t in_operations) {
+	return std::chrono::duration<double, std::nano>(clock_type::now() - in_start).count() / in_operations;
+}
+
+/** Stand-in for Jupiter::Timer: one allocation per timer, and every timer is checked each tick */
+struct ScannedTimer
+{
+	clock_type::time_point deadline;
+	std::function<void()> function;
+};
+
+void bench_scanned(const std::vector<std::chrono::milliseconds>& in_delays) {
+	size_t fired = 0;
+	std::vector<std::unique_ptr<ScannedTimer>> timers;
+	clock_type::time_point base = clock_type::now();
+
+	auto start = clock_type::now();
+	for (auto delay : in_delays) {
+		timers.push_back(std::make_unique<ScannedTimer>(ScannedTimer{ base + delay, [&fired]() { ++fired; } }));
+	}
+	std::printf("scanned list: schedule                  %10.1f ns/timer\n", nanoseconds_per(start, timers.size()));
+
+	// Cost of a tick where nothing is due; this is paid every millisecond
+	auto result = Benchmark::run([&]() {
+		size_t due = 0;
+		for (const auto& timer : timers) {
+			if (timer->deadline <= base) {
+				++due;
+			}
+		}
+		Benchmark::keep(due);
+	}, 200ms);
+	std::printf("scanned list: idle tick                 %10.1f us\n", result.second * 1e6 / result.first);
+}
+
+void bench_wheel(const std::vector<std::chrono::milliseconds>& in_delays) {
+	size_t fired = 0;
+	TimerWheel wheel;
+	clock_type::time_point base = clock_type::now();
+	std::vector<TimerWheel::TimerId> ids;
+	ids.reserve(in_delays.size());
+
+	// First round grows the node pool; the second reuses it, and doesn't allocate
+	for (int round = 0; round != 2; ++round) {
+		ids.clear();
+		auto start = clock_type::now();
+		for (auto delay : in_delays) {
+			ids.push_back(wheel.schedule(delay, [&fired]() { ++fired; }));
+		}
+		std::printf("timer wheel: schedule (%s pool)       %10.1f ns/timer\n", round == 0 ? "cold" : "warm", nanoseconds_per(start, ids.size()));
+
+		if (round == 0) {
+			start = clock_type::now();
+			for (auto id : ids) {
+				wheel.cancel(id);
+			}
+			std::printf("timer wheel: cancel                     %10.1f ns/timer\n", nanoseconds_per(start, ids.size()));
+		}
+	}
+
+	auto result = Benchmark::run([&]() {
+		Benchmark::keep(static_cast<size_t>(wheel.nextDeadline().time_since_epoch().count()));
+	}, 200ms);
+	std::printf("timer wheel: nextDeadline               %10.1f ns\n", result.second * 1e9 / result.first);
+
+	result = Benchmark::run([&]() {
+		Benchmark::keep(wheel.advance(base));
+	}, 200ms);
+	std::printf("timer wheel: idle tick                  %10.1f ns\n", result.second * 1e9 / result.first);
+
+	// Run the clock forward one millisecond per tick until every timer has fired
+	auto start = clock_type::now();
+	size_t ticks = 0;
+	for (auto now = base; wheel.size() != 0; now += 1ms, ++ticks) {
+		wheel.advance(now);
+	}
+	double elapsed = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+	std::printf("timer wheel: fire all                   %10.1f ms (%zu ticks, %zu fired, %.1f ns/timer including ticks)\n",
+		elapsed, ticks, fired, elapsed * 1e6 / timer_count);
+}
+}
+
+int main() {
+	std::mt19937 engine{ 35 };
+	std::uniform_int_distribution<long long> delay_distribution{ 1, max_delay.count() };
+	std::vector<std::chrono::milliseconds> delays;
+	delays.reserve(timer_count);
+	for (size_t index = 0; index != timer_count; ++index) {
+		delays.emplace_back(delay_distribution(engine));
+	}
+
+	std::printf("%zu timers, delays up to %lld ms\n", timer_count, static_cast<long long>(max_delay.count()));
+	bench_wheel(delays);
+	bench_scanned(delays);
+	return 0;
+}
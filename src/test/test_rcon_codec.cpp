@@ -0,0 +1,260 @@
+/**
+ * Copyright (C) 2021 Jessica James.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+ * OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Written by Jessica James <jessica.aj@outlook.com>
+ */
+
+
+#include <random>
+#include "gtest/gtest.h"
+#include "RenX_RCONCodec.h"
+
+using namespace std::literals;
+
+namespace {
+/** Straightforward byte-at-a-time escapifier; this is the implementation RenX::escapifyRCON replaced, copied verbatim */
+std::string reference_escapify(std::string_view in_text) {
+	constexpr char hex_upper[] = "0123456789ABCDEF";
+	const char* ptr = in_text.data();
+	size_t length = in_text.size();
+	std::string result;
+
+	while (length != 0) {
+		if ((*ptr & 0x80) != 0) { // UTF-8 sequence
+			if (length < 2) {
+				break;
+			}
+
+			if ((*ptr & 0x40) != 0) { // validity check
+				uint16_t value;
+				if ((*ptr & 0x20) != 0) {
+					if (length < 3) {
+						break;
+					}
+
+					if ((*ptr & 0x10) != 0) { // 4 byte sequence; dropped
+						if (length < 4) {
+							break;
+						}
+
+						ptr += 4;
+						length -= 4;
+						continue;
+					}
+
+					value = (*ptr & 0x0F) << 12;
+					value += (*++ptr & 0x3F) << 6;
+					value += *++ptr & 0x3F;
+					length -= 3;
+				}
+				else {
+					value = (*ptr & 0x1F) << 6;
+					value += *++ptr & 0x3F;
+					length -= 2;
+				}
+
+				result += "\\u"sv;
+				result += hex_upper[value >> 12];
+				result += hex_upper[(value >> 8) & 0x0F];
+				result += hex_upper[(value >> 4) & 0x0F];
+				result += hex_upper[value & 0x0F];
+			}
+			else { // invalid 1 byte sequence; skipped
+				--length;
+			}
+		}
+		else if (*ptr == '\\') {
+			result += "\\\\"sv;
+			--length;
+		}
+		else {
+			result += *ptr;
+			--length;
+		}
+
+		++ptr;
+	}
+
+	return result;
+}
+
+std::string escapify(std::string_view in_text) {
+	std::string result;
+	RenX::escapifyRCON(in_text, result);
+	return result;
+}
+
+std::string unescapify(std::string_view in_text) {
+	std::string result;
+	RenX::unescapifyRCON(in_text, result);
+	return result;
+}
+
+/** Generates text weighted towards the bytes the codec treats specially, long enough to cross the 16-byte SIMD blocks */
+std::string random_text(std::mt19937& in_engine, bool in_valid_utf8) {
+	static constexpr std::string_view samples[]{
+		"a"sv, "Z"sv, " "sv, "\\"sv, "\\\\"sv, "\\n"sv, "\\u"sv, "\\u00E9"sv, "\\uD83D\\uDE00"sv, "\\uDC00"sv,
+		"\\uZZZZ"sv, "\\101"sv, "\\0"sv, "\\x4"sv, "\\xC3"sv, "\\U0001F600"sv, "\\U00110000"sv,
+		"u"sv, "\xC3\xA9"sv, "\xE2\x82\xAC"sv, "\xF0\x9F\x98\x80"sv, "0123456789abcdef"sv
+	};
+
+	std::uniform_int_distribution<size_t> length_distribution{ 0, 96 };
+	std::uniform_int_distribution<size_t> sample_distribution{ 0, std::size(samples) - 1 };
+	std::uniform_int_distribution<int> byte_distribution{ 0, 255 };
+	std::bernoulli_distribution raw_byte{ in_valid_utf8 ? 0.0 : 0.25 };
+
+	std::string result;
+	size_t length = length_distribution(in_engine);
+	while (result.size() < length) {
+		if (raw_byte(in_engine)) {
+			result += static_cast<char>(byte_distribution(in_engine));
+		}
+		else {
+			result += samples[sample_distribution(in_engine)];
+		}
+	}
+
+	return result;
+}
+
+/** Drops the 4-byte sequences from valid UTF-8 text, as escapifying does */
+std::string strip_astral(std::string_view in_text) {
+	std::string result;
+	for (size_t index = 0; index < in_text.size();) {
+		if ((in_text[index] & 0xF8) == 0xF0) {
+			index += 4;
+			continue;
+		}
+		result += in_text[index++];
+	}
+	return result;
+}
+}
+
+TEST(RCONCodecTest, escapify_ascii) {
+	EXPECT_EQ(escapify(""sv), ""sv);
+	EXPECT_EQ(escapify("hello world"sv), "hello world"sv);
+	EXPECT_EQ(escapify("a\\b"sv), "a\\\\b"sv);
+	EXPECT_EQ(escapify("\\\\"sv), "\\\\\\\\"sv);
+	EXPECT_EQ(escapify("tab\tand\nnewline"sv), "tab\tand\nnewline"sv);
+}
+
+TEST(RCONCodecTest, escapify_utf8) {
+	EXPECT_EQ(escapify("caf\xC3\xA9"sv), "caf\\u00E9"sv); // 2 byte sequence
+	EXPECT_EQ(escapify("\xE2\x82\xAC" "5"sv), "\\u20AC5"sv); // 3 byte sequence
+	EXPECT_EQ(escapify("a\xF0\x9F\x98\x80" "b"sv), "ab"sv); // 4 byte sequences are dropped
+	EXPECT_EQ(escapify("a\x80" "b"sv), "ab"sv); // invalid lead bytes are dropped
+	EXPECT_EQ(escapify("ab\xC3"sv), "ab"sv); // truncated sequences are dropped
+	EXPECT_EQ(escapify("ab\xE2\x82"sv), "ab"sv);
+}
+
+TEST(RCONCodecTest, escapify_appends) {
+	std::string buffer = "prefix "s;
+	RenX::escapifyRCON("a\\b"sv, buffer);
+	EXPECT_EQ(buffer, "prefix a\\\\b"sv);
+}
+
+/** Expected values are written as the same escape sequences in C++ literals, so that the compiler decodes them */
+TEST(RCONCodecTest, unescapify_matches_compiler) {
+	EXPECT_EQ(unescapify("a\\\\b"sv), "a\\b"sv);
+	EXPECT_EQ(unescapify("\\a\\b\\f\\n\\r\\t\\v\\'\\\"\\?"sv), "\a\b\f\n\r\t\v\'\"\?"sv);
+	EXPECT_EQ(unescapify("\\101\\60\\7\\0x"sv), "\101\60\7\0x"sv);
+	EXPECT_EQ(unescapify("\\303\\251\\377"sv), "\303\251\377"sv);
+	EXPECT_EQ(unescapify("\\x41\\x7f\\xC3\\xA9\\x0"sv), "\x41\x7f\xC3\xA9\x0"sv);
+}
+
+/** Expected values are the UTF-8 encodings of each codepoint, as listed in the Unicode code charts */
+TEST(RCONCodecTest, unescapify_codepoints) {
+	EXPECT_EQ(unescapify("\\u0041"sv), "A"sv);
+	EXPECT_EQ(unescapify("caf\\u00e9"sv), "caf\xC3\xA9"sv); // U+00E9 LATIN SMALL LETTER E WITH ACUTE
+	EXPECT_EQ(unescapify("\\u20AC"sv), "\xE2\x82\xAC"sv); // U+20AC EURO SIGN
+	EXPECT_EQ(unescapify("\\uD83D\\uDE00"sv), "\xF0\x9F\x98\x80"sv); // U+1F600 GRINNING FACE, as a surrogate pair
+	EXPECT_EQ(unescapify("\\U0001F600"sv), "\xF0\x9F\x98\x80"sv);
+	EXPECT_EQ(unescapify("\\U000000E9"sv), "\xC3\xA9"sv);
+	EXPECT_EQ(unescapify("\\U0010FFFF"sv), "\xF4\x8F\xBF\xBF"sv); // Last codepoint
+}
+
+TEST(RCONCodecTest, unescapify_malformed) {
+	EXPECT_EQ(unescapify("trailing\\"sv), "trailing\\"sv);
+	EXPECT_EQ(unescapify("\\q"sv), "\\q"sv);
+	EXPECT_EQ(unescapify("\\8"sv), "\\8"sv); // Not an octal digit
+	EXPECT_EQ(unescapify("\\u12"sv), "\\u12"sv);
+	EXPECT_EQ(unescapify("\\uZZZZ"sv), "\\uZZZZ"sv);
+	EXPECT_EQ(unescapify("\\uD83Dx"sv), "\xED\xA0\xBD" "x"sv); // lone high surrogate is encoded as-is
+	EXPECT_EQ(unescapify("\\x"sv), "\\x"sv);
+	EXPECT_EQ(unescapify("\\xG"sv), "\\xG"sv);
+	EXPECT_EQ(unescapify("\\U0001F60"sv), "\\U0001F60"sv); // Too few digits
+	EXPECT_EQ(unescapify("\\U00110000"sv), "\\U00110000"sv); // Past the last codepoint
+}
+
+TEST(RCONCodecTest, unescapify_sequence_lengths) {
+	EXPECT_EQ(unescapify("\\1012"sv), "A2"sv); // Octal takes at most 3 digits
+	EXPECT_EQ(unescapify("\\400"sv), "\040" "0"sv); // and stops before exceeding a byte
+	EXPECT_EQ(unescapify("\\x414"sv), "A4"sv); // Hex takes at most 2 digits
+}
+
+TEST(RCONCodecTest, unescapify_in_place) {
+	std::string text = "a\\\\b\\u00E9\\n"s;
+	RenX::unescapifyRCON(text);
+	EXPECT_EQ(text, "a\\b\xC3\xA9\n"sv);
+
+	std::string buffer = "prefix "s;
+	RenX::unescapifyRCON("\\t"sv, buffer);
+	EXPECT_EQ(buffer, "prefix \t"sv);
+}
+
+TEST(RCONCodecTest, round_trip) {
+	constexpr std::string_view samples[]{
+		""sv,
+		"plain ascii text that is longer than a single sixteen byte block"sv,
+		"C:\\Program Files\\Renegade X\\"sv,
+		"\\n is not a newline once escaped"sv,
+		"caf\xC3\xA9 \xE2\x82\xAC \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"sv,
+		"\\u00E9 should survive literally"sv
+	};
+
+	for (std::string_view sample : samples) {
+		EXPECT_EQ(unescapify(escapify(sample)), sample);
+	}
+}
+
+TEST(RCONCodecTest, fuzz_matches_reference) {
+	std::mt19937 engine{ 0x52434F4E }; // fixed seed, so failures are reproducible
+	for (size_t iteration = 0; iteration != 20000; ++iteration) {
+		std::string text = random_text(engine, false);
+		ASSERT_EQ(escapify(text), reference_escapify(text)) << "iteration " << iteration;
+	}
+}
+
+TEST(RCONCodecTest, fuzz_unescapify_in_place) {
+	std::mt19937 engine{ 0x494E504C };
+	for (size_t iteration = 0; iteration != 20000; ++iteration) {
+		std::string text = random_text(engine, false);
+		std::string copied = unescapify(text);
+		ASSERT_LE(copied.size(), text.size()) << "iteration " << iteration;
+
+		std::string in_place = text;
+		RenX::unescapifyRCON(in_place);
+		ASSERT_EQ(in_place, copied) << "iteration " << iteration;
+	}
+}
+
+TEST(RCONCodecTest, fuzz_round_trip) {
+	std::mt19937 engine{ 0x55544638 };
+	for (size_t iteration = 0; iteration != 20000; ++iteration) {
+		std::string text = random_text(engine, true);
+		ASSERT_EQ(unescapify(escapify(text)), strip_astral(text)) << "iteration " << iteration;
+	}
+}